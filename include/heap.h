@@ -45,6 +45,48 @@ static inline void HeapExp_FndInitAllocator(NNSFndAllocator *pAllocator, u32 hea
 void Heap_Realloc(void *ptr, u32 newSize);
 BOOL GF_heap_c_dummy_return_true(u32 heapID);
 
+#ifndef PLATFORM_DS
+/*
+ * Usage of one heap. Sizes are in bytes; curSize and highWaterMark count the
+ * bytes requested, not including block headers or alignment.
+ */
+typedef struct HeapStats {
+    u32 budget;         // Size the heap was created with on DS
+    u32 capacity;       // Bytes reserved for it, including overflow chunks
+    u32 curSize;
+    u32 highWaterMark;
+    u32 numBlocks;
+    u32 peakBlocks;
+    u32 numChunks;
+    u32 slabPages;      // Pages of small blocks, PAL_SLAB_PAGE_SIZE each
+} HeapStats;
+
+u32 Heap_GetSize(enum HeapID heapID);
+u32 Heap_GetMaxAllocatableSize(enum HeapID heapID);
+u32 Heap_GetTotalSize(enum HeapID heapID);
+u32 Heap_GetCurSize(enum HeapID heapID);
+u32 Heap_GetHighWaterMark(enum HeapID heapID);
+u16 Heap_GetNumBlocks(enum HeapID heapID);
+
+/*
+ * Fills stats for a heap. Returns FALSE, with stats zeroed, if the heap does
+ * not exist.
+ */
+BOOL Heap_GetStats(enum HeapID heapID, HeapStats *stats);
+
+/*
+ * Prints the usage of every existing heap, flagging those whose peak usage
+ * was over their DS budget, and the small-block counts per size class.
+ */
+void Heap_PrintStats(void);
+
+/*
+ * Serves small requests from per-heap slab caches (the default) or from the
+ * arenas like everything else. Only affects allocations made afterwards.
+ */
+void Heap_SetSlabEnabled(BOOL enabled);
+#endif
+
 #ifdef PLATFORM_DS
 NNSFndHeapHandle Heap_GetHandle(enum HeapID heapID);
 #else
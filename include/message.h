@@ -145,6 +145,18 @@ Strbuf *MessageBank_GetNewStrbufFromNARC(enum NarcID narcID, u32 bankID, u32 ent
  */
 Strbuf *MessageBank_GetNewStrbufFromHandle(NARC *narc, u32 bankID, u32 entryID, u32 heapID);
 
+#ifndef PLATFORM_DS
+/**
+ * @brief Decode every entry of a message bank into the message store ahead of
+ * time, so that later fetches from it only copy. Meant for loading screens.
+ * SDL only. Does nothing if the bank's archive is not available.
+ *
+ * @param narcID    Archive containing the message bank.
+ * @param bankID    Index of the bank in the archive.
+ */
+void MessageBank_Prefetch(enum NarcID narcID, u32 bankID);
+#endif
+
 /**
  * @brief Get the number of entries in a pre-loaded message bank.
  *
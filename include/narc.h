@@ -2,16 +2,13 @@
 #define POKEPLATINUM_NARC_H
 
 #ifndef PLATFORM_DS
-#include "platform/platform_types.h"
-
 #include "platform/platform_types.h"
 #endif
 
 #include "constants/narc.h"
 
 #ifndef PLATFORM_DS
-// SDL stub - NARC not used in SDL build (uses filesystem instead)
-// FSFile is defined in platform_types.h
+struct PAL_Archive;
 #endif
 
 /*
@@ -19,9 +16,17 @@
  * offsets to the FATB and the FIMG chunks within the file.
  *
  * FATB defines the regions within the FIMG to which the data are allocated.
+ *
+ * On SDL the archive is memory-mapped once and shared by every handle, so
+ * the handle only keeps its own read cursor.
  */
 typedef struct NARC {
+#ifdef PLATFORM_DS
     FSFile file;
+#else
+    struct PAL_Archive *archive;
+    u32 position;
+#endif
     u32 fatbStart;
     u32 fimgStart;
     u16 numFiles;
@@ -86,6 +91,30 @@ void *NARC_AllocAtEndAndReadFromMemberByIndexPair(enum NarcID narcID, int member
  */
 u32 NARC_GetMemberSizeByIndexPair(enum NarcID narcID, int memberIndex);
 
+#ifndef PLATFORM_DS
+/*
+ * Gets the number of members in a NARC. SDL only.
+ *
+ * @param narcID:      Index of NARC to read
+ *
+ * @returns: Number of FAT members in the NARC, 0 if it is not available
+ */
+u16 NARC_GetMemberCountByIndexPair(enum NarcID narcID);
+
+/*
+ * Gets a read-only view of an archive member without copying it. The view stays valid for the
+ * rest of the program. SDL only, where archives are memory-mapped; callers must fall back to the
+ * reading functions when this returns NULL.
+ *
+ * @param narcID:      Index of NARC to read
+ * @param memberIndex:    Index of FAT member within the NARC
+ * @param size:           Receives the size in bytes of the member, can be NULL
+ *
+ * @returns: Pointer to the member data, or NULL if unavailable
+ */
+const void *NARC_GetMemberView(enum NarcID narcID, int memberIndex, u32 *size);
+#endif
+
 /*
  * Constructs a new NARC which contains an open FSFile to the corresponding archive.
  * Useful to reduce overhead when reading from the same NARC multiple times.
@@ -157,6 +186,69 @@ void NARC_ReadFile(NARC *narc, u32 bytesToRead, void *dest);
 
 void NARC_Seek(NARC *narc, u32 offset);
 
+#ifndef PLATFORM_DS
+/*
+ * Gets a read-only view of the archive file at the current cursor and advances the cursor past
+ * it, like NARC_ReadFile without the copy. Returns NULL if the data is not available, leaving the
+ * cursor untouched so the caller can fall back to NARC_ReadFile.
+ *
+ * @param narc:           Pointer to the NARC
+ * @param bytes:          Number of bytes to view
+ *
+ * @returns: Pointer to the data at the cursor, or NULL if unavailable
+ */
+const void *NARC_ViewFile(NARC *narc, u32 bytes);
+
+/*
+ * Called on the main thread, from a SysTask, when an asynchronous read finishes.
+ *
+ * @param data:           The destination buffer, or NULL if the read failed (an allocated buffer is
+ *                        freed before the call in that case)
+ * @param size:           Number of bytes read
+ * @param userData:       As passed to the read function
+ */
+typedef void (*NARCReadCallback)(void *data, u32 size, void *userData);
+
+/*
+ * Like NARC_ReadFile, but the copy happens on a loader thread. The cursor advances immediately, so
+ * the caller can keep reading what follows. dest must stay valid until the callback runs or the
+ * read is cancelled.
+ *
+ * @param narc:           Pointer to the NARC
+ * @param bytesToRead:    Number of bytes to read
+ * @param dest:           Pointer to destination buffer, should be large enough to hold the data
+ * @param callback:       Called once the data is in dest
+ * @param userData:       Passed to callback
+ *
+ * @returns: Handle for NARC_CancelAsyncRead, or 0 if the read could not be queued. The cursor is
+ *           left untouched in that case so the caller can fall back to NARC_ReadFile.
+ */
+u32 NARC_ReadFileAsync(NARC *narc, u32 bytesToRead, void *dest, NARCReadCallback callback, void *userData);
+
+/*
+ * Allocates a buffer for an archive member on the calling thread, then reads the member into it on
+ * a loader thread. The callback owns the buffer.
+ *
+ * @param narcID:      Index of NARC to read
+ * @param memberIndex:    Index of FAT member within the NARC
+ * @param heapID:         ID of the heap to alloc from
+ * @param callback:       Called with the buffer once the data is in it
+ * @param userData:       Passed to callback
+ *
+ * @returns: Handle for NARC_CancelAsyncRead, or 0 if the read could not be queued
+ */
+u32 NARC_AllocAndReadWholeMemberAsync(enum NarcID narcID, int memberIndex, u32 heapID, NARCReadCallback callback, void *userData);
+
+/*
+ * Cancels an asynchronous read so its callback never runs. Waits for a read that is already being
+ * copied, so the destination can be freed as soon as this returns. A buffer allocated by
+ * NARC_AllocAndReadWholeMemberAsync is freed. Handles of finished reads are ignored.
+ *
+ * @param handle:         Handle returned by one of the asynchronous read functions, or 0
+ */
+void NARC_CancelAsyncRead(u32 handle);
+#endif
+
 /*
  * Gets the total number of archive members
  *
@@ -44,4 +44,20 @@ void PCBoxes_UnlockWallpaper(PCBoxes *pcBoxes, u32 wallpaper);
 BOOL PCBoxes_CheckHasUnlockedWallpaper(const PCBoxes *pcBoxes, u32 wallpaper);
 u32 PCBoxes_CountUnlockedWallpapers(const PCBoxes *pcBoxes);
 
+#ifndef PLATFORM_DS
+typedef struct PCBoxSlotSummary {
+    u16 species;
+    u16 heldItem;
+    u8 form;
+    u8 level;
+    u8 exists : 1;
+    u8 isEgg : 1;
+    u8 isShiny : 1;
+    u8 checksumValid : 1;
+} PCBoxSlotSummary;
+
+void PCBoxes_RebuildIndex(const PCBoxes *pcBoxes);
+void PCBoxes_GetSlotSummary(const PCBoxes *pcBoxes, u32 boxID, u32 monPosInBox, PCBoxSlotSummary *summary);
+#endif
+
 #endif // POKEPLATINUM_PC_BOXES_H
@@ -0,0 +1,103 @@
+/**
+ * @file pal_archive.h
+ * @brief Platform Abstraction Layer - Memory-Mapped NARC Archives
+ *
+ * Maps a NARC file into memory once and parses its file allocation table
+ * (BTAF) into an array, so reading a member is a bounds check plus a
+ * pointer instead of a chain of seeks and small reads.
+ *
+ * Archives are looked up under a root directory holding the ROM file system
+ * (the same relative paths as on the cartridge, e.g. "msgdata/pl_msg.narc").
+ */
+
+#ifndef PAL_ARCHIVE_H
+#define PAL_ARCHIVE_H
+
+#include "platform_config.h"
+#include "platform_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct PAL_Archive PAL_Archive;
+
+/**
+ * @brief Default directory archives are opened from
+ */
+#define PAL_ARCHIVE_DEFAULT_ROOT "resources/filesys"
+
+/**
+ * @brief Set the directory archive paths are relative to
+ *
+ * Only affects archives opened afterwards.
+ *
+ * @param dir Root directory (copied)
+ */
+void PAL_Archive_SetRootDir(const char* dir);
+
+/**
+ * @brief Get the directory archive paths are relative to
+ * @return Root directory
+ */
+const char* PAL_Archive_GetRootDir(void);
+
+/**
+ * @brief Map an archive and index its members
+ *
+ * @param path Archive path relative to the root directory
+ * @return Archive handle, or NULL if the file is missing or not a valid NARC
+ */
+PAL_Archive* PAL_Archive_Open(const char* path);
+
+/**
+ * @brief Unmap an archive
+ *
+ * Every pointer returned for this archive becomes invalid.
+ *
+ * @param archive Archive to close (can be NULL)
+ */
+void PAL_Archive_Close(PAL_Archive* archive);
+
+/**
+ * @brief Get the whole mapped file
+ *
+ * @param archive Archive
+ * @param size Receives the file size in bytes
+ * @return Start of the file
+ */
+const u8* PAL_Archive_GetData(const PAL_Archive* archive, u32* size);
+
+/**
+ * @brief Get the number of members
+ * @param archive Archive
+ * @return Member count
+ */
+u32 PAL_Archive_GetMemberCount(const PAL_Archive* archive);
+
+/**
+ * @brief Get a member without copying it
+ *
+ * @param archive Archive
+ * @param index Member index
+ * @param size Receives the member size in bytes (can be NULL)
+ * @return Read-only member data, or NULL if index is out of range
+ */
+const void* PAL_Archive_GetMember(const PAL_Archive* archive, u32 index, u32* size);
+
+/**
+ * @brief Get where a member lies within the file
+ *
+ * @param archive Archive
+ * @param index Member index
+ * @param start Receives the offset of the first byte
+ * @param end Receives the offset one past the last byte
+ * @return TRUE on success, FALSE if index is out of range
+ */
+BOOL PAL_Archive_GetMemberRange(const PAL_Archive* archive, u32 index, u32* start, u32* end);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PAL_ARCHIVE_H
@@ -0,0 +1,139 @@
+#ifndef PAL_ASSET_CACHE_H
+#define PAL_ASSET_CACHE_H
+
+/**
+ * @file pal_asset_cache.h
+ * @brief Platform Abstraction Layer - Decoded Asset Cache
+ *
+ * A process-wide LRU cache of assets that are expensive to produce: NARC
+ * members after decompression, converted graphics read from loose files.
+ * Entries are keyed by (NARC ID, member, transform), where the transform
+ * says what was done to the raw member, so the same member can be cached
+ * both raw and decoded.
+ *
+ * Memory comes from PAL_Malloc, not from a game heap, so entries survive
+ * Heap_Destroy and ApplicationManager transitions. The total size is kept
+ * under a byte budget by evicting the least recently used unpinned entries.
+ *
+ * Not thread-safe; call from the main thread.
+ */
+
+#include "platform_config.h"
+#include "platform_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Default byte budget
+ */
+#define PAL_ASSET_CACHE_DEFAULT_BUDGET (32u * 1024 * 1024)
+
+/**
+ * @brief What was done to a NARC member before caching it
+ */
+typedef enum {
+    PAL_ASSET_TRANSFORM_RAW = 0,            // Member bytes as stored
+    PAL_ASSET_TRANSFORM_LZ,                 // LZ10/LZ11 member, decompressed
+    PAL_ASSET_TRANSFORM_CONVERTED_TILES,    // Loose-file assets from the
+    PAL_ASSET_TRANSFORM_CONVERTED_TILEMAP,  // converter, in PAL_AssetKind
+    PAL_ASSET_TRANSFORM_CONVERTED_PALETTE,  // order
+} PAL_AssetTransform;
+
+/**
+ * @brief Cache counters, since startup or the last PAL_AssetCache_ResetStats
+ */
+typedef struct {
+    u64 hits;
+    u64 misses;
+    u64 evictions;
+    u64 rejected;           // Inserts larger than the budget allows
+    size_t bytes;           // Currently cached
+    size_t pinned_bytes;
+    size_t budget;
+    u32 entries;
+} PAL_AssetCacheStats;
+
+/**
+ * Set the byte budget, evicting entries if the cache is now over it
+ * @param bytes New budget; 0 disables caching
+ */
+void PAL_AssetCache_SetBudget(size_t bytes);
+
+/**
+ * Look up an asset and mark it most recently used
+ *
+ * The pointer stays valid until the entry is evicted, which only happens
+ * inside PAL_AssetCache_Insert, SetBudget and Clear; pin the entry to keep
+ * it longer.
+ *
+ * @param narcID NARC the asset came from
+ * @param member Member index
+ * @param transform What was done to the member
+ * @param size Receives the asset size in bytes (can be NULL)
+ * @return Cached data, or NULL on a miss
+ */
+const void* PAL_AssetCache_Find(u32 narcID, u32 member, PAL_AssetTransform transform, u32* size);
+
+/**
+ * Add an asset, taking ownership of its buffer
+ *
+ * Evicts least recently used unpinned entries as needed to stay within the
+ * budget. Replaces an existing entry with the same key unless it is pinned.
+ *
+ * @param narcID NARC the asset came from
+ * @param member Member index
+ * @param transform What was done to the member
+ * @param data Buffer allocated with PAL_Malloc
+ * @param size Size of data in bytes
+ * @return TRUE if the cache now owns data; FALSE if it was not cached (too
+ *         large, or the key is pinned) and the caller still owns it
+ */
+BOOL PAL_AssetCache_Insert(u32 narcID, u32 member, PAL_AssetTransform transform, void* data, u32 size);
+
+/**
+ * Keep an entry resident regardless of the budget
+ *
+ * Pins nest; each PAL_AssetCache_Pin needs a matching PAL_AssetCache_Unpin.
+ *
+ * @return TRUE if the entry exists and is now pinned
+ */
+BOOL PAL_AssetCache_Pin(u32 narcID, u32 member, PAL_AssetTransform transform);
+
+/**
+ * Release a pin taken with PAL_AssetCache_Pin
+ */
+void PAL_AssetCache_Unpin(u32 narcID, u32 member, PAL_AssetTransform transform);
+
+/**
+ * Drop every unpinned entry
+ */
+void PAL_AssetCache_Clear(void);
+
+/**
+ * Drop every entry, pinned or not, and free the cache's own memory
+ */
+void PAL_AssetCache_Shutdown(void);
+
+/**
+ * Get the current counters
+ * @param stats Receives the counters
+ */
+void PAL_AssetCache_GetStats(PAL_AssetCacheStats* stats);
+
+/**
+ * Zero the hit, miss, eviction and rejection counters
+ */
+void PAL_AssetCache_ResetStats(void);
+
+/**
+ * Print the counters and current usage to stdout
+ */
+void PAL_AssetCache_PrintSummary(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PAL_ASSET_CACHE_H
@@ -0,0 +1,131 @@
+#ifndef PAL_ASYNC_LOAD_H
+#define PAL_ASYNC_LOAD_H
+
+/**
+ * @file pal_async_load.h
+ * @brief Platform Abstraction Layer - Background Asset Loading
+ *
+ * A small pool of worker threads that copy (and optionally LZ-decompress)
+ * slices of memory-mapped archives into caller-provided buffers. The copy
+ * is where the page faults, and so the actual disk I/O, happen, which is
+ * the work the field streaming code used to do on the main thread.
+ *
+ * Workers never call back into game code. A finished load is pushed onto a
+ * lock-free completion queue, and its callback runs on the main thread the
+ * next time PAL_AsyncLoad_Drain is called, so everything that touches game
+ * state stays single-threaded.
+ *
+ * Submit, Cancel and Drain must be called from the main thread.
+ */
+
+#include "platform_config.h"
+#include "platform_types.h"
+#include "pal_archive.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Maximum number of loads in flight (submitted but not yet drained)
+ */
+#define PAL_ASYNC_LOAD_MAX_JOBS 64
+
+/**
+ * @brief Use as the member of a request to make its offset relative to the
+ *        start of the archive file instead of a member
+ */
+#define PAL_ASYNC_LOAD_FILE_OFFSET 0xFFFFFFFF
+
+/**
+ * @brief Identifies a submitted load; 0 is never a valid handle
+ *
+ * Handles are generation-checked, so cancelling one whose load has already
+ * completed is harmless.
+ */
+typedef u32 PAL_AsyncLoadHandle;
+
+typedef enum {
+    PAL_ASYNC_LOAD_OK = 0,
+    PAL_ASYNC_LOAD_FAILED,      // Out of range, or corrupt LZ data
+} PAL_AsyncLoadStatus;
+
+/**
+ * @brief Completion callback, run on the main thread by PAL_AsyncLoad_Drain
+ * @param status Whether dest holds the requested data
+ * @param dest The request's destination buffer
+ * @param size Bytes written to dest
+ * @param userData The request's user data
+ */
+typedef void (*PAL_AsyncLoadCallback)(PAL_AsyncLoadStatus status, void* dest, u32 size, void* userData);
+
+typedef struct {
+    const PAL_Archive* archive;
+    u32 member;                 // Member index, or PAL_ASYNC_LOAD_FILE_OFFSET
+    u32 offset;                 // Byte offset within the member (or file)
+    u32 size;                   // Bytes to read; 0 reads to the end of the member
+    BOOL decompress;            // LZ-decompress the bytes read into dest
+    void* dest;
+    u32 dest_capacity;
+    PAL_AsyncLoadCallback callback;
+    void* user_data;
+} PAL_AsyncLoadRequest;
+
+/**
+ * @brief Start the worker threads
+ *
+ * Without workers (never initialized, or thread creation failed) loads run
+ * inside PAL_AsyncLoad_Submit, but their callbacks are still deferred to
+ * PAL_AsyncLoad_Drain, so callers see the same ordering either way.
+ *
+ * @param numWorkers Worker count; 0 picks one based on the CPU count
+ * @return TRUE if at least one worker is running
+ */
+BOOL PAL_AsyncLoad_Init(u32 numWorkers);
+
+/**
+ * @brief Stop the workers and drop every pending load without running its
+ *        callback
+ */
+void PAL_AsyncLoad_Shutdown(void);
+
+/**
+ * @brief Queue a load
+ *
+ * The archive and dest must stay valid until the callback has run or the
+ * load has been cancelled.
+ *
+ * @param request What to load; copied
+ * @return Handle, or 0 if the request is invalid or too many loads are in
+ *         flight (the caller should then load synchronously)
+ */
+PAL_AsyncLoadHandle PAL_AsyncLoad_Submit(const PAL_AsyncLoadRequest* request);
+
+/**
+ * @brief Cancel a load so its callback never runs
+ *
+ * If a worker is already copying into dest this waits for it to finish, so
+ * once it returns dest can be freed. Does nothing for handles that have
+ * completed and been drained.
+ *
+ * @param handle Load to cancel (0 is ignored)
+ */
+void PAL_AsyncLoad_Cancel(PAL_AsyncLoadHandle handle);
+
+/**
+ * @brief Run the callbacks of finished loads, in completion order
+ * @return Number of callbacks run
+ */
+u32 PAL_AsyncLoad_Drain(void);
+
+/**
+ * @brief Get the number of loads submitted but not yet drained or cancelled
+ * @return Pending load count
+ */
+u32 PAL_AsyncLoad_GetPendingCount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PAL_ASYNC_LOAD_H
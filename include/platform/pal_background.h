@@ -21,6 +21,7 @@ extern "C" {
 // Note: PAL_BgConfig is typedef'd in bg_window.h as BgConfig (which is struct BgConfig)
 struct BgConfig;
 typedef struct BgConfig PAL_BgConfig;  // Make it refer to the actual struct
+struct PAL_SpriteManager;
 typedef struct PAL_BgTemplate PAL_BgTemplate;
 
 /**
@@ -293,6 +294,24 @@ void* PAL_Bg_GetTilemapBuffer(PAL_BgConfig* bgConfig, u8 bgLayer);
 void PAL_Bg_LoadTiles(PAL_BgConfig* bgConfig, u8 bgLayer, const void* src, 
                      u32 size, u32 tileStart);
 
+/**
+ * @brief Get writable layer storage for a range of tiles
+ *
+ * Lets a loader read or decompress tile graphics straight into the layer
+ * instead of into a buffer that PAL_Bg_LoadTiles then copies. The storage
+ * grows as needed (doubling, so repeated loads rarely reallocate) and the
+ * range is marked for re-decode. The pointer is only valid until the next
+ * call that loads tiles into the same layer, and the data must be in place
+ * before the layer is next rendered.
+ *
+ * @param bgConfig Background configuration
+ * @param bgLayer Target layer
+ * @param tileStart Starting tile index
+ * @param size Size of the range in bytes
+ * @return Start of the range, or NULL on failure
+ */
+void* PAL_Bg_MapTileRange(PAL_BgConfig* bgConfig, u8 bgLayer, u32 tileStart, u32 size);
+
 /**
  * @brief Load tile graphics directly to VRAM
  * 
@@ -330,6 +349,19 @@ void PAL_Bg_ClearTilesRange(u8 bgLayer, u32 size, u32 offset, u32 heapID);
  */
 void PAL_Bg_LoadPalette(PAL_BgConfig* bgConfig, u8 bgLayer, const void* src, u16 size, u16 offset);
 
+/**
+ * @brief Load the standard BG palette shared by all layers of a screen
+ *
+ * Equivalent of GX_LoadBGPltt / GXS_LoadBGPltt. Colors that did not change
+ * are skipped, so only tiles using a changed sub-palette get re-decoded.
+ *
+ * @param screen Target screen
+ * @param src Source palette data (RGB555 format)
+ * @param size Size in bytes
+ * @param offset Offset in palette memory (in colors)
+ */
+void PAL_Bg_LoadScreenPalette(PAL_Screen screen, const void* src, u16 size, u16 offset);
+
 /**
  * @brief Apply mask to palette
  * 
@@ -343,21 +375,77 @@ void PAL_Bg_MaskPalette(u8 bgLayer, u16 mask);
 // ============================================================================
 
 /**
- * @brief Render all background layers to screen
+ * @brief Render the background layers and sprites to screen
  * 
- * Called internally by PAL_Graphics_EndFrame()
+ * Composes each screen in one pass (see pal_compositor.h), honouring
+ * BG and OBJ priority, windows (including the OBJ window) and blending.
  * 
  * @param bgConfig Background configuration
+ * @param sprites Sprite manager, or NULL for no OBJ plane
  */
-void PAL_Bg_RenderAll(PAL_BgConfig* bgConfig);
+void PAL_Bg_RenderAll(PAL_BgConfig* bgConfig, struct PAL_SpriteManager* sprites);
+
+// ============================================================================
+// Compositor Access
+// ============================================================================
+
+/**
+ * @brief Read-only view of a layer's decoded pixels
+ *
+ * Exactly one of pixels / indices is set, depending on the color mode the
+ * layer was created with. Width and height are powers of two.
+ */
+typedef struct {
+    const u32* pixels;      // RGBA32 pixels, 0 = transparent (direct color)
+    const u8* indices;      // Palette indices, 0 = transparent (indexed color)
+    const u32* palette;     // Packed 256-color palette for indices
+    int width;
+    int height;
+    int xOffset;
+    int yOffset;
+    u8 priority;
+} PAL_BgLayerView;
 
 /**
- * @brief Render a specific background layer
+ * @brief Bring a layer's decoded pixels up to date and describe them
  * 
  * @param bgConfig Background configuration
- * @param bgLayer Layer to render
+ * @param bgLayer Layer to query
+ * @param view Filled in on success
+ * @return TRUE if the layer is enabled and has pixels to show
+ */
+BOOL PAL_Bg_GetLayerView(PAL_BgConfig* bgConfig, u8 bgLayer, PAL_BgLayerView* view);
+
+/**
+ * @brief Get layer priority
+ * 
+ * @param bgLayer Layer to query
+ * @return Priority value (0-3, 0 = front)
+ */
+u8 PAL_Bg_GetPriority(u8 bgLayer);
+
+/**
+ * @brief Get the backdrop color of a screen (BG palette color 0)
+ * 
+ * @param screen Screen to query
+ * @return Opaque packed RGBA32 color
+ */
+u32 PAL_Bg_GetBackdropColor(PAL_Screen screen);
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+/**
+ * @brief Get the number of tiles decoded by the last render of a layer
+ *
+ * Only tiles whose tilemap entry, graphics or palette changed are
+ * re-decoded, so this is 0 for a layer that was static this frame.
+ *
+ * @param bgLayer Layer to query
+ * @return Tiles decoded the last time the compositor read the layer
  */
-void PAL_Bg_RenderLayer(PAL_BgConfig* bgConfig, u8 bgLayer);
+u32 PAL_Bg_GetTilesDecoded(u8 bgLayer);
 
 #ifdef __cplusplus
 }
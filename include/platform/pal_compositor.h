@@ -0,0 +1,250 @@
+/**
+ * @file pal_compositor.h
+ * @brief Platform Abstraction Layer - 2D Screen Compositor
+ *
+ * Produces the final 256x192 image of a screen in a single pass the way the
+ * DS 2D engine does: per pixel it picks the two front-most visible planes
+ * (BG0-3, OBJ, backdrop) by priority, applies the window masks and then the
+ * color effect (alpha blend, brighten, darken).
+ *
+ * The registers mirror the G2/GX window and blend registers; the
+ * platform_types.h stubs for G2_SetBlendAlpha, G2_SetWnd0Position, ...
+ * forward to these functions on SDL.
+ */
+
+#ifndef PAL_COMPOSITOR_H
+#define PAL_COMPOSITOR_H
+
+#include "platform_config.h"
+#include "platform_types.h"
+#include "pal_graphics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct BgConfig;
+struct PAL_SpriteManager;
+
+/**
+ * @brief Plane mask bits (same values as GX_BLEND_PLANEMASK_* / GX_WND_PLANEMASK_*)
+ */
+#define PAL_PLANE_BG0 0x01
+#define PAL_PLANE_BG1 0x02
+#define PAL_PLANE_BG2 0x04
+#define PAL_PLANE_BG3 0x08
+#define PAL_PLANE_OBJ 0x10
+#define PAL_PLANE_BD  0x20
+#define PAL_PLANE_ALL 0x3F
+
+/**
+ * @brief Window enable bits (same values as GX_WNDMASK_*)
+ */
+#define PAL_WINDOW_MASK_W0      0x01
+#define PAL_WINDOW_MASK_W1      0x02
+#define PAL_WINDOW_MASK_OBJ     0x04
+
+/**
+ * @brief Hardware windows
+ */
+typedef enum {
+    PAL_WINDOW_0 = 0,
+    PAL_WINDOW_1,
+    PAL_WINDOW_MAX
+} PAL_Window;
+
+/**
+ * @brief Color special effect
+ */
+typedef enum {
+    PAL_BLEND_NONE = 0,
+    PAL_BLEND_ALPHA,        // target1 * eva/16 + target2 * evb/16
+    PAL_BLEND_BRIGHTEN,     // target1 towards white by evy/16
+    PAL_BLEND_DARKEN        // target1 towards black by evy/16
+} PAL_BlendMode;
+
+// ============================================================================
+// Window Registers
+// ============================================================================
+
+/**
+ * @brief Select which windows are enabled (GX_SetVisibleWnd)
+ *
+ * @param screen Target screen
+ * @param mask PAL_WINDOW_MASK_* bits, 0 disables windowing
+ */
+void PAL_Compositor_SetVisibleWindows(PAL_Screen screen, u32 mask);
+
+/**
+ * @brief Set a window rectangle (G2_SetWnd0Position)
+ *
+ * Right and bottom are exclusive. A left edge greater than the right edge
+ * wraps around the screen, like on hardware.
+ *
+ * @param screen Target screen
+ * @param window Window to set
+ * @param left Left edge
+ * @param top Top edge
+ * @param right Right edge (exclusive)
+ * @param bottom Bottom edge (exclusive)
+ */
+void PAL_Compositor_SetWindowRect(PAL_Screen screen, PAL_Window window,
+                                  int left, int top, int right, int bottom);
+
+/**
+ * @brief Set the planes visible inside a window (G2_SetWnd0InsidePlane)
+ *
+ * @param screen Target screen
+ * @param window Window to set
+ * @param planeMask PAL_PLANE_* bits shown inside the window
+ * @param effect TRUE to apply the color effect inside the window
+ */
+void PAL_Compositor_SetWindowInside(PAL_Screen screen, PAL_Window window, u32 planeMask, BOOL effect);
+
+/**
+ * @brief Set the planes visible inside the OBJ window (G2_SetWndOBJInsidePlane)
+ *
+ * The OBJ window is the union of the opaque pixels of OBJ window sprites
+ * (see PAL_Sprite_SetObjWindow). WIN0 and WIN1 take precedence over it.
+ *
+ * @param screen Target screen
+ * @param planeMask PAL_PLANE_* bits shown inside the OBJ window
+ * @param effect TRUE to apply the color effect inside the OBJ window
+ */
+void PAL_Compositor_SetObjWindowInside(PAL_Screen screen, u32 planeMask, BOOL effect);
+
+/**
+ * @brief Set the planes visible outside all windows (G2_SetWndOutsidePlane)
+ *
+ * @param screen Target screen
+ * @param planeMask PAL_PLANE_* bits shown outside the windows
+ * @param effect TRUE to apply the color effect outside the windows
+ */
+void PAL_Compositor_SetWindowOutside(PAL_Screen screen, u32 planeMask, BOOL effect);
+
+// ============================================================================
+// Blend Registers
+// ============================================================================
+
+/**
+ * @brief Disable the color effect (G2_BlendNone)
+ *
+ * @param screen Target screen
+ */
+void PAL_Compositor_BlendNone(PAL_Screen screen);
+
+/**
+ * @brief Set up alpha blending (G2_SetBlendAlpha)
+ *
+ * @param screen Target screen
+ * @param plane1 First target planes (PAL_PLANE_*)
+ * @param plane2 Second target planes (PAL_PLANE_*)
+ * @param eva First target weight (0-16)
+ * @param evb Second target weight (0-16)
+ */
+void PAL_Compositor_SetBlendAlpha(PAL_Screen screen, u32 plane1, u32 plane2, int eva, int evb);
+
+/**
+ * @brief Change alpha blending weights only (G2_ChangeBlendAlpha)
+ *
+ * @param screen Target screen
+ * @param eva First target weight (0-16)
+ * @param evb Second target weight (0-16)
+ */
+void PAL_Compositor_ChangeBlendAlpha(PAL_Screen screen, int eva, int evb);
+
+/**
+ * @brief Set up brighten/darken (G2_SetBlendBrightness)
+ *
+ * @param screen Target screen
+ * @param plane Target planes (PAL_PLANE_*)
+ * @param brightness -16 (black) to 16 (white)
+ */
+void PAL_Compositor_SetBlendBrightness(PAL_Screen screen, u32 plane, int brightness);
+
+// ============================================================================
+// Composition
+// ============================================================================
+
+/**
+ * @brief Compose one screen into its screen texture
+ *
+ * Replaces the previous contents of the screen texture with a single
+ * upload and copy. Sprites are rasterized on the CPU with their priority,
+ * so OBJ/BG ordering is exact.
+ *
+ * @param bgConfig Background configuration
+ * @param sprites Sprite manager, or NULL for no OBJ plane
+ * @param screen Screen to compose
+ */
+void PAL_Compositor_ComposeScreen(struct BgConfig* bgConfig, struct PAL_SpriteManager* sprites,
+                                  PAL_Screen screen);
+
+/**
+ * @brief Compose both screens
+ *
+ * @param bgConfig Background configuration
+ * @param sprites Sprite manager, or NULL for no OBJ plane
+ */
+void PAL_Compositor_ComposeAll(struct BgConfig* bgConfig, struct PAL_SpriteManager* sprites);
+
+/**
+ * @brief Make a BG config the BG source of PAL_Compositor_ComposeFrame
+ *
+ * Called by PAL_Bg_CreateConfig; the BG layer state is global, so the most
+ * recently created config is the live one.
+ *
+ * @param bgConfig Background configuration
+ */
+void PAL_Compositor_AttachBgConfig(struct BgConfig* bgConfig);
+
+/**
+ * @brief Stop composing a BG config (no-op if it is not attached)
+ *
+ * @param bgConfig Background configuration
+ */
+void PAL_Compositor_DetachBgConfig(struct BgConfig* bgConfig);
+
+/**
+ * @brief Make a sprite manager the OBJ source of PAL_Compositor_ComposeFrame
+ *
+ * Called by PAL_Sprite_CreateManager.
+ *
+ * @param sprites Sprite manager
+ */
+void PAL_Compositor_AttachSprites(struct PAL_SpriteManager* sprites);
+
+/**
+ * @brief Stop composing a sprite manager (no-op if it is not attached)
+ *
+ * @param sprites Sprite manager
+ */
+void PAL_Compositor_DetachSprites(struct PAL_SpriteManager* sprites);
+
+/**
+ * @brief Compose both screens from the attached BG config and sprite manager
+ *
+ * Called once per frame by the main loop.
+ *
+ * @return TRUE if a frame was composed, FALSE if nothing is attached
+ */
+BOOL PAL_Compositor_ComposeFrame(void);
+
+/**
+ * @brief Get the CPU copy of the last composed frame
+ *
+ * @param screen Screen to query
+ * @return PAL_SCREEN_WIDTH x PAL_SCREEN_HEIGHT RGBA32 pixels, or NULL
+ */
+const u32* PAL_Compositor_GetFrame(PAL_Screen screen);
+
+/**
+ * @brief Free the compositor's textures and frame buffers
+ */
+void PAL_Compositor_Shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PAL_COMPOSITOR_H
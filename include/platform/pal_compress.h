@@ -0,0 +1,119 @@
+#ifndef PAL_COMPRESS_H
+#define PAL_COMPRESS_H
+
+/**
+ * @file pal_compress.h
+ * @brief Platform Abstraction Layer - LZ77 Decompression
+ *
+ * Decodes the LZ77 formats the DS BIOS and NitroSDK use for compressed
+ * graphics and data (MI_UncompressLZ8):
+ *   LZ10  header byte 0x10, 2-byte matches of 3..18 bytes
+ *   LZ11  header byte 0x11, 2/3/4-byte matches of up to 65808 bytes
+ *
+ * Both share a 4-byte header: the type byte followed by the 24-bit
+ * uncompressed size. A size of 0 means a second u32 holds the real size.
+ *
+ * Unlike the BIOS routine every read and write is bounds-checked, so a
+ * damaged stream fails instead of running off the end of either buffer.
+ */
+
+#include "platform_config.h"
+#include "platform_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PAL_LZ_TYPE_LZ10 0x10
+#define PAL_LZ_TYPE_LZ11 0x11
+
+/**
+ * @brief Decoder states returned by PAL_LZ_StreamFeed
+ */
+typedef enum {
+    PAL_LZ_STREAM_NEED_INPUT = 0,   // Everything fed so far was consumed
+    PAL_LZ_STREAM_DONE,             // Output complete, further input is ignored
+    PAL_LZ_STREAM_ERROR             // Bad header, bad match or output too small
+} PAL_LZStreamStatus;
+
+/**
+ * @brief Streaming decoder state
+ *
+ * Lets a compressed resource be decoded as it arrives (chunked file reads,
+ * a partially loaded archive) straight into its final buffer, such as a
+ * background's tile data, without holding the whole source in memory.
+ * Treat the fields as private.
+ */
+typedef struct {
+    u8* dest;
+    u32 dest_capacity;
+    u32 dest_size;          // From the header, 0 until it is read
+    u32 dest_pos;
+    u8 type;
+    u8 flags;               // Current flag byte, shifted as tokens are used
+    u8 flag_bits;           // Tokens left in the current flag byte
+    u8 pending_count;
+    u8 pending[8];          // Header or token bytes split across feeds
+    PAL_LZStreamStatus status;
+} PAL_LZStream;
+
+/**
+ * Check whether data starts with an LZ10/LZ11 header
+ * @param src Compressed data
+ * @param srcSize Bytes available at src
+ * @return TRUE if the header is complete and has a known type
+ */
+BOOL PAL_LZ_IsCompressed(const void* src, u32 srcSize);
+
+/**
+ * Read the uncompressed size from an LZ10/LZ11 header
+ * @param src Compressed data
+ * @param srcSize Bytes available at src
+ * @return Uncompressed size, or 0 if the header is missing or invalid
+ */
+u32 PAL_LZ_GetUncompressedSize(const void* src, u32 srcSize);
+
+/**
+ * Decompress a whole LZ10/LZ11 stream
+ * @param src Compressed data, including the header
+ * @param srcSize Bytes available at src
+ * @param dest Output buffer
+ * @param destSize Size of dest, at least PAL_LZ_GetUncompressedSize()
+ * @return Bytes written, or 0 if the stream is invalid or doesn't fit
+ */
+u32 PAL_LZ_Decompress(const void* src, u32 srcSize, void* dest, u32 destSize);
+
+/**
+ * Start a streaming decode
+ * @param stream Decoder state
+ * @param dest Output buffer
+ * @param destCapacity Size of dest; the stream fails if the header asks for more
+ */
+void PAL_LZ_StreamInit(PAL_LZStream* stream, void* dest, u32 destCapacity);
+
+/**
+ * Decode the next piece of the compressed stream
+ *
+ * All of src is consumed; bytes that end mid-token are kept in the stream
+ * until the next call. Output is written to dest in order, so everything
+ * below PAL_LZ_StreamGetOutputSize() is final.
+ *
+ * @param stream Decoder state
+ * @param src Next compressed bytes
+ * @param srcSize Number of bytes at src
+ * @return Decoder state after this chunk
+ */
+PAL_LZStreamStatus PAL_LZ_StreamFeed(PAL_LZStream* stream, const void* src, u32 srcSize);
+
+/**
+ * Get how many bytes have been written so far
+ * @param stream Decoder state
+ * @return Bytes of final output at the start of dest
+ */
+u32 PAL_LZ_StreamGetOutputSize(const PAL_LZStream* stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PAL_COMPRESS_H
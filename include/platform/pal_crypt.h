@@ -0,0 +1,91 @@
+#ifndef PAL_CRYPT_H
+#define PAL_CRYPT_H
+
+/**
+ * @file pal_crypt.h
+ * @brief Platform Abstraction Layer - LCRNG Stream Cipher Kernels
+ *
+ * XORs data with the keystream of the game's LCRNG (x = x * 1103515245 + 24691,
+ * key = x >> 16), one key per halfword. This is the cipher behind EncodeData
+ * and DecodeData, used for BoxPokemon data blocks, party data and game records.
+ *
+ * The LCRNG is affine, so x[n + k] = A_k * x[n] + C_k for constants that only
+ * depend on k. The SIMD kernels seed each lane with a different x[1..k] and
+ * step every lane by k at once, generating 8 (SSE2, NEON) or 16 (AVX2) keys
+ * per step instead of one long dependency chain. Output is bit-identical to
+ * the scalar loop on every path.
+ *
+ * The best kernel for the running CPU (AVX2, SSE2, NEON or scalar) is
+ * picked on first use; PAL_Crypt_SetPath() can force a specific one.
+ */
+
+#include "platform_config.h"
+#include "platform_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Keystream kernel implementations
+ */
+typedef enum {
+    PAL_CRYPT_SCALAR = 0,
+    PAL_CRYPT_SSE2,
+    PAL_CRYPT_AVX2,
+    PAL_CRYPT_NEON,
+    PAL_CRYPT_PATH_MAX
+} PAL_CryptPath;
+
+/**
+ * Get the kernel currently used for the keystream
+ * @return Active path
+ */
+PAL_CryptPath PAL_Crypt_GetPath(void);
+
+/**
+ * Force a specific keystream kernel
+ * @param path Path to use
+ * @return TRUE if the path is supported on this CPU and is now active
+ */
+BOOL PAL_Crypt_SetPath(PAL_CryptPath path);
+
+/**
+ * Check whether a keystream kernel is compiled in and supported by this CPU
+ * @param path Path to check
+ * @return TRUE if supported
+ */
+BOOL PAL_Crypt_IsPathSupported(PAL_CryptPath path);
+
+/**
+ * Get a printable name for a keystream kernel
+ * @param path Path to name
+ * @return Static string ("scalar", "sse2", ...)
+ */
+const char* PAL_Crypt_GetPathName(PAL_CryptPath path);
+
+/**
+ * XOR data with the LCRNG keystream (encrypts and decrypts alike)
+ * @param data Data to transform in place, 2-byte aligned
+ * @param size Size in bytes; a trailing odd byte is left untouched
+ * @param seed LCRNG seed; the first key comes from the state after one step
+ */
+void PAL_Crypt_LCRNGXor(void* data, u32 size, u32 seed);
+
+/**
+ * XOR data with the LCRNG keystream and sum the resulting halfwords
+ *
+ * Decrypts and checksums in one pass, for the decrypt-then-verify pattern
+ * of BoxPokemon data blocks.
+ * @param data Data to transform in place, 2-byte aligned
+ * @param size Size in bytes; a trailing odd byte is left untouched
+ * @param seed LCRNG seed
+ * @return Sum of the transformed halfwords, modulo 2^16
+ */
+u16 PAL_Crypt_LCRNGXorChecksum(void* data, u32 size, u32 seed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PAL_CRYPT_H
@@ -72,6 +72,21 @@ int PAL_File_Seek(PAL_File file, long offset, int origin);
  */
 long PAL_File_Tell(PAL_File file);
 
+/**
+ * Map a whole file into memory, read-only
+ * @param path File path
+ * @param size Receives the file size in bytes
+ * @return Start of the mapping, or NULL on failure or if the file is empty
+ */
+const void* PAL_File_Map(const char* path, size_t* size);
+
+/**
+ * Unmap a file mapped with PAL_File_Map
+ * @param data Start of the mapping (can be NULL)
+ * @param size Size returned by PAL_File_Map
+ */
+void PAL_File_Unmap(const void* data, size_t size);
+
 /**
  * Open a directory for reading
  * @param path Directory path
@@ -114,4 +129,53 @@ BOOL PAL_Path_Exists(const char* path);
  */
 BOOL PAL_Path_IsDirectory(const char* path);
 
+// ============================================================================
+// Asset Pack
+// ============================================================================
+
+/*
+ * A single container holding the converted assets that would otherwise be
+ * loose files under resources/graphics, built by tools/pack_assets.py.
+ * It is mapped once, and lookups go through a hashed directory, so
+ * loading an asset needs no open, seek or read.
+ */
+
+#define PAL_ASSET_PACK_DEFAULT_PATH "resources/assets.pak"
+
+// Must match ASSET_KINDS in tools/pack_assets.py
+typedef enum {
+    PAL_ASSET_TILES,        // "tiles.bin"
+    PAL_ASSET_TILEMAP,      // "tilemap.bin"
+    PAL_ASSET_PALETTE,      // "palette.pal"
+    PAL_ASSET_KIND_MAX
+} PAL_AssetKind;
+
+/**
+ * Map an asset pack, replacing any pack opened before
+ * @param path Pack file path
+ * @return TRUE on success, FALSE if the file is missing or invalid
+ */
+BOOL PAL_AssetPack_Open(const char* path);
+
+/**
+ * Unmap the asset pack. Pointers returned by PAL_AssetPack_Find become invalid.
+ */
+void PAL_AssetPack_Close(void);
+
+/**
+ * Check whether an asset pack is open
+ * @return TRUE if PAL_AssetPack_Find can serve lookups
+ */
+BOOL PAL_AssetPack_IsOpen(void);
+
+/**
+ * Look up an asset
+ * @param narcID NARC the asset was converted from
+ * @param member Member index within the NARC
+ * @param kind Asset kind
+ * @param size Receives the asset size in bytes (can be NULL)
+ * @return Read-only asset data, or NULL if no pack is open or it lacks the asset
+ */
+const void* PAL_AssetPack_Find(u32 narcID, u32 member, PAL_AssetKind kind, u32* size);
+
 #endif // PAL_FILE_H
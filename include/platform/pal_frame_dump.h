@@ -0,0 +1,98 @@
+/**
+ * @file pal_frame_dump.h
+ * @brief Platform Abstraction Layer - Frame Dump Sink
+ *
+ * Writes every presented frame (both screens side by side) to a directory
+ * as a numbered image sequence, for screenshot regression and offline
+ * inspection of batch runs. PNG files are written with a small built-in
+ * encoder, so no image library is needed.
+ */
+
+#ifndef PAL_FRAME_DUMP_H
+#define PAL_FRAME_DUMP_H
+
+#include "platform_config.h"
+#include "platform_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Output file format
+ */
+typedef enum {
+    PAL_FRAME_DUMP_RAW = 0,     // frame_NNNNNN.rgba, tightly packed RGBA8 rows
+    PAL_FRAME_DUMP_PNG          // frame_NNNNNN.png, 8-bit RGBA, uncompressed deflate
+} PAL_FrameDumpFormat;
+
+/**
+ * @brief Start dumping frames
+ *
+ * The directory is created if it does not exist. Raw frames carry no
+ * header; their size is the window size passed to PAL_Graphics_Init().
+ *
+ * @param directory Output directory
+ * @param format File format
+ * @param interval Write every Nth frame (0 or 1 = every frame)
+ * @return TRUE on success, FALSE if the directory can't be created
+ */
+BOOL PAL_FrameDump_Start(const char* directory, PAL_FrameDumpFormat format, u32 interval);
+
+/**
+ * @brief Stop dumping frames
+ */
+void PAL_FrameDump_Stop(void);
+
+/**
+ * @brief Check whether the sink is active
+ * @return TRUE between Start and Stop
+ */
+BOOL PAL_FrameDump_IsActive(void);
+
+/**
+ * @brief Offer a presented frame to the sink
+ *
+ * Called by PAL_Graphics_EndFrame(); frames skipped by the interval only
+ * cost a counter increment.
+ *
+ * @param pixels RGBA8 pixels (R first in memory)
+ * @param width Frame width
+ * @param height Frame height
+ * @param pitch Bytes per row
+ */
+void PAL_FrameDump_Submit(const void* pixels, int width, int height, int pitch);
+
+/**
+ * @brief Check whether the next submitted frame will be written
+ *
+ * Lets the window backend skip reading pixels back from the GPU on frames
+ * that would be dropped anyway.
+ *
+ * @return TRUE if the next PAL_FrameDump_Submit() writes a file
+ */
+BOOL PAL_FrameDump_WantsNextFrame(void);
+
+/**
+ * @brief Get the number of files written since PAL_FrameDump_Start()
+ * @return Frames written
+ */
+u32 PAL_FrameDump_GetWrittenCount(void);
+
+/**
+ * @brief Write a single RGBA8 image as a PNG file
+ *
+ * @param path Output file
+ * @param pixels RGBA8 pixels (R first in memory)
+ * @param width Image width
+ * @param height Image height
+ * @param pitch Bytes per row
+ * @return TRUE on success
+ */
+BOOL PAL_FrameDump_WritePNG(const char* path, const void* pixels, int width, int height, int pitch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PAL_FRAME_DUMP_H
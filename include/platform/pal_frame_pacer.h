@@ -0,0 +1,178 @@
+/**
+ * @file pal_frame_pacer.h
+ * @brief Platform Abstraction Layer - Frame Pacing and Frame-Time Telemetry
+ *
+ * Runs the main loop at the DS refresh rate (59.8261 Hz) from the
+ * performance counter. Deadlines are accumulated rather than restarted
+ * each frame, so a long frame is made up by the following ones instead of
+ * shifting every later frame, and the average rate does not drift.
+ *
+ * The time spent in each phase of a frame is recorded into a ring buffer
+ * of the last PAL_FRAME_PACER_HISTORY frames.
+ */
+
+#ifndef PAL_FRAME_PACER_H
+#define PAL_FRAME_PACER_H
+
+#include "platform_config.h"
+#include "platform_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief DS LCD refresh rate (33.513982 MHz / (355 * 263 * 6))
+ */
+#define PAL_FRAME_PACER_DS_REFRESH_HZ 59.8261
+
+/**
+ * @brief Number of frames kept in the timing history
+ */
+#define PAL_FRAME_PACER_HISTORY 1024
+
+/**
+ * @brief How the pacer waits for the next frame
+ */
+typedef enum {
+    PAL_PACE_TIMED = 0,     // Sleep until the next deadline, spin for the last stretch
+    PAL_PACE_VSYNC,         // Presenting blocks on vsync; the pacer only measures
+    PAL_PACE_UNCAPPED       // Never wait
+} PAL_PaceMode;
+
+/**
+ * @brief Timed sections of a frame
+ */
+typedef enum {
+    PAL_FRAME_PHASE_INPUT = 0,  // Event polling and input update
+    PAL_FRAME_PHASE_TASKS,      // Task managers, vblank callback, sound tick
+    PAL_FRAME_PHASE_RENDER,     // Building the frame
+    PAL_FRAME_PHASE_PRESENT,    // Handing the frame to the display
+    PAL_FRAME_PHASE_WAIT,       // Time spent in PAL_FramePacer_WaitForNextFrame()
+    PAL_FRAME_PHASE_MAX
+} PAL_FramePhase;
+
+/**
+ * @brief Timings of one frame, in microseconds
+ */
+typedef struct {
+    u32 phase_us[PAL_FRAME_PHASE_MAX];
+    u32 frame_us;           // Wall time from the previous frame's end to this one's
+    BOOL late;              // The deadline had already passed when the frame ended
+} PAL_FrameTiming;
+
+/**
+ * @brief Percentiles over the timing history, in microseconds
+ */
+typedef struct {
+    u32 p50;
+    u32 p95;
+    u32 p99;
+    u32 max;
+} PAL_FramePercentiles;
+
+/**
+ * @brief Summary of the timing history
+ */
+typedef struct {
+    u32 num_frames;                                     // Frames in the history
+    PAL_FramePercentiles phases[PAL_FRAME_PHASE_MAX];
+    PAL_FramePercentiles frame;
+    u64 total_frames;                                   // Frames since PAL_FramePacer_Init()
+    u64 late_frames;                                    // Frames that missed their deadline
+    u64 resyncs;                                        // Times the backlog was dropped
+} PAL_FramePacerSummary;
+
+/**
+ * @brief Initialize the pacer and start the first frame
+ *
+ * @param refreshHz Target rate, or 0 for PAL_FRAME_PACER_DS_REFRESH_HZ
+ */
+void PAL_FramePacer_Init(double refreshHz);
+
+/**
+ * @brief Select how the pacer waits
+ *
+ * PAL_PACE_VSYNC expects vsync to be enabled on the renderer (see
+ * PAL_Graphics_SetVSync()); the loop then runs at the display's rate.
+ *
+ * @param mode Pacing mode
+ */
+void PAL_FramePacer_SetMode(PAL_PaceMode mode);
+
+/**
+ * @brief Get the pacing mode
+ * @return Mode set by PAL_FramePacer_SetMode()
+ */
+PAL_PaceMode PAL_FramePacer_GetMode(void);
+
+/**
+ * @brief Temporarily run uncapped
+ *
+ * Overrides the mode without changing it; when fast-forward ends the
+ * cadence restarts from the current time instead of catching up.
+ *
+ * @param enabled TRUE to stop waiting
+ */
+void PAL_FramePacer_SetFastForward(BOOL enabled);
+
+/**
+ * @brief Check whether fast-forward is on
+ * @return TRUE while fast-forwarding
+ */
+BOOL PAL_FramePacer_IsFastForward(void);
+
+/**
+ * @brief Start timing a phase
+ *
+ * A phase may be entered several times per frame; the times add up.
+ *
+ * @param phase Phase to start
+ */
+void PAL_FramePacer_BeginPhase(PAL_FramePhase phase);
+
+/**
+ * @brief Stop timing a phase
+ * @param phase Phase started by PAL_FramePacer_BeginPhase()
+ */
+void PAL_FramePacer_EndPhase(PAL_FramePhase phase);
+
+/**
+ * @brief Wait for the next frame deadline and record the frame's timings
+ *
+ * Replaces a fixed per-frame delay. If the loop falls more than a few
+ * frames behind, the backlog is dropped rather than run back to back.
+ */
+void PAL_FramePacer_WaitForNextFrame(void);
+
+/**
+ * @brief Get the timings of the most recently finished frame
+ * @return Last frame, or NULL before the first one
+ */
+const PAL_FrameTiming* PAL_FramePacer_GetLastFrame(void);
+
+/**
+ * @brief Copy the timing history, oldest frame first
+ *
+ * @param out Destination array
+ * @param maxFrames Capacity of out
+ * @return Number of frames copied
+ */
+u32 PAL_FramePacer_GetHistory(PAL_FrameTiming* out, u32 maxFrames);
+
+/**
+ * @brief Compute percentiles over the timing history
+ * @param out Receives the summary
+ */
+void PAL_FramePacer_GetSummary(PAL_FramePacerSummary* out);
+
+/**
+ * @brief Print the p50/p95/p99/max table of the timing history
+ */
+void PAL_FramePacer_PrintSummary(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PAL_FRAME_PACER_H
@@ -41,6 +41,11 @@ static inline PAL_Color PAL_ColorFromRGB555(u16 rgb555) {
     return color;
 }
 
+// Helper: Pack PAL_Color into a 32-bit pixel for SDL_PIXELFORMAT_RGBA32 textures
+static inline u32 PAL_ColorToRGBA32(PAL_Color color) {
+    return ((u32)color.a << 24) | ((u32)color.b << 16) | ((u32)color.g << 8) | color.r;
+}
+
 // Helper: Convert PAL_Color to DS RGB555
 static inline u16 PAL_ColorToRGB555(PAL_Color color) {
     u16 r = (color.r >> 3) & 0x1F;
@@ -50,6 +55,24 @@ static inline u16 PAL_ColorToRGB555(PAL_Color color) {
     return r | (g << 5) | (b << 10) | (a << 15);
 }
 
+// Number of 16-color sub-palettes in a 256-color palette
+#define PAL_PALETTE_NUM_SUBPALETTES 16
+
+/**
+ * Palette pre-packed into texture pixels, built once per palette load
+ *
+ * Generations come from one global counter, so two LUTs never share a
+ * value and a cached texture can remember "which palette, which version"
+ * with a single u32.
+ */
+typedef struct {
+    u32 colors[256];        // Packed SDL_PIXELFORMAT_RGBA32 pixels
+    u16 rgb555[256];        // Source colors, used to detect real changes
+    u32 generation;         // Bumped whenever any color changes
+    u32 subGenerations[PAL_PALETTE_NUM_SUBPALETTES];  // Per 16-color sub-palette
+    int num_colors;
+} PAL_PaletteLUT;
+
 /**
  * Initialize the graphics system
  * @param window_width Total window width
@@ -147,6 +170,74 @@ void PAL_Graphics_TransferVRAM(void* src, void* dst, size_t size);
 #ifdef PLATFORM_SDL
 #include <SDL3/SDL.h>
 
+/**
+ * How BG layer and sprite textures store their colors
+ */
+typedef enum {
+    PAL_GRAPHICS_COLOR_DIRECT = 0,  // RGBA32 textures, palette baked in on the CPU
+    PAL_GRAPHICS_COLOR_INDEXED      // INDEX8 textures, palette resolved at draw time
+} PAL_GraphicsColorMode;
+
+/**
+ * Where the graphics system presents its frames
+ */
+typedef enum {
+    PAL_GRAPHICS_BACKEND_WINDOW = 0,    // Window with a hardware renderer, presented to the display
+    PAL_GRAPHICS_BACKEND_HEADLESS       // No window; software renderer drawing into a CPU framebuffer
+} PAL_GraphicsBackend;
+
+/**
+ * Select the graphics backend
+ *
+ * Must be called before PAL_Graphics_Init(); ignored afterwards. The
+ * headless backend needs neither a display nor a GPU and never waits for
+ * vsync, so the main loop runs as fast as the CPU allows.
+ *
+ * @param backend Backend to use
+ */
+void PAL_Graphics_SetBackend(PAL_GraphicsBackend backend);
+
+/**
+ * Get the selected graphics backend
+ * @return Active backend
+ */
+PAL_GraphicsBackend PAL_Graphics_GetBackend(void);
+
+/**
+ * Get the CPU framebuffer of the headless backend
+ *
+ * Holds the last frame finished by PAL_Graphics_EndFrame(), both screens
+ * side by side, as SDL_PIXELFORMAT_RGBA32.
+ *
+ * @param width Receives the width in pixels (can be NULL)
+ * @param height Receives the height in pixels (can be NULL)
+ * @param pitch Receives the bytes per row (can be NULL)
+ * @return Pixel data, or NULL with the window backend
+ */
+const void* PAL_Graphics_GetFramebuffer(int* width, int* height, int* pitch);
+
+/**
+ * Enable or disable waiting for vsync when presenting
+ *
+ * Only the window backend presents; the headless backend never waits.
+ *
+ * @param enabled TRUE to lock presentation to the display refresh
+ * @return TRUE on success, FALSE if the renderer can't change vsync
+ */
+BOOL PAL_Graphics_SetVSync(BOOL enabled);
+
+/**
+ * Get the number of frames finished by PAL_Graphics_EndFrame()
+ * @return Frames since PAL_Graphics_Init()
+ */
+u64 PAL_Graphics_GetFrameCount(void);
+
+/**
+ * Get the frame rate, updated about once per second
+ * @return Frames per second over the last measurement window, 0 until the first one ends
+ */
+float PAL_Graphics_GetFrameRate(void);
+
 /**
  * Create a texture from RGBA pixel data
  * @param width Texture width
@@ -234,6 +325,72 @@ void PAL_Graphics_DrawLine(PAL_Surface* surf, int x1, int y1, int x2, int y2,
  */
 void PAL_Graphics_SetPalette(const u16* palette_rgb555, int num_colors);
 
+/**
+ * Get the palette set by PAL_Graphics_SetPalette()
+ * @return Packed palette LUT (never NULL)
+ */
+const PAL_PaletteLUT* PAL_Graphics_GetPaletteLUT(void);
+
+/**
+ * Reset a palette LUT to "nothing loaded" (all colors transparent)
+ * @param lut LUT to reset
+ */
+void PAL_PaletteLUT_Init(PAL_PaletteLUT* lut);
+
+/**
+ * Load RGB555 colors into a palette LUT
+ *
+ * Only colors that differ from what is already loaded are re-packed, and
+ * the LUT's generations are only bumped when something actually changed.
+ *
+ * @param lut Target LUT
+ * @param src Source colors (DS RGB555)
+ * @param offset First color index to write
+ * @param count Number of colors
+ * @return Mask of 16-color sub-palettes whose colors changed
+ */
+u16 PAL_PaletteLUT_Load(PAL_PaletteLUT* lut, const u16* src, u32 offset, u32 count);
+
+/**
+ * Select how BG layer and sprite textures store their colors
+ *
+ * In indexed mode a palette change (fade, flash) only re-uploads the
+ * changed palette entries; the tile and sprite textures are left alone.
+ * Only affects layers and sprites created after the call.
+ *
+ * @param mode Color mode to use
+ * @return TRUE on success, FALSE if the renderer has no indexed textures
+ */
+BOOL PAL_Graphics_SetColorMode(PAL_GraphicsColorMode mode);
+
+/**
+ * Get the current texture color mode
+ * @return Active color mode
+ */
+PAL_GraphicsColorMode PAL_Graphics_GetColorMode(void);
+
+/**
+ * Create a streaming SDL_PIXELFORMAT_INDEX8 texture with its own palette
+ * @param width Texture width
+ * @param height Texture height
+ * @param outPalette Receives the 256-entry palette attached to the texture
+ * @return SDL texture handle, or NULL on failure
+ */
+SDL_Texture* PAL_Graphics_CreateIndexedTexture(int width, int height, SDL_Palette** outPalette);
+
+/**
+ * Copy the sub-palettes of a LUT that changed after a given generation
+ * into an indexed texture's palette
+ *
+ * Entry 0 is always made transparent.
+ *
+ * @param palette Target SDL palette
+ * @param lut Source palette LUT
+ * @param syncedGeneration Generation returned by the previous sync (0 = none)
+ * @return Generation to pass to the next sync
+ */
+u32 PAL_Graphics_SyncIndexedPalette(SDL_Palette* palette, const PAL_PaletteLUT* lut, u32 syncedGeneration);
+
 /**
  * Get the SDL renderer (for advanced operations)
  * @return SDL renderer handle
@@ -242,7 +399,7 @@ SDL_Renderer* PAL_Graphics_GetRenderer(void);
 
 /**
  * Get the SDL window (for advanced operations)
- * @return SDL window handle
+ * @return SDL window handle, or NULL with the headless backend
  */
 SDL_Window* PAL_Graphics_GetWindow(void);
 
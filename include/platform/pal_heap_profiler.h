@@ -0,0 +1,133 @@
+/**
+ * @file pal_heap_profiler.h
+ * @brief Platform Abstraction Layer - Heap Allocation Profiler
+ *
+ * Records every Heap_Alloc/Heap_AllocAtEnd/Heap_Free/Heap_Realloc and
+ * PAL_Malloc/PAL_Free with the calling address, size, heap and frame, and
+ * attributes them to (callsite, heap). Reports:
+ * - allocations and frees per frame
+ * - the callsites allocating the most, with churn flagged: sites whose
+ *   blocks are mostly freed in the frame that allocated them, every frame
+ * - blocks still allocated when Heap_Destroy or ApplicationManager_Free runs
+ *
+ * The JSON dump is meant to be compared between builds with
+ * tools/heap_profile_diff.py, which flags callsites whose allocation rate
+ * went up.
+ *
+ * Only built with -DPAL_HEAP_PROFILER (CMake option PAL_ENABLE_HEAP_PROFILER).
+ * Without it, heap.c and pal_memory_sdl.c contain no profiling code at all
+ * and these functions are not defined.
+ */
+
+#ifndef PAL_HEAP_PROFILER_H
+#define PAL_HEAP_PROFILER_H
+
+#include "platform_config.h"
+#include "platform_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PAL_HEAP_PROFILER
+
+/**
+ * @brief Heap ID under which PAL_Malloc allocations are recorded
+ */
+#define PAL_HEAP_PROFILER_PAL_HEAP 0xFF
+
+/**
+ * @brief Return address of the current function, recorded as the callsite
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define PAL_HEAP_PROFILER_CALLER() __builtin_return_address(0)
+#else
+#define PAL_HEAP_PROFILER_CALLER() NULL
+#endif
+
+/**
+ * @brief Start profiling
+ *
+ * Allocations made before this are not tracked, and freeing them is
+ * ignored.
+ *
+ * @param maxEvents Most recent allocation events kept for the JSON dump,
+ *        0 to keep none
+ * @return TRUE on success, FALSE if the event buffer can't be allocated
+ */
+BOOL PAL_HeapProfiler_Init(u32 maxEvents);
+
+/**
+ * @brief Stop profiling and free the profiler's own memory
+ */
+void PAL_HeapProfiler_Shutdown(void);
+
+/**
+ * @brief Check whether the profiler is running
+ * @return TRUE between Init and Shutdown
+ */
+BOOL PAL_HeapProfiler_IsEnabled(void);
+
+/**
+ * @brief Record an allocation
+ * @param ptr Allocated block (NULL is ignored)
+ * @param size Requested size in bytes
+ * @param heapID Heap it came from, or PAL_HEAP_PROFILER_PAL_HEAP
+ * @param caller Address the allocation was requested from
+ */
+void PAL_HeapProfiler_RecordAlloc(void* ptr, u32 size, u32 heapID, void* caller);
+
+/**
+ * @brief Record a free; call before the block is released
+ * @param ptr Block being freed (NULL and untracked blocks are ignored)
+ */
+void PAL_HeapProfiler_RecordFree(void* ptr);
+
+/**
+ * @brief Record an in-place resize
+ * @param ptr Block that was resized
+ * @param newSize Its new requested size
+ */
+void PAL_HeapProfiler_RecordResize(void* ptr, u32 newSize);
+
+/**
+ * @brief Report and forget the blocks still allocated in a heap; call
+ *        before the heap's memory is released
+ * @param heapID Heap being destroyed
+ */
+void PAL_HeapProfiler_HeapDestroyed(u32 heapID);
+
+/**
+ * @brief Print the blocks still allocated in each heap
+ * @param when Shown in the report, e.g. "ApplicationManager_Free"
+ */
+void PAL_HeapProfiler_ReportOutstanding(const char* when);
+
+/**
+ * @brief Mark the end of a frame
+ */
+void PAL_HeapProfiler_EndFrame(void);
+
+/**
+ * @brief Print per-frame counts, the top callsites and outstanding blocks
+ */
+void PAL_HeapProfiler_PrintSummary(void);
+
+/**
+ * @brief Write callsites, per-frame counts and recent events as JSON
+ *
+ * Callsites are written one per line, sorted by name, so dumps from two
+ * runs can also be compared with a plain diff.
+ *
+ * @param path Output file
+ * @return TRUE on success
+ */
+BOOL PAL_HeapProfiler_WriteJSON(const char* path);
+
+#endif // PAL_HEAP_PROFILER
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PAL_HEAP_PROFILER_H
@@ -92,6 +92,120 @@ typedef struct PAL_Allocator {
  * @param allocator Custom allocator structure
  */
 void PAL_Memory_SetAllocator(PAL_Allocator* allocator);
+
+// ============================================================================
+// Small-object slab allocator (SDL only)
+// ============================================================================
+//
+// Objects of 16..512 bytes are rounded up to one of PAL_SLAB_NUM_CLASSES
+// size classes and carved out of PAL_SLAB_PAGE_SIZE pages, one class per
+// page. Allocation pops a per-class free list or bumps through the newest
+// page, and freeing pushes onto the free list, so neither ever searches or
+// coalesces.
+//
+// A cache is owned by the thread that created it: only that thread may
+// allocate from it. Any thread may free; frees from other threads are
+// queued and picked up by the owner on its next allocation.
+// Heap_Alloc keeps one cache per game heap for small requests, so
+// Heap_Destroy still releases them in one go.
+
+#define PAL_SLAB_MIN_SIZE 16
+#define PAL_SLAB_MAX_SIZE 512
+#define PAL_SLAB_NUM_CLASSES 16
+#define PAL_SLAB_PAGE_SIZE (16 * 1024)
+
+typedef struct PAL_SlabCache PAL_SlabCache;
+
+/**
+ * Counters for one size class of a cache
+ */
+typedef struct {
+    u32 object_size;
+    u64 allocs;
+    u64 frees;
+    u32 live;
+    u32 peak_live;
+    u32 pages;
+} PAL_SlabClassStats;
+
+/**
+ * Create a cache owned by the calling thread
+ * @return New cache, or NULL on failure
+ */
+PAL_SlabCache* PAL_Slab_CreateCache(void);
+
+/**
+ * Free a cache and every page it owns, whether or not its objects were freed
+ * @param cache Cache to destroy (NULL is ignored)
+ */
+void PAL_Slab_DestroyCache(PAL_SlabCache* cache);
+
+/**
+ * Get the calling thread's own cache, creating it on first use
+ *
+ * Thread caches are never destroyed: a thread that exits leaves its pages
+ * behind for objects other threads may still hold.
+ *
+ * @return Cache, or NULL on failure
+ */
+PAL_SlabCache* PAL_Slab_GetThreadCache(void);
+
+/**
+ * Allocate a small object from a cache owned by the calling thread
+ * @param cache Cache to allocate from
+ * @param size Size in bytes, up to PAL_SLAB_MAX_SIZE
+ * @return 16-byte aligned object, or NULL if size is too large or out of memory
+ */
+void* PAL_Slab_Alloc(PAL_SlabCache* cache, size_t size);
+
+/**
+ * Allocate an object of a given class from a cache owned by the calling thread
+ * @param cache Cache to allocate from
+ * @param sizeClass Class index, below PAL_SLAB_NUM_CLASSES
+ * @return 16-byte aligned object, or NULL if out of memory
+ */
+void* PAL_Slab_AllocFromClass(PAL_SlabCache* cache, u32 sizeClass);
+
+/**
+ * Return an object to the cache it came from; callable from any thread
+ * @param ptr Object from PAL_Slab_Alloc (NULL is ignored)
+ */
+void PAL_Slab_Free(void* ptr);
+
+/**
+ * Return an object to a cache owned by the calling thread
+ *
+ * Unlike PAL_Slab_Free, this neither reads the object's page header nor
+ * checks the thread, so it is for callers that only use the cache from its
+ * owner and kept the object's class from when they allocated it.
+ *
+ * @param cache Cache the object came from
+ * @param sizeClass Class of the object, from PAL_Slab_GetSizeClass
+ * @param ptr Object from PAL_Slab_Alloc, not NULL
+ */
+void PAL_Slab_FreeToClass(PAL_SlabCache* cache, u32 sizeClass, void* ptr);
+
+/**
+ * Get the usable size of an object, i.e. the size of its class
+ * @param ptr Object from PAL_Slab_Alloc
+ * @return Size in bytes
+ */
+size_t PAL_Slab_GetObjectSize(const void* ptr);
+
+/**
+ * Get the size class a request falls into
+ * @param size Size in bytes
+ * @return Class index, or PAL_SLAB_NUM_CLASSES if size is above PAL_SLAB_MAX_SIZE
+ */
+u32 PAL_Slab_GetSizeClass(size_t size);
+
+/**
+ * Get the counters of one size class; call from the owning thread
+ * @param cache Cache to query; NULL gives zero counts
+ * @param sizeClass Class index
+ * @param stats Receives the counters
+ */
+void PAL_Slab_GetStats(const PAL_SlabCache* cache, u32 sizeClass, PAL_SlabClassStats* stats);
 #endif
 
 #endif // PAL_MEMORY_H
@@ -75,7 +75,7 @@ typedef enum {
 typedef struct {
     const void* graphics_data;      // Tile data
     u32 graphics_size;
-    const void* palette_data;        // Palette (RGB555)
+    const void* palette_data;        // Palette (RGB555), NULL = use the screen's OBJ palette
     u16 palette_size;
     
     PAL_SpriteSize size;
@@ -239,6 +239,17 @@ void PAL_Sprite_SetAlpha(PAL_Sprite* sprite, u8 alpha);
  */
 void PAL_Sprite_SetBlendMode(PAL_Sprite* sprite, PAL_SpriteBlendMode blend_mode);
 
+/**
+ * @brief Make a sprite an OBJ window sprite (OBJ mode 2 on DS)
+ * 
+ * An OBJ window sprite is not drawn; its opaque pixels form the OBJ window
+ * of its screen (see PAL_Compositor_SetObjWindowInside).
+ * 
+ * @param sprite Sprite to modify
+ * @param enable TRUE for an OBJ window sprite, FALSE for a normal one
+ */
+void PAL_Sprite_SetObjWindow(PAL_Sprite* sprite, BOOL enable);
+
 // ============================================================================
 // Affine Transformations
 // ============================================================================
@@ -313,7 +324,10 @@ void PAL_Sprite_UpdateAll(PAL_SpriteManager* manager);
 /**
  * @brief Render all visible sprites
  * 
- * Called internally by PAL_Graphics_EndFrame()
+ * Direct color sprites are packed into a shared atlas texture and drawn
+ * with SDL_RenderGeometry, one batch per screen and blend mode. Indexed
+ * color sprites, and sprites that found no room in the atlas, are drawn
+ * from their own texture.
  * 
  * @param manager Sprite manager
  */
@@ -326,6 +340,58 @@ void PAL_Sprite_RenderAll(PAL_SpriteManager* manager);
  */
 void PAL_Sprite_Render(const PAL_Sprite* sprite);
 
+/**
+ * @brief Read-only description of a sprite for CPU compositing
+ */
+typedef struct {
+    const u8* graphics;         // Linear 4bpp (low nibble first) or 8bpp pixels
+    const u32* palette;         // 16 packed colors for 4bpp, 256 for 8bpp
+    BOOL is8bpp;
+    int width, height;
+    int x, y;
+    u8 priority;
+    PAL_SpriteFlip flip;
+    BOOL affine;
+    float rotation;             // Degrees, about the sprite center
+    float scaleX, scaleY;
+    u8 alpha;
+    PAL_SpriteBlendMode blendMode;
+    BOOL objWindow;             // Shapes the OBJ window instead of being drawn
+} PAL_SpriteView;
+
+/**
+ * @brief Describe the visible sprites of one screen
+ * 
+ * Views are returned in OAM (slot) order, which is the tie-break order
+ * between sprites of equal priority.
+ * 
+ * @param manager Sprite manager
+ * @param screen Screen to collect sprites for
+ * @param views Output array
+ * @param maxViews Capacity of views
+ * @return Number of views written
+ */
+int PAL_Sprite_GetViews(PAL_SpriteManager* manager, PAL_Screen screen,
+                        PAL_SpriteView* views, int maxViews);
+
+// ============================================================================
+// OBJ Palette
+// ============================================================================
+
+/**
+ * @brief Load the shared OBJ palette of a screen
+ * 
+ * Equivalent of GX_LoadOBJPltt / GXS_LoadOBJPltt. Used by sprites created
+ * without their own palette_data. Sprite textures are only re-decoded when
+ * the sub-palette they use actually changed.
+ * 
+ * @param screen Target screen
+ * @param src Source palette data (RGB555 format)
+ * @param size Size in bytes
+ * @param offset Offset in palette memory (in colors)
+ */
+void PAL_Sprite_LoadScreenPalette(PAL_Screen screen, const void* src, u16 size, u16 offset);
+
 // ============================================================================
 // Utility Functions
 // ============================================================================
@@ -0,0 +1,105 @@
+/**
+ * @file pal_task_profiler.h
+ * @brief Platform Abstraction Layer - SysTask Profiler
+ *
+ * Times every task callback run by SysTaskManager_ExecuteTasks() and
+ * attributes it to (task manager, callback, priority). Results are shown
+ * as a per-second top-N table, a per-manager summary on exit and an
+ * optional Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev).
+ *
+ * Only built with -DPAL_TASK_PROFILER (CMake option PAL_ENABLE_TASK_PROFILER).
+ * Without it, sys_task_manager.c contains no profiling code at all and
+ * these functions are not defined.
+ */
+
+#ifndef PAL_TASK_PROFILER_H
+#define PAL_TASK_PROFILER_H
+
+#include "platform_config.h"
+#include "platform_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PAL_TASK_PROFILER
+
+/**
+ * @brief Start profiling
+ *
+ * @param topN Rows of the per-second table, 0 to not print it
+ * @param maxTraceEvents Callbacks kept for the Chrome trace (most recent
+ *        ones win), 0 to not record a trace
+ * @return TRUE on success, FALSE if the trace buffer can't be allocated
+ */
+BOOL PAL_TaskProfiler_Init(u32 topN, u32 maxTraceEvents);
+
+/**
+ * @brief Stop profiling and free the trace buffer
+ */
+void PAL_TaskProfiler_Shutdown(void);
+
+/**
+ * @brief Check whether the profiler is running
+ * @return TRUE between Init and Shutdown
+ */
+BOOL PAL_TaskProfiler_IsEnabled(void);
+
+/**
+ * @brief Name a task manager in reports
+ *
+ * Unnamed managers are reported by address.
+ *
+ * @param manager Task manager
+ * @param name Display name (must outlive the profiler)
+ */
+void PAL_TaskProfiler_RegisterManager(const void* manager, const char* name);
+
+/**
+ * @brief Get a timestamp to pass to PAL_TaskProfiler_EndTask()
+ * @return Performance counter value
+ */
+u64 PAL_TaskProfiler_BeginTask(void);
+
+/**
+ * @brief Record one task callback
+ *
+ * Callback and priority are passed in rather than read from the task,
+ * because the callback may have deleted its task.
+ *
+ * @param manager Task manager that ran the task
+ * @param callback Task callback
+ * @param priority Task priority
+ * @param start Value returned by PAL_TaskProfiler_BeginTask()
+ */
+void PAL_TaskProfiler_EndTask(const void* manager, void* callback, u32 priority, u64 start);
+
+/**
+ * @brief Mark the end of a frame
+ *
+ * Prints the top-N table about once per second.
+ */
+void PAL_TaskProfiler_EndFrame(void);
+
+/**
+ * @brief Print per-manager totals and the most expensive tasks since Init
+ */
+void PAL_TaskProfiler_PrintSummary(void);
+
+/**
+ * @brief Write the recorded callbacks as Chrome trace-event JSON
+ *
+ * Each task manager becomes a thread row; events carry the priority.
+ *
+ * @param path Output file
+ * @return TRUE on success
+ */
+BOOL PAL_TaskProfiler_WriteChromeTrace(const char* path);
+
+#endif // PAL_TASK_PROFILER
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PAL_TASK_PROFILER_H
@@ -0,0 +1,168 @@
+#ifndef PAL_TILE_DECODE_H
+#define PAL_TILE_DECODE_H
+
+/**
+ * @file pal_tile_decode.h
+ * @brief Platform Abstraction Layer - Indexed Pixel Decode Kernels
+ *
+ * Converts DS 4bpp/8bpp character data into 32-bit texture pixels using a
+ * pre-packed palette lookup table. Shared by the background and sprite
+ * renderers. Color index 0 always decodes to a fully transparent pixel.
+ *
+ * The best kernel for the running CPU (AVX2, SSE2, NEON or scalar) is
+ * picked on first use; PAL_TileDecode_SetPath() can force a specific one.
+ *
+ * The *Index variants emit 8-bit palette indices instead, for textures
+ * whose colors are resolved at draw time (PAL_GRAPHICS_COLOR_INDEXED).
+ */
+
+#include "platform_config.h"
+#include "platform_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Decode kernel implementations
+ */
+typedef enum {
+    PAL_TILE_DECODE_SCALAR = 0,
+    PAL_TILE_DECODE_SSE2,
+    PAL_TILE_DECODE_AVX2,
+    PAL_TILE_DECODE_NEON,
+    PAL_TILE_DECODE_PATH_MAX
+} PAL_TileDecodePath;
+
+/**
+ * @brief Flip flags (same bit values as PAL_SpriteFlip)
+ */
+#define PAL_TILE_DECODE_FLIP_H 0x01
+#define PAL_TILE_DECODE_FLIP_V 0x02
+
+/**
+ * Get the kernel currently used for decoding
+ * @return Active decode path
+ */
+PAL_TileDecodePath PAL_TileDecode_GetPath(void);
+
+/**
+ * Force a specific decode kernel
+ * @param path Path to use
+ * @return TRUE if the path is supported on this CPU and is now active
+ */
+BOOL PAL_TileDecode_SetPath(PAL_TileDecodePath path);
+
+/**
+ * Check whether a decode kernel is compiled in and supported by this CPU
+ * @param path Path to check
+ * @return TRUE if supported
+ */
+BOOL PAL_TileDecode_IsPathSupported(PAL_TileDecodePath path);
+
+/**
+ * Get a printable name for a decode kernel
+ * @param path Path to name
+ * @return Static string ("scalar", "sse2", ...)
+ */
+const char* PAL_TileDecode_GetPathName(PAL_TileDecodePath path);
+
+/**
+ * Decode one 8x8 4bpp tile (32 bytes)
+ * @param src Tile data
+ * @param lut16 16-entry packed sub-palette (entry 0 is ignored)
+ * @param dst Top-left destination pixel
+ * @param dstStride Destination row stride in pixels
+ * @param flip PAL_TILE_DECODE_FLIP_* flags
+ */
+void PAL_TileDecode_Tile4bpp(const u8* src, const u32* lut16, u32* dst, int dstStride, u32 flip);
+
+/**
+ * Decode one 8x8 8bpp tile (64 bytes)
+ * @param src Tile data
+ * @param lut256 256-entry packed palette (entry 0 is ignored)
+ * @param dst Top-left destination pixel
+ * @param dstStride Destination row stride in pixels
+ * @param flip PAL_TILE_DECODE_FLIP_* flags
+ */
+void PAL_TileDecode_Tile8bpp(const u8* src, const u32* lut256, u32* dst, int dstStride, u32 flip);
+
+/**
+ * Decode a linear (row-major) 4bpp bitmap
+ * @param src Bitmap data, width / 2 bytes per row
+ * @param lut16 16-entry packed sub-palette (entry 0 is ignored)
+ * @param dst Top-left destination pixel
+ * @param width Width in pixels (multiple of 8)
+ * @param height Height in pixels
+ * @param dstStride Destination row stride in pixels
+ * @param flip PAL_TILE_DECODE_FLIP_* flags (applied to the whole bitmap)
+ */
+void PAL_TileDecode_Linear4bpp(const u8* src, const u32* lut16, u32* dst,
+                               int width, int height, int dstStride, u32 flip);
+
+/**
+ * Decode a linear (row-major) 8bpp bitmap
+ * @param src Bitmap data, width bytes per row
+ * @param lut256 256-entry packed palette (entry 0 is ignored)
+ * @param dst Top-left destination pixel
+ * @param width Width in pixels (multiple of 8)
+ * @param height Height in pixels
+ * @param dstStride Destination row stride in pixels
+ * @param flip PAL_TILE_DECODE_FLIP_* flags (applied to the whole bitmap)
+ */
+void PAL_TileDecode_Linear8bpp(const u8* src, const u32* lut256, u32* dst,
+                               int width, int height, int dstStride, u32 flip);
+
+/**
+ * Decode one 8x8 4bpp tile into 8-bit palette indices
+ *
+ * Non-zero color c becomes paletteNum * 16 + c; color 0 stays 0 so that a
+ * single transparent palette entry covers every sub-palette.
+ *
+ * @param src Tile data
+ * @param paletteNum Sub-palette number (0-15)
+ * @param dst Top-left destination index
+ * @param dstStride Destination row stride in bytes
+ * @param flip PAL_TILE_DECODE_FLIP_* flags
+ */
+void PAL_TileDecode_Tile4bppIndex(const u8* src, u8 paletteNum, u8* dst, int dstStride, u32 flip);
+
+/**
+ * Decode one 8x8 8bpp tile into 8-bit palette indices
+ * @param src Tile data
+ * @param dst Top-left destination index
+ * @param dstStride Destination row stride in bytes
+ * @param flip PAL_TILE_DECODE_FLIP_* flags
+ */
+void PAL_TileDecode_Tile8bppIndex(const u8* src, u8* dst, int dstStride, u32 flip);
+
+/**
+ * Decode a linear 4bpp bitmap into 8-bit palette indices
+ * @param src Bitmap data, width / 2 bytes per row
+ * @param paletteNum Sub-palette number (0-15)
+ * @param dst Top-left destination index
+ * @param width Width in pixels (multiple of 8)
+ * @param height Height in pixels
+ * @param dstStride Destination row stride in bytes
+ * @param flip PAL_TILE_DECODE_FLIP_* flags (applied to the whole bitmap)
+ */
+void PAL_TileDecode_Linear4bppIndex(const u8* src, u8 paletteNum, u8* dst,
+                                    int width, int height, int dstStride, u32 flip);
+
+/**
+ * Decode a linear 8bpp bitmap into 8-bit palette indices
+ * @param src Bitmap data, width bytes per row
+ * @param dst Top-left destination index
+ * @param width Width in pixels (multiple of 8)
+ * @param height Height in pixels
+ * @param dstStride Destination row stride in bytes
+ * @param flip PAL_TILE_DECODE_FLIP_* flags (applied to the whole bitmap)
+ */
+void PAL_TileDecode_Linear8bppIndex(const u8* src, u8* dst,
+                                    int width, int height, int dstStride, u32 flip);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PAL_TILE_DECODE_H
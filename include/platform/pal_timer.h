@@ -46,4 +46,13 @@ u64 PAL_Timer_GetPerformanceFrequency(void);
  */
 void PAL_Timer_Delay(u32 ms);
 
+/**
+ * Sleep/delay for specified nanoseconds
+ * 
+ * Uses the most precise sleep the OS offers; the wakeup can still be late
+ * by the scheduler's granularity.
+ * @param ns Nanoseconds to sleep
+ */
+void PAL_Timer_DelayNS(u64 ns);
+
 #endif // PAL_TIMER_H
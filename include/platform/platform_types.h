@@ -287,24 +287,24 @@
     } TPData;
     
     // Graphics hardware functions (DS specific, stub for SDL)
-    static inline void G2_SetBG0Priority(int priority) {
-        // Stub: DS sets background layer 0 priority
-        (void)priority;
-    }
+    // BG priorities go to the PAL layer state the compositor sorts by
+    void PAL_Bg_SetPriority(u8 bgLayer, u8 priority);
+    
+    static inline void G2_SetBG0Priority(int priority) { PAL_Bg_SetPriority(0, (u8)priority); }
 
     static inline void G2_SetBG0Control(int screenSize, int colorMode, int screenBase, int charBase, int bgExtPltt) {}
     static inline void G2_BG0Mosaic(int mosaic) {}
     static inline void G2_SetBG0Offset(int hOffset, int vOffset) {}
     
     static inline void G2_SetBG1Control(int screenSize, int colorMode, int screenBase, int charBase, int bgExtPltt) {}
-    static inline void G2_SetBG1Priority(int priority) {}
+    static inline void G2_SetBG1Priority(int priority) { PAL_Bg_SetPriority(1, (u8)priority); }
     static inline void G2_BG1Mosaic(int mosaic) {}
     static inline void G2_SetBG1Offset(int hOffset, int vOffset) {}
     
     static inline void G2_SetBG2ControlText(int screenSize, int colorMode, int screenBase, int charBase) {}
     static inline void G2_SetBG2ControlAffine(int screenSize, int areaOver, int screenBase, int charBase) {}
     static inline void G2_SetBG2Control256x16Pltt(int screenSize, int areaOver, int screenBase, int charBase) {}
-    static inline void G2_SetBG2Priority(int priority) {}
+    static inline void G2_SetBG2Priority(int priority) { PAL_Bg_SetPriority(2, (u8)priority); }
     static inline void G2_BG2Mosaic(int mosaic) {}
     static inline void G2_SetBG2Offset(int hOffset, int vOffset) {}
     static inline void G2_SetBG2Affine(const void* mtx, int centerX, int centerY, int x1, int y1) {}
@@ -312,25 +312,25 @@
     static inline void G2_SetBG3ControlText(int screenSize, int colorMode, int screenBase, int charBase) {}
     static inline void G2_SetBG3ControlAffine(int screenSize, int areaOver, int screenBase, int charBase) {}
     static inline void G2_SetBG3Control256x16Pltt(int screenSize, int areaOver, int screenBase, int charBase) {}
-    static inline void G2_SetBG3Priority(int priority) {}
+    static inline void G2_SetBG3Priority(int priority) { PAL_Bg_SetPriority(3, (u8)priority); }
     static inline void G2_BG3Mosaic(int mosaic) {}
     static inline void G2_SetBG3Offset(int hOffset, int vOffset) {}
     static inline void G2_SetBG3Affine(const void* mtx, int centerX, int centerY, int x1, int y1) {}
     
     static inline void G2S_SetBG0Control(int screenSize, int colorMode, int screenBase, int charBase, int bgExtPltt) {}
-    static inline void G2S_SetBG0Priority(int priority) {}
+    static inline void G2S_SetBG0Priority(int priority) { PAL_Bg_SetPriority(4, (u8)priority); }
     static inline void G2S_BG0Mosaic(int mosaic) {}
     static inline void G2S_SetBG0Offset(int hOffset, int vOffset) {}
     
     static inline void G2S_SetBG1Control(int screenSize, int colorMode, int screenBase, int charBase, int bgExtPltt) {}
-    static inline void G2S_SetBG1Priority(int priority) {}
+    static inline void G2S_SetBG1Priority(int priority) { PAL_Bg_SetPriority(5, (u8)priority); }
     static inline void G2S_BG1Mosaic(int mosaic) {}
     static inline void G2S_SetBG1Offset(int hOffset, int vOffset) {}
     
     static inline void G2S_SetBG2ControlText(int screenSize, int colorMode, int screenBase, int charBase) {}
     static inline void G2S_SetBG2ControlAffine(int screenSize, int areaOver, int screenBase, int charBase) {}
     static inline void G2S_SetBG2Control256x16Pltt(int screenSize, int areaOver, int screenBase, int charBase) {}
-    static inline void G2S_SetBG2Priority(int priority) {}
+    static inline void G2S_SetBG2Priority(int priority) { PAL_Bg_SetPriority(6, (u8)priority); }
     static inline void G2S_BG2Mosaic(int mosaic) {}
     static inline void G2S_SetBG2Offset(int hOffset, int vOffset) {}
     static inline void G2S_SetBG2Affine(const void* mtx, int centerX, int centerY, int x1, int y1) {}
@@ -338,7 +338,7 @@
     static inline void G2S_SetBG3ControlText(int screenSize, int colorMode, int screenBase, int charBase) {}
     static inline void G2S_SetBG3ControlAffine(int screenSize, int areaOver, int screenBase, int charBase) {}
     static inline void G2S_SetBG3Control256x16Pltt(int screenSize, int areaOver, int screenBase, int charBase) {}
-    static inline void G2S_SetBG3Priority(int priority) {}
+    static inline void G2S_SetBG3Priority(int priority) { PAL_Bg_SetPriority(7, (u8)priority); }
     static inline void G2S_BG3Mosaic(int mosaic) {}
     static inline void G2S_SetBG3Offset(int hOffset, int vOffset) {}
     static inline void G2S_SetBG3Affine(const void* mtx, int centerX, int centerY, int x1, int y1) {}
@@ -386,15 +386,19 @@
     static inline void GX_SetBankForTexPltt(int bank) {}
     
     // Memory Interface (MI) functions
-    static inline void MI_UncompressLZ8(const void* src, void* dest) {
-        // Stub: Just copy for now, assuming uncompressed in SDL build or handled elsewhere
-        // In a real port, we'd implement LZ77 decompression
-        (void)src; (void)dest;
-    }
+    // LZ decoding lives in pal_compress_sdl.c (declared in pal_compress.h)
+    u32 PAL_LZ_GetUncompressedSize(const void* src, u32 srcSize);
+    u32 PAL_LZ_Decompress(const void* src, u32 srcSize, void* dest, u32 destSize);
     
     static inline u32 MI_GetUncompressedSize(const void* src) {
-        // Stub: Return 0 or read header
-        return 0;
+        return PAL_LZ_GetUncompressedSize(src, 8);
+    }
+    
+    static inline void MI_UncompressLZ8(const void* src, void* dest) {
+        // The DS API has no sizes; dest is sized from the header by the caller,
+        // and a valid stream is never longer than all literals plus flag bytes
+        u32 size = MI_GetUncompressedSize(src);
+        PAL_LZ_Decompress(src, 8 + size + (size + 7) / 8, dest, size);
     }
     
     static inline void MI_CpuFillFast(void* dest, u32 data, u32 size) {
@@ -509,25 +513,30 @@
         (void)src; (void)offset; (void)size;
     }
     
-    static inline void GX_SetVisibleWnd(u32 mask) {
-        // Stub: DS sets window visibility mask
-        (void)mask;
-    }
-    
-    static inline void GXS_SetVisibleWnd(u32 mask) {
-        // Stub: DS sets sub-screen window visibility mask
-        (void)mask;
-    }
-    
-    static inline void G2_SetWnd0InsidePlane(u32 mask, int enable) {
-        // Stub: DS window 0 inside plane
-        (void)mask; (void)enable;
-    }
-    
-    static inline void G2_SetWndOutsidePlane(u32 mask, int enable) {
-        // Stub: DS window outside plane
-        (void)mask; (void)enable;
-    }
+    // Window and color effect registers, implemented by the 2D compositor
+    // (pal_compositor_sdl.c)
+    void GX_SetVisibleWnd(u32 mask);
+    void GXS_SetVisibleWnd(u32 mask);
+    void G2_SetWnd0InsidePlane(u32 mask, int enable);
+    void G2_SetWndOutsidePlane(u32 mask, int enable);
+    void G2_SetWnd1InsidePlane(u32 plane, int visible);
+    void G2_SetWnd0Position(int x1, int y1, int x2, int y2);
+    void G2_SetWnd1Position(int x1, int y1, int x2, int y2);
+    void G2S_SetWndOutsidePlane(u32 plane, int visible);
+    void G2S_SetWnd0InsidePlane(u32 plane, int visible);
+    void G2S_SetWnd0Position(int x1, int y1, int x2, int y2);
+    void G2S_SetWnd1InsidePlane(u32 plane, int visible);
+    void G2S_SetWnd1Position(int x1, int y1, int x2, int y2);
+    void G2_SetWndOBJInsidePlane(u32 plane, int visible);
+    void G2S_SetWndOBJInsidePlane(u32 plane, int visible);
+    void G2_BlendNone(void);
+    void G2S_BlendNone(void);
+    void G2_SetBlendAlpha(u32 plane1, u32 plane2, int ev1, int ev2);
+    void G2S_SetBlendAlpha(u32 plane1, u32 plane2, int ev1, int ev2);
+    void G2_ChangeBlendAlpha(int ev1, int ev2);
+    void G2S_ChangeBlendAlpha(int ev1, int ev2);
+    void G2_SetBlendBrightness(int plane, int brightness);
+    void G2S_SetBlendBrightness(int plane, int brightness);
     
     static inline void G3X_SetShading(int mode) {
         // Stub: DS 3D shading mode
@@ -589,74 +598,6 @@
     #define NNS_GFD_ALLOC_ERROR_PLTTKEY ((u32)-1)
     static inline u32 NNS_GfdGetPlttKeyAddr(u32 key) { return 0; }
     
-    static inline void G2_BlendNone(void) {
-        // Stub: DS 2D blend none
-    }
-    
-    static inline void G2S_BlendNone(void) {
-        // Stub: DS 2D sub-screen blend none
-    }
-    
-    static inline void G2_SetBlendAlpha(u32 plane1, u32 plane2, int ev1, int ev2) {
-        // Stub: DS main screen alpha blending
-        (void)plane1; (void)plane2; (void)ev1; (void)ev2;
-    }
-    
-    static inline void G2_ChangeBlendAlpha(int ev1, int ev2) {
-        // Stub: DS change alpha blend values
-        (void)ev1; (void)ev2;
-    }
-    
-    static inline void G2S_SetBlendAlpha(u32 plane1, u32 plane2, int ev1, int ev2) {
-        // Stub: DS sub-screen alpha blending
-        (void)plane1; (void)plane2; (void)ev1; (void)ev2;
-    }
-    
-    static inline void G2S_SetWndOutsidePlane(u32 plane, int visible) {
-        // Stub: DS sub-screen window outside plane
-        (void)plane; (void)visible;
-    }
-    
-    static inline void G2S_SetWnd0InsidePlane(u32 plane, int visible) {
-        // Stub: DS sub-screen window 0 inside plane
-        (void)plane; (void)visible;
-    }
-    
-    static inline void G2S_SetWnd0Position(int x1, int y1, int x2, int y2) {
-        // Stub: DS sub-screen window 0 position
-        (void)x1; (void)y1; (void)x2; (void)y2;
-    }
-    
-    static inline void G2_SetWnd1InsidePlane(u32 plane, int visible) {
-        // Stub: DS main screen window 1 inside plane
-        (void)plane; (void)visible;
-    }
-    
-    static inline void G2S_SetWnd1InsidePlane(u32 plane, int visible) {
-        // Stub: DS sub-screen window 1 inside plane
-        (void)plane; (void)visible;
-    }
-    
-    static inline void G2S_SetWnd1Position(int x1, int y1, int x2, int y2) {
-        // Stub: DS sub-screen window 1 position
-        (void)x1; (void)y1; (void)x2; (void)y2;
-    }
-    
-    static inline void G2_SetWndOBJInsidePlane(u32 plane, int visible) {
-        // Stub: DS main screen OBJ window inside plane
-        (void)plane; (void)visible;
-    }
-    
-    static inline void G2_SetWnd0Position(int x1, int y1, int x2, int y2) {
-        // Stub: DS main screen window 0 position
-        (void)x1; (void)y1; (void)x2; (void)y2;
-    }
-
-    static inline void G2_SetWnd1Position(int x1, int y1, int x2, int y2) {
-        // Stub: DS main screen window 1 position
-        (void)x1; (void)y1; (void)x2; (void)y2;
-    }
-    
     static inline void G2_SetOBJMosaicSize(int width, int height) {
         // Stub: DS main screen object mosaic effect size
         (void)width; (void)height;
@@ -142,6 +142,22 @@ void Pokemon_CalcStats(Pokemon *mon);
  */
 u32 Pokemon_GetValue(Pokemon *mon, enum PokemonDataParam param, void *dest);
 
+#ifndef PLATFORM_DS
+/**
+ * @brief Gets several values from a Pokemon, decrypting it only once. SDL only.
+ *
+ * Equivalent to calling Pokemon_GetValue for each param in turn. Only values
+ * returned directly are supported; params that copy into dest (nickname,
+ * OT name, mail, ...) must still go through Pokemon_GetValue.
+ *
+ * @param mon
+ * @param params Params to read
+ * @param[out] out Receives the value of each param, in order
+ * @param count Number of params
+ */
+void Pokemon_GetValues(Pokemon *mon, const enum PokemonDataParam *params, u32 *out, u32 count);
+#endif
+
 /**
  * @brief Gets a value from a Pokemon, storing it in dest if neccessary
  *
@@ -152,6 +168,23 @@ u32 Pokemon_GetValue(Pokemon *mon, enum PokemonDataParam param, void *dest);
  */
 u32 BoxPokemon_GetValue(BoxPokemon *boxMon, enum PokemonDataParam param, void *dest);
 
+#ifndef PLATFORM_DS
+/**
+ * @brief Gets several values from a BoxPokemon, decrypting it only once. SDL
+ * only.
+ *
+ * Equivalent to calling BoxPokemon_GetValue for each param in turn. Only
+ * values returned directly are supported; params that copy into dest must
+ * still go through BoxPokemon_GetValue.
+ *
+ * @param boxMon
+ * @param params Params to read
+ * @param[out] out Receives the value of each param, in order
+ * @param count Number of params
+ */
+void BoxPokemon_GetValues(BoxPokemon *boxMon, const enum PokemonDataParam *params, u32 *out, u32 count);
+#endif
+
 /**
  * @brief Sets a value in a Pokemon, reading it from value if neccessary
  *
@@ -0,0 +1,69 @@
+#ifndef POKEPLATINUM_SPECIES_TABLE_H
+#define POKEPLATINUM_SPECIES_TABLE_H
+
+#include "platform/platform_types.h"
+
+#include "constants/pokemon.h"
+#include "struct_defs/species.h"
+
+#include "generated/exp_rates.h"
+
+/*
+ * Resident, read-only copies of the species data (pl_personal), experience
+ * tables (pl_growtbl), level-up learnsets (wotbl) and evolutions (evo), built
+ * once from the mapped archives. Lookups are array reads with no allocation or
+ * archive access. SDL port only; the DS build keeps reading the archives.
+ *
+ * The species data is stored as one column per SpeciesDataParam rather than
+ * as SpeciesData records, so screens that read one field of many species
+ * (levels and genders of every mon in a box) touch only the columns they use.
+ */
+
+/*
+ * Builds the tables from the archives the first time it is called.
+ *
+ * @returns: TRUE if the tables are loaded. FALSE if one of the archives is
+ *           unavailable, in which case callers must read the archives
+ *           themselves. A failed load is not retried.
+ */
+BOOL SpeciesTable_Load(void);
+
+/*
+ * Frees the tables; the next SpeciesTable_Load builds them again.
+ */
+void SpeciesTable_Unload(void);
+
+/*
+ * @param personalIndex:  Index into pl_personal (a species, or a form index
+ *                        from Pokemon_GetFormNarcIndex)
+ * @param param:          Field to read
+ *
+ * @returns: The value of the field, as SpeciesData_GetValue would return it
+ */
+u32 SpeciesTable_GetValue(int personalIndex, enum SpeciesDataParam param);
+
+/*
+ * @returns: The total experience needed to reach monLevel at the given rate.
+ *           monLevel may be MAX_POKEMON_LEVEL + 1, which is never reachable.
+ */
+u32 SpeciesTable_GetBaseExpAt(enum ExpRate expRate, int monLevel);
+
+/*
+ * @returns: The level reached with monExp total experience at the given rate
+ */
+u32 SpeciesTable_GetLevelAt(enum ExpRate expRate, u32 monExp);
+
+/*
+ * @param learnsetIndex:  Index into wotbl (a species, or a form index)
+ *
+ * @returns: The level-up learnset, terminated by LEARNSET_SENTINEL_ENTRY. Each
+ *           entry is packed as in SpeciesLearnsetEntry.
+ */
+const u16 *SpeciesTable_GetLevelUpMoves(int learnsetIndex);
+
+/*
+ * @returns: The MAX_EVOLUTIONS evolution entries of a species
+ */
+const SpeciesEvolution *SpeciesTable_GetEvolutions(int monSpecies);
+
+#endif // POKEPLATINUM_SPECIES_TABLE_H
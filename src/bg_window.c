@@ -1208,6 +1208,7 @@ void Bg_LoadTiles(BgConfig *bgConfig, u8 bgLayer, void *src, u32 size, u32 tileS
 
 void Bg_LoadTilesToVRAM(BgConfig *bgConfig, u8 bgLayer, void *src, u32 size, u32 offset)
 {
+    #ifdef PLATFORM_DS
     if (size == 0) {
         u32 decompressedSize = MI_GetUncompressedSize(src);
         void *tmp = Heap_AllocAtEnd(bgConfig->heapID, decompressedSize);
@@ -1220,6 +1221,16 @@ void Bg_LoadTilesToVRAM(BgConfig *bgConfig, u8 bgLayer, void *src, u32 size, u32
     }
 
     LoadBgVRAMChar(bgLayer, (void *)src, offset, size);
+    #else
+    // Copy or decompress straight into the layer's tile storage, no staging buffer
+    u32 tileSize = bgConfig->bgs[bgLayer].colorMode == GX_BG_COLORMODE_16 ? TILE_SIZE_4BPP : TILE_SIZE_8BPP;
+    u32 loadSize = size == 0 ? MI_GetUncompressedSize(src) : size;
+    void *dest = PAL_Bg_MapTileRange(bgConfig, bgLayer, offset / tileSize, loadSize);
+
+    if (dest != NULL) {
+        CopyOrDecompressData(src, dest, size);
+    }
+    #endif
 }
 
 static void LoadBgVRAMChar(u8 bgLayer, void *src, u32 offset, u32 size)
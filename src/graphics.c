@@ -3,9 +3,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include "platform/pal_file.h"
+#include "platform/pal_asset_cache.h"
 #include "platform/pal_background.h"
+#include "platform/pal_compress.h"
+#include "platform/pal_file.h"
 #include "platform/pal_graphics.h"
+#include "platform/pal_memory.h"
 
 #include "heap.h"
 #include "narc.h"
@@ -106,43 +109,235 @@ static void GetAssetPath(enum NarcID narcID, u32 narcMemberIdx, const char* asse
     snprintf(outPath, pathSize, "resources/graphics/narc_%03d/%04d_%s", narcID, narcMemberIdx, assetType);
 }
 
-u32 Graphics_LoadTilesToBgLayer(enum NarcID narcID, u32 narcMemberIdx, BgConfig *bgConfig, u32 bgLayer, u32 offset, u32 size, BOOL compressed, u32 heapID)
+// Loose file suffix for each asset kind, passed to GetAssetPath
+static const char *const sAssetTypes[PAL_ASSET_KIND_MAX] = {
+    [PAL_ASSET_TILES] = "tiles.bin",
+    [PAL_ASSET_TILEMAP] = "tilemap.bin",
+    [PAL_ASSET_PALETTE] = "palette.pal",
+};
+
+/**
+ * LoadAsset - Get an asset's data from the asset pack, the asset cache or its loose file
+ * 
+ * The asset pack (see PAL_AssetPack_Open) is checked first and serves the data
+ * in place. Assets missing from it are read from the file named by GetAssetPath
+ * and kept in the asset cache, so loading them again costs no file access. If
+ * the cache can't take the buffer it is returned through ownedData for the
+ * caller to PAL_Free.
+ * 
+ * @param narcID        NARC archive ID
+ * @param narcMemberIdx Member index within the NARC
+ * @param kind          Asset kind
+ * @param outSize       Receives the asset size in bytes
+ * @param ownedData     Receives the buffer to free, or NULL if nothing needs freeing
+ * @param outPath       Receives where the asset came from, for log messages
+ * @param pathSize      Size of outPath
+ * @return Asset data, or NULL if it could not be loaded
+ */
+static const void *LoadAsset(enum NarcID narcID, u32 narcMemberIdx, PAL_AssetKind kind, u32 *outSize, void **ownedData, char *outPath, size_t pathSize)
 {
-    (void)compressed;  // Unused in SDL3 - assets are pre-converted
+    PAL_AssetTransform transform = PAL_ASSET_TRANSFORM_CONVERTED_TILES + kind;
     
-    // SDL3: Load tile data from filesystem
-    char tilePath[512];
-    GetAssetPath(narcID, narcMemberIdx, "tiles.bin", tilePath, sizeof(tilePath));
+    *ownedData = NULL;
     
-    PAL_File file = PAL_File_Open(tilePath, "rb");
+    const void *packed = PAL_AssetPack_Find(narcID, narcMemberIdx, kind, outSize);
+    if (packed) {
+        snprintf(outPath, pathSize, "asset pack (NARC %d, member %u, %s)", narcID, narcMemberIdx, sAssetTypes[kind]);
+        return packed;
+    }
+    
+    GetAssetPath(narcID, narcMemberIdx, sAssetTypes[kind], outPath, pathSize);
+    
+    const void *cached = PAL_AssetCache_Find(narcID, narcMemberIdx, transform, outSize);
+    if (cached) {
+        return cached;
+    }
+    
+    PAL_File file = PAL_File_Open(outPath, "rb");
     if (!file) {
-        fprintf(stderr, "[Graphics] Failed to load tiles: %s\n", tilePath);
-        return 0;
+        fprintf(stderr, "[Graphics] Failed to load %s\n", outPath);
+        return NULL;
     }
     
-    size_t fileSize = PAL_File_Size(file);
-    void *tileData = Heap_Alloc(heapID, fileSize);
-    if (!tileData) {
-        fprintf(stderr, "[Graphics] Failed to allocate %zu bytes for tiles\n", fileSize);
+    long fileSize = PAL_File_Size(file);
+    void *data = fileSize > 0 ? PAL_Malloc(fileSize, 0) : NULL;
+    if (!data) {
+        fprintf(stderr, "[Graphics] Failed to allocate %ld bytes for %s\n", fileSize, outPath);
         PAL_File_Close(file);
-        return 0;
+        return NULL;
     }
     
-    PAL_File_Read(tileData, 1, fileSize, file);
+    PAL_File_Read(data, 1, fileSize, file);
     PAL_File_Close(file);
     
-    // Determine actual size to load
-    u32 loadSize = (size == 0) ? fileSize : size;
+    if (!PAL_AssetCache_Insert(narcID, narcMemberIdx, transform, data, (u32)fileSize)) {
+        *ownedData = data;
+    }
     
-    // Load to PAL background layer
+    *outSize = (u32)fileSize;
+    return data;
+}
+
+/**
+ * GetNARCMemberData - Get a NARC member, decompressed if asked, without copying it
+ * 
+ * Uncompressed members are served straight from the mapped archive. Compressed
+ * ones are decoded once and kept in the asset cache; if the cache can't take the
+ * decoded buffer it is returned through ownedData for the caller to PAL_Free.
+ * 
+ * @param narcID        NARC archive ID
+ * @param narcMemberIdx Member index within the NARC
+ * @param compressed    TRUE if the member is LZ-compressed
+ * @param outSize       Receives the (decompressed) size in bytes
+ * @param ownedData     Receives the buffer to free, or NULL if nothing needs freeing
+ * @return Member data, or NULL if it could not be loaded
+ */
+static const void *GetNARCMemberData(enum NarcID narcID, u32 narcMemberIdx, BOOL compressed, u32 *outSize, void **ownedData)
+{
+    u32 srcSize;
+    
+    *ownedData = NULL;
+    
+    if (!compressed) {
+        return NARC_GetMemberView(narcID, narcMemberIdx, outSize);
+    }
+    
+    const void *cached = PAL_AssetCache_Find(narcID, narcMemberIdx, PAL_ASSET_TRANSFORM_LZ, outSize);
+    if (cached) {
+        return cached;
+    }
+    
+    const void *src = NARC_GetMemberView(narcID, narcMemberIdx, &srcSize);
+    if (!src) {
+        return NULL;
+    }
+    
+    u32 size = PAL_LZ_GetUncompressedSize(src, srcSize);
+    void *decoded = size > 0 ? PAL_Malloc(size, 0) : NULL;
+    
+    if (!decoded || PAL_LZ_Decompress(src, srcSize, decoded, size) == 0) {
+        fprintf(stderr, "[Graphics] NARC %d member %u is not valid LZ data\n", narcID, narcMemberIdx);
+        PAL_Free(decoded);
+        return NULL;
+    }
+    
+    if (!PAL_AssetCache_Insert(narcID, narcMemberIdx, PAL_ASSET_TRANSFORM_LZ, decoded, size)) {
+        *ownedData = decoded;
+    }
+    
+    *outSize = size;
+    return decoded;
+}
+
+void *LoadCompressedMemberFromNARC(enum NarcID narcID, u32 narcMemberIdx, u32 heapID)
+{
+    return LoadMemberFromNARC(narcID, narcMemberIdx, TRUE, heapID, FALSE);
+}
+
+void *LoadMemberFromNARC(enum NarcID narcID, u32 narcMemberIdx, BOOL compressed, u32 heapID, BOOL allocAtEnd)
+{
+    return LoadMemberFromNARC_OutFileSize(narcID, narcMemberIdx, compressed, heapID, allocAtEnd, NULL);
+}
+
+void *LoadMemberFromNARC_OutFileSize(enum NarcID narcID, u32 narcMemberIdx, BOOL compressed, u32 heapID, BOOL allocAtEnd, u32 *fileSize)
+{
+    void *ownedData;
+    u32 size;
+    const void *src = GetNARCMemberData(narcID, narcMemberIdx, compressed, &size, &ownedData);
+    
+    if (src == NULL) {
+        return NULL;
+    }
+    
+    // Callers own the result and free it with Heap_Free, so hand out a copy
+    void *data = allocAtEnd ? Heap_AllocAtEnd(heapID, size) : Heap_Alloc(heapID, size);
+    
+    if (data != NULL) {
+        memcpy(data, src, size);
+        
+        if (fileSize != NULL) {
+            *fileSize = size;
+        }
+    }
+    
+    PAL_Free(ownedData);
+    return data;
+}
+
+void *LoadMemberFromOpenNARC(NARC *narc, u32 narcMemberIdx, BOOL compressed, u32 heapID, BOOL allocAtEnd)
+{
+    return LoadMemberFromOpenNARC_OutFileSize(narc, narcMemberIdx, compressed, heapID, allocAtEnd, NULL);
+}
+
+void *LoadMemberFromOpenNARC_OutFileSize(NARC *narc, u32 narcMemberIdx, BOOL compressed, u32 heapID, BOOL allocAtEnd, u32 *fileSize)
+{
+    // An open NARC doesn't know its ID, so these loads bypass the asset cache
+    u32 memberSize = NARC_GetMemberSize(narc, narcMemberIdx);
+    void *data;
+    
+    // The compressed copy is short-lived, keep it out of the way at the end
+    if (compressed || allocAtEnd == TRUE) {
+        data = Heap_AllocAtEnd(heapID, memberSize);
+    } else {
+        data = Heap_Alloc(heapID, memberSize);
+    }
+    
+    if (data == NULL) {
+        return NULL;
+    }
+    
+    NARC_ReadWholeMember(narc, narcMemberIdx, data);
+    
+    if (!compressed) {
+        if (fileSize != NULL) {
+            *fileSize = memberSize;
+        }
+        return data;
+    }
+    
+    u32 size = MI_GetUncompressedSize(data);
+    void *decompressed = allocAtEnd ? Heap_AllocAtEnd(heapID, size) : Heap_Alloc(heapID, size);
+    
+    if (decompressed != NULL) {
+        MI_UncompressLZ8(data, decompressed);
+        
+        if (fileSize != NULL) {
+            *fileSize = size;
+        }
+    }
+    
+    Heap_Free(data);
+    return decompressed;
+}
+
+u32 Graphics_LoadTilesToBgLayer(enum NarcID narcID, u32 narcMemberIdx, BgConfig *bgConfig, u32 bgLayer, u32 offset, u32 size, BOOL compressed, u32 heapID)
+{
+    (void)compressed;  // Unused in SDL3 - assets are pre-converted
+    
+    // SDL3: Load tile data from the asset pack or filesystem
+    char tilePath[512];
+    void *ownedData;
+    u32 fileSize;
+    const void *tileData = LoadAsset(narcID, narcMemberIdx, PAL_ASSET_TILES, &fileSize, &ownedData, tilePath, sizeof(tilePath));
+    if (!tileData) {
+        return 0;
+    }
+    
+    // Determine actual size to load, never past the end of the asset
+    u32 loadSize = (size == 0 || size > fileSize) ? fileSize : size;
+    
+    // Copy from the pack or cache view straight into the layer's tile storage
     PAL_BgConfig *palBgConfig = (PAL_BgConfig*)bgConfig;
-    PAL_Bg_LoadTiles(palBgConfig, bgLayer, tileData, loadSize, offset);
+    void *dest = PAL_Bg_MapTileRange(palBgConfig, bgLayer, offset, loadSize);
+    if (dest) {
+        memcpy(dest, tileData, loadSize);
+    }
     
     // Track last used layer for palette loading
     g_last_bgConfig = bgConfig;
     g_last_bgLayer = bgLayer;
     
-    Heap_Free(tileData);
+    PAL_Free(ownedData);
     
     printf("[Graphics] Loaded %u bytes of tiles from %s to layer %u\n", loadSize, tilePath, bgLayer);
     return loadSize;
@@ -153,32 +348,20 @@ void Graphics_LoadTilemapToBgLayer(enum NarcID narcID, u32 narcMemberIdx, BgConf
     (void)compressed;  // Unused in SDL3 - assets are pre-converted
     (void)offset;      // TODO: Implement offset support if needed
     
-    // SDL3: Load tilemap data from filesystem
+    // SDL3: Load tilemap data from the asset pack or filesystem
     char tilemapPath[512];
-    GetAssetPath(narcID, narcMemberIdx, "tilemap.bin", tilemapPath, sizeof(tilemapPath));
-    
-    PAL_File file = PAL_File_Open(tilemapPath, "rb");
-    if (!file) {
-        fprintf(stderr, "[Graphics] Failed to load tilemap: %s\n", tilemapPath);
-        return;
-    }
-    
-    size_t fileSize = PAL_File_Size(file);
-    void *tilemapData = Heap_Alloc(heapID, fileSize);
+    void *ownedData;
+    u32 fileSize;
+    const void *tilemapData = LoadAsset(narcID, narcMemberIdx, PAL_ASSET_TILEMAP, &fileSize, &ownedData, tilemapPath, sizeof(tilemapPath));
     if (!tilemapData) {
-        fprintf(stderr, "[Graphics] Failed to allocate %zu bytes for tilemap\n", fileSize);
-        PAL_File_Close(file);
         return;
     }
     
-    PAL_File_Read(tilemapData, 1, fileSize, file);
-    PAL_File_Close(file);
-    
     // Check if this is an NSCR file (Nintendo Screen format)
-    void* actualTilemapData = tilemapData;
+    const void* actualTilemapData = tilemapData;
     u32 actualSize = fileSize;
     
-    u32* magic = (u32*)tilemapData;
+    const u32* magic = (const u32*)tilemapData;
     if (*magic == 0x4E534352) {  // "RCSN" in little-endian (0x52='R', 0x43='C', 0x53='S', 0x4E='N')
         // NSCR format: Skip header to get to actual tilemap data
         // Structure:
@@ -191,8 +374,8 @@ void Graphics_LoadTilemapToBgLayer(enum NarcID narcID, u32 narcMemberIdx, BgConf
         
         if (fileSize >= 0x20) {
             // Skip to SCRN section (usually at 0x10)
-            u8* scrn_section = (u8*)tilemapData + 0x10;
-            u32 scrn_magic = *(u32*)scrn_section;
+            const u8* scrn_section = (const u8*)tilemapData + 0x10;
+            u32 scrn_magic = *(const u32*)scrn_section;
             
             if (scrn_magic == 0x5343524E || scrn_magic == 0x4E524353) { // "NRCS" or "SCRN" in little-endian
                 // SCRN section structure:
@@ -222,7 +405,7 @@ void Graphics_LoadTilemapToBgLayer(enum NarcID narcID, u32 narcMemberIdx, BgConf
     g_last_bgConfig = bgConfig;
     g_last_bgLayer = bgLayer;
     
-    Heap_Free(tilemapData);
+    PAL_Free(ownedData);
     
     printf("[Graphics] Loaded %u bytes of tilemap from %s to layer %u\n", loadSize, tilemapPath, bgLayer);
 }
@@ -236,27 +419,15 @@ void Graphics_LoadPaletteWithSrcOffset(enum NarcID narcID, u32 narcMemberIdx, en
 {
     (void)loadLocation;  // TODO: Use this to determine which screen/layer
     
-    // SDL3: Load palette from filesystem
+    // SDL3: Load palette from the asset pack or filesystem
     char palettePath[512];
-    GetAssetPath(narcID, narcMemberIdx, "palette.pal", palettePath, sizeof(palettePath));
-    
-    PAL_File file = PAL_File_Open(palettePath, "rb");
-    if (!file) {
-        fprintf(stderr, "[Graphics] Failed to load palette: %s\n", palettePath);
-        return;
-    }
-    
-    size_t fileSize = PAL_File_Size(file);
-    u16 *paletteData = (u16*)Heap_Alloc(heapID, fileSize);
+    void *ownedData;
+    u32 fileSize;
+    const u16 *paletteData = LoadAsset(narcID, narcMemberIdx, PAL_ASSET_PALETTE, &fileSize, &ownedData, palettePath, sizeof(palettePath));
     if (!paletteData) {
-        fprintf(stderr, "[Graphics] Failed to allocate %zu bytes for palette\n", fileSize);
-        PAL_File_Close(file);
         return;
     }
     
-    PAL_File_Read(paletteData, 1, fileSize, file);
-    PAL_File_Close(file);
-    
     // Determine actual size to load
     // size is in BYTES, convert to number of colors
     u32 numColors = fileSize / 2; // RGB555 is 2 bytes per color
@@ -280,7 +451,7 @@ void Graphics_LoadPaletteWithSrcOffset(enum NarcID narcID, u32 narcMemberIdx, en
                g_last_bgLayer, srcColorOffset, palColorOffset, loadSize);
     }
     
-    Heap_Free(paletteData);
+    PAL_Free(ownedData);
 }
 
 // ============================================================================
@@ -11,79 +11,849 @@
 #include "error_message_reset.h"
 #include "unk_020366A0.h"
 #else
-// SDL Build: Simple heap implementation using malloc/free
-#include <stdlib.h>
+// SDL Build: per-heap arenas
+//
+// Every HeapID owns an arena, carved into blocks much like the DS expanded
+// heap: Heap_Alloc takes from the bottom of the arena and Heap_AllocAtEnd
+// from the top, so long-lived data and short-lived scratch buffers do not
+// fragment each other. The common case is a pointer bump at one of the two
+// frontiers. Freed blocks of up to HEAP_FAST_MAX bytes go on a per-size
+// fast bin untouched, for the next request of that size. Larger ones next
+// to a frontier move the frontier back; others are coalesced with free
+// neighbours and kept in size-class bins, which are only searched once the
+// frontiers meet. Heap_Destroy releases the whole arena at once, whatever
+// is still allocated in it.
+//
+// Requests of up to HEAP_SLAB_MAX_SIZE bytes, most of the game's
+// allocations, skip the arena and come from a PAL slab cache belonging to
+// the heap instead: a free-list pop per allocation and a push per free.
+// They keep the usual block header, so Heap_Free tells them apart by a
+// flag. The header also records the size class, so Heap_Free can push them
+// back on their class's free list without going near the slab page. The
+// cache is destroyed along with the arena.
+//
+// Heap sizes are the DS ones scaled up, since structs holding pointers are
+// larger on 64-bit hosts. An arena that still runs out grows by an overflow
+// chunk instead of failing, and says so once, so heaps that need a bigger
+// budget show up in the log rather than as crashes.
+//
+// Like on DS, heaps are only used from the main thread.
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
-// Simple SDL implementation - just use malloc/free
+#include "platform/pal_memory.h"
+
+#ifdef PAL_HEAP_PROFILER
+#include "platform/pal_heap_profiler.h"
+#endif
+
+#define HEAP_ALIGN           16
+#define HEAP_MIN_PAYLOAD     16
+#define HEAP_SIZE_SCALE      4
+#define HEAP_DEFAULT_SIZE    0x40000
+#define HEAP_BLOCK_MAGIC     0x4850
+#define HEAP_SMALL_BINS      64
+#define HEAP_NUM_BINS        96
+
+#define HEAP_BLOCK_FREE      (1 << 0)
+#define HEAP_BLOCK_TAIL      (1 << 1)
+#define HEAP_BLOCK_SLAB      (1 << 2)
+#define HEAP_BLOCK_FAST      (1 << 3)
+
+// Largest payload freed to a fast bin
+#define HEAP_FAST_MAX        (HEAP_SMALL_BINS * HEAP_ALIGN)
+
+#define HEAP_ROUND_UP(x)     (((x) + (HEAP_ALIGN - 1)) & ~(size_t)(HEAP_ALIGN - 1))
+
+struct HeapChunk;
+
+typedef struct HeapBlock {
+    u32 size;               // Payload bytes, a multiple of HEAP_ALIGN
+    u32 prevSize;           // Payload bytes of the block just below, 0 if this block is the lowest in its region
+    struct HeapChunk *chunk;
+    u32 requested;          // Bytes asked for, for the statistics
+    u16 magic;
+    u8 heapID;
+    u8 flags;
+    u8 slabClass;           // PAL slab size class, for HEAP_BLOCK_SLAB blocks
+    u8 padding[HEAP_ALIGN - sizeof(struct HeapChunk *) - 1]; // 17 bytes of fields above besides the pointer
+} HeapBlock;
+
+// Payloads follow the header, so it must keep them HEAP_ALIGN aligned
+_Static_assert(sizeof(HeapBlock) % HEAP_ALIGN == 0, "HeapBlock size must be a multiple of HEAP_ALIGN");
+
+// Stored in the payload of free blocks
+typedef struct HeapFreeLinks {
+    HeapBlock *prev;
+    HeapBlock *next;
+} HeapFreeLinks;
+
+// Blocks grow up from base to head, and down from end to tail
+typedef struct HeapChunk {
+    struct HeapChunk *next;
+    u8 *base;
+    u8 *head;
+    u8 *tail;
+    u8 *end;
+    HeapBlock *headLast;    // Block ending at head, or NULL
+} HeapChunk;
+
+typedef struct SDLHeap {
+    HeapChunk *chunks;
+    HeapBlock *bins[HEAP_NUM_BINS];
+    u32 binMask[HEAP_NUM_BINS / 32];
+    HeapBlock *fastBins[HEAP_SMALL_BINS]; // Singly linked, one per size, never merged
+    u32 numFastBlocks;
+    u32 budget;             // Size passed to Heap_Create
+    u32 capacity;           // Bytes reserved across all chunks
+    u32 curSize;
+    u32 highWaterMark;
+    u32 numBlocks;
+    u32 peakBlocks;
+    u32 numChunks;
+    PAL_SlabCache *slab;    // Created on the first small allocation
+    u8 parent;
+    BOOL active;
+    BOOL overflowReported;
+} SDLHeap;
+
+#define HEAP_BLOCK_HEADER_SIZE sizeof(HeapBlock)
+#define HEAP_CHUNK_HEADER_SIZE HEAP_ROUND_UP(sizeof(HeapChunk))
+#define HEAP_SLAB_MAX_SIZE     (PAL_SLAB_MAX_SIZE - HEAP_BLOCK_HEADER_SIZE)
+
+static SDLHeap sHeaps[HEAP_ID_MAX];
+static BOOL sSlabEnabled = TRUE;
+
+static inline void *BlockPayload(HeapBlock *block)
+{
+    return (u8 *)block + HEAP_BLOCK_HEADER_SIZE;
+}
+
+static inline HeapBlock *PayloadBlock(void *ptr)
+{
+    return (HeapBlock *)((u8 *)ptr - HEAP_BLOCK_HEADER_SIZE);
+}
+
+static inline HeapBlock *NextBlock(HeapBlock *block)
+{
+    return (HeapBlock *)((u8 *)block + HEAP_BLOCK_HEADER_SIZE + block->size);
+}
+
+static inline HeapBlock *PrevBlock(HeapBlock *block)
+{
+    return (HeapBlock *)((u8 *)block - HEAP_BLOCK_HEADER_SIZE - block->prevSize);
+}
+
+static inline BOOL IsLowestBlock(HeapBlock *block)
+{
+    HeapChunk *chunk = block->chunk;
+
+    if (block->flags & HEAP_BLOCK_TAIL) {
+        return (u8 *)block == chunk->tail;
+    }
+
+    return (u8 *)block == chunk->base;
+}
+
+static inline BOOL HasNextBlock(HeapBlock *block)
+{
+    HeapChunk *chunk = block->chunk;
+    u8 *regionEnd = (block->flags & HEAP_BLOCK_TAIL) ? chunk->end : chunk->head;
+
+    return (u8 *)NextBlock(block) < regionEnd;
+}
+
+static inline HeapFreeLinks *FreeLinks(HeapBlock *block)
+{
+    return (HeapFreeLinks *)BlockPayload(block);
+}
+
+// Free and in a bin, so it can be merged with a neighbour
+static inline BOOL IsBinnedFree(HeapBlock *block)
+{
+    return (block->flags & (HEAP_BLOCK_FREE | HEAP_BLOCK_FAST)) == HEAP_BLOCK_FREE;
+}
+
+// One bin per size up to 1 KiB, so small requests never have to search
+// a bin; larger ones are binned by power of two
+static u32 BinIndex(u32 size)
+{
+    if (size <= HEAP_SMALL_BINS * HEAP_ALIGN) {
+        return size / HEAP_ALIGN - 1;
+    }
+
+    u32 bin = HEAP_SMALL_BINS;
+
+    size /= HEAP_SMALL_BINS * HEAP_ALIGN * 2;
+    while (size != 0 && bin < HEAP_NUM_BINS - 1) {
+        size >>= 1;
+        bin++;
+    }
+
+    return bin;
+}
+
+static u32 LowestSetBit(u32 bits)
+{
+    u32 index = 0;
+
+    bits &= 0u - bits;
+
+    if (bits & 0xFFFF0000) {
+        index += 16;
+    }
+
+    if (bits & 0xFF00FF00) {
+        index += 8;
+    }
+
+    if (bits & 0xF0F0F0F0) {
+        index += 4;
+    }
+
+    if (bits & 0xCCCCCCCC) {
+        index += 2;
+    }
+
+    if (bits & 0xAAAAAAAA) {
+        index += 1;
+    }
+
+    return index;
+}
+
+// Finds the first non-empty bin at or after bin, or HEAP_NUM_BINS
+static u32 NextUsedBin(SDLHeap *heap, u32 bin)
+{
+    u32 word = bin / 32;
+    u32 bits = heap->binMask[word] & (0xFFFFFFFFu << (bin % 32));
+
+    while (bits == 0) {
+        if (++word == HEAP_NUM_BINS / 32) {
+            return HEAP_NUM_BINS;
+        }
+
+        bits = heap->binMask[word];
+    }
+
+    return word * 32 + LowestSetBit(bits);
+}
+
+static void BinInsert(SDLHeap *heap, HeapBlock *block)
+{
+    u32 index = BinIndex(block->size);
+    HeapBlock **bin = &heap->bins[index];
+    HeapFreeLinks *links = FreeLinks(block);
+
+    heap->binMask[index / 32] |= 1u << (index % 32);
+
+    links->prev = NULL;
+    links->next = *bin;
+
+    if (*bin != NULL) {
+        FreeLinks(*bin)->prev = block;
+    }
+
+    *bin = block;
+}
+
+static void BinRemove(SDLHeap *heap, HeapBlock *block)
+{
+    HeapFreeLinks *links = FreeLinks(block);
+
+    if (links->prev != NULL) {
+        FreeLinks(links->prev)->next = links->next;
+    } else {
+        u32 index = BinIndex(block->size);
+
+        heap->bins[index] = links->next;
+
+        if (links->next == NULL) {
+            heap->binMask[index / 32] &= ~(1u << (index % 32));
+        }
+    }
+
+    if (links->next != NULL) {
+        FreeLinks(links->next)->prev = links->prev;
+    }
+}
+
+static HeapChunk *AddChunk(SDLHeap *heap, u32 size)
+{
+    size = HEAP_ROUND_UP(size);
+
+    HeapChunk *chunk = malloc(HEAP_CHUNK_HEADER_SIZE + size);
+
+    if (chunk == NULL) {
+        return NULL;
+    }
+
+    chunk->base = (u8 *)chunk + HEAP_CHUNK_HEADER_SIZE;
+    chunk->head = chunk->base;
+    chunk->end = chunk->base + size;
+    chunk->tail = chunk->end;
+    chunk->headLast = NULL;
+
+    // Newest chunk last, so the original arena is always searched first
+    HeapChunk **link = &heap->chunks;
+
+    while (*link != NULL) {
+        link = &(*link)->next;
+    }
+
+    chunk->next = NULL;
+    *link = chunk;
+
+    heap->capacity += size;
+    heap->numChunks++;
+
+    return chunk;
+}
+
+static void ReleaseChunk(SDLHeap *heap, HeapChunk *chunk)
+{
+    HeapChunk **link = &heap->chunks;
+
+    while (*link != chunk) {
+        link = &(*link)->next;
+    }
+
+    *link = chunk->next;
+    heap->capacity -= (u32)(chunk->end - chunk->base);
+    heap->numChunks--;
+    free(chunk);
+}
+
+static void InitBlock(HeapBlock *block, HeapChunk *chunk, enum HeapID heapID, u32 size, u32 prevSize, u8 flags)
+{
+    block->size = size;
+    block->prevSize = prevSize;
+    block->chunk = chunk;
+    block->requested = 0;
+    block->magic = HEAP_BLOCK_MAGIC;
+    block->heapID = heapID;
+    block->flags = flags;
+}
+
+static HeapBlock *BumpHead(HeapChunk *chunk, enum HeapID heapID, u32 size)
+{
+    if ((size_t)(chunk->tail - chunk->head) < HEAP_BLOCK_HEADER_SIZE + size) {
+        return NULL;
+    }
+
+    HeapBlock *block = (HeapBlock *)chunk->head;
+
+    InitBlock(block, chunk, heapID, size, chunk->headLast ? chunk->headLast->size : 0, 0);
+    chunk->head += HEAP_BLOCK_HEADER_SIZE + size;
+    chunk->headLast = block;
+
+    return block;
+}
+
+static HeapBlock *BumpTail(HeapChunk *chunk, enum HeapID heapID, u32 size)
+{
+    if ((size_t)(chunk->tail - chunk->head) < HEAP_BLOCK_HEADER_SIZE + size) {
+        return NULL;
+    }
+
+    HeapBlock *block = (HeapBlock *)(chunk->tail - HEAP_BLOCK_HEADER_SIZE - size);
+
+    InitBlock(block, chunk, heapID, size, 0, HEAP_BLOCK_TAIL);
+
+    if (chunk->tail < chunk->end) {
+        ((HeapBlock *)chunk->tail)->prevSize = size;
+    }
+
+    chunk->tail = (u8 *)block;
+
+    return block;
+}
+
+// Gives the end of a block back to the heap if it is big enough to be a block of its own
+static void SplitBlock(SDLHeap *heap, HeapBlock *block, u32 size);
+
+static void ReleaseBlock(SDLHeap *heap, HeapBlock *block)
+{
+    HeapChunk *chunk = block->chunk;
+
+    block->flags |= HEAP_BLOCK_FREE;
+
+    if (HasNextBlock(block)) {
+        HeapBlock *next = NextBlock(block);
+
+        if (IsBinnedFree(next)) {
+            BinRemove(heap, next);
+            block->size += HEAP_BLOCK_HEADER_SIZE + next->size;
+        }
+    }
+
+    if (!IsLowestBlock(block)) {
+        HeapBlock *prev = PrevBlock(block);
+
+        if (IsBinnedFree(prev)) {
+            BinRemove(heap, prev);
+            prev->size += HEAP_BLOCK_HEADER_SIZE + block->size;
+            block = prev;
+        }
+    }
+
+    // A binned block is never left next to a frontier, so moving the frontier
+    // back is all it takes to merge with the unused middle of the chunk
+    if (block->flags & HEAP_BLOCK_TAIL) {
+        if ((u8 *)block == chunk->tail) {
+            chunk->tail = (u8 *)NextBlock(block);
+
+            if (chunk->tail < chunk->end) {
+                ((HeapBlock *)chunk->tail)->prevSize = 0;
+            }
+        } else {
+            if (HasNextBlock(block)) {
+                NextBlock(block)->prevSize = block->size;
+            }
+
+            BinInsert(heap, block);
+        }
+    } else {
+        if ((u8 *)NextBlock(block) == chunk->head) {
+            chunk->head = (u8 *)block;
+            chunk->headLast = IsLowestBlock(block) ? NULL : PrevBlock(block);
+        } else {
+            NextBlock(block)->prevSize = block->size;
+            BinInsert(heap, block);
+        }
+    }
+
+    if (chunk != heap->chunks && chunk->head == chunk->base && chunk->tail == chunk->end) {
+        ReleaseChunk(heap, chunk);
+    }
+}
+
+static void SplitBlock(SDLHeap *heap, HeapBlock *block, u32 size)
+{
+    if (block->size - size < HEAP_BLOCK_HEADER_SIZE + HEAP_MIN_PAYLOAD) {
+        return;
+    }
+
+    HeapBlock *rest = (HeapBlock *)((u8 *)BlockPayload(block) + size);
+
+    InitBlock(rest, block->chunk, block->heapID, block->size - size - HEAP_BLOCK_HEADER_SIZE, size, block->flags & HEAP_BLOCK_TAIL);
+    block->size = size;
+
+    if (!(rest->flags & HEAP_BLOCK_TAIL) && block == block->chunk->headLast) {
+        block->chunk->headLast = rest;
+    }
+
+    if (HasNextBlock(rest)) {
+        NextBlock(rest)->prevSize = rest->size;
+    }
+
+    ReleaseBlock(heap, rest);
+}
+
+static HeapBlock *TakeFromBins(SDLHeap *heap, u32 size)
+{
+    for (u32 bin = NextUsedBin(heap, BinIndex(size)); bin < HEAP_NUM_BINS; bin = NextUsedBin(heap, bin + 1)) {
+        for (HeapBlock *block = heap->bins[bin]; block != NULL; block = FreeLinks(block)->next) {
+            if (block->size >= size) {
+                BinRemove(heap, block);
+                block->flags &= ~HEAP_BLOCK_FREE;
+                SplitBlock(heap, block, size);
+                return block;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+// Small blocks are freed onto a per-size list without touching their
+// neighbours, and taken back off it by the next request of that size
+static void PushFastBin(SDLHeap *heap, HeapBlock *block)
+{
+    HeapBlock **bin = &heap->fastBins[block->size / HEAP_ALIGN - 1];
+
+    block->flags |= HEAP_BLOCK_FREE | HEAP_BLOCK_FAST;
+    FreeLinks(block)->next = *bin;
+    *bin = block;
+    heap->numFastBlocks++;
+}
+
+static HeapBlock *PopFastBin(SDLHeap *heap, u32 size)
+{
+    HeapBlock **bin = &heap->fastBins[size / HEAP_ALIGN - 1];
+    HeapBlock *block = *bin;
+
+    if (block != NULL) {
+        *bin = FreeLinks(block)->next;
+        block->flags &= ~(HEAP_BLOCK_FREE | HEAP_BLOCK_FAST);
+        heap->numFastBlocks--;
+    }
+
+    return block;
+}
+
+// Releases every fast bin block properly, merging it with its neighbours
+static void MergeFastBins(SDLHeap *heap)
+{
+    for (u32 bin = 0; bin < HEAP_SMALL_BINS; bin++) {
+        while (heap->fastBins[bin] != NULL) {
+            ReleaseBlock(heap, PopFastBin(heap, (bin + 1) * HEAP_ALIGN));
+        }
+    }
+}
+
+static BOOL CreateHeapInternal(enum HeapID parent, enum HeapID child, u32 size)
+{
+    GF_ASSERT(child < HEAP_ID_MAX);
+
+    if (child >= HEAP_ID_MAX) {
+        return FALSE;
+    }
+
+    SDLHeap *heap = &sHeaps[child];
+
+    if (heap->active) {
+        printf("[Heap] Heap %d already exists\n", child);
+        GF_ASSERT(FALSE);
+        return FALSE;
+    }
+
+    memset(heap, 0, sizeof(*heap));
+
+    if (AddChunk(heap, size * HEAP_SIZE_SCALE) == NULL) {
+        printf("[Heap] Failed to reserve %u bytes for heap %d\n", size * HEAP_SIZE_SCALE, child);
+        return FALSE;
+    }
+
+    heap->budget = size;
+    heap->parent = parent;
+    heap->active = TRUE;
+
+    return TRUE;
+}
+
+static HeapBlock *AllocSlabBlock(SDLHeap *heap, u32 heapID, u32 size)
+{
+    if (heap->slab == NULL) {
+        heap->slab = PAL_Slab_CreateCache();
+
+        if (heap->slab == NULL) {
+            return NULL;
+        }
+    }
+
+    u32 slabClass = PAL_Slab_GetSizeClass(HEAP_BLOCK_HEADER_SIZE + size);
+    HeapBlock *block = PAL_Slab_AllocFromClass(heap->slab, slabClass);
+
+    // Heap_Free only reads these; size, prevSize and chunk are arena
+    // bookkeeping, and Heap_Realloc looks the slab object size up instead.
+    // Keeping the class here lets Heap_Free skip the slab page header, which
+    // is on a cache line the caller has usually not touched
+    if (block != NULL) {
+        block->magic = HEAP_BLOCK_MAGIC;
+        block->heapID = heapID;
+        block->flags = HEAP_BLOCK_SLAB;
+        block->slabClass = slabClass;
+    }
+
+    return block;
+}
+
+static HeapBlock *AllocArenaBlock(SDLHeap *heap, u32 heapID, u32 size, BOOL atEnd)
+{
+    u32 payload = size < HEAP_MIN_PAYLOAD ? HEAP_MIN_PAYLOAD : (u32)HEAP_ROUND_UP(size);
+    HeapBlock *block = NULL;
+    HeapChunk *chunk;
+
+    // Fast path. Scratch buffers from the top stay at the top, where they
+    // are most likely to be freed by moving the frontier; everything else
+    // reuses a freed block of the same size, or else grows the head region
+    if (atEnd) {
+        for (chunk = heap->chunks; chunk != NULL && block == NULL; chunk = chunk->next) {
+            block = BumpTail(chunk, heapID, payload);
+        }
+    }
+
+    if (block == NULL && payload <= HEAP_FAST_MAX) {
+        block = PopFastBin(heap, payload);
+    }
+
+    for (chunk = heap->chunks; chunk != NULL && block == NULL && !atEnd; chunk = chunk->next) {
+        block = BumpHead(chunk, heapID, payload);
+    }
+
+    // Slow path once the frontiers meet: split a larger free block, first
+    // merging the fast bins if no binned block is big enough
+    if (block == NULL) {
+        block = TakeFromBins(heap, payload);
+    }
+
+    if (block == NULL && heap->numFastBlocks != 0) {
+        MergeFastBins(heap);
+        block = TakeFromBins(heap, payload);
+
+        for (chunk = heap->chunks; chunk != NULL && block == NULL; chunk = chunk->next) {
+            block = atEnd ? BumpTail(chunk, heapID, payload) : BumpHead(chunk, heapID, payload);
+        }
+    }
+
+    if (block == NULL) {
+        u32 chunkSize = heap->budget * HEAP_SIZE_SCALE / 2;
+
+        if (chunkSize < HEAP_BLOCK_HEADER_SIZE + payload) {
+            chunkSize = HEAP_BLOCK_HEADER_SIZE + payload;
+        }
+
+        if (!heap->overflowReported) {
+            printf("[Heap] Heap %u outgrew its %u byte budget (%u bytes in use); adding overflow chunks\n", heapID, heap->budget, heap->curSize);
+            heap->overflowReported = TRUE;
+        }
+
+        chunk = AddChunk(heap, chunkSize);
+
+        if (chunk == NULL) {
+            printf("[Heap] Out of memory allocating %u bytes from heap %u\n", size, heapID);
+            return NULL;
+        }
+
+        block = atEnd ? BumpTail(chunk, heapID, payload) : BumpHead(chunk, heapID, payload);
+    }
+
+    return block;
+}
+
+static void *AllocFromHeapInternal(u32 heapID, u32 size, BOOL atEnd)
+{
+    GF_ASSERT(heapID < HEAP_ID_MAX);
+
+    if (heapID >= HEAP_ID_MAX) {
+        return NULL;
+    }
+
+    SDLHeap *heap = &sHeaps[heapID];
+
+    if (!heap->active) {
+        printf("[Heap] Allocating from heap %u before it was created; creating it with %u bytes\n", heapID, HEAP_DEFAULT_SIZE);
+
+        if (!CreateHeapInternal(HEAP_ID_SYSTEM, heapID, HEAP_DEFAULT_SIZE)) {
+            return NULL;
+        }
+    }
+
+    HeapBlock *block = NULL;
+
+    if (sSlabEnabled && size <= HEAP_SLAB_MAX_SIZE) {
+        block = AllocSlabBlock(heap, heapID, size);
+    }
+
+    if (block == NULL) {
+        block = AllocArenaBlock(heap, heapID, size, atEnd);
+    }
+
+    if (block == NULL) {
+        return NULL;
+    }
+
+    block->requested = size;
+
+    heap->curSize += size;
+    heap->numBlocks++;
+
+    if (heap->curSize > heap->highWaterMark) {
+        heap->highWaterMark = heap->curSize;
+    }
+
+    if (heap->numBlocks > heap->peakBlocks) {
+        heap->peakBlocks = heap->numBlocks;
+    }
+
+    return BlockPayload(block);
+}
+
+static HeapBlock *GetBlockForFree(void *ptr)
+{
+    HeapBlock *block = PayloadBlock(ptr);
+
+    if (block->magic != HEAP_BLOCK_MAGIC || block->heapID >= HEAP_ID_MAX || !sHeaps[block->heapID].active) {
+        printf("[Heap] Freeing %p, which was not allocated from a heap\n", ptr);
+        GF_ASSERT(FALSE);
+        return NULL;
+    }
+
+    if (block->flags & HEAP_BLOCK_FREE) {
+        printf("[Heap] Double free of %p in heap %u\n", ptr, block->heapID);
+        GF_ASSERT(FALSE);
+        return NULL;
+    }
+
+    return block;
+}
+
 void Heap_Init(void) {
-    printf("[Heap] Initialized (SDL malloc/free)\n");
+    memset(sHeaps, 0, sizeof(sHeaps));
 }
 
 void Heap_InitSystem(const HeapParam *templates, u32 nTemplates, u32 totalNumHeaps, u32 preSize) {
-    (void)templates;
-    (void)nTemplates;
     (void)totalNumHeaps;
     (void)preSize;
+
     Heap_Init();
+
+    for (u32 i = 0; i < nTemplates; i++) {
+        CreateHeapInternal(HEAP_ID_SYSTEM, (enum HeapID)i, templates[i].size);
+    }
 }
 
 BOOL Heap_Create(enum HeapID parent, enum HeapID child, u32 size) {
-    (void)parent;
-    (void)child;
-    (void)size;
-    return TRUE;  // Always succeed for SDL
+    return CreateHeapInternal(parent, child, size);
 }
 
 BOOL Heap_CreateAtEnd(enum HeapID parent, enum HeapID child, u32 size) {
-    (void)parent;
-    (void)child;
-    (void)size;
-    return TRUE;
+    return CreateHeapInternal(parent, child, size);
 }
 
 void Heap_Destroy(enum HeapID heapID) {
-    (void)heapID;
+    GF_ASSERT(heapID < HEAP_ID_MAX);
+
+    if (heapID >= HEAP_ID_MAX) {
+        return;
+    }
+
+    SDLHeap *heap = &sHeaps[heapID];
+    HeapChunk *chunk = heap->chunks;
+
+#ifdef PAL_HEAP_PROFILER
+    PAL_HeapProfiler_HeapDestroyed(heapID);
+#endif
+
+    while (chunk != NULL) {
+        HeapChunk *next = chunk->next;
+
+        free(chunk);
+        chunk = next;
+    }
+
+    PAL_Slab_DestroyCache(heap->slab);
+    memset(heap, 0, sizeof(*heap));
 }
 
 void *Heap_Alloc(u32 heapID, u32 size) {
-    (void)heapID;
-    return malloc(size);
+    void *ptr = AllocFromHeapInternal(heapID, size, FALSE);
+
+#ifdef PAL_HEAP_PROFILER
+    PAL_HeapProfiler_RecordAlloc(ptr, size, heapID, PAL_HEAP_PROFILER_CALLER());
+#endif
+
+    return ptr;
 }
 
 void *Heap_AllocAtEnd(u32 heapID, u32 size) {
-    (void)heapID;
-    return malloc(size);
+    void *ptr = AllocFromHeapInternal(heapID, size, TRUE);
+
+#ifdef PAL_HEAP_PROFILER
+    PAL_HeapProfiler_RecordAlloc(ptr, size, heapID, PAL_HEAP_PROFILER_CALLER());
+#endif
+
+    return ptr;
 }
 
 void Heap_Free(void *ptr) {
-    free(ptr);
+    if (ptr == NULL) {
+        return;
+    }
+
+    HeapBlock *block = GetBlockForFree(ptr);
+
+    if (block == NULL) {
+        return;
+    }
+
+#ifdef PAL_HEAP_PROFILER
+    PAL_HeapProfiler_RecordFree(ptr);
+#endif
+
+    SDLHeap *heap = &sHeaps[block->heapID];
+
+    heap->curSize -= block->requested;
+    heap->numBlocks--;
+
+    if (block->flags & HEAP_BLOCK_SLAB) {
+        // The flag stays readable in the freed object, so a double free is still caught
+        block->flags |= HEAP_BLOCK_FREE;
+        PAL_Slab_FreeToClass(heap->slab, block->slabClass, block);
+    } else if (block->size <= HEAP_FAST_MAX) {
+        PushFastBin(heap, block);
+    } else {
+        ReleaseBlock(heap, block);
+    }
 }
 
 void Heap_FreeExplicit(u32 heapID, void *ptr) {
-    (void)heapID;
-    free(ptr);
+    if (ptr == NULL) {
+        return;
+    }
+
+    GF_ASSERT(PayloadBlock(ptr)->heapID == heapID);
+    Heap_Free(ptr);
 }
 
 u32 Heap_GetSize(enum HeapID heapID) {
-    (void)heapID;
-    return 0xFFFFFFFF;  // Unlimited for SDL
+    return Heap_GetTotalSize(heapID);
 }
 
 u32 Heap_GetMaxAllocatableSize(enum HeapID heapID) {
-    (void)heapID;
-    return 0xFFFFFFFF;
+    if (heapID >= HEAP_ID_MAX || !sHeaps[heapID].active) {
+        return 0;
+    }
+
+    SDLHeap *heap = &sHeaps[heapID];
+    size_t largest = 0;
+
+    // Fast bin blocks may be holding a frontier up
+    MergeFastBins(heap);
+
+    for (HeapChunk *chunk = heap->chunks; chunk != NULL; chunk = chunk->next) {
+        size_t gap = chunk->tail - chunk->head;
+
+        if (gap > HEAP_BLOCK_HEADER_SIZE && gap - HEAP_BLOCK_HEADER_SIZE > largest) {
+            largest = gap - HEAP_BLOCK_HEADER_SIZE;
+        }
+    }
+
+    for (u32 bin = 0; bin < HEAP_NUM_BINS; bin++) {
+        for (HeapBlock *block = heap->bins[bin]; block != NULL; block = FreeLinks(block)->next) {
+            if (block->size > largest) {
+                largest = block->size;
+            }
+        }
+    }
+
+    return (u32)largest;
 }
 
 u32 Heap_GetTotalSize(enum HeapID heapID) {
-    (void)heapID;
-    return 0xFFFFFFFF;
+    if (heapID >= HEAP_ID_MAX) {
+        return 0;
+    }
+
+    return sHeaps[heapID].capacity;
 }
 
 u32 Heap_GetCurSize(enum HeapID heapID) {
-    (void)heapID;
-    return 0;  // Unknown
+    if (heapID >= HEAP_ID_MAX) {
+        return 0;
+    }
+
+    return sHeaps[heapID].curSize;
+}
+
+u32 Heap_GetHighWaterMark(enum HeapID heapID) {
+    if (heapID >= HEAP_ID_MAX) {
+        return 0;
+    }
+
+    return sHeaps[heapID].highWaterMark;
 }
 
 u32 Heap_GetPreSize(enum HeapID heapID) {
@@ -92,8 +862,76 @@ u32 Heap_GetPreSize(enum HeapID heapID) {
 }
 
 u16 Heap_GetNumBlocks(enum HeapID heapID) {
-    (void)heapID;
-    return 0;
+    if (heapID >= HEAP_ID_MAX) {
+        return 0;
+    }
+
+    return sHeaps[heapID].numBlocks > 0xFFFF ? 0xFFFF : (u16)sHeaps[heapID].numBlocks;
+}
+
+BOOL Heap_GetStats(enum HeapID heapID, HeapStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+
+    if (heapID >= HEAP_ID_MAX || !sHeaps[heapID].active) {
+        return FALSE;
+    }
+
+    SDLHeap *heap = &sHeaps[heapID];
+
+    stats->budget = heap->budget;
+    stats->capacity = heap->capacity;
+    stats->curSize = heap->curSize;
+    stats->highWaterMark = heap->highWaterMark;
+    stats->numBlocks = heap->numBlocks;
+    stats->peakBlocks = heap->peakBlocks;
+    stats->numChunks = heap->numChunks;
+
+    for (u32 i = 0; i < PAL_SLAB_NUM_CLASSES; i++) {
+        PAL_SlabClassStats classStats;
+
+        PAL_Slab_GetStats(heap->slab, i, &classStats);
+        stats->slabPages += classStats.pages;
+    }
+
+    return TRUE;
+}
+
+void Heap_PrintStats(void) {
+    printf("[Heap] %-4s %10s %10s %10s %8s %8s %6s %6s\n", "id", "budget", "in use", "peak", "blocks", "peak", "chunks", "slabs");
+
+    for (u32 i = 0; i < HEAP_ID_MAX; i++) {
+        HeapStats stats;
+
+        if (Heap_GetStats(i, &stats)) {
+            printf("[Heap] %-4u %10u %10u %10u %8u %8u %6u %6u%s\n", i, stats.budget, stats.curSize, stats.highWaterMark, stats.numBlocks, stats.peakBlocks, stats.numChunks, stats.slabPages, stats.highWaterMark > stats.budget ? "  over DS budget" : "");
+        }
+    }
+
+    printf("[Heap] Small blocks by size class, all heaps:\n");
+    printf("[Heap] %6s %12s %10s %10s %6s\n", "size", "allocs", "live", "peak", "pages");
+
+    for (u32 i = 0; i < PAL_SLAB_NUM_CLASSES; i++) {
+        PAL_SlabClassStats total = { 0 };
+
+        for (u32 heapID = 0; heapID < HEAP_ID_MAX; heapID++) {
+            PAL_SlabClassStats classStats;
+
+            PAL_Slab_GetStats(sHeaps[heapID].slab, i, &classStats);
+            total.object_size = classStats.object_size;
+            total.allocs += classStats.allocs;
+            total.live += classStats.live;
+            total.peak_live += classStats.peak_live;
+            total.pages += classStats.pages;
+        }
+
+        if (total.allocs > 0) {
+            printf("[Heap] %6u %12llu %10u %10u %6u\n", total.object_size, (unsigned long long)total.allocs, total.live, total.peak_live, total.pages);
+        }
+    }
+}
+
+void Heap_SetSlabEnabled(BOOL enabled) {
+    sSlabEnabled = enabled;
 }
 
 u8 Heap_GetIndex(enum HeapID heapID) {
@@ -106,14 +944,84 @@ enum HeapID Heap_GetIdFromIndex(u8 heapIdx) {
 }
 
 u32 HeapExp_FndGetTotalFreeSize(u32 heapID) {
-    (void)heapID;
-    return 0xFFFFFFFF;  // Unlimited for SDL
+    if (heapID >= HEAP_ID_MAX || !sHeaps[heapID].active) {
+        return 0;
+    }
+
+    SDLHeap *heap = &sHeaps[heapID];
+    size_t total = 0;
+
+    MergeFastBins(heap);
+
+    for (HeapChunk *chunk = heap->chunks; chunk != NULL; chunk = chunk->next) {
+        total += chunk->tail - chunk->head;
+    }
+
+    for (u32 bin = 0; bin < HEAP_NUM_BINS; bin++) {
+        for (HeapBlock *block = heap->bins[bin]; block != NULL; block = FreeLinks(block)->next) {
+            total += block->size;
+        }
+    }
+
+    return (u32)total;
 }
 
 void Heap_Realloc(void *ptr, u32 newSize) {
-    // SDL: realloc not implemented yet
-    (void)ptr;
-    (void)newSize;
+    HeapBlock *block = GetBlockForFree(ptr);
+
+    if (block == NULL) {
+        return;
+    }
+
+    SDLHeap *heap = &sHeaps[block->heapID];
+    HeapChunk *chunk = block->chunk;
+    u32 payload = newSize < HEAP_MIN_PAYLOAD ? HEAP_MIN_PAYLOAD : (u32)HEAP_ROUND_UP(newSize);
+
+    if (block->flags & HEAP_BLOCK_SLAB) {
+        // Slab objects can only change size within their class
+        if (HEAP_BLOCK_HEADER_SIZE + newSize > PAL_Slab_GetObjectSize(block)) {
+            printf("[Heap] Cannot grow %p in heap %u from %u to %u bytes in place\n", ptr, block->heapID, block->requested, newSize);
+            GF_ASSERT(FALSE);
+            return;
+        }
+    } else if (payload > block->size) {
+        if (block == chunk->headLast && (size_t)(chunk->tail - chunk->head) >= payload - block->size) {
+            chunk->head += payload - block->size;
+            block->size = payload;
+        } else if (HasNextBlock(block) && IsBinnedFree(NextBlock(block)) && block->size + HEAP_BLOCK_HEADER_SIZE + NextBlock(block)->size >= payload) {
+            HeapBlock *next = NextBlock(block);
+
+            BinRemove(heap, next);
+            block->size += HEAP_BLOCK_HEADER_SIZE + next->size;
+
+            if (HasNextBlock(block)) {
+                NextBlock(block)->prevSize = block->size;
+            }
+
+            SplitBlock(heap, block, payload);
+        } else {
+            // The DS heap can only resize in place as well
+            printf("[Heap] Cannot grow %p in heap %u from %u to %u bytes in place\n", ptr, block->heapID, block->requested, newSize);
+            GF_ASSERT(FALSE);
+            return;
+        }
+    } else if (block == chunk->headLast) {
+        chunk->head -= block->size - payload;
+        block->size = payload;
+    } else {
+        SplitBlock(heap, block, payload);
+    }
+
+    heap->curSize += newSize - block->requested;
+    block->requested = newSize;
+
+#ifdef PAL_HEAP_PROFILER
+    PAL_HeapProfiler_RecordResize(ptr, newSize);
+#endif
+
+    if (heap->curSize > heap->highWaterMark) {
+        heap->highWaterMark = heap->curSize;
+    }
 }
 
 BOOL GF_heap_c_dummy_return_true(u32 heapID) {
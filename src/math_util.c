@@ -4,7 +4,13 @@
 
 #include "heap.h"
 
+#ifndef PLATFORM_DS
+#include "platform/pal_crypt.h"
+#endif
+
+#ifdef PLATFORM_DS
 static u16 LCRNG_NextFrom(u32 *seed);
+#endif
 
 fx32 CalcSineDegrees(u16 degrees)
 {
@@ -216,10 +222,15 @@ u32 SumBytes(const void *data, u32 size)
 
 void EncodeData(void *data, u32 size, u32 seed)
 {
+#ifndef PLATFORM_DS
+    // Same keystream, generated several halfwords at a time
+    PAL_Crypt_LCRNGXor(data, size, seed);
+#else
     u16 *halfWords = (u16 *)data;
     for (int i = 0; i < size / 2; i++) {
         halfWords[i] ^= LCRNG_NextFrom(&seed);
     }
+#endif
 }
 
 void DecodeData(void *data, u32 size, u32 seed)
@@ -227,11 +238,13 @@ void DecodeData(void *data, u32 size, u32 seed)
     EncodeData(data, size, seed);
 }
 
+#ifdef PLATFORM_DS
 static u16 LCRNG_NextFrom(u32 *seed)
 {
     *seed = *seed * LCRNG_MULTIPLIER + LCRNG_INCREMENT;
     return *seed >> 16;
 }
+#endif
 
 static MATHCRC16Table *sCRC16Table = NULL;
 
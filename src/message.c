@@ -11,6 +11,12 @@
 #include "narc.h"
 #include "strbuf.h"
 
+#ifndef PLATFORM_DS
+#include <stdio.h>
+
+#include "platform/pal_memory.h"
+#endif
+
 #define KEY_START 596947
 #define KEY_INC   18749
 
@@ -46,6 +52,228 @@ static inline u8 *EntryOffsetAddress(const MessageBank *bank, u32 bankIndex)
     return (u8 *)bank + bankIndex;
 }
 
+#ifndef PLATFORM_DS
+
+// Message store. Banks are read in place out of the mapped archives, and each
+// entry is decoded at most once, the first time it is fetched, into an
+// immutable string keyed by (narc, bank, entry). The strings live for the rest
+// of the run, like the archives they come from. Messages are only fetched from
+// the main thread, so the store takes no locks.
+
+#define STORE_CHUNK_SIZE    0x10000
+#define STORE_MIN_CAPACITY  64
+
+typedef struct MessageStoreBank {
+    u32 key;
+    const MessageBank *bank;
+    u32 bankSize;
+    const charcode_t **strings;
+    u16 *lengths;
+} MessageStoreBank;
+
+typedef struct MessageStoreChunk {
+    struct MessageStoreChunk *next;
+    u32 used;
+    u32 size;
+    charcode_t data[];
+} MessageStoreChunk;
+
+static MessageStoreBank *sStoreBanks;
+static u32 sStoreCapacity;
+static u32 sStoreCount;
+static MessageStoreChunk *sStoreChunks;
+
+static inline u32 StoreKey(enum NarcID narcID, u32 bankID)
+{
+    // 0 marks an empty slot, so keys are offset by one
+    return (((u32)narcID << 16) | (bankID & 0xFFFF)) + 1;
+}
+
+static inline u32 StoreSlot(u32 key, u32 capacity)
+{
+    return (key * 0x9E3779B1) & (capacity - 1);
+}
+
+static BOOL GrowStore(void)
+{
+    u32 capacity = sStoreCapacity ? sStoreCapacity * 2 : STORE_MIN_CAPACITY;
+    MessageStoreBank *banks = PAL_Calloc(sizeof(MessageStoreBank) * capacity, 0);
+
+    if (banks == NULL) {
+        return FALSE;
+    }
+
+    for (u32 i = 0; i < sStoreCapacity; i++) {
+        if (sStoreBanks[i].key != 0) {
+            u32 slot = StoreSlot(sStoreBanks[i].key, capacity);
+
+            while (banks[slot].key != 0) {
+                slot = (slot + 1) & (capacity - 1);
+            }
+
+            banks[slot] = sStoreBanks[i];
+        }
+    }
+
+    PAL_Free(sStoreBanks);
+    sStoreBanks = banks;
+    sStoreCapacity = capacity;
+
+    return TRUE;
+}
+
+// Returns the store's record of a bank, adding it the first time the bank is
+// seen, or NULL if the bank is not in a mapped archive
+static MessageStoreBank *GetStoreBank(enum NarcID narcID, u32 bankID)
+{
+    u32 key = StoreKey(narcID, bankID);
+
+    if (sStoreCapacity != 0) {
+        u32 slot = StoreSlot(key, sStoreCapacity);
+
+        while (sStoreBanks[slot].key != 0) {
+            if (sStoreBanks[slot].key == key) {
+                return &sStoreBanks[slot];
+            }
+
+            slot = (slot + 1) & (sStoreCapacity - 1);
+        }
+    }
+
+    u32 bankSize = 0;
+    const MessageBank *bank = NARC_GetMemberView(narcID, bankID, &bankSize);
+
+    if (bank == NULL || bankSize < sizeof(MessageBank) || bankSize < (u32)EntryOffset(bank->count)) {
+        return NULL;
+    }
+
+    if ((sStoreCount + 1) * 4 > sStoreCapacity * 3 && !GrowStore()) {
+        return NULL;
+    }
+
+    const charcode_t **strings = PAL_Calloc(sizeof(charcode_t *) * (bank->count + 1), 0);
+    u16 *lengths = PAL_Calloc(sizeof(u16) * (bank->count + 1), 0);
+
+    if (strings == NULL || lengths == NULL) {
+        PAL_Free(strings);
+        PAL_Free(lengths);
+        return NULL;
+    }
+
+    u32 slot = StoreSlot(key, sStoreCapacity);
+
+    while (sStoreBanks[slot].key != 0) {
+        slot = (slot + 1) & (sStoreCapacity - 1);
+    }
+
+    MessageStoreBank *storeBank = &sStoreBanks[slot];
+    storeBank->key = key;
+    storeBank->bank = bank;
+    storeBank->bankSize = bankSize;
+    storeBank->strings = strings;
+    storeBank->lengths = lengths;
+    sStoreCount++;
+
+    return storeBank;
+}
+
+static charcode_t *AllocStoreString(u32 length)
+{
+    if (sStoreChunks == NULL || sStoreChunks->size - sStoreChunks->used < length) {
+        u32 size = STORE_CHUNK_SIZE / sizeof(charcode_t);
+
+        if (length > size) {
+            size = length;
+        }
+
+        MessageStoreChunk *chunk = PAL_Malloc(sizeof(MessageStoreChunk) + size * sizeof(charcode_t), 0);
+
+        if (chunk == NULL) {
+            return NULL;
+        }
+
+        chunk->next = sStoreChunks;
+        chunk->used = 0;
+        chunk->size = size;
+        sStoreChunks = chunk;
+    }
+
+    charcode_t *str = sStoreChunks->data + sStoreChunks->used;
+    sStoreChunks->used += length;
+
+    return str;
+}
+
+static const charcode_t *DecodeStoreEntry(MessageStoreBank *storeBank, u32 entryID)
+{
+    const MessageBank *bank = storeBank->bank;
+    MessageBankEntry entry = bank->entries[entryID];
+    DecodeEntry(&entry, entryID, bank->seed);
+
+    u32 size = entry.length * sizeof(charcode_t);
+
+    if (entry.length > 0xFFFF || entry.offset > storeBank->bankSize || size > storeBank->bankSize - entry.offset) {
+        printf("[Message] Entry %u of bank %u overruns the bank\n", entryID, (storeBank->key - 1) & 0xFFFF);
+        GF_ASSERT(FALSE);
+        return NULL;
+    }
+
+    charcode_t *str = AllocStoreString(entry.length);
+
+    if (str) {
+        memcpy(str, EntryOffsetAddress(bank, entry.offset), size);
+        DecodeString(str, entry.length, entryID, bank->seed);
+
+        storeBank->strings[entryID] = str;
+        storeBank->lengths[entryID] = entry.length;
+    }
+
+    return str;
+}
+
+// Looks an entry up in the message store. Returns FALSE if the bank is not in a
+// mapped archive, in which case callers read it the usual way. Otherwise *str
+// is the decoded entry, or NULL if the entry does not exist.
+static BOOL GetStoreEntry(enum NarcID narcID, u32 bankID, u32 entryID, const charcode_t **str, u32 *length)
+{
+    MessageStoreBank *storeBank = GetStoreBank(narcID, bankID);
+
+    if (storeBank == NULL) {
+        return FALSE;
+    }
+
+    *str = NULL;
+    *length = 0;
+
+    if (entryID >= storeBank->bank->count) {
+        GF_ASSERT(FALSE);
+        return TRUE;
+    }
+
+    *str = storeBank->strings[entryID];
+
+    if (*str == NULL) {
+        *str = DecodeStoreEntry(storeBank, entryID);
+    }
+
+    *length = storeBank->lengths[entryID];
+    return TRUE;
+}
+
+// Loaders for banks in the message store keep neither a copy of the bank nor
+// an open archive
+static inline BOOL IsBankInStore(enum NarcID narcID, u32 bankID)
+{
+    return GetStoreBank(narcID, bankID) != NULL;
+}
+
+static inline BOOL LoaderUsesStore(const MessageLoader *loader)
+{
+    return loader->bank == NULL;
+}
+
+#endif // PLATFORM_DS
+
 MessageBank *MessageBank_Load(enum NarcID narcID, u32 bankID, u32 heapID)
 {
     return NARC_AllocAndReadWholeMemberByIndexPair(narcID, bankID, heapID);
@@ -74,6 +302,19 @@ void MessageBank_Get(const MessageBank *bank, u32 entryID, charcode_t *dst)
 
 void MessageBank_GetFromNARC(enum NarcID narcID, u32 bankID, u32 entryID, u32 heapID, charcode_t *dst)
 {
+#ifndef PLATFORM_DS
+    const charcode_t *str;
+    u32 length;
+
+    if (GetStoreEntry(narcID, bankID, entryID, &str, &length)) {
+        if (str) {
+            memcpy(dst, str, length * sizeof(charcode_t));
+        }
+
+        return;
+    }
+#endif
+
     NARC *narc = NARC_ctor(narcID, heapID);
 
     if (narc) {
@@ -152,6 +393,21 @@ Strbuf *MessageBank_GetNewStrbuf(const MessageBank *bank, u32 entryID, u32 heapI
 
 void MessageBank_GetStrbufFromNARC(enum NarcID narcID, u32 bankID, u32 entryID, u32 heapID, Strbuf *strbuf)
 {
+#ifndef PLATFORM_DS
+    const charcode_t *str;
+    u32 length;
+
+    if (GetStoreEntry(narcID, bankID, entryID, &str, &length)) {
+        if (str) {
+            Strbuf_CopyNumChars(strbuf, str, length);
+        } else {
+            Strbuf_Clear(strbuf);
+        }
+
+        return;
+    }
+#endif
+
     NARC *narc = NARC_ctor(narcID, heapID);
 
     if (narc) {
@@ -190,6 +446,25 @@ void MessageBank_GetStrbufFromHandle(NARC *narc, u32 bankID, u32 entryID, u32 he
 
 Strbuf *MessageBank_GetNewStrbufFromNARC(enum NarcID narcID, u32 bankID, u32 entryID, u32 heapID)
 {
+#ifndef PLATFORM_DS
+    const charcode_t *str;
+    u32 length;
+
+    if (GetStoreEntry(narcID, bankID, entryID, &str, &length)) {
+        if (str == NULL) {
+            return Strbuf_Init(4, heapID);
+        }
+
+        Strbuf *strbuf = Strbuf_Init(length, heapID);
+
+        if (strbuf) {
+            Strbuf_CopyNumChars(strbuf, str, length);
+        }
+
+        return strbuf;
+    }
+#endif
+
     NARC *narc = NARC_ctor(narcID, heapID);
 
     Strbuf *strbuf;
@@ -235,6 +510,23 @@ Strbuf *MessageBank_GetNewStrbufFromHandle(NARC *narc, u32 bankID, u32 entryID,
     return Strbuf_Init(4, heapID);
 }
 
+#ifndef PLATFORM_DS
+void MessageBank_Prefetch(enum NarcID narcID, u32 bankID)
+{
+    MessageStoreBank *storeBank = GetStoreBank(narcID, bankID);
+
+    if (storeBank == NULL) {
+        return;
+    }
+
+    for (u32 i = 0; i < storeBank->bank->count; i++) {
+        if (storeBank->strings[i] == NULL && DecodeStoreEntry(storeBank, i) == NULL) {
+            break;
+        }
+    }
+}
+#endif
+
 u32 MessageBank_EntryCount(const MessageBank *bank)
 {
     return bank->count;
@@ -242,6 +534,14 @@ u32 MessageBank_EntryCount(const MessageBank *bank)
 
 u32 MessageBank_NARCEntryCount(enum NarcID narcID, u32 bankID)
 {
+#ifndef PLATFORM_DS
+    const MessageBank *mappedBank = NARC_GetMemberView(narcID, bankID, NULL);
+
+    if (mappedBank) {
+        return mappedBank->count;
+    }
+#endif
+
     MessageBank bank;
     NARC_ReadFromMemberByIndexPair(&bank, narcID, bankID, 0, sizeof(MessageBank));
 
@@ -253,6 +553,18 @@ MessageLoader *MessageLoader_Init(enum MessageLoaderType type, enum NarcID narcI
     MessageLoader *loader = Heap_AllocAtEnd(heapID, sizeof(MessageLoader));
 
     if (loader) {
+#ifndef PLATFORM_DS
+        if (IsBankInStore(narcID, bankID)) {
+            loader->bank = NULL;
+            loader->type = type;
+            loader->narcID = narcID;
+            loader->bankID = bankID;
+            loader->heapID = heapID;
+
+            return loader;
+        }
+#endif
+
         if (type == MESSAGE_LOADER_BANK_HANDLE) {
             loader->bank = MessageBank_Load(narcID, bankID, heapID);
 
@@ -276,6 +588,13 @@ MessageLoader *MessageLoader_Init(enum MessageLoaderType type, enum NarcID narcI
 void MessageLoader_Free(MessageLoader *loader)
 {
     if (loader) {
+#ifndef PLATFORM_DS
+        if (LoaderUsesStore(loader)) {
+            Heap_Free(loader);
+            return;
+        }
+#endif
+
         switch (loader->type) {
         case MESSAGE_LOADER_BANK_HANDLE:
             MessageBank_Free(loader->bank);
@@ -291,6 +610,13 @@ void MessageLoader_Free(MessageLoader *loader)
 
 void MessageLoader_GetStrbuf(const MessageLoader *loader, u32 entryID, Strbuf *strbuf)
 {
+#ifndef PLATFORM_DS
+    if (LoaderUsesStore(loader)) {
+        MessageBank_GetStrbufFromNARC(loader->narcID, loader->bankID, entryID, loader->heapID, strbuf);
+        return;
+    }
+#endif
+
     switch (loader->type) {
     case MESSAGE_LOADER_BANK_HANDLE:
         MessageBank_GetStrbuf(loader->bank, entryID, strbuf);
@@ -303,6 +629,12 @@ void MessageLoader_GetStrbuf(const MessageLoader *loader, u32 entryID, Strbuf *s
 
 Strbuf *MessageLoader_GetNewStrbuf(const MessageLoader *loader, u32 entryID)
 {
+#ifndef PLATFORM_DS
+    if (LoaderUsesStore(loader)) {
+        return MessageBank_GetNewStrbufFromNARC(loader->narcID, loader->bankID, entryID, loader->heapID);
+    }
+#endif
+
     switch (loader->type) {
     case MESSAGE_LOADER_BANK_HANDLE:
         return MessageBank_GetNewStrbuf(loader->bank, entryID, loader->heapID);
@@ -315,6 +647,12 @@ Strbuf *MessageLoader_GetNewStrbuf(const MessageLoader *loader, u32 entryID)
 
 u32 MessageLoader_MessageCount(const MessageLoader *loader)
 {
+#ifndef PLATFORM_DS
+    if (LoaderUsesStore(loader)) {
+        return MessageBank_NARCEntryCount(loader->narcID, loader->bankID);
+    }
+#endif
+
     switch (loader->type) {
     case MESSAGE_LOADER_BANK_HANDLE:
         return MessageBank_EntryCount(loader->bank);
@@ -327,6 +665,13 @@ u32 MessageLoader_MessageCount(const MessageLoader *loader)
 
 void MessageLoader_Get(const MessageLoader *loader, u32 entryID, charcode_t *dst)
 {
+#ifndef PLATFORM_DS
+    if (LoaderUsesStore(loader)) {
+        MessageBank_GetFromNARC(loader->narcID, loader->bankID, entryID, loader->heapID, dst);
+        return;
+    }
+#endif
+
     switch (loader->type) {
     case MESSAGE_LOADER_BANK_HANDLE:
         MessageBank_Get(loader->bank, entryID, dst);
@@ -3,11 +3,18 @@
 #ifdef PLATFORM_DS
 #include <nitro.h>
 #else
+#include <stdio.h>
+
+#include "platform/pal_archive.h"
+#include "platform/pal_async_load.h"
 #include "platform/platform_types.h"
 #endif
 #include <string.h>
 
 #include "heap.h"
+#ifndef PLATFORM_DS
+#include "sys_task.h"
+#endif
 
 // Mapping of NARC indices to filesystem paths.
 static const char *sNarcPaths[] = {
@@ -208,6 +215,8 @@ static const char *sNarcPaths[] = {
     [NARC_INDEX_APPLICATION__ZUKANLIST__ZKN_DATA__ZUKAN_DATA_GIRA] = "application/zukanlist/zkn_data/zukan_data_gira.narc",
 };
 
+#ifdef PLATFORM_DS
+
 static void ReadFromNarcMemberByPathAndIndex(void *dest, const char *path, int memberIndex, int offset, int bytesToRead);
 static void *AllocAndReadFromNarcMemberByPathAndIndex(const char *path, int memberIndex, int heapID, int offset, int bytesToRead, BOOL allocAtEnd);
 
@@ -222,102 +231,30 @@ static void ReadFromNarcMemberByPathAndIndex(void *dest, const char *path, int m
     u32 fileEnd = 0;
     u16 fileCount = 0;
 
-    #ifdef PLATFORM_DS
     FS_InitFile(&file);
-    #else
-    // TODO: Port FS_InitFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_OpenFile(&file, path);
-    #else
-    // TODO: Port FS_OpenFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&file, 12, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &btafStart, 2);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
 
     btnfStart = btafStart;
 
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&file, btnfStart + 4, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &btafStart, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &fileCount, 2);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
 
     GF_ASSERT(fileCount > memberIndex);
 
     gmifStart = btnfStart + btafStart;
 
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&file, gmifStart + 4, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &btafStart, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
 
     chunkSize = gmifStart + btafStart;
 
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&file, btnfStart + 12 + memberIndex * 8, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &fileStart, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &fileEnd, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&file, chunkSize + 8 + fileStart + offset, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
 
     if (bytesToRead) {
         btafStart = bytesToRead;
@@ -327,16 +264,8 @@ static void ReadFromNarcMemberByPathAndIndex(void *dest, const char *path, int m
 
     GF_ASSERT(btafStart != 0);
 
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, dest, btafStart);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_CloseFile(&file);
-    #else
-    // TODO: Port FS_CloseFile to PAL
-    #endif
 }
 
 static void *AllocAndReadFromNarcMemberByPathAndIndex(const char *path, int memberIndex, int heapID, int offset, int bytesToRead, BOOL allocAtEnd)
@@ -351,102 +280,30 @@ static void *AllocAndReadFromNarcMemberByPathAndIndex(const char *path, int memb
     void *dest;
     u16 fileCount = 0;
 
-    #ifdef PLATFORM_DS
     FS_InitFile(&file);
-    #else
-    // TODO: Port FS_InitFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_OpenFile(&file, path);
-    #else
-    // TODO: Port FS_OpenFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&file, 12, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &btafStart, 2);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
 
     btnfStart = btafStart;
 
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&file, btnfStart + 4, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &btafStart, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &fileCount, 2);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
 
     GF_ASSERT(fileCount > memberIndex);
 
     gmifStart = btnfStart + btafStart;
 
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&file, gmifStart + 4, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &btafStart, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
 
     chunkSize = gmifStart + btafStart;
 
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&file, btnfStart + 12 + memberIndex * 8, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &fileStart, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &fileEnd, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&file, chunkSize + 8 + fileStart + offset, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
 
     if (bytesToRead) {
         btafStart = bytesToRead;
@@ -462,16 +319,8 @@ static void *AllocAndReadFromNarcMemberByPathAndIndex(const char *path, int memb
         dest = Heap_AllocAtEnd(heapID, btafStart);
     }
 
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, dest, btafStart);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_CloseFile(&file);
-    #else
-    // TODO: Port FS_CloseFile to PAL
-    #endif
 
     return dest;
 }
@@ -506,6 +355,7 @@ void *NARC_AllocAtEndAndReadFromMemberByIndexPair(enum NarcID narcID, int member
     return AllocAndReadFromNarcMemberByPathAndIndex(sNarcPaths[narcID], memberIndex, heapID, offset, bytesToRead, TRUE);
 }
 
+
 u32 NARC_GetMemberSizeByIndexPair(enum NarcID narcID, int memberIndex)
 {
     FSFile file;
@@ -517,107 +367,34 @@ u32 NARC_GetMemberSizeByIndexPair(enum NarcID narcID, int memberIndex)
     u32 fileEnd = 0;
     u16 fileCount = 0;
 
-    #ifdef PLATFORM_DS
     FS_InitFile(&file);
-    #else
-    // TODO: Port FS_InitFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_OpenFile(&file, sNarcPaths[narcID]);
-    #else
-    // TODO: Port FS_OpenFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&file, 12, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &chunkSize, 2);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
 
     btafStart = chunkSize;
 
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&file, btafStart + 4, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &chunkSize, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &fileCount, 2);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
 
     GF_ASSERT(fileCount > memberIndex);
 
     btnfStart = btafStart + chunkSize;
 
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&file, btnfStart + 4, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &chunkSize, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
 
     gmifStart = btnfStart + chunkSize;
 
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&file, btafStart + 12 + memberIndex * 8, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &fileStart, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&file, &fileEnd, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&file, gmifStart + 8 + fileStart, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
 
     chunkSize = fileEnd - fileStart;
 
     GF_ASSERT(chunkSize != 0);
-    // Bug: file is never closed!
 
     return chunkSize;
 }
@@ -632,66 +409,18 @@ NARC *NARC_ctor(enum NarcID narcID, u32 heapID)
 
         narc->fatbStart = 0;
 
-        #ifdef PLATFORM_DS
         FS_InitFile(&narc->file);
-        #else
-        // TODO: Port FS_InitFile to PAL
-        #endif
-        #ifdef PLATFORM_DS
         FS_OpenFile(&narc->file, sNarcPaths[narcID]);
-        #else
-        // TODO: Port FS_OpenFile to PAL
-        #endif
-        #ifdef PLATFORM_DS
-        #ifdef PLATFORM_DS
-        #else
-        // TODO: Port FS_SeekFile to PAL
-        #endif
         FS_SeekFile(&narc->file, 12, FS_SEEK_SET);
-        #else
-        // TODO: Port FS_SEEK_SET to PAL
-        #endif
-        #ifdef PLATFORM_DS
         FS_ReadFile(&narc->file, &(narc->fatbStart), 2);
-        #else
-        // TODO: Port FS_ReadFile to PAL
-        #endif
-        #ifdef PLATFORM_DS
-        #ifdef PLATFORM_DS
-        #else
-        // TODO: Port FS_SeekFile to PAL
-        #endif
         FS_SeekFile(&narc->file, narc->fatbStart + 4, FS_SEEK_SET);
-        #else
-        // TODO: Port FS_SEEK_SET to PAL
-        #endif
-        #ifdef PLATFORM_DS
         FS_ReadFile(&narc->file, &chunkSize, 4);
-        #else
-        // TODO: Port FS_ReadFile to PAL
-        #endif
-        #ifdef PLATFORM_DS
         FS_ReadFile(&narc->file, &(narc->numFiles), 2);
-        #else
-        // TODO: Port FS_ReadFile to PAL
-        #endif
 
         btnfStart = narc->fatbStart + chunkSize;
 
-        #ifdef PLATFORM_DS
-        #ifdef PLATFORM_DS
-        #else
-        // TODO: Port FS_SeekFile to PAL
-        #endif
         FS_SeekFile(&narc->file, btnfStart + 4, FS_SEEK_SET);
-        #else
-        // TODO: Port FS_SEEK_SET to PAL
-        #endif
-        #ifdef PLATFORM_DS
         FS_ReadFile(&narc->file, &chunkSize, 4);
-        #else
-        // TODO: Port FS_ReadFile to PAL
-        #endif
 
         narc->fimgStart = btnfStart + chunkSize;
     }
@@ -701,11 +430,7 @@ NARC *NARC_ctor(enum NarcID narcID, u32 heapID)
 
 void NARC_dtor(NARC *param0)
 {
-    #ifdef PLATFORM_DS
     FS_CloseFile(&(param0->file));
-    #else
-    // TODO: Port FS_CloseFile to PAL
-    #endif
     Heap_Free(param0);
 }
 
@@ -717,43 +442,15 @@ void *NARC_AllocAndReadWholeMember(NARC *narc, u32 memberIndex, u32 heapID)
 
     GF_ASSERT(narc->numFiles > memberIndex);
 
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&narc->file, narc->fatbStart + 12 + memberIndex * 8, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&narc->file, &fileStart, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&narc->file, &fileEnd, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&narc->file, narc->fimgStart + 8 + fileStart, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
 
     dest = Heap_Alloc(heapID, fileEnd - fileStart);
 
     if (dest) {
-        #ifdef PLATFORM_DS
         FS_ReadFile(&narc->file, dest, fileEnd - fileStart);
-        #else
-        // TODO: Port FS_ReadFile to PAL
-        #endif
     }
 
     return dest;
@@ -766,39 +463,11 @@ void NARC_ReadWholeMember(NARC *narc, u32 memberIndex, void *dest)
 
     GF_ASSERT(narc->numFiles > memberIndex);
 
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&narc->file, narc->fatbStart + 12 + memberIndex * 8, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&narc->file, &fileStart, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&narc->file, &fileEnd, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&narc->file, narc->fimgStart + 8 + fileStart, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&narc->file, dest, fileEnd - fileStart);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
 }
 
 u32 NARC_GetMemberSize(NARC *narc, u32 memberIndex)
@@ -808,25 +477,9 @@ u32 NARC_GetMemberSize(NARC *narc, u32 memberIndex)
 
     GF_ASSERT(narc->numFiles > memberIndex);
 
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&narc->file, narc->fatbStart + 12 + memberIndex * 8, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&narc->file, &fileStart, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&narc->file, &fileEnd, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
 
     return fileEnd - fileStart;
 }
@@ -837,58 +490,526 @@ void NARC_ReadFromMember(NARC *narc, u32 memberIndex, u32 offset, u32 bytesToRea
 
     GF_ASSERT(narc->numFiles > memberIndex);
 
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&narc->file, narc->fatbStart + 12 + memberIndex * 8, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&narc->file, &fileStart, 4);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&narc->file, narc->fimgStart + 8 + fileStart + offset, FS_SEEK_SET);
-    #else
-    // TODO: Port FS_SEEK_SET to PAL
-    #endif
-    #ifdef PLATFORM_DS
     FS_ReadFile(&narc->file, dest, bytesToRead);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
 }
 
 void NARC_ReadFile(NARC *narc, u32 bytesToRead, void *dest)
 {
-    #ifdef PLATFORM_DS
     FS_ReadFile(&narc->file, dest, bytesToRead);
-    #else
-    // TODO: Port FS_ReadFile to PAL
-    #endif
 }
 
 void NARC_Seek(NARC *narc, u32 offset)
 {
-    #ifdef PLATFORM_DS
-    #ifdef PLATFORM_DS
-    #else
-    // TODO: Port FS_SeekFile to PAL
-    #endif
     FS_SeekFile(&narc->file, offset, FS_SEEK_CUR);
-    #else
-    // TODO: Port FS_SEEK_CUR to PAL
-    #endif
 }
 
+#else
+
+// Archives are mapped on first use and stay mapped, so member views handed
+// out by NARC_GetMemberView never dangle.
+static PAL_Archive *sNarcArchives[NELEMS(sNarcPaths)];
+static BOOL sNarcMissing[NELEMS(sNarcPaths)];
+
+static PAL_Archive *GetArchive(enum NarcID narcID)
+{
+    if ((u32)narcID >= NELEMS(sNarcPaths)) {
+        GF_ASSERT(FALSE);
+        return NULL;
+    }
+
+    if (sNarcArchives[narcID] == NULL && !sNarcMissing[narcID]) {
+        if (sNarcPaths[narcID] != NULL) {
+            sNarcArchives[narcID] = PAL_Archive_Open(sNarcPaths[narcID]);
+        }
+
+        if (sNarcArchives[narcID] == NULL) {
+            printf("[NARC] Archive %d (%s) is not available under %s\n", narcID, sNarcPaths[narcID] ? sNarcPaths[narcID] : "unmapped", PAL_Archive_GetRootDir());
+            sNarcMissing[narcID] = TRUE;
+        }
+    }
+
+    return sNarcArchives[narcID];
+}
+
+// Returns the bytes [offset, offset + bytesToRead) of a member, or the rest of
+// the member if bytesToRead is 0
+static const u8 *GetMemberSlice(PAL_Archive *archive, u32 memberIndex, u32 offset, u32 bytesToRead, u32 *sliceSize)
+{
+    u32 memberSize;
+    const u8 *member = PAL_Archive_GetMember(archive, memberIndex, &memberSize);
+
+    if (member == NULL) {
+        GF_ASSERT(FALSE);
+        return NULL;
+    }
+
+    if (offset > memberSize) {
+        GF_ASSERT(FALSE);
+        return NULL;
+    }
+
+    if (bytesToRead == 0) {
+        bytesToRead = memberSize - offset;
+    }
+
+    if (bytesToRead > memberSize - offset) {
+        printf("[NARC] Read of %u bytes at %u overruns member %u (%u bytes)\n", bytesToRead, offset, memberIndex, memberSize);
+        GF_ASSERT(FALSE);
+        return NULL;
+    }
+
+    *sliceSize = bytesToRead;
+    return member + offset;
+}
+
+static void ReadFromNarcMember(void *dest, enum NarcID narcID, int memberIndex, int offset, int bytesToRead)
+{
+    PAL_Archive *archive = GetArchive(narcID);
+    const u8 *src;
+    u32 size;
+
+    if (archive == NULL) {
+        return;
+    }
+
+    src = GetMemberSlice(archive, memberIndex, offset, bytesToRead, &size);
+
+    if (src) {
+        memcpy(dest, src, size);
+    }
+}
+
+static void *AllocAndReadFromNarcMember(enum NarcID narcID, int memberIndex, int heapID, int offset, int bytesToRead, BOOL allocAtEnd)
+{
+    PAL_Archive *archive = GetArchive(narcID);
+    const u8 *src;
+    void *dest;
+    u32 size;
+
+    if (archive == NULL) {
+        return NULL;
+    }
+
+    src = GetMemberSlice(archive, memberIndex, offset, bytesToRead, &size);
+
+    if (src == NULL || size == 0) {
+        return NULL;
+    }
+
+    if (allocAtEnd == 0) {
+        dest = Heap_Alloc(heapID, size);
+    } else {
+        dest = Heap_AllocAtEnd(heapID, size);
+    }
+
+    if (dest) {
+        memcpy(dest, src, size);
+    }
+
+    return dest;
+}
+
+void NARC_ReadWholeMemberByIndexPair(void *dest, enum NarcID narcID, int memberIndex)
+{
+    ReadFromNarcMember(dest, narcID, memberIndex, 0, 0);
+}
+
+void *NARC_AllocAndReadWholeMemberByIndexPair(enum NarcID narcID, int memberIndex, int heapID)
+{
+    return AllocAndReadFromNarcMember(narcID, memberIndex, heapID, 0, 0, FALSE);
+}
+
+void *NARC_AllocAtEndAndReadWholeMemberByIndexPair(enum NarcID narcID, int memberIndex, int heapID)
+{
+    return AllocAndReadFromNarcMember(narcID, memberIndex, heapID, 0, 0, TRUE);
+}
+
+void NARC_ReadFromMemberByIndexPair(void *dest, enum NarcID narcID, int memberIndex, int offset, int bytesToRead)
+{
+    ReadFromNarcMember(dest, narcID, memberIndex, offset, bytesToRead);
+}
+
+void *NARC_AllocAndReadFromMemberByIndexPair(enum NarcID narcID, int memberIndex, int heapID, int offset, int bytesToRead)
+{
+    return AllocAndReadFromNarcMember(narcID, memberIndex, heapID, offset, bytesToRead, FALSE);
+}
+
+void *NARC_AllocAtEndAndReadFromMemberByIndexPair(enum NarcID narcID, int memberIndex, int heapID, int offset, int bytesToRead)
+{
+    return AllocAndReadFromNarcMember(narcID, memberIndex, heapID, offset, bytesToRead, TRUE);
+}
+
+
+u32 NARC_GetMemberSizeByIndexPair(enum NarcID narcID, int memberIndex)
+{
+    PAL_Archive *archive = GetArchive(narcID);
+    u32 size = 0;
+
+    if (archive == NULL) {
+        return 0;
+    }
+
+    if (PAL_Archive_GetMember(archive, memberIndex, &size) == NULL) {
+        GF_ASSERT(FALSE);
+        return 0;
+    }
+
+    return size;
+}
+
+u16 NARC_GetMemberCountByIndexPair(enum NarcID narcID)
+{
+    PAL_Archive *archive = GetArchive(narcID);
+
+    if (archive == NULL) {
+        return 0;
+    }
+
+    return PAL_Archive_GetMemberCount(archive);
+}
+
+const void *NARC_GetMemberView(enum NarcID narcID, int memberIndex, u32 *size)
+{
+    PAL_Archive *archive = GetArchive(narcID);
+
+    if (archive == NULL) {
+        return NULL;
+    }
+
+    return PAL_Archive_GetMember(archive, memberIndex, size);
+}
+
+NARC *NARC_ctor(enum NarcID narcID, u32 heapID)
+{
+    NARC *narc = Heap_Alloc(heapID, sizeof(NARC));
+
+    if (narc) {
+        u32 btnfStart;
+        u32 chunkSize = 0;
+
+        narc->archive = GetArchive(narcID);
+        narc->position = 0;
+        narc->fatbStart = 0;
+        narc->fimgStart = 0;
+        narc->numFiles = 0;
+
+        if (narc->archive) {
+            // The chunk layout was validated when the archive was mapped
+            const u8 *data = PAL_Archive_GetData(narc->archive, NULL);
+
+            memcpy(&narc->fatbStart, data + 12, 2);
+            memcpy(&chunkSize, data + narc->fatbStart + 4, 4);
+            narc->numFiles = PAL_Archive_GetMemberCount(narc->archive);
+
+            btnfStart = narc->fatbStart + chunkSize;
+
+            memcpy(&chunkSize, data + btnfStart + 4, 4);
+
+            narc->fimgStart = btnfStart + chunkSize;
+        }
+    }
+
+    return narc;
+}
+
+void NARC_dtor(NARC *param0)
+{
+    Heap_Free(param0);
+}
+
+// Points the cursor at the start of a member and returns its size, or returns
+// FALSE if the NARC has no backing archive
+static BOOL SeekToMember(NARC *narc, u32 memberIndex, u32 *size)
+{
+    u32 memberStart, memberEnd;
+
+    if (narc->archive == NULL) {
+        return FALSE;
+    }
+
+    GF_ASSERT(narc->numFiles > memberIndex);
+
+    if (!PAL_Archive_GetMemberRange(narc->archive, memberIndex, &memberStart, &memberEnd)) {
+        return FALSE;
+    }
+
+    narc->position = memberStart;
+    *size = memberEnd - memberStart;
+    return TRUE;
+}
+
+void *NARC_AllocAndReadWholeMember(NARC *narc, u32 memberIndex, u32 heapID)
+{
+    void *dest;
+    u32 size;
+
+    if (!SeekToMember(narc, memberIndex, &size)) {
+        return NULL;
+    }
+
+    dest = Heap_Alloc(heapID, size);
+
+    if (dest) {
+        NARC_ReadFile(narc, size, dest);
+    }
+
+    return dest;
+}
+
+void NARC_ReadWholeMember(NARC *narc, u32 memberIndex, void *dest)
+{
+    u32 size;
+
+    if (SeekToMember(narc, memberIndex, &size)) {
+        NARC_ReadFile(narc, size, dest);
+    }
+}
+
+u32 NARC_GetMemberSize(NARC *narc, u32 memberIndex)
+{
+    u32 memberStart, memberEnd;
+
+    if (narc->archive == NULL) {
+        return 0;
+    }
+
+    GF_ASSERT(narc->numFiles > memberIndex);
+
+    if (!PAL_Archive_GetMemberRange(narc->archive, memberIndex, &memberStart, &memberEnd)) {
+        return 0;
+    }
+
+    // Leave the cursor where the DS version does, just past the FAT entry
+    narc->position = narc->fatbStart + 12 + memberIndex * 8 + 8;
+    return memberEnd - memberStart;
+}
+
+void NARC_ReadFromMember(NARC *narc, u32 memberIndex, u32 offset, u32 bytesToRead, void *dest)
+{
+    u32 size;
+
+    if (!SeekToMember(narc, memberIndex, &size)) {
+        return;
+    }
+
+    if (offset > size || bytesToRead > size - offset) {
+        printf("[NARC] Read of %u bytes at %u overruns member %u (%u bytes)\n", bytesToRead, offset, memberIndex, size);
+        GF_ASSERT(FALSE);
+        return;
+    }
+
+    narc->position += offset;
+    NARC_ReadFile(narc, bytesToRead, dest);
+}
+
+void NARC_ReadFile(NARC *narc, u32 bytesToRead, void *dest)
+{
+    const void *src = NARC_ViewFile(narc, bytesToRead);
+
+    if (src) {
+        memcpy(dest, src, bytesToRead);
+    }
+}
+
+void NARC_Seek(NARC *narc, u32 offset)
+{
+    narc->position += offset;
+}
+
+const void *NARC_ViewFile(NARC *narc, u32 bytes)
+{
+    const u8 *data;
+    u32 fileSize;
+
+    if (narc->archive == NULL) {
+        return NULL;
+    }
+
+    data = PAL_Archive_GetData(narc->archive, &fileSize);
+
+    if (narc->position > fileSize || bytes > fileSize - narc->position) {
+        printf("[NARC] Read of %u bytes at %u overruns the archive (%u bytes)\n", bytes, narc->position, fileSize);
+        GF_ASSERT(FALSE);
+        return NULL;
+    }
+
+    data += narc->position;
+    narc->position += bytes;
+    return data;
+}
+
+// Asynchronous reads run on the PAL loader threads. Their completions are
+// drained by a SysTask that only exists while reads are in flight, so the
+// callbacks run on the main thread between other tasks.
+typedef struct NARCAsyncRead {
+    u32 handle;
+    NARCReadCallback callback;
+    void *userData;
+    void *ownedBuffer;
+} NARCAsyncRead;
+
+static NARCAsyncRead sAsyncReads[PAL_ASYNC_LOAD_MAX_JOBS];
+static SysTask *sAsyncReadDrainTask;
+
+static void NARC_DrainAsyncReads(SysTask *task, void *unused)
+{
+    PAL_AsyncLoad_Drain();
+
+    if (PAL_AsyncLoad_GetPendingCount() == 0) {
+        sAsyncReadDrainTask = NULL;
+        SysTask_Done(task);
+    }
+}
+
+static void NARC_AsyncReadFinished(PAL_AsyncLoadStatus status, void *dest, u32 size, void *userData)
+{
+    NARCAsyncRead *read = userData;
+    NARCReadCallback callback = read->callback;
+    void *callbackUserData = read->userData;
+
+    if (status != PAL_ASYNC_LOAD_OK) {
+        printf("[NARC] Asynchronous read failed\n");
+
+        if (read->ownedBuffer != NULL) {
+            Heap_Free(read->ownedBuffer);
+        }
+
+        dest = NULL;
+        size = 0;
+    }
+
+    read->handle = 0;
+    read->ownedBuffer = NULL;
+    callback(dest, size, callbackUserData);
+}
+
+static u32 NARC_SubmitAsyncRead(const PAL_AsyncLoadRequest *request, NARCReadCallback callback, void *userData, void *ownedBuffer)
+{
+    NARCAsyncRead *read = NULL;
+
+    for (int i = 0; i < NELEMS(sAsyncReads); i++) {
+        if (sAsyncReads[i].handle == 0) {
+            read = &sAsyncReads[i];
+            break;
+        }
+    }
+
+    if (read == NULL) {
+        return 0;
+    }
+
+    PAL_AsyncLoadRequest submitted = *request;
+    submitted.callback = NARC_AsyncReadFinished;
+    submitted.user_data = read;
+
+    read->handle = PAL_AsyncLoad_Submit(&submitted);
+
+    if (read->handle == 0) {
+        return 0;
+    }
+
+    read->callback = callback;
+    read->userData = userData;
+    read->ownedBuffer = ownedBuffer;
+
+    // Priority 0 runs before the field loaders, which poll at priority 1
+    if (sAsyncReadDrainTask == NULL) {
+        sAsyncReadDrainTask = SysTask_Start(NARC_DrainAsyncReads, NULL, 0);
+    }
+
+    return read->handle;
+}
+
+u32 NARC_ReadFileAsync(NARC *narc, u32 bytesToRead, void *dest, NARCReadCallback callback, void *userData)
+{
+    PAL_AsyncLoadRequest request = { 0 };
+    u32 fileSize;
+
+    if (narc->archive == NULL) {
+        return 0;
+    }
+
+    PAL_Archive_GetData(narc->archive, &fileSize);
+
+    if (narc->position > fileSize || bytesToRead > fileSize - narc->position) {
+        printf("[NARC] Read of %u bytes at %u overruns the archive (%u bytes)\n", bytesToRead, narc->position, fileSize);
+        GF_ASSERT(FALSE);
+        return 0;
+    }
+
+    request.archive = narc->archive;
+    request.member = PAL_ASYNC_LOAD_FILE_OFFSET;
+    request.offset = narc->position;
+    request.size = bytesToRead;
+    request.dest = dest;
+    request.dest_capacity = bytesToRead;
+
+    u32 handle = NARC_SubmitAsyncRead(&request, callback, userData, NULL);
+
+    if (handle != 0) {
+        narc->position += bytesToRead;
+    }
+
+    return handle;
+}
+
+u32 NARC_AllocAndReadWholeMemberAsync(enum NarcID narcID, int memberIndex, u32 heapID, NARCReadCallback callback, void *userData)
+{
+    PAL_AsyncLoadRequest request = { 0 };
+    PAL_Archive *archive = GetArchive(narcID);
+    u32 size;
+
+    if (archive == NULL || PAL_Archive_GetMember(archive, memberIndex, &size) == NULL || size == 0) {
+        return 0;
+    }
+
+    // Heaps are not thread-safe, so the buffer is allocated here rather than by the loader
+    void *dest = Heap_Alloc(heapID, size);
+
+    if (dest == NULL) {
+        return 0;
+    }
+
+    request.archive = archive;
+    request.member = memberIndex;
+    request.dest = dest;
+    request.dest_capacity = size;
+
+    u32 handle = NARC_SubmitAsyncRead(&request, callback, userData, dest);
+
+    if (handle == 0) {
+        Heap_Free(dest);
+    }
+
+    return handle;
+}
+
+void NARC_CancelAsyncRead(u32 handle)
+{
+    if (handle == 0) {
+        return;
+    }
+
+    for (int i = 0; i < NELEMS(sAsyncReads); i++) {
+        if (sAsyncReads[i].handle == handle) {
+            PAL_AsyncLoad_Cancel(handle);
+
+            if (sAsyncReads[i].ownedBuffer != NULL) {
+                Heap_Free(sAsyncReads[i].ownedBuffer);
+            }
+
+            sAsyncReads[i].handle = 0;
+            sAsyncReads[i].ownedBuffer = NULL;
+            return;
+        }
+    }
+}
+
+#endif // PLATFORM_DS
+
 u16 NARC_GetFileCount(NARC *narc)
 {
     return narc->numFiles;
@@ -17,6 +17,9 @@
 enum BDHCSubTask {
     BDHC_LOADER_SUBTASK_PREPARE_FILE_LOAD = 0,
     BDHC_LOADER_SUBTASK_LOAD_FILE,
+#ifndef PLATFORM_DS
+    BDHC_LOADER_SUBTASK_WAIT_FOR_FILE_READ,
+#endif
     BDHC_LOADER_SUBTASK_END_TASK,
 };
 
@@ -42,6 +45,10 @@ typedef struct {
     NARC *landDataNARC;
     int dummyE4;
     BOOL *mapModelLoadTaskRunning;
+#ifndef PLATFORM_DS
+    u32 asyncRead;
+    BOOL fileReadFinished;
+#endif
 } BDHCLoaderTaskContext;
 
 typedef struct {
@@ -282,6 +289,55 @@ static void BDHC_PrepareBuffers(const BDHCHeader *bdhcHeader, BDHC *bdhc, void *
     GF_ASSERT(offset <= BDHC_BUFFER_SIZE);
 }
 
+#ifndef PLATFORM_DS
+/*
+ * Points the BDHC arrays straight into the archive data when the NARC is memory-mapped, instead of
+ * copying every section into the buffer. The data is read-only, which is fine since the BDHC is
+ * never written to once loaded. Returns FALSE if the sections have to be copied instead.
+ */
+static u32 BDHC_GetSectionsSize(const BDHCHeader *bdhcHeader)
+{
+    return sizeof(BDHCPoint) * bdhcHeader->pointsCount
+        + sizeof(VecFx32) * bdhcHeader->normalsCount
+        + sizeof(fx32) * bdhcHeader->constantsCount
+        + sizeof(BDHCPlate) * bdhcHeader->platesCount
+        + sizeof(BDHCStrip) * bdhcHeader->stripsCount
+        + sizeof(u16) * bdhcHeader->accessListCount;
+}
+
+static BOOL BDHC_MapSections(NARC *narc, BDHC *bdhc, const BDHCHeader *bdhcHeader)
+{
+    u32 size = BDHC_GetSectionsSize(bdhcHeader);
+
+    // Peek first so the cursor stays put if the data can't be used in place
+    const u8 *data = NARC_ViewFile(narc, 0);
+
+    if (data == NULL || ((uintptr_t)data & 3) != 0) {
+        return FALSE;
+    }
+
+    data = NARC_ViewFile(narc, size);
+
+    if (data == NULL) {
+        return FALSE;
+    }
+
+    bdhc->points = (BDHCPoint *)data;
+    data += sizeof(BDHCPoint) * bdhcHeader->pointsCount;
+    bdhc->normals = (VecFx32 *)data;
+    data += sizeof(VecFx32) * bdhcHeader->normalsCount;
+    bdhc->constants = (fx32 *)data;
+    data += sizeof(fx32) * bdhcHeader->constantsCount;
+    bdhc->plates = (BDHCPlate *)data;
+    data += sizeof(BDHCPlate) * bdhcHeader->platesCount;
+    bdhc->strips = (BDHCStrip *)data;
+    data += sizeof(BDHCStrip) * bdhcHeader->stripsCount;
+    bdhc->accessList = (u16 *)data;
+
+    return TRUE;
+}
+#endif
+
 static void BDHC_LoadPoints(NARC *narc, BDHC *bdhc, const BDHCHeader *bdhcHeader)
 {
     NARC_ReadFile(narc, sizeof(BDHCPoint) * bdhcHeader->pointsCount, bdhc->points);
@@ -312,6 +368,18 @@ static void BDHC_LoadAccessList(NARC *narc, BDHC *bdhc, const BDHCHeader *bdhcHe
     NARC_ReadFile(narc, sizeof(u16) * bdhcHeader->accessListCount, bdhc->accessList);
 }
 
+#ifndef PLATFORM_DS
+static void BDHC_LazyLoadFileRead(void *data, u32 size, void *userData)
+{
+    BDHCLoaderTaskContext *ctx = userData;
+
+    GF_ASSERT(data != NULL);
+
+    ctx->asyncRead = 0;
+    ctx->fileReadFinished = TRUE;
+}
+#endif
+
 static void BDHC_LazyLoadTask(SysTask *sysTask, void *sysTaskParam)
 {
     BOOL subTaskCompleted;
@@ -336,6 +404,18 @@ static void BDHC_LazyLoadTask(SysTask *sysTask, void *sysTaskParam)
         break;
 
     case BDHC_LOADER_SUBTASK_LOAD_FILE:
+#ifndef PLATFORM_DS
+        // The sections are laid out in the buffer in file order, so one read on a loader
+        // thread fills them all
+        ctx->asyncRead = NARC_ReadFileAsync(ctx->landDataNARC, BDHC_GetSectionsSize(&ctx->bdhcHeader), ctx->buffer, BDHC_LazyLoadFileRead, ctx);
+
+        if (ctx->asyncRead != 0) {
+            subTaskCompleted = TRUE;
+            break;
+        }
+
+        ctx->fileReadFinished = TRUE;
+#endif
         BDHC_LoadPoints(ctx->landDataNARC, ctx->bdhc, &ctx->bdhcHeader);
         BDHC_LoadNormals(ctx->landDataNARC, ctx->bdhc, &ctx->bdhcHeader);
         BDHC_LoadConstants(ctx->landDataNARC, ctx->bdhc, &ctx->bdhcHeader);
@@ -346,6 +426,12 @@ static void BDHC_LazyLoadTask(SysTask *sysTask, void *sysTaskParam)
         subTaskCompleted = TRUE;
         break;
 
+#ifndef PLATFORM_DS
+    case BDHC_LOADER_SUBTASK_WAIT_FOR_FILE_READ:
+        subTaskCompleted = ctx->fileReadFinished;
+        break;
+#endif
+
     case BDHC_LOADER_SUBTASK_END_TASK:
         *ctx->loadTaskRunning = FALSE;
 
@@ -386,6 +472,15 @@ void BDHC_Load(NARC *narc, const int bdhcSize, BDHC *bdhc, u8 *buffer)
 
     BDHC_LoadHeader(narc, bdhcHeader);
     bdhc->stripsCount = bdhcHeader->stripsCount;
+
+#ifndef PLATFORM_DS
+    if (BDHC_MapSections(narc, bdhc, bdhcHeader)) {
+        Heap_Free(bdhcHeader);
+        bdhc->loaded = TRUE;
+        return;
+    }
+#endif
+
     BDHC_PrepareBuffers(bdhcHeader, bdhc, (void **)&buffer);
 
     BDHC_LoadPoints(narc, bdhc, bdhcHeader);
@@ -437,6 +532,10 @@ SysTask *BDHC_LazyLoad(NARC *landDataNARC, const int unused1, BDHC *bdhc, BOOL *
     ctx->dummyAC = 0;
     ctx->buffer = *buffer;
     ctx->mapModelLoadTaskRunning = mapModelLoadTaskRunning;
+#ifndef PLATFORM_DS
+    ctx->asyncRead = 0;
+    ctx->fileReadFinished = FALSE;
+#endif
 
     return SysTask_Start(BDHC_LazyLoadTask, ctx, 1);
 }
@@ -445,6 +544,11 @@ void BDHC_KillLoad(SysTask *sysTask)
 {
     BDHCLoaderTaskContext *ctx = SysTask_GetParam(sysTask);
     ctx->killLoadTask = TRUE;
+
+#ifndef PLATFORM_DS
+    NARC_CancelAsyncRead(ctx->asyncRead);
+    ctx->asyncRead = 0;
+#endif
 }
 
 void BDHC_MarkNotLoaded(BDHC *bdhc)
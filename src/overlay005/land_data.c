@@ -151,6 +151,9 @@ typedef struct MapModelLoaderTaskContext {
     BOOL killLoadTask;
     int *loadTaskRunning;
     u32 bytesRead;
+#ifndef PLATFORM_DS
+    u32 asyncRead;
+#endif
 } MapModelLoaderTaskContext;
 
 enum LazyLoaderSubTask {
@@ -165,6 +168,9 @@ enum MapModelLoadSubTask {
     MAP_MODEL_LOADER_SUBTASK_FILE_READ,
     MAP_MODEL_LOADER_SUBTASK_BIND_TEXTURE,
     MAP_MODEL_LOADER_SUBTASK_INIT_RENDER_OBJ,
+#ifndef PLATFORM_DS
+    MAP_MODEL_LOADER_SUBTASK_WAIT_FOR_FILE_READ,
+#endif
     MAP_MODEL_LOADER_SUBTASK_END_TASK = 5
 };
 
@@ -1878,7 +1884,25 @@ static void LandDataManager_KillLoadMapModel(SysTask *sysTask)
 {
     MapModelLoaderTaskContext *ctx = SysTask_GetParam(sysTask);
     ctx->killLoadTask = TRUE;
+
+#ifndef PLATFORM_DS
+    // The model buffer may be reused as soon as this returns
+    NARC_CancelAsyncRead(ctx->asyncRead);
+    ctx->asyncRead = 0;
+#endif
+}
+
+#ifndef PLATFORM_DS
+static void LandDataManager_MapModelFileRead(void *data, u32 size, void *userData)
+{
+    MapModelLoaderTaskContext *ctx = userData;
+
+    GF_ASSERT(data != NULL);
+
+    ctx->asyncRead = 0;
+    ctx->currentSubTask = MAP_MODEL_LOADER_SUBTASK_BIND_TEXTURE;
 }
+#endif
 
 static void LandDataManager_LazyLoadMapModelTask(SysTask *sysTask, void *sysTaskParam)
 {
@@ -1931,6 +1955,12 @@ static void LandDataManager_LazyLoadMapModelTask(SysTask *sysTask, void *sysTask
         break;
     }
 
+#ifndef PLATFORM_DS
+    case MAP_MODEL_LOADER_SUBTASK_WAIT_FOR_FILE_READ:
+        // Moved on by LandDataManager_MapModelFileRead
+        break;
+#endif
+
     case MAP_MODEL_LOADER_SUBTASK_BIND_TEXTURE: {
         if (ctx->mapTexture != NULL) {
             if (Easy3D_IsTextureUploadedToVRAM(ctx->mapTexture) == TRUE) {
@@ -1997,6 +2027,16 @@ SysTask *LandDataManager_LazyLoadMapModel(NARC *landDataNARC, const int mapModel
     ctx->loadTaskRunning = loadTaskRunning;
     ctx->killLoadTask = FALSE;
 
+#ifndef PLATFORM_DS
+    // Read the whole model on a loader thread instead of a chunk per frame. If it can't be
+    // queued, the chunked reads below still work.
+    ctx->asyncRead = NARC_ReadFileAsync(landDataNARC, mapModelDataSize, *mapModelFile, LandDataManager_MapModelFileRead, ctx);
+
+    if (ctx->asyncRead != 0) {
+        ctx->currentSubTask = MAP_MODEL_LOADER_SUBTASK_WAIT_FOR_FILE_READ;
+    }
+#endif
+
     return SysTask_Start(LandDataManager_LazyLoadMapModelTask, ctx, 1);
 }
 
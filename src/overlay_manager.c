@@ -10,6 +10,10 @@
 #include "game_overlay.h"
 #include "heap.h"
 
+#ifdef PAL_HEAP_PROFILER
+#include "platform/pal_heap_profiler.h"
+#endif
+
 ApplicationManager *ApplicationManager_New(const ApplicationManagerTemplate *template, void *args, const enum HeapID heapID)
 {
     ApplicationManager *appMan = Heap_Alloc(heapID, sizeof(ApplicationManager));
@@ -28,6 +32,10 @@ ApplicationManager *ApplicationManager_New(const ApplicationManagerTemplate *tem
 void ApplicationManager_Free(ApplicationManager *appMan)
 {
     Heap_Free(appMan);
+
+#ifdef PAL_HEAP_PROFILER
+    PAL_HeapProfiler_ReportOutstanding("ApplicationManager_Free");
+#endif
 }
 
 void *ApplicationManager_NewData(ApplicationManager *appMan, u32 size, enum HeapID heapID)
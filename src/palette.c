@@ -4,6 +4,8 @@
 #include <nitro.h>
 #else
 #include "platform/platform_types.h"
+#include "platform/pal_background.h"
+#include "platform/pal_sprite.h"
 #endif
 #include <string.h>
 
@@ -373,7 +375,8 @@ void PaletteData_CommitFadedBuffers(PaletteData *paletteData)
             #ifdef PLATFORM_DS
             GX_LoadBGPltt(paletteData->buffers[bufferID].faded, 0, paletteData->buffers[bufferID].size);
             #else
-            // TODO: Port GX_LoadBGPltt to PAL
+            // Only the sub-palettes whose colors changed get re-packed and re-decoded
+            PAL_Bg_LoadScreenPalette(PAL_SCREEN_MAIN, paletteData->buffers[bufferID].faded, paletteData->buffers[bufferID].size, 0);
             #endif
             break;
 
@@ -381,7 +384,7 @@ void PaletteData_CommitFadedBuffers(PaletteData *paletteData)
             #ifdef PLATFORM_DS
             GXS_LoadBGPltt(paletteData->buffers[bufferID].faded, 0, paletteData->buffers[bufferID].size);
             #else
-            // TODO: Port GXS_LoadBGPltt to PAL
+            PAL_Bg_LoadScreenPalette(PAL_SCREEN_SUB, paletteData->buffers[bufferID].faded, paletteData->buffers[bufferID].size, 0);
             #endif
             break;
 
@@ -389,7 +392,7 @@ void PaletteData_CommitFadedBuffers(PaletteData *paletteData)
             #ifdef PLATFORM_DS
             GX_LoadOBJPltt(paletteData->buffers[bufferID].faded, 0, paletteData->buffers[bufferID].size);
             #else
-            // TODO: Port GX_LoadOBJPltt to PAL
+            PAL_Sprite_LoadScreenPalette(PAL_SCREEN_MAIN, paletteData->buffers[bufferID].faded, paletteData->buffers[bufferID].size, 0);
             #endif
             break;
 
@@ -397,7 +400,7 @@ void PaletteData_CommitFadedBuffers(PaletteData *paletteData)
             #ifdef PLATFORM_DS
             GXS_LoadOBJPltt(paletteData->buffers[bufferID].faded, 0, paletteData->buffers[bufferID].size);
             #else
-            // TODO: Port GXS_LoadOBJPltt to PAL
+            PAL_Sprite_LoadScreenPalette(PAL_SCREEN_SUB, paletteData->buffers[bufferID].faded, paletteData->buffers[bufferID].size, 0);
             #endif
             break;
 
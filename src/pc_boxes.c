@@ -26,6 +26,43 @@ typedef struct PCBoxes {
 
 static void PCBoxes_InitInternal(PCBoxes *pcBoxes);
 
+#ifndef PLATFORM_DS
+#define BOX_INDEX_SLOTS (MAX_PC_BOXES * MAX_MONS_PER_BOX)
+
+enum BoxIndexFlag {
+    BOX_INDEX_CURRENT = 1 << 0,
+    BOX_INDEX_EXISTS = 1 << 1,
+    BOX_INDEX_EGG = 1 << 2,
+    BOX_INDEX_SHINY = 1 << 3,
+    BOX_INDEX_CHECKSUM_VALID = 1 << 4,
+};
+
+/*
+ * Plaintext summary of every box slot of one PCBoxes, so that counts and
+ * empty slot searches are array scans instead of 540 decrypts. Not part of
+ * the save data; SDL port only.
+ *
+ * Each entry keeps a copy of the BoxPokemon it was built from. The PCBoxes
+ * functions below refresh entries as they write. Writes made elsewhere
+ * (through a PCBoxes_GetBoxMonAt pointer, a decryption context or a save
+ * load) cannot be tracked, so every lookup compares the slot against its
+ * copy and rebuilds the entry if any byte differs. The header checksum alone
+ * is not enough for this: it is a sum of halfwords, which an edit touching
+ * several of them can leave unchanged.
+ */
+typedef struct PCBoxesIndex {
+    const PCBoxes *pcBoxes;
+    BoxPokemon stamps[BOX_INDEX_SLOTS];
+    u16 species[BOX_INDEX_SLOTS];
+    u16 heldItems[BOX_INDEX_SLOTS];
+    u8 forms[BOX_INDEX_SLOTS];
+    u8 levels[BOX_INDEX_SLOTS];
+    u8 flags[BOX_INDEX_SLOTS];
+} PCBoxesIndex;
+
+static PCBoxesIndex sBoxIndex;
+#endif
+
 void PCBoxes_Init(PCBoxes *pcBoxes)
 {
     PCBoxes_InitInternal(pcBoxes);
@@ -37,6 +74,124 @@ u32 PCBoxes_SaveSize(void)
     return sizeof(PCBoxes);
 }
 
+#ifndef PLATFORM_DS
+static void BoxIndex_Bind(const PCBoxes *pcBoxes)
+{
+    if (sBoxIndex.pcBoxes != pcBoxes) {
+        sBoxIndex.pcBoxes = pcBoxes;
+        memset(sBoxIndex.flags, 0, sizeof(sBoxIndex.flags));
+    }
+}
+
+static void BoxIndex_Update(const PCBoxes *pcBoxes, u32 boxID, u32 monPosInBox)
+{
+    static const enum PokemonDataParam params[] = {
+        MON_DATA_SPECIES_EXISTS,
+        MON_DATA_SPECIES,
+        MON_DATA_FORM,
+        MON_DATA_IS_EGG,
+        MON_DATA_LEVEL,
+        MON_DATA_HELD_ITEM,
+        MON_DATA_OT_ID,
+        MON_DATA_CHECKSUM_FAILED,
+    };
+
+    BoxPokemon *boxMon = (BoxPokemon *)&pcBoxes->boxMons[boxID][monPosInBox];
+    u32 slot = boxID * MAX_MONS_PER_BOX + monPosInBox;
+    u32 values[NELEMS(params)];
+
+    BoxIndex_Bind(pcBoxes);
+    BoxPokemon_GetValues(boxMon, params, values, NELEMS(params));
+
+    u8 flags = 0;
+
+    // A mon in the middle of a decryption context gets its header rewritten
+    // when the context ends, so its summary is only good for this lookup
+    if (boxMon->boxDecrypted == FALSE && boxMon->partyDecrypted == FALSE) {
+        flags |= BOX_INDEX_CURRENT;
+    }
+
+    if (values[0]) {
+        flags |= BOX_INDEX_EXISTS;
+
+        if (Pokemon_IsPersonalityShiny(values[6], boxMon->personality)) {
+            flags |= BOX_INDEX_SHINY;
+        }
+    }
+
+    if (values[3]) {
+        flags |= BOX_INDEX_EGG;
+    }
+
+    if (values[7] == FALSE) {
+        flags |= BOX_INDEX_CHECKSUM_VALID;
+    }
+
+    memcpy(&sBoxIndex.stamps[slot], boxMon, sizeof(BoxPokemon));
+    sBoxIndex.species[slot] = values[1];
+    sBoxIndex.forms[slot] = values[2];
+    sBoxIndex.levels[slot] = values[4];
+    sBoxIndex.heldItems[slot] = values[5];
+    sBoxIndex.flags[slot] = flags;
+}
+
+static u8 BoxIndex_GetFlags(const PCBoxes *pcBoxes, u32 boxID, u32 monPosInBox)
+{
+    u32 slot = boxID * MAX_MONS_PER_BOX + monPosInBox;
+
+    BoxIndex_Bind(pcBoxes);
+
+    if ((sBoxIndex.flags[slot] & BOX_INDEX_CURRENT) == 0
+        || memcmp(&sBoxIndex.stamps[slot], &pcBoxes->boxMons[boxID][monPosInBox], sizeof(BoxPokemon)) != 0) {
+        BoxIndex_Update(pcBoxes, boxID, monPosInBox);
+    }
+
+    return sBoxIndex.flags[slot];
+}
+
+static BOOL BoxIndex_MonExists(const PCBoxes *pcBoxes, u32 boxID, u32 monPosInBox)
+{
+    return (BoxIndex_GetFlags(pcBoxes, boxID, monPosInBox) & BOX_INDEX_EXISTS) != 0;
+}
+
+static u16 BoxIndex_GetSpecies(const PCBoxes *pcBoxes, u32 boxID, u32 monPosInBox)
+{
+    BoxIndex_GetFlags(pcBoxes, boxID, monPosInBox);
+    return sBoxIndex.species[boxID * MAX_MONS_PER_BOX + monPosInBox];
+}
+
+void PCBoxes_RebuildIndex(const PCBoxes *pcBoxes)
+{
+    for (u32 boxID = 0; boxID < MAX_PC_BOXES; boxID++) {
+        for (u32 monPosInBox = 0; monPosInBox < MAX_MONS_PER_BOX; monPosInBox++) {
+            BoxIndex_Update(pcBoxes, boxID, monPosInBox);
+        }
+    }
+}
+
+void PCBoxes_GetSlotSummary(const PCBoxes *pcBoxes, u32 boxID, u32 monPosInBox, PCBoxSlotSummary *summary)
+{
+    if (boxID == USE_CURRENT_BOX) {
+        boxID = pcBoxes->currentBoxID;
+    }
+
+    GF_ASSERT(boxID < MAX_PC_BOXES);
+    GF_ASSERT(monPosInBox < MAX_MONS_PER_BOX);
+
+    u32 slot = boxID * MAX_MONS_PER_BOX + monPosInBox;
+    u8 flags = BoxIndex_GetFlags(pcBoxes, boxID, monPosInBox);
+
+    summary->species = sBoxIndex.species[slot];
+    summary->heldItem = sBoxIndex.heldItems[slot];
+    summary->form = sBoxIndex.forms[slot];
+    summary->level = sBoxIndex.levels[slot];
+    summary->exists = (flags & BOX_INDEX_EXISTS) != 0;
+    summary->isEgg = (flags & BOX_INDEX_EGG) != 0;
+    summary->isShiny = (flags & BOX_INDEX_SHINY) != 0;
+    summary->checksumValid = (flags & BOX_INDEX_CHECKSUM_VALID) != 0;
+}
+#endif
+
 static void PCBoxes_InitInternal(PCBoxes *pcBoxes)
 {
     u32 boxID, i;
@@ -46,6 +201,10 @@ static void PCBoxes_InitInternal(PCBoxes *pcBoxes)
         }
     }
 
+#ifndef PLATFORM_DS
+    PCBoxes_RebuildIndex(pcBoxes);
+#endif
+
     for (boxID = 0, i = 0; boxID < MAX_PC_BOXES; boxID++) {
         pcBoxes->wallpapers[boxID] = i++;
 
@@ -99,8 +258,15 @@ BOOL PCBoxes_TryStoreBoxMonInBox(PCBoxes *pcBoxes, u32 boxID, BoxPokemon *boxMon
     }
 
     for (monPosInBox = 0; monPosInBox < MAX_MONS_PER_BOX; monPosInBox++) {
+#ifndef PLATFORM_DS
+        if (BoxIndex_GetSpecies(pcBoxes, boxID, monPosInBox) == SPECIES_NONE) {
+#else
         if (BoxPokemon_GetValue(&pcBoxes->boxMons[boxID][monPosInBox], MON_DATA_SPECIES, NULL) == SPECIES_NONE) {
+#endif
             pcBoxes->boxMons[boxID][monPosInBox] = *boxMon;
+#ifndef PLATFORM_DS
+            BoxIndex_Update(pcBoxes, boxID, monPosInBox);
+#endif
             SaveData_SetFullSaveRequired();
             return TRUE;
         }
@@ -120,6 +286,9 @@ BOOL PCBoxes_TryStoreBoxMonAt(PCBoxes *pcBoxes, u32 boxID, u32 monPosInBox, BoxP
 
     if (boxID < MAX_PC_BOXES && monPosInBox < MAX_MONS_PER_BOX) {
         pcBoxes->boxMons[boxID][monPosInBox] = *boxMon;
+#ifndef PLATFORM_DS
+        BoxIndex_Update(pcBoxes, boxID, monPosInBox);
+#endif
         SaveData_SetFullSaveRequired();
         return TRUE;
     } else {
@@ -137,6 +306,9 @@ void PCBoxes_InitBoxMonAt(PCBoxes *pcBoxes, u32 boxID, u32 monPosInBox)
 
     if (monPosInBox < MAX_MONS_PER_BOX && boxID < MAX_PC_BOXES) {
         BoxPokemon_Init(&pcBoxes->boxMons[boxID][monPosInBox]);
+#ifndef PLATFORM_DS
+        BoxIndex_Update(pcBoxes, boxID, monPosInBox);
+#endif
         SaveData_SetFullSaveRequired();
     } else {
         GF_ASSERT(0);
@@ -154,7 +326,11 @@ u32 PCBoxes_FirstEmptyBox(const PCBoxes *pcBoxes)
 
     while (TRUE) {
         for (int monPosInBox = 0; monPosInBox < MAX_MONS_PER_BOX; monPosInBox++) {
+#ifndef PLATFORM_DS
+            if (BoxIndex_MonExists(pcBoxes, boxID, monPosInBox) == FALSE) {
+#else
             if (BoxPokemon_GetValue(&pcBoxes->boxMons[boxID][monPosInBox], MON_DATA_SPECIES_EXISTS, NULL) == 0) {
+#endif
                 return boxID;
             }
         }
@@ -182,7 +358,11 @@ BOOL PCBoxes_TryGetNextAvailableSpace(const PCBoxes *pcBoxes, int *boxIndexDest,
 
     while (TRUE) {
         for (; monPosInBox < MAX_MONS_PER_BOX; monPosInBox++) {
+#ifndef PLATFORM_DS
+            if (BoxIndex_MonExists(pcBoxes, boxID, monPosInBox) == FALSE) {
+#else
             if (BoxPokemon_GetValue(&pcBoxes->boxMons[boxID][monPosInBox], MON_DATA_SPECIES_EXISTS, NULL) == FALSE) {
+#endif
                 *boxIndexDest = boxID;
                 *monPosInBoxDest = monPosInBox;
                 return TRUE;
@@ -210,7 +390,11 @@ u32 PCBoxes_CountAllBoxMons(const PCBoxes *pcBoxes)
 
     for (boxID = 0; boxID < MAX_PC_BOXES; boxID++) {
         for (monPosInBox = 0; monPosInBox < MAX_MONS_PER_BOX; monPosInBox++) {
+#ifndef PLATFORM_DS
+            if (BoxIndex_MonExists(pcBoxes, boxID, monPosInBox)) {
+#else
             if (BoxPokemon_GetValue(&pcBoxes->boxMons[boxID][monPosInBox], MON_DATA_SPECIES_EXISTS, NULL)) {
+#endif
                 count++;
             }
         }
@@ -292,7 +476,11 @@ u32 PCBoxes_CountMonsInBox(const PCBoxes *pcBoxes, u32 boxID)
         u32 count = 0;
 
         for (int monPosInBox = 0; monPosInBox < MAX_MONS_PER_BOX; monPosInBox++) {
+#ifndef PLATFORM_DS
+            if (BoxIndex_MonExists(pcBoxes, boxID, monPosInBox)) {
+#else
             if (BoxPokemon_GetValue(&pcBoxes->boxMons[boxID][monPosInBox], MON_DATA_SPECIES_EXISTS, NULL)) {
+#endif
                 count++;
             }
         }
@@ -314,6 +502,13 @@ u32 PCBoxes_CountNonEggMonsInBox(const PCBoxes *pcBoxes, u32 boxID)
     if (boxID < MAX_PC_BOXES) {
         u32 count = 0;
 
+#ifndef PLATFORM_DS
+        for (int monPosInBox = 0; monPosInBox < MAX_MONS_PER_BOX; monPosInBox++) {
+            if ((BoxIndex_GetFlags(pcBoxes, boxID, monPosInBox) & (BOX_INDEX_EXISTS | BOX_INDEX_EGG)) == BOX_INDEX_EXISTS) {
+                count++;
+            }
+        }
+#else
         for (int monPosInBox = 0; monPosInBox < MAX_MONS_PER_BOX; monPosInBox++) {
             if (BoxPokemon_GetValue(&pcBoxes->boxMons[boxID][monPosInBox], MON_DATA_SPECIES_EXISTS, NULL)) {
                 if (BoxPokemon_GetValue(&pcBoxes->boxMons[boxID][monPosInBox], MON_DATA_IS_EGG, NULL) == FALSE) {
@@ -321,6 +516,7 @@ u32 PCBoxes_CountNonEggMonsInBox(const PCBoxes *pcBoxes, u32 boxID)
                 }
             }
         }
+#endif
 
         return count;
     } else {
@@ -363,6 +559,9 @@ void PCBoxes_SetBoxMonData(PCBoxes *pcBoxes, u32 boxID, u32 slot, enum PokemonDa
     }
 
     BoxPokemon_SetValue((&pcBoxes->boxMons[boxID][slot]), pokemonData, value);
+#ifndef PLATFORM_DS
+    BoxIndex_Update(pcBoxes, boxID, slot);
+#endif
     SaveData_SetFullSaveRequired();
 }
 
@@ -10,9 +10,18 @@
 #include "platform/pal_graphics.h"
 #include "platform/pal_input.h"
 #include "platform/pal_audio.h"
+#include "platform/pal_archive.h"
+#include "platform/pal_asset_cache.h"
+#include "platform/pal_async_load.h"
+#include "platform/pal_file.h"
 #include "platform/pal_timer.h"
 #include "platform/pal_background.h"
 #include "platform/pal_sprite.h"
+#include "platform/pal_compositor.h"
+#include "platform/pal_frame_dump.h"
+#include "platform/pal_frame_pacer.h"
+#include "platform/pal_task_profiler.h"
+#include "platform/pal_heap_profiler.h"
 
 #include <SDL3/SDL.h>
 #include <stdio.h>
@@ -23,6 +32,7 @@
 #include "constants/heap.h"
 #include "brightness_controller.h"
 #include "font.h"
+#include "heap.h"
 #include "game_start.h"
 #include "main.h"
 #include "overlay_manager.h"
@@ -38,6 +48,7 @@ const u8 gGameVersion = 12; // VERSION_PLATINUM
 #include "unk_0202CC64.h"
 #include "screen_fade.h"
 #include "sound_system.h"
+#include "species_table.h"
 #include "sys_task_manager.h"
 #include "system.h"
 #include "timer.h"
@@ -57,8 +68,79 @@ FS_EXTERN_OVERLAY(game_start);
 FS_EXTERN_OVERLAY(game_opening);
 
 int main(int argc, char* argv[]) {
-    (void)argc;  // Unused
-    (void)argv;  // Unused
+    BOOL indexedColor = FALSE;
+    BOOL headless = FALSE;
+    BOOL vsync = FALSE;
+    BOOL uncapped = FALSE;
+    const char* dumpDir = NULL;
+    PAL_FrameDumpFormat dumpFormat = PAL_FRAME_DUMP_PNG;
+    u32 dumpInterval = 1;
+    u64 maxFrames = 0;  // 0 = run until quit
+    const char* assetPackPath = NULL;
+    int loadThreads = -1;
+    BOOL heapStats = FALSE;
+#ifdef PAL_TASK_PROFILER
+    BOOL profileTasks = FALSE;
+    const char* taskTracePath = NULL;
+#endif
+#ifdef PAL_HEAP_PROFILER
+    BOOL profileHeaps = FALSE;
+    const char* heapProfilePath = NULL;
+#endif
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--indexed-color") == 0) {
+            indexedColor = TRUE;
+        } else if (strcmp(argv[i], "--headless") == 0) {
+            headless = TRUE;
+        } else if (strcmp(argv[i], "--vsync") == 0) {
+            vsync = TRUE;
+        } else if (strcmp(argv[i], "--uncapped") == 0) {
+            uncapped = TRUE;
+        } else if (strcmp(argv[i], "--dump-frames") == 0 && i + 1 < argc) {
+            dumpDir = argv[++i];
+        } else if (strcmp(argv[i], "--dump-format") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "raw") == 0) {
+                dumpFormat = PAL_FRAME_DUMP_RAW;
+            } else if (strcmp(argv[i], "png") == 0) {
+                dumpFormat = PAL_FRAME_DUMP_PNG;
+            } else {
+                fprintf(stderr, "Unknown dump format '%s' (expected raw or png)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--dump-every") == 0 && i + 1 < argc) {
+            dumpInterval = (u32)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            maxFrames = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--filesys") == 0 && i + 1 < argc) {
+            PAL_Archive_SetRootDir(argv[++i]);
+        } else if (strcmp(argv[i], "--asset-pack") == 0 && i + 1 < argc) {
+            assetPackPath = argv[++i];
+        } else if (strcmp(argv[i], "--load-threads") == 0 && i + 1 < argc) {
+            loadThreads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--asset-cache-mb") == 0 && i + 1 < argc) {
+            PAL_AssetCache_SetBudget((size_t)strtoul(argv[++i], NULL, 10) * 1024 * 1024);
+        } else if (strcmp(argv[i], "--heap-stats") == 0) {
+            heapStats = TRUE;
+        }
+#ifdef PAL_TASK_PROFILER
+        else if (strcmp(argv[i], "--profile-tasks") == 0) {
+            profileTasks = TRUE;
+        } else if (strcmp(argv[i], "--task-trace") == 0 && i + 1 < argc) {
+            profileTasks = TRUE;
+            taskTracePath = argv[++i];
+        }
+#endif
+#ifdef PAL_HEAP_PROFILER
+        else if (strcmp(argv[i], "--profile-heaps") == 0) {
+            profileHeaps = TRUE;
+        } else if (strcmp(argv[i], "--heap-profile") == 0 && i + 1 < argc) {
+            profileHeaps = TRUE;
+            heapProfilePath = argv[++i];
+        }
+#endif
+    }
     
     printf("========================================\n");
     printf("Pokemon Platinum SDL3 Port\n");
@@ -67,11 +149,57 @@ int main(int argc, char* argv[]) {
     
     // Step 1: Initialize SDL3 subsystems
     printf("Initializing SDL3...\n");
-    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_EVENTS | SDL_INIT_GAMEPAD)) {
+    SDL_InitFlags sdlFlags = SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_EVENTS | SDL_INIT_GAMEPAD;
+    
+    if (headless) {
+        // No display, no GPU, no sound card: render in software and mix
+        // audio into the dummy driver (SDL_AUDIO_DRIVER still overrides it)
+        sdlFlags = SDL_INIT_AUDIO | SDL_INIT_EVENTS;
+        SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+        PAL_Graphics_SetBackend(PAL_GRAPHICS_BACKEND_HEADLESS);
+        printf("  - Headless mode\n");
+    }
+    
+    if (!SDL_Init(sdlFlags)) {
         fprintf(stderr, "Failed to initialize SDL3: %s\n", SDL_GetError());
         return 1;
     }
     
+#ifdef PAL_TASK_PROFILER
+    // Before InitSystem, which names the task managers
+    if (profileTasks && !PAL_TaskProfiler_Init(10, taskTracePath ? 1 << 20 : 0)) {
+        fprintf(stderr, "Failed to allocate the task trace buffer\n");
+        SDL_Quit();
+        return 1;
+    }
+#endif
+#ifdef PAL_HEAP_PROFILER
+    // Before InitSystem, which creates the root heaps
+    if (profileHeaps && !PAL_HeapProfiler_Init(heapProfilePath ? 1 << 20 : 0)) {
+        fprintf(stderr, "Failed to allocate the heap profiler tables\n");
+        SDL_Quit();
+        return 1;
+    }
+#endif
+    
+    // Converted assets come from the asset pack when there is one, and from
+    // loose files under resources/graphics otherwise
+    if (assetPackPath) {
+        if (!PAL_AssetPack_Open(assetPackPath)) {
+            fprintf(stderr, "Failed to open asset pack %s\n", assetPackPath);
+            SDL_Quit();
+            return 1;
+        }
+    } else if (PAL_Path_Exists(PAL_ASSET_PACK_DEFAULT_PATH)) {
+        PAL_AssetPack_Open(PAL_ASSET_PACK_DEFAULT_PATH);
+    }
+    
+    // Field streaming reads archives on these threads; with 0 they are read
+    // on the main thread when the read is submitted
+    if (loadThreads != 0) {
+        PAL_AsyncLoad_Init(loadThreads > 0 ? (u32)loadThreads : 0);
+    }
+    
     // Step 2: Initialize game systems (mirrors NitroMain)
     printf("Initializing game systems...\n");
     
@@ -79,6 +207,21 @@ int main(int argc, char* argv[]) {
     InitSystem();
     printf("  - System initialized\n");
     
+    // Resolve BG/sprite palettes at draw time instead of re-decoding on fades
+    if (indexedColor && !PAL_Graphics_SetColorMode(PAL_GRAPHICS_COLOR_INDEXED)) {
+        printf("  - Indexed color not supported by this renderer, using direct color\n");
+    }
+    
+    if (dumpDir) {
+        if (!PAL_FrameDump_Start(dumpDir, dumpFormat, dumpInterval)) {
+            fprintf(stderr, "Failed to start frame dump to %s\n", dumpDir);
+            PAL_Graphics_Shutdown();
+            SDL_Quit();
+            return 1;
+        }
+        printf("  - Dumping frames to %s\n", dumpDir);
+    }
+    
     // InitVRAM() - SDL stub, initializes PAL graphics memory
     InitVRAM();
     printf("  - VRAM initialized\n");
@@ -109,6 +252,19 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
+    // Pace the loop at the DS refresh rate. Headless runs are
+    // throughput-bound, so they never wait.
+    PAL_FramePacer_Init(PAL_FRAME_PACER_DS_REFRESH_HZ);
+    if (uncapped || headless) {
+        PAL_FramePacer_SetMode(PAL_PACE_UNCAPPED);
+    } else if (vsync) {
+        if (PAL_Graphics_SetVSync(TRUE)) {
+            PAL_FramePacer_SetMode(PAL_PACE_VSYNC);
+        } else {
+            printf("  - VSync not available, using timed pacing\n");
+        }
+    }
+    
     printf("  - PAL subsystems ready\n");
     
     // Step 3: Continue with game initialization (from NitroMain)
@@ -118,6 +274,12 @@ int main(int argc, char* argv[]) {
     InitRTC();
     printf("  - RTC initialized\n");
     
+    // Species data, experience tables, learnsets and evolutions stay
+    // resident for the whole run
+    if (SpeciesTable_Load()) {
+        printf("  - Species tables loaded\n");
+    }
+    
     // Initialize fonts
     Fonts_Init();
     Font_InitManager(FONT_SYSTEM, HEAP_ID_APPLICATION);
@@ -162,6 +324,7 @@ int main(int argc, char* argv[]) {
     printf("  Arrow Keys - D-Pad\n");
     printf("  Z/Enter    - A Button\n");
     printf("  X/Backspace- B Button\n");
+    printf("  Tab (hold) - Fast-forward\n");
     printf("  ESC        - Quit\n\n");
     
     // Step 5: Main game loop (from NitroMain)
@@ -170,7 +333,12 @@ int main(int argc, char* argv[]) {
     
     printf("Entering main game loop...\n");
     
+    u64 loop_start = PAL_Timer_GetPerformanceCounter();
+    u64 next_report_ms = PAL_Timer_GetTicks() + 1000;
+    
     while (running) {
+        PAL_FramePacer_BeginPhase(PAL_FRAME_PHASE_INPUT);
+        
         // Handle SDL events
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
@@ -181,6 +349,16 @@ int main(int argc, char* argv[]) {
                 running = FALSE;
             }
             
+            // Hold Tab to run uncapped
+            if ((event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP)
+                && event.key.scancode == SDL_SCANCODE_TAB && !event.key.repeat) {
+                BOOL fastForward = event.type == SDL_EVENT_KEY_DOWN;
+                PAL_FramePacer_SetFastForward(fastForward);
+                if (PAL_FramePacer_GetMode() == PAL_PACE_VSYNC) {
+                    PAL_Graphics_SetVSync(!fastForward);
+                }
+            }
+            
             // Handle gamepad connection/disconnection
             if (event.type == SDL_EVENT_GAMEPAD_ADDED) {
                 SDL_Gamepad* gamepad = SDL_OpenGamepad(event.gdevice.which);
@@ -199,6 +377,8 @@ int main(int argc, char* argv[]) {
         // Read input (replaces ReadKeypadAndTouchpad)
         PAL_Input_Update();
         
+        PAL_FramePacer_EndPhase(PAL_FRAME_PHASE_INPUT);
+        
         // TODO: Check for soft reset combo
         // if ((gSystem.heldKeysRaw & RESET_COMBO) == RESET_COMBO && !gSystem.inhibitReset) {
         //     SoftReset(RESET_CLEAN);
@@ -208,23 +388,31 @@ int main(int argc, char* argv[]) {
         // For now, assume it always returns TRUE
         
         // Begin frame rendering
+        PAL_FramePacer_BeginPhase(PAL_FRAME_PHASE_RENDER);
         PAL_Graphics_BeginFrame();
+        PAL_FramePacer_EndPhase(PAL_FRAME_PHASE_RENDER);
         
         // Run the application (this calls the current game screen)
         // TODO: Call RunApplication() from main.c
         // RunApplication();
         
         // Execute task managers
+        PAL_FramePacer_BeginPhase(PAL_FRAME_PHASE_TASKS);
         SysTaskManager_ExecuteTasks(gSystem.mainTaskMgr);
         SysTaskManager_ExecuteTasks(gSystem.printTaskMgr);
+        PAL_FramePacer_EndPhase(PAL_FRAME_PHASE_TASKS);
         
-        // Render PAL subsystems
-        // TODO: Render backgrounds and sprites when they're set up
-        // PAL_Bg_RenderAll(bgConfig);
-        // PAL_Sprite_RenderAll(spriteManager);
+        // Compose backgrounds and sprites of both screens in one pass
+        PAL_FramePacer_BeginPhase(PAL_FRAME_PHASE_RENDER);
+        PAL_Compositor_ComposeFrame();
+        PAL_FramePacer_EndPhase(PAL_FRAME_PHASE_RENDER);
         
         // End frame rendering
+        PAL_FramePacer_BeginPhase(PAL_FRAME_PHASE_PRESENT);
         PAL_Graphics_EndFrame();
+        PAL_FramePacer_EndPhase(PAL_FRAME_PHASE_PRESENT);
+        
+        PAL_FramePacer_BeginPhase(PAL_FRAME_PHASE_TASKS);
         
         // VBlank handling
         if (!gSystem.frameCounter) {
@@ -236,9 +424,12 @@ int main(int argc, char* argv[]) {
         PlayTime_IncrementTimer();
         sub_020241CC();
         SysTaskManager_ExecuteTasks(gSystem.printTaskMgr);
+        PAL_FramePacer_EndPhase(PAL_FRAME_PHASE_TASKS);
+        
+        // Wait for VBlank
+        PAL_FramePacer_WaitForNextFrame();
         
-        // Wait for VBlank (SDL: just delay for frame timing)
-        PAL_Timer_Delay(16);  // ~60 FPS
+        PAL_FramePacer_BeginPhase(PAL_FRAME_PHASE_TASKS);
         
         gSystem.vblankCounter++;
         gSystem.frameCounter = 0;
@@ -255,17 +446,69 @@ int main(int argc, char* argv[]) {
         // Sound system tick
         SoundSystem_Tick();
         SysTaskManager_ExecuteTasks(gSystem.postVBlankTaskMgr);
+        PAL_FramePacer_EndPhase(PAL_FRAME_PHASE_TASKS);
+        
+#ifdef PAL_TASK_PROFILER
+        PAL_TaskProfiler_EndFrame();
+#endif
+#ifdef PAL_HEAP_PROFILER
+        PAL_HeapProfiler_EndFrame();
+#endif
         
         frame_count++;
         
-        // Debug output every 60 frames
-        if (frame_count % 60 == 0) {
-            printf("Frame %llu - Running\n", (unsigned long long)frame_count);
+        // Report throughput once per second, however fast frames run
+        if (PAL_Timer_GetTicks() >= next_report_ms) {
+            printf("Frame %llu - %.1f FPS\n", (unsigned long long)frame_count, PAL_Graphics_GetFrameRate());
+            next_report_ms = PAL_Timer_GetTicks() + 1000;
+        }
+        
+        if (maxFrames != 0 && frame_count >= maxFrames) {
+            running = FALSE;
         }
     }
     
+    double elapsed = (double)(PAL_Timer_GetPerformanceCounter() - loop_start) / (double)PAL_Timer_GetPerformanceFrequency();
+    
     printf("\nShutting down...\n");
     printf("Total frames: %llu\n", (unsigned long long)frame_count);
+    if (elapsed > 0.0) {
+        printf("Average: %.1f FPS over %.2f s\n", (double)frame_count / elapsed, elapsed);
+    }
+    PAL_FramePacer_PrintSummary();
+    PAL_AssetCache_PrintSummary();
+    if (heapStats) {
+        Heap_PrintStats();
+    }
+#ifdef PAL_TASK_PROFILER
+    if (PAL_TaskProfiler_IsEnabled()) {
+        PAL_TaskProfiler_PrintSummary();
+        if (taskTracePath) {
+            if (PAL_TaskProfiler_WriteChromeTrace(taskTracePath)) {
+                printf("Task trace written to %s\n", taskTracePath);
+            } else {
+                fprintf(stderr, "Failed to write task trace to %s\n", taskTracePath);
+            }
+        }
+        PAL_TaskProfiler_Shutdown();
+    }
+#endif
+#ifdef PAL_HEAP_PROFILER
+    if (PAL_HeapProfiler_IsEnabled()) {
+        PAL_HeapProfiler_PrintSummary();
+        if (heapProfilePath) {
+            if (PAL_HeapProfiler_WriteJSON(heapProfilePath)) {
+                printf("Heap profile written to %s\n", heapProfilePath);
+            } else {
+                fprintf(stderr, "Failed to write heap profile to %s\n", heapProfilePath);
+            }
+        }
+    }
+#endif
+    if (dumpDir) {
+        printf("Frames dumped: %u\n", PAL_FrameDump_GetWrittenCount());
+        PAL_FrameDump_Stop();
+    }
     
     // Cleanup game systems
     // TODO: Proper cleanup of save data, fonts, etc.
@@ -275,6 +518,13 @@ int main(int argc, char* argv[]) {
     PAL_Audio_Shutdown();
     PAL_Input_Shutdown();
     PAL_Graphics_Shutdown();
+    PAL_AsyncLoad_Shutdown();
+    PAL_AssetPack_Close();
+    PAL_AssetCache_Shutdown();
+#ifdef PAL_HEAP_PROFILER
+    // Last, once no other thread can be allocating
+    PAL_HeapProfiler_Shutdown();
+#endif
     SDL_Quit();
     
     printf("Clean shutdown complete!\n");
@@ -0,0 +1,260 @@
+/**
+ * @file pal_archive_sdl.c
+ * @brief SDL3 implementation of memory-mapped NARC archives
+ *
+ * NARC layout (all values little-endian):
+ *   header  "NARC", BOM, version, file size, u16 header size, u16 chunk count
+ *   BTAF    "BTAF", chunk size, u16 member count, u16 pad, {u32 start, u32 end}[]
+ *   BTNF    "BTNF", chunk size, name table (unused here)
+ *   GMIF    "GMIF", chunk size, member data (BTAF offsets are relative to it)
+ */
+
+#include "platform/pal_archive.h"
+#include "platform/pal_file.h"
+#include "platform/pal_memory.h"
+
+#ifdef PLATFORM_SDL
+
+#include <stdio.h>
+#include <string.h>
+
+#define ARCHIVE_PATH_MAX 512
+
+#define NARC_HEADER_SIZE_OFFSET 12
+#define CHUNK_HEADER_SIZE 8
+#define BTAF_ENTRIES_OFFSET 12
+
+typedef struct {
+    u32 start;      // Absolute file offsets
+    u32 end;
+} ArchiveMember;
+
+struct PAL_Archive {
+    const u8* data;
+    u32 size;
+    BOOL mapped;        // FALSE if data was read into a heap buffer
+    ArchiveMember* members;
+    u32 num_members;
+};
+
+static char g_archiveRoot[ARCHIVE_PATH_MAX] = PAL_ARCHIVE_DEFAULT_ROOT;
+
+void PAL_Archive_SetRootDir(const char* dir) {
+    if (dir) {
+        snprintf(g_archiveRoot, sizeof(g_archiveRoot), "%s", dir);
+    }
+}
+
+const char* PAL_Archive_GetRootDir(void) {
+    return g_archiveRoot;
+}
+
+static u32 ReadU32LE(const u8* p) {
+    return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16) | ((u32)p[3] << 24);
+}
+
+static u16 ReadU16LE(const u8* p) {
+    return (u16)(p[0] | (p[1] << 8));
+}
+
+// ============================================================================
+// Mapping
+// ============================================================================
+
+static BOOL MapFile(PAL_Archive* archive, const char* path) {
+    size_t size;
+    const u8* data = PAL_File_Map(path, &size);
+    
+    if (!data) {
+        return FALSE;
+    }
+    
+    if (size > 0xFFFFFFFFu) {
+        PAL_File_Unmap(data, size);
+        return FALSE;
+    }
+    
+    archive->data = data;
+    archive->size = (u32)size;
+    archive->mapped = TRUE;
+    return TRUE;
+}
+
+// Fallback for file systems that can't be mapped
+static BOOL ReadWholeFile(PAL_Archive* archive, const char* path) {
+    PAL_File file = PAL_File_Open(path, "rb");
+    if (!file) {
+        return FALSE;
+    }
+    
+    long size = PAL_File_Size(file);
+    u8* data = size > 0 ? PAL_Malloc((size_t)size, 0) : NULL;
+    
+    if (!data || PAL_File_Read(data, 1, (size_t)size, file) != (size_t)size) {
+        PAL_Free(data);
+        PAL_File_Close(file);
+        return FALSE;
+    }
+    
+    PAL_File_Close(file);
+    archive->data = data;
+    archive->size = (u32)size;
+    archive->mapped = FALSE;
+    return TRUE;
+}
+
+static void UnmapFile(PAL_Archive* archive) {
+    if (!archive->data) {
+        return;
+    }
+    
+    if (archive->mapped) {
+        PAL_File_Unmap(archive->data, archive->size);
+    } else {
+        PAL_Free((void*)archive->data);
+    }
+    
+    archive->data = NULL;
+}
+
+// ============================================================================
+// FAT Parsing
+// ============================================================================
+
+static BOOL CheckChunk(const PAL_Archive* archive, u32 offset, const char* magic, u32* chunkSize) {
+    if (offset > archive->size || archive->size - offset < CHUNK_HEADER_SIZE) {
+        return FALSE;
+    }
+    
+    // Some tools write the magic reversed ("FATB" for "BTAF")
+    const u8* p = archive->data + offset;
+    BOOL forward = memcmp(p, magic, 4) == 0;
+    BOOL reversed = p[0] == magic[3] && p[1] == magic[2] && p[2] == magic[1] && p[3] == magic[0];
+    
+    *chunkSize = ReadU32LE(p + 4);
+    return (forward || reversed) && *chunkSize >= CHUNK_HEADER_SIZE && *chunkSize <= archive->size - offset;
+}
+
+static BOOL ParseFAT(PAL_Archive* archive, const char* path) {
+    if (archive->size < 16 || (memcmp(archive->data, "NARC", 4) != 0 && memcmp(archive->data, "CRAN", 4) != 0)) {
+        printf("[Archive] %s is not a NARC\n", path);
+        return FALSE;
+    }
+    
+    u32 btafStart = ReadU16LE(archive->data + NARC_HEADER_SIZE_OFFSET);
+    u32 btafSize, btnfSize, gmifSize;
+    
+    if (!CheckChunk(archive, btafStart, "BTAF", &btafSize)
+        || !CheckChunk(archive, btafStart + btafSize, "BTNF", &btnfSize)
+        || !CheckChunk(archive, btafStart + btafSize + btnfSize, "GMIF", &gmifSize)) {
+        printf("[Archive] %s has a damaged chunk table\n", path);
+        return FALSE;
+    }
+    
+    u32 numMembers = ReadU16LE(archive->data + btafStart + CHUNK_HEADER_SIZE);
+    if (BTAF_ENTRIES_OFFSET + (u64)numMembers * 8 > btafSize) {
+        printf("[Archive] %s: FAT larger than its chunk\n", path);
+        return FALSE;
+    }
+    
+    u32 gmifData = btafStart + btafSize + btnfSize + CHUNK_HEADER_SIZE;
+    u32 gmifEnd = gmifData - CHUNK_HEADER_SIZE + gmifSize;
+    
+    archive->members = PAL_Malloc(sizeof(ArchiveMember) * (numMembers > 0 ? numMembers : 1), 0);
+    if (!archive->members) {
+        return FALSE;
+    }
+    
+    const u8* entry = archive->data + btafStart + BTAF_ENTRIES_OFFSET;
+    for (u32 i = 0; i < numMembers; i++, entry += 8) {
+        u32 start = ReadU32LE(entry);
+        u32 end = ReadU32LE(entry + 4);
+        
+        if (start > end || (u64)gmifData + end > gmifEnd) {
+            printf("[Archive] %s: member %u lies outside the archive\n", path, i);
+            return FALSE;
+        }
+        
+        archive->members[i].start = gmifData + start;
+        archive->members[i].end = gmifData + end;
+    }
+    
+    archive->num_members = numMembers;
+    return TRUE;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+PAL_Archive* PAL_Archive_Open(const char* path) {
+    char fullPath[ARCHIVE_PATH_MAX];
+    
+    if (!path) {
+        return NULL;
+    }
+    
+    snprintf(fullPath, sizeof(fullPath), "%s/%s", g_archiveRoot, path);
+    
+    PAL_Archive* archive = PAL_Calloc(sizeof(PAL_Archive), 0);
+    if (!archive) {
+        return NULL;
+    }
+    
+    if (!MapFile(archive, fullPath) && !ReadWholeFile(archive, fullPath)) {
+        PAL_Free(archive);
+        return NULL;
+    }
+    
+    if (!ParseFAT(archive, fullPath)) {
+        PAL_Archive_Close(archive);
+        return NULL;
+    }
+    
+    return archive;
+}
+
+void PAL_Archive_Close(PAL_Archive* archive) {
+    if (!archive) {
+        return;
+    }
+    
+    UnmapFile(archive);
+    PAL_Free(archive->members);
+    PAL_Free(archive);
+}
+
+const u8* PAL_Archive_GetData(const PAL_Archive* archive, u32* size) {
+    if (size) {
+        *size = archive->size;
+    }
+    return archive->data;
+}
+
+u32 PAL_Archive_GetMemberCount(const PAL_Archive* archive) {
+    return archive->num_members;
+}
+
+const void* PAL_Archive_GetMember(const PAL_Archive* archive, u32 index, u32* size) {
+    if (index >= archive->num_members) {
+        return NULL;
+    }
+    
+    const ArchiveMember* member = &archive->members[index];
+    if (size) {
+        *size = member->end - member->start;
+    }
+    return archive->data + member->start;
+}
+
+BOOL PAL_Archive_GetMemberRange(const PAL_Archive* archive, u32 index, u32* start, u32* end) {
+    if (index >= archive->num_members) {
+        return FALSE;
+    }
+    
+    *start = archive->members[index].start;
+    *end = archive->members[index].end;
+    return TRUE;
+}
+
+#endif // PLATFORM_SDL
@@ -0,0 +1,280 @@
+/**
+ * @file pal_asset_cache_sdl.c
+ * @brief SDL3 implementation of the decoded asset cache
+ *
+ * Entries live in a chained hash table for lookup and on a doubly linked
+ * list in recency order (head = most recently used) for eviction. Both are
+ * intrusive, so a hit is a hash, a short chain walk and a list splice.
+ */
+
+#include "platform/pal_asset_cache.h"
+#include "platform/pal_memory.h"
+
+#ifdef PLATFORM_SDL
+
+#include <stdio.h>
+#include <string.h>
+
+#define NUM_BUCKETS 1024
+
+typedef struct CacheEntry {
+    u64 key;
+    void* data;
+    u32 size;
+    u32 pins;
+    struct CacheEntry* hash_next;
+    struct CacheEntry* prev;        // Towards the most recently used
+    struct CacheEntry* next;        // Towards the least recently used
+} CacheEntry;
+
+static struct {
+    CacheEntry** buckets;
+    CacheEntry* head;
+    CacheEntry* tail;
+    size_t budget;
+    PAL_AssetCacheStats stats;
+} g_assetCache = { .budget = PAL_ASSET_CACHE_DEFAULT_BUDGET };
+
+static u64 MakeKey(u32 narcID, u32 member, PAL_AssetTransform transform) {
+    return ((u64)narcID << 40) | ((u64)member << 8) | ((u64)transform & 0xFF);
+}
+
+static u32 HashKey(u64 key) {
+    key *= 0x9E3779B97F4A7C15ull;
+    return (u32)(key >> 54);    // Top log2(NUM_BUCKETS) bits
+}
+
+static BOOL EnsureBuckets(void) {
+    if (!g_assetCache.buckets) {
+        g_assetCache.buckets = PAL_Calloc(sizeof(CacheEntry*) * NUM_BUCKETS, 0);
+    }
+    return g_assetCache.buckets != NULL;
+}
+
+static CacheEntry* FindEntry(u64 key) {
+    if (!g_assetCache.buckets) {
+        return NULL;
+    }
+    
+    CacheEntry* entry = g_assetCache.buckets[HashKey(key)];
+    while (entry && entry->key != key) {
+        entry = entry->hash_next;
+    }
+    return entry;
+}
+
+// ============================================================================
+// Recency List
+// ============================================================================
+
+static void Unlink(CacheEntry* entry) {
+    if (entry->prev) {
+        entry->prev->next = entry->next;
+    } else {
+        g_assetCache.head = entry->next;
+    }
+    
+    if (entry->next) {
+        entry->next->prev = entry->prev;
+    } else {
+        g_assetCache.tail = entry->prev;
+    }
+    
+    entry->prev = entry->next = NULL;
+}
+
+static void PushFront(CacheEntry* entry) {
+    entry->prev = NULL;
+    entry->next = g_assetCache.head;
+    
+    if (g_assetCache.head) {
+        g_assetCache.head->prev = entry;
+    } else {
+        g_assetCache.tail = entry;
+    }
+    
+    g_assetCache.head = entry;
+}
+
+// ============================================================================
+// Entry Management
+// ============================================================================
+
+static void RemoveEntry(CacheEntry* entry) {
+    CacheEntry** link = &g_assetCache.buckets[HashKey(entry->key)];
+    while (*link != entry) {
+        link = &(*link)->hash_next;
+    }
+    *link = entry->hash_next;
+    
+    Unlink(entry);
+    
+    g_assetCache.stats.bytes -= entry->size;
+    g_assetCache.stats.entries--;
+    if (entry->pins > 0) {
+        g_assetCache.stats.pinned_bytes -= entry->size;
+    }
+    
+    PAL_Free(entry->data);
+    PAL_Free(entry);
+}
+
+// Evict from the cold end until `incoming` more bytes fit, skipping pinned
+// entries. Returns FALSE if pinned entries alone leave too little room.
+static BOOL MakeRoom(size_t incoming) {
+    CacheEntry* entry = g_assetCache.tail;
+    
+    while (entry && g_assetCache.stats.bytes + incoming > g_assetCache.budget) {
+        CacheEntry* warmer = entry->prev;
+        
+        if (entry->pins == 0) {
+            RemoveEntry(entry);
+            g_assetCache.stats.evictions++;
+        }
+        
+        entry = warmer;
+    }
+    
+    return g_assetCache.stats.bytes + incoming <= g_assetCache.budget;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void PAL_AssetCache_SetBudget(size_t bytes) {
+    g_assetCache.budget = bytes;
+    MakeRoom(0);
+}
+
+const void* PAL_AssetCache_Find(u32 narcID, u32 member, PAL_AssetTransform transform, u32* size) {
+    CacheEntry* entry = FindEntry(MakeKey(narcID, member, transform));
+    
+    if (!entry) {
+        g_assetCache.stats.misses++;
+        return NULL;
+    }
+    
+    g_assetCache.stats.hits++;
+    
+    if (entry != g_assetCache.head) {
+        Unlink(entry);
+        PushFront(entry);
+    }
+    
+    if (size) {
+        *size = entry->size;
+    }
+    return entry->data;
+}
+
+BOOL PAL_AssetCache_Insert(u32 narcID, u32 member, PAL_AssetTransform transform, void* data, u32 size) {
+    u64 key = MakeKey(narcID, member, transform);
+    CacheEntry* existing = FindEntry(key);
+    
+    if (!data || (existing && existing->pins > 0)) {
+        return FALSE;
+    }
+    
+    if (existing) {
+        RemoveEntry(existing);
+    }
+    
+    if (size > g_assetCache.budget || !MakeRoom(size) || !EnsureBuckets()) {
+        g_assetCache.stats.rejected++;
+        return FALSE;
+    }
+    
+    CacheEntry* entry = PAL_Calloc(sizeof(CacheEntry), 0);
+    if (!entry) {
+        return FALSE;
+    }
+    
+    u32 bucket = HashKey(key);
+    entry->key = key;
+    entry->data = data;
+    entry->size = size;
+    entry->hash_next = g_assetCache.buckets[bucket];
+    g_assetCache.buckets[bucket] = entry;
+    PushFront(entry);
+    
+    g_assetCache.stats.bytes += size;
+    g_assetCache.stats.entries++;
+    return TRUE;
+}
+
+BOOL PAL_AssetCache_Pin(u32 narcID, u32 member, PAL_AssetTransform transform) {
+    CacheEntry* entry = FindEntry(MakeKey(narcID, member, transform));
+    
+    if (!entry) {
+        return FALSE;
+    }
+    
+    if (entry->pins++ == 0) {
+        g_assetCache.stats.pinned_bytes += entry->size;
+    }
+    return TRUE;
+}
+
+void PAL_AssetCache_Unpin(u32 narcID, u32 member, PAL_AssetTransform transform) {
+    CacheEntry* entry = FindEntry(MakeKey(narcID, member, transform));
+    
+    if (!entry || entry->pins == 0) {
+        return;
+    }
+    
+    if (--entry->pins == 0) {
+        g_assetCache.stats.pinned_bytes -= entry->size;
+        
+        // The budget may have shrunk while it was pinned
+        MakeRoom(0);
+    }
+}
+
+void PAL_AssetCache_Clear(void) {
+    CacheEntry* entry = g_assetCache.tail;
+    
+    while (entry) {
+        CacheEntry* warmer = entry->prev;
+        if (entry->pins == 0) {
+            RemoveEntry(entry);
+        }
+        entry = warmer;
+    }
+}
+
+void PAL_AssetCache_Shutdown(void) {
+    while (g_assetCache.head) {
+        RemoveEntry(g_assetCache.head);
+    }
+    
+    PAL_Free(g_assetCache.buckets);
+    g_assetCache.buckets = NULL;
+}
+
+void PAL_AssetCache_GetStats(PAL_AssetCacheStats* stats) {
+    *stats = g_assetCache.stats;
+    stats->budget = g_assetCache.budget;
+}
+
+void PAL_AssetCache_ResetStats(void) {
+    g_assetCache.stats.hits = 0;
+    g_assetCache.stats.misses = 0;
+    g_assetCache.stats.evictions = 0;
+    g_assetCache.stats.rejected = 0;
+}
+
+void PAL_AssetCache_PrintSummary(void) {
+    const PAL_AssetCacheStats* stats = &g_assetCache.stats;
+    u64 lookups = stats->hits + stats->misses;
+    
+    printf("Asset cache: %llu hits, %llu misses (%.1f%% hit rate), %llu evictions, %llu rejected\n",
+           (unsigned long long)stats->hits, (unsigned long long)stats->misses,
+           lookups ? 100.0 * stats->hits / lookups : 0.0,
+           (unsigned long long)stats->evictions, (unsigned long long)stats->rejected);
+    printf("  %u entries, %.1f of %.1f MB (%.1f MB pinned)\n", stats->entries,
+           stats->bytes / (1024.0 * 1024.0), g_assetCache.budget / (1024.0 * 1024.0),
+           stats->pinned_bytes / (1024.0 * 1024.0));
+}
+
+#endif // PLATFORM_SDL
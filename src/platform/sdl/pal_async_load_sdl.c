@@ -0,0 +1,389 @@
+/**
+ * @file pal_async_load_sdl.c
+ * @brief SDL3 implementation of background asset loading
+ *
+ * Jobs live in a fixed table. The main thread hands them to the workers
+ * through a mutex-protected FIFO; workers hand them back through a
+ * lock-free multi-producer, single-consumer stack (push with a CAS, pop
+ * everything with one exchange) that PAL_AsyncLoad_Drain reverses into
+ * completion order. The table's free list is only touched by the main
+ * thread, so it needs no locking.
+ */
+
+#include "platform/pal_async_load.h"
+#include "platform/pal_compress.h"
+
+#ifdef PLATFORM_SDL
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_WORKERS 8
+
+typedef enum {
+    JOB_FREE = 0,
+    JOB_QUEUED,         // On the work queue
+    JOB_RUNNING,        // Owned by a worker
+    JOB_DONE,           // On (or about to be pushed onto) the completion stack
+} JobState;
+
+typedef struct Job {
+    PAL_AsyncLoadRequest request;
+    PAL_AsyncLoadHandle handle;
+    SDL_AtomicInt state;
+    BOOL cancelled;                 // Main thread only
+    PAL_AsyncLoadStatus status;
+    u32 result_size;
+    struct Job* queue_next;         // Work queue, guarded by the mutex
+    struct Job* done_next;          // Completion stack
+} Job;
+
+static struct {
+    Job jobs[PAL_ASYNC_LOAD_MAX_JOBS];
+    u8 free_list[PAL_ASYNC_LOAD_MAX_JOBS];
+    u32 free_count;
+    u32 generation;
+    
+    SDL_Mutex* mutex;
+    SDL_Condition* work_ready;      // Signalled when the queue gains a job
+    SDL_Condition* job_finished;    // Broadcast when a running job ends
+    Job* queue_head;
+    Job* queue_tail;
+    BOOL quit;
+    
+    void* completed;                // Job*, most recently finished first
+    
+    SDL_Thread* workers[MAX_WORKERS];
+    u32 num_workers;
+    BOOL initialized;
+} g_asyncLoad;
+
+// ============================================================================
+// Job Execution
+// ============================================================================
+
+static void RunJob(Job* job) {
+    const PAL_AsyncLoadRequest* req = &job->request;
+    const u8* src;
+    u32 available;
+    
+    job->status = PAL_ASYNC_LOAD_FAILED;
+    job->result_size = 0;
+    
+    if (req->member == PAL_ASYNC_LOAD_FILE_OFFSET) {
+        src = PAL_Archive_GetData(req->archive, &available);
+    } else {
+        src = PAL_Archive_GetMember(req->archive, req->member, &available);
+    }
+    
+    if (!src || req->offset > available) {
+        return;
+    }
+    
+    src += req->offset;
+    available -= req->offset;
+    
+    u32 size = req->size != 0 ? req->size : available;
+    if (size > available) {
+        return;
+    }
+    
+    if (req->decompress) {
+        job->result_size = PAL_LZ_Decompress(src, size, req->dest, req->dest_capacity);
+        if (job->result_size != 0) {
+            job->status = PAL_ASYNC_LOAD_OK;
+        }
+    } else if (size <= req->dest_capacity) {
+        memcpy(req->dest, src, size);
+        job->result_size = size;
+        job->status = PAL_ASYNC_LOAD_OK;
+    }
+}
+
+static void PushCompleted(Job* job) {
+    void* head;
+    
+    do {
+        head = SDL_GetAtomicPointer(&g_asyncLoad.completed);
+        job->done_next = head;
+    } while (!SDL_CompareAndSwapAtomicPointer(&g_asyncLoad.completed, head, job));
+}
+
+static int WorkerMain(void* unused) {
+    (void)unused;
+    
+    for (;;) {
+        SDL_LockMutex(g_asyncLoad.mutex);
+        
+        while (!g_asyncLoad.queue_head && !g_asyncLoad.quit) {
+            SDL_WaitCondition(g_asyncLoad.work_ready, g_asyncLoad.mutex);
+        }
+        
+        if (g_asyncLoad.quit) {
+            SDL_UnlockMutex(g_asyncLoad.mutex);
+            return 0;
+        }
+        
+        Job* job = g_asyncLoad.queue_head;
+        g_asyncLoad.queue_head = job->queue_next;
+        if (!g_asyncLoad.queue_head) {
+            g_asyncLoad.queue_tail = NULL;
+        }
+        SDL_SetAtomicInt(&job->state, JOB_RUNNING);
+        
+        SDL_UnlockMutex(g_asyncLoad.mutex);
+        
+        RunJob(job);
+        
+        // Mark it done before publishing it; once it is on the completion
+        // stack the main thread may free the slot at any time
+        SDL_LockMutex(g_asyncLoad.mutex);
+        SDL_SetAtomicInt(&job->state, JOB_DONE);
+        SDL_BroadcastCondition(g_asyncLoad.job_finished);
+        SDL_UnlockMutex(g_asyncLoad.mutex);
+        
+        PushCompleted(job);
+    }
+}
+
+// ============================================================================
+// Job Table
+// ============================================================================
+
+static void ResetJobTable(void) {
+    memset(g_asyncLoad.jobs, 0, sizeof(g_asyncLoad.jobs));
+    
+    for (u32 i = 0; i < PAL_ASYNC_LOAD_MAX_JOBS; i++) {
+        g_asyncLoad.free_list[i] = (u8)(PAL_ASYNC_LOAD_MAX_JOBS - 1 - i);
+    }
+    g_asyncLoad.free_count = PAL_ASYNC_LOAD_MAX_JOBS;
+    
+    g_asyncLoad.queue_head = g_asyncLoad.queue_tail = NULL;
+    SDL_SetAtomicPointer(&g_asyncLoad.completed, NULL);
+}
+
+static void ReleaseJob(Job* job) {
+    SDL_SetAtomicInt(&job->state, JOB_FREE);
+    job->handle = 0;
+    g_asyncLoad.free_list[g_asyncLoad.free_count++] = (u8)(job - g_asyncLoad.jobs);
+}
+
+// Low byte is the slot plus one so no handle is 0; the rest is a generation
+static Job* FindJob(PAL_AsyncLoadHandle handle) {
+    u32 slot = (handle & 0xFF) - 1;
+    
+    if (handle == 0 || slot >= PAL_ASYNC_LOAD_MAX_JOBS) {
+        return NULL;
+    }
+    
+    Job* job = &g_asyncLoad.jobs[slot];
+    return job->handle == handle ? job : NULL;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+BOOL PAL_AsyncLoad_Init(u32 numWorkers) {
+    if (g_asyncLoad.mutex) {
+        return g_asyncLoad.num_workers > 0;
+    }
+    
+    // Submit may already have set up the table for synchronous loads
+    if (!g_asyncLoad.initialized) {
+        ResetJobTable();
+        g_asyncLoad.initialized = TRUE;
+    }
+    g_asyncLoad.quit = FALSE;
+    
+    if (numWorkers == 0) {
+        // Leave a core for the main thread; loading is mostly I/O-bound
+        int cores = SDL_GetNumLogicalCPUCores();
+        numWorkers = cores > 2 ? (u32)(cores - 1) : 1;
+        if (numWorkers > 4) {
+            numWorkers = 4;
+        }
+    }
+    if (numWorkers > MAX_WORKERS) {
+        numWorkers = MAX_WORKERS;
+    }
+    
+    g_asyncLoad.mutex = SDL_CreateMutex();
+    g_asyncLoad.work_ready = SDL_CreateCondition();
+    g_asyncLoad.job_finished = SDL_CreateCondition();
+    
+    if (!g_asyncLoad.mutex || !g_asyncLoad.work_ready || !g_asyncLoad.job_finished) {
+        printf("[AsyncLoad] Failed to create sync objects: %s; loading synchronously\n", SDL_GetError());
+        return FALSE;
+    }
+    
+    for (u32 i = 0; i < numWorkers; i++) {
+        char name[16];
+        snprintf(name, sizeof(name), "pal_load%u", i);
+        
+        g_asyncLoad.workers[i] = SDL_CreateThread(WorkerMain, name, NULL);
+        if (!g_asyncLoad.workers[i]) {
+            printf("[AsyncLoad] Failed to start worker %u: %s\n", i, SDL_GetError());
+            break;
+        }
+        g_asyncLoad.num_workers++;
+    }
+    
+    return g_asyncLoad.num_workers > 0;
+}
+
+void PAL_AsyncLoad_Shutdown(void) {
+    if (!g_asyncLoad.initialized) {
+        return;
+    }
+    
+    if (g_asyncLoad.mutex) {
+        SDL_LockMutex(g_asyncLoad.mutex);
+        g_asyncLoad.quit = TRUE;
+        SDL_BroadcastCondition(g_asyncLoad.work_ready);
+        SDL_UnlockMutex(g_asyncLoad.mutex);
+    }
+    
+    for (u32 i = 0; i < g_asyncLoad.num_workers; i++) {
+        SDL_WaitThread(g_asyncLoad.workers[i], NULL);
+        g_asyncLoad.workers[i] = NULL;
+    }
+    g_asyncLoad.num_workers = 0;
+    
+    SDL_DestroyCondition(g_asyncLoad.job_finished);
+    SDL_DestroyCondition(g_asyncLoad.work_ready);
+    SDL_DestroyMutex(g_asyncLoad.mutex);
+    g_asyncLoad.job_finished = g_asyncLoad.work_ready = NULL;
+    g_asyncLoad.mutex = NULL;
+    
+    ResetJobTable();
+    g_asyncLoad.initialized = FALSE;
+}
+
+PAL_AsyncLoadHandle PAL_AsyncLoad_Submit(const PAL_AsyncLoadRequest* request) {
+    if (!request || !request->archive || !request->dest || !request->callback) {
+        return 0;
+    }
+    
+    if (!g_asyncLoad.initialized) {
+        ResetJobTable();
+        g_asyncLoad.initialized = TRUE;
+    }
+    
+    if (g_asyncLoad.free_count == 0) {
+        return 0;
+    }
+    
+    Job* job = &g_asyncLoad.jobs[g_asyncLoad.free_list[--g_asyncLoad.free_count]];
+    
+    g_asyncLoad.generation++;
+    job->request = *request;
+    job->handle = (g_asyncLoad.generation << 8) | (u32)(job - g_asyncLoad.jobs + 1);
+    job->cancelled = FALSE;
+    job->queue_next = NULL;
+    job->done_next = NULL;
+    
+    if (g_asyncLoad.num_workers == 0) {
+        SDL_SetAtomicInt(&job->state, JOB_DONE);
+        RunJob(job);
+        PushCompleted(job);
+        return job->handle;
+    }
+    
+    SDL_LockMutex(g_asyncLoad.mutex);
+    SDL_SetAtomicInt(&job->state, JOB_QUEUED);
+    if (g_asyncLoad.queue_tail) {
+        g_asyncLoad.queue_tail->queue_next = job;
+    } else {
+        g_asyncLoad.queue_head = job;
+    }
+    g_asyncLoad.queue_tail = job;
+    SDL_SignalCondition(g_asyncLoad.work_ready);
+    SDL_UnlockMutex(g_asyncLoad.mutex);
+    
+    return job->handle;
+}
+
+void PAL_AsyncLoad_Cancel(PAL_AsyncLoadHandle handle) {
+    Job* job = FindJob(handle);
+    
+    if (!job || job->cancelled) {
+        return;
+    }
+    
+    if (g_asyncLoad.num_workers == 0) {
+        // Already finished inside Submit; Drain frees the slot
+        job->cancelled = TRUE;
+        return;
+    }
+    
+    SDL_LockMutex(g_asyncLoad.mutex);
+    
+    if (SDL_GetAtomicInt(&job->state) == JOB_QUEUED) {
+        Job** link = &g_asyncLoad.queue_head;
+        Job* prev = NULL;
+        
+        while (*link != job) {
+            prev = *link;
+            link = &(*link)->queue_next;
+        }
+        *link = job->queue_next;
+        if (g_asyncLoad.queue_tail == job) {
+            g_asyncLoad.queue_tail = prev;
+        }
+        
+        SDL_UnlockMutex(g_asyncLoad.mutex);
+        ReleaseJob(job);
+        return;
+    }
+    
+    while (SDL_GetAtomicInt(&job->state) == JOB_RUNNING) {
+        SDL_WaitCondition(g_asyncLoad.job_finished, g_asyncLoad.mutex);
+    }
+    
+    SDL_UnlockMutex(g_asyncLoad.mutex);
+    
+    // Finished but not drained yet; Drain frees the slot
+    job->cancelled = TRUE;
+}
+
+u32 PAL_AsyncLoad_Drain(void) {
+    Job* job = SDL_SetAtomicPointer(&g_asyncLoad.completed, NULL);
+    Job* ordered = NULL;
+    u32 count = 0;
+    
+    // The stack is newest first
+    while (job) {
+        Job* next = job->done_next;
+        job->done_next = ordered;
+        ordered = job;
+        job = next;
+    }
+    
+    while (ordered) {
+        Job* next = ordered->done_next;
+        PAL_AsyncLoadRequest request = ordered->request;
+        PAL_AsyncLoadStatus status = ordered->status;
+        u32 size = ordered->result_size;
+        BOOL cancelled = ordered->cancelled;
+        
+        // Free the slot first so the callback can submit a follow-up load
+        ReleaseJob(ordered);
+        
+        if (!cancelled) {
+            request.callback(status, request.dest, size, request.user_data);
+            count++;
+        }
+        
+        ordered = next;
+    }
+    
+    return count;
+}
+
+u32 PAL_AsyncLoad_GetPendingCount(void) {
+    return g_asyncLoad.initialized ? PAL_ASYNC_LOAD_MAX_JOBS - g_asyncLoad.free_count : 0;
+}
+
+#endif // PLATFORM_SDL
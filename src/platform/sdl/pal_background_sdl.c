@@ -6,6 +6,8 @@
 #include "platform/pal_background.h"
 #include "platform/pal_memory.h"
 #include "platform/pal_graphics.h"
+#include "platform/pal_tile_decode.h"
+#include "platform/pal_compositor.h"
 #include "bg_window.h"  // Need full BgConfig definition
 #include <SDL3/SDL.h>
 #include <string.h>
@@ -25,20 +27,40 @@
 #define TILEMAP_TILE_MASK     0x03FF
 #define TILEMAP_HFLIP_MASK    0x0400
 #define TILEMAP_VFLIP_MASK    0x0800
+#define TILEMAP_FLIP_SHIFT    10
 #define TILEMAP_PALETTE_SHIFT 12
 #define TILEMAP_PALETTE_MASK  0xF000
 
+// Tile indices addressable by a tilemap entry
+#define MAX_TILE_INDEX (TILEMAP_TILE_MASK + 1)
+
 // Internal PAL state for each background layer (extends game's Background struct)
 typedef struct {
     BOOL enabled;           // Is this layer active?
-    SDL_Texture* renderTexture;  // Cached rendered tilemap
+    u8 priority;            // 0-3, 0 = front
     void* tileData;         // Tile graphics data
-    u32 tileDataSize;       // Size of tile data buffer
-    PAL_Palette palette;    // Layer palette (up to 16 sub-palettes for 4bpp)
+    u32 tileDataSize;       // Bytes of tileData holding tiles
+    u32 tileDataCapacity;   // Bytes allocated; grows geometrically
+    PAL_PaletteLUT palette; // Packed layer palette (up to 16 sub-palettes for 4bpp)
     u16* paletteData;       // Palette data (RGB555 format) - kept for reference if needed
-    BOOL dirty;             // Needs re-render?
+    BOOL dirty;             // Needs a full re-render?
+    u8 colorMode;           // Mirrors Background.colorMode for config-less palette loads
     int texWidth;
     int texHeight;
+    
+    // Incremental re-render state
+    u16* shadowTilemap;     // Tilemap entries as of the last decode
+    u32* pixelCache;        // Decoded tilemap read by the compositor (texWidth x texHeight)
+    
+    // PAL_GRAPHICS_COLOR_INDEXED: the compositor resolves indexCache through palette
+    BOOL indexed;
+    u8* indexCache;         // Replaces pixelCache in indexed mode
+    int dirtyRowMin;        // Tilemap rows that may differ from shadowTilemap
+    int dirtyRowMax;
+    u8 dirtyTiles[MAX_TILE_INDEX / 8];  // Tile indices whose graphics changed
+    BOOL tilesChanged;      // Any bit set in dirtyTiles?
+    u16 dirtyPalettes;      // 4bpp sub-palettes changed since the last decode
+    u32 tilesDecoded;       // Tiles decoded by the last cache update
 } PAL_BgLayerState;
 
 // Global state for all background layers
@@ -47,10 +69,11 @@ static PAL_BgLayerState g_palBgLayers[8] = {0};
 // Helper functions
 static void GetScreenDimensions(u8 screenSize, int* width, int* height);
 static void RenderTilemap(Background* bg, PAL_BgLayerState* state);
-static void DecodeTile4bpp(const u8* tileData, u8 paletteIdx, const PAL_Palette* palette, 
-                           u32* output, BOOL hflip, BOOL vflip);
-static void DecodeTile8bpp(const u8* tileData, const PAL_Palette* palette, 
-                           u32* output, BOOL hflip, BOOL vflip);
+static void FreeLayerCaches(PAL_BgLayerState* state);
+static void MarkTilemapRowsDirty(PAL_BgLayerState* state, int rowStart, int rowEnd);
+static void MarkTilesDirty(PAL_BgLayerState* state, u32 tileStart, u32 tileCount);
+static void LoadLayerPalette(PAL_BgLayerState* state, const u16* src, u32 numColors, u32 offset);
+static void UpdateLayerCache(Background* bg, PAL_BgLayerState* state);
 
 // ============================================================================
 // Initialization and Management
@@ -69,22 +92,37 @@ PAL_BgConfig* PAL_Bg_CreateConfig(u32 heapID) {
     // Initialize all PAL layer states as disabled
     for (int i = 0; i < 8; i++) {
         g_palBgLayers[i].enabled = FALSE;
-        g_palBgLayers[i].renderTexture = NULL;
+        g_palBgLayers[i].priority = 0;
         g_palBgLayers[i].tileData = NULL;
         g_palBgLayers[i].tileDataSize = 0;
+        g_palBgLayers[i].tileDataCapacity = 0;
         g_palBgLayers[i].paletteData = NULL;
         g_palBgLayers[i].dirty = TRUE;
         g_palBgLayers[i].texWidth = 0;
         g_palBgLayers[i].texHeight = 0;
-        memset(&g_palBgLayers[i].palette, 0, sizeof(PAL_Palette));
-    }
-    
+        g_palBgLayers[i].shadowTilemap = NULL;
+        g_palBgLayers[i].pixelCache = NULL;
+        g_palBgLayers[i].indexed = FALSE;
+        g_palBgLayers[i].indexCache = NULL;
+        g_palBgLayers[i].dirtyRowMin = 0;
+        g_palBgLayers[i].dirtyRowMax = -1;
+        memset(g_palBgLayers[i].dirtyTiles, 0, sizeof(g_palBgLayers[i].dirtyTiles));
+        g_palBgLayers[i].tilesChanged = FALSE;
+        g_palBgLayers[i].dirtyPalettes = 0;
+        g_palBgLayers[i].tilesDecoded = 0;
+        g_palBgLayers[i].colorMode = PAL_BG_COLOR_MODE_4BPP;
+        PAL_PaletteLUT_Init(&g_palBgLayers[i].palette);
+    }
+    
+    PAL_Compositor_AttachBgConfig(config);
     return config;
 }
 
 void PAL_Bg_DestroyConfig(PAL_BgConfig* bgConfig) {
     if (!bgConfig) return;
     
+    PAL_Compositor_DetachBgConfig(bgConfig);
+    
     // Free all PAL layer resources
     for (int i = 0; i < 8; i++) {
         PAL_Bg_FreeTilemapBuffer(bgConfig, i);
@@ -92,12 +130,11 @@ void PAL_Bg_DestroyConfig(PAL_BgConfig* bgConfig) {
         if (g_palBgLayers[i].tileData) {
             PAL_Free(g_palBgLayers[i].tileData);
             g_palBgLayers[i].tileData = NULL;
+            g_palBgLayers[i].tileDataSize = 0;
+            g_palBgLayers[i].tileDataCapacity = 0;
         }
         
-        if (g_palBgLayers[i].renderTexture) {
-            SDL_DestroyTexture(g_palBgLayers[i].renderTexture);
-            g_palBgLayers[i].renderTexture = NULL;
-        }
+        FreeLayerCaches(&g_palBgLayers[i]);
     }
     
     PAL_Free(bgConfig);
@@ -116,10 +153,7 @@ void PAL_Bg_InitFromTemplate(PAL_BgConfig* bgConfig, u8 bgLayer,
     if (bg->tilemapBuffer) {
         PAL_Free(bg->tilemapBuffer);
     }
-    if (state->renderTexture) {
-        SDL_DestroyTexture(state->renderTexture);
-        state->renderTexture = NULL;
-    }
+    FreeLayerCaches(state);
     
     // Set parameters
     bg->type = bgType;
@@ -128,6 +162,8 @@ void PAL_Bg_InitFromTemplate(PAL_BgConfig* bgConfig, u8 bgLayer,
     bg->baseTile = bgTemplate->baseTile;
     
     state->enabled = TRUE;
+    state->priority = bgTemplate->priority & 3;
+    state->colorMode = bgTemplate->colorMode;
     state->dirty = TRUE;
     
     // Allocate tilemap buffer
@@ -139,21 +175,20 @@ void PAL_Bg_InitFromTemplate(PAL_BgConfig* bgConfig, u8 bgLayer,
         }
     }
     
-    // Create render texture
+    // Size the decode caches
     int width, height;
     GetScreenDimensions(bg->screenSize, &width, &height);
     state->texWidth = width;
     state->texHeight = height;
     
-    SDL_Renderer* renderer = PAL_Graphics_GetRenderer();
-    if (renderer) {
-        state->renderTexture = SDL_CreateTexture(renderer, 
-                                             SDL_PIXELFORMAT_RGBA32,
-                                             SDL_TEXTUREACCESS_STREAMING,
-                                             width, height);
-        if (state->renderTexture) {
-            SDL_SetTextureBlendMode(state->renderTexture, SDL_BLENDMODE_BLEND);
-        }
+    // Allocate incremental re-render caches
+    int numCells = (width / TILE_SIZE) * (height / TILE_SIZE);
+    state->indexed = (PAL_Graphics_GetColorMode() == PAL_GRAPHICS_COLOR_INDEXED);
+    state->shadowTilemap = (u16*)PAL_Calloc(numCells * sizeof(u16), bgConfig->heapID);
+    if (state->indexed) {
+        state->indexCache = (u8*)PAL_Calloc(width * height, bgConfig->heapID);
+    } else {
+        state->pixelCache = (u32*)PAL_Calloc(width * height * sizeof(u32), bgConfig->heapID);
     }
     
     // Reset offsets
@@ -187,6 +222,7 @@ void PAL_Bg_SetControlParam(PAL_BgConfig* bgConfig, u8 bgLayer,
     switch (param) {
         case PAL_BG_CONTROL_COLOR_MODE:
             bg->colorMode = value;
+            state->colorMode = value;
             state->dirty = TRUE;
             break;
         case PAL_BG_CONTROL_SCREEN_SIZE:
@@ -205,10 +241,8 @@ void PAL_Bg_SetControlParam(PAL_BgConfig* bgConfig, u8 bgLayer,
 // ============================================================================
 
 void PAL_Bg_SetPriority(u8 bgLayer, u8 priority) {
-    // Priority is handled during rendering by layer order
-    // This is a stub for DS compatibility
-    (void)bgLayer;
-    (void)priority;
+    if (bgLayer >= PAL_BG_LAYER_MAX) return;
+    g_palBgLayers[bgLayer].priority = priority & 3;
 }
 
 void PAL_Bg_ToggleLayer(u8 bgLayer, BOOL enable) {
@@ -282,7 +316,12 @@ void PAL_Bg_LoadTilemapBuffer(PAL_BgConfig* bgConfig, u8 bgLayer,
     }
     
     memcpy(bg->tilemapBuffer, src, size);
-    state->dirty = TRUE;
+    
+    int tilesX = state->texWidth / TILE_SIZE;
+    if (tilesX > 0) {
+        u32 numEntries = size / sizeof(u16);
+        MarkTilemapRowsDirty(state, 0, (int)((numEntries + tilesX - 1) / tilesX) - 1);
+    }
 }
 
 void PAL_Bg_CopyTilemapBufferToVRAM(PAL_BgConfig* bgConfig, u8 bgLayer) {
@@ -292,8 +331,9 @@ void PAL_Bg_CopyTilemapBufferToVRAM(PAL_BgConfig* bgConfig, u8 bgLayer) {
     
     PAL_BgLayerState* state = &g_palBgLayers[bgLayer];
     
-    // Mark for re-rendering
-    state->dirty = TRUE;
+    // The game may have written to the buffer directly, so every row has
+    // to be compared against the shadow copy on the next render
+    MarkTilemapRowsDirty(state, 0, state->texHeight / TILE_SIZE - 1);
 }
 
 void PAL_Bg_FillTilemap(PAL_BgConfig* bgConfig, u8 bgLayer, u16 fillVal) {
@@ -315,7 +355,7 @@ void PAL_Bg_FillTilemap(PAL_BgConfig* bgConfig, u8 bgLayer, u16 fillVal) {
         tilemap[i] = fillVal;
     }
     
-    state->dirty = TRUE;
+    MarkTilemapRowsDirty(state, 0, state->texHeight / TILE_SIZE - 1);
 }
 
 void PAL_Bg_FillTilemapRect(PAL_BgConfig* bgConfig, u8 bgLayer, u16 fillVal,
@@ -349,7 +389,7 @@ void PAL_Bg_FillTilemapRect(PAL_BgConfig* bgConfig, u8 bgLayer, u16 fillVal,
         }
     }
     
-    state->dirty = TRUE;
+    MarkTilemapRowsDirty(state, y, y + height - 1);
 }
 
 void PAL_Bg_ClearTilemap(PAL_BgConfig* bgConfig, u8 bgLayer) {
@@ -367,36 +407,54 @@ void* PAL_Bg_GetTilemapBuffer(PAL_BgConfig* bgConfig, u8 bgLayer) {
 // Tile/Character Data
 // ============================================================================
 
-void PAL_Bg_LoadTiles(PAL_BgConfig* bgConfig, u8 bgLayer, const void* src, 
-                     u32 size, u32 tileStart) {
-    if (!bgConfig || bgLayer >= PAL_BG_LAYER_MAX || !src) {
-        return;
+void* PAL_Bg_MapTileRange(PAL_BgConfig* bgConfig, u8 bgLayer, u32 tileStart, u32 size) {
+    if (!bgConfig || bgLayer >= PAL_BG_LAYER_MAX || size == 0) {
+        return NULL;
     }
     
-    Background* bg = &bgConfig->bgs[bgLayer];
     PAL_BgLayerState* state = &g_palBgLayers[bgLayer];
-    
-    // Allocate or reallocate tile data buffer
-    u32 neededSize = (tileStart * (bg->colorMode == PAL_BG_COLOR_MODE_4BPP ? 32 : 64)) + size;
-    
-    if (!state->tileData || state->tileDataSize < neededSize) {
-        void* newBuffer = PAL_Malloc(neededSize, bgConfig->heapID);
-        if (!newBuffer) return;
+    u32 bytesPerTile = (bgConfig->bgs[bgLayer].colorMode == PAL_BG_COLOR_MODE_4BPP ? 32 : 64);
+    u32 offset = tileStart * bytesPerTile;
+    u32 neededSize = offset + size;
+    
+    if (neededSize > state->tileDataCapacity) {
+        // Doubling keeps a screen's worth of tile loads to a few reallocations
+        u32 capacity = state->tileDataCapacity * 2;
+        if (capacity < neededSize) {
+            capacity = neededSize;
+        }
         
-        if (state->tileData) {
-            memcpy(newBuffer, state->tileData, state->tileDataSize);
-            PAL_Free(state->tileData);
+        void* newBuffer = PAL_Realloc(state->tileData, capacity);
+        if (!newBuffer) {
+            return NULL;
         }
         
         state->tileData = newBuffer;
+        state->tileDataCapacity = capacity;
+    }
+    
+    if (neededSize > state->tileDataSize) {
+        // Tiles skipped over by this load read as blank rather than garbage
+        if (offset > state->tileDataSize) {
+            memset((u8*)state->tileData + state->tileDataSize, 0, offset - state->tileDataSize);
+        }
         state->tileDataSize = neededSize;
     }
     
-    // Copy tile data
-    u32 offset = tileStart * (bg->colorMode == PAL_BG_COLOR_MODE_4BPP ? 32 : 64);
-    memcpy((u8*)state->tileData + offset, src, size);
+    MarkTilesDirty(state, tileStart, (size + bytesPerTile - 1) / bytesPerTile);
+    return (u8*)state->tileData + offset;
+}
+
+void PAL_Bg_LoadTiles(PAL_BgConfig* bgConfig, u8 bgLayer, const void* src, 
+                     u32 size, u32 tileStart) {
+    if (!src) {
+        return;
+    }
     
-    state->dirty = TRUE;
+    void* dest = PAL_Bg_MapTileRange(bgConfig, bgLayer, tileStart, size);
+    if (dest) {
+        memcpy(dest, src, size);
+    }
 }
 
 void PAL_Bg_LoadTilesToVRAM(PAL_BgConfig* bgConfig, u8 bgLayer, 
@@ -424,29 +482,21 @@ void PAL_Bg_LoadPalette(PAL_BgConfig* bgConfig, u8 bgLayer, const void* src, u16
     }
     
     PAL_BgLayerState* state = &g_palBgLayers[bgLayer];
+    state->colorMode = bgConfig->bgs[bgLayer].colorMode;
     
-    // Convert RGB555 palette to PAL_Color format
-    const u16* rgb555Palette = (const u16*)src;
-    u32 numColors = size / sizeof(u16);
-    if (numColors > 256) numColors = 256;
-    
-    for (u32 i = 0; i < numColors; i++) {
-        u32 palIdx = offset + i;
-        if (palIdx < 256) {
-            state->palette.colors[palIdx] = PAL_ColorFromRGB555(rgb555Palette[i]);
-        }
+    LoadLayerPalette(state, (const u16*)src, size / sizeof(u16), offset);
+}
+
+void PAL_Bg_LoadScreenPalette(PAL_Screen screen, const void* src, u16 size, u16 offset) {
+    if (screen >= PAL_SCREEN_MAX || !src) {
+        return;
     }
     
-    // Update color count
-    u32 maxIdx = offset + numColors;
-    if (maxIdx > state->palette.num_colors) {
-        state->palette.num_colors = maxIdx;
+    // On DS all four layers of a screen share one standard BG palette
+    int firstLayer = (screen == PAL_SCREEN_MAIN) ? PAL_BG_LAYER_MAIN_0 : PAL_BG_LAYER_SUB_0;
+    for (int layer = firstLayer; layer < firstLayer + 4; layer++) {
+        LoadLayerPalette(&g_palBgLayers[layer], (const u16*)src, size / sizeof(u16), offset);
     }
-    
-    printf("[BG] LoadPalette: layer=%d, loaded %d colors at offset %d, total=%d colors\n",
-           bgLayer, numColors, offset, state->palette.num_colors);
-    
-    state->dirty = TRUE;
 }
 
 void PAL_Bg_MaskPalette(u8 bgLayer, u16 mask) {
@@ -459,71 +509,72 @@ void PAL_Bg_MaskPalette(u8 bgLayer, u16 mask) {
 // Rendering
 // ============================================================================
 
-void PAL_Bg_RenderAll(PAL_BgConfig* bgConfig) {
+void PAL_Bg_RenderAll(PAL_BgConfig* bgConfig, struct PAL_SpriteManager* sprites) {
     if (!bgConfig) return;
     
-    SDL_Renderer* renderer = PAL_Graphics_GetRenderer();
-    if (!renderer) return;
-    
-    // Render layers in priority order (lower priority = drawn first)
-    // Note: Background struct doesn't have priority field in bg_window.h
-    // We might need to store priority in PAL_BgLayerState if it's not in Background
-    // For now, we'll just iterate 0-3 and assume priority is set somewhere or default
-    
-    // Since we can't easily get priority from Background struct if it's missing,
-    // we'll just render in layer order for now, or check if we can find where priority is stored.
-    // BgTemplate has priority. Maybe we should store it in PAL_BgLayerState.
-    // Let's assume we added priority to PAL_BgLayerState.
-    
-    // For now, just render all enabled layers.
-    for (int layer = 0; layer < PAL_BG_LAYER_MAX; layer++) {
-        PAL_BgLayerState* state = &g_palBgLayers[layer];
-        if (state->enabled) {
-            PAL_Bg_RenderLayer(bgConfig, layer);
-        }
-    }
+    // BGs and OBJs go through one compositing pass per screen
+    PAL_Compositor_ComposeAll(bgConfig, sprites);
 }
 
-void PAL_Bg_RenderLayer(PAL_BgConfig* bgConfig, u8 bgLayer) {
-    if (!bgConfig || bgLayer >= PAL_BG_LAYER_MAX) {
-        return;
+// ============================================================================
+// Compositor Access
+// ============================================================================
+
+BOOL PAL_Bg_GetLayerView(PAL_BgConfig* bgConfig, u8 bgLayer, PAL_BgLayerView* view) {
+    if (!bgConfig || bgLayer >= PAL_BG_LAYER_MAX || !view) {
+        return FALSE;
     }
     
     Background* bg = &bgConfig->bgs[bgLayer];
     PAL_BgLayerState* state = &g_palBgLayers[bgLayer];
     
-    if (!state->enabled || !state->renderTexture) {
-        return;
-    }
-    
-    // Re-render tilemap if dirty
-    if (state->dirty) {
-        RenderTilemap(bg, state);
-        state->dirty = FALSE;
+    if (!state->enabled || !bg->tilemapBuffer || !state->tileData) {
+        return FALSE;
     }
     
-    // Determine which screen to render to
-    SDL_Renderer* renderer = PAL_Graphics_GetRenderer();
-    PAL_Screen targetScreen = (bgLayer < PAL_BG_LAYER_SUB_0) ? PAL_SCREEN_MAIN : PAL_SCREEN_SUB;
+    UpdateLayerCache(bg, state);
     
-    // Get the target screen texture and set it as render target
-    SDL_Texture* screenTexture = PAL_Graphics_GetScreenTexture(targetScreen);
-    if (!screenTexture) return;
-    
-    SDL_SetRenderTarget(renderer, screenTexture);
-    
-    // Calculate destination rectangle with scrolling
-    SDL_FRect dstRect;
-    dstRect.x = (float)-bg->xOffset;
-    dstRect.y = (float)-bg->yOffset;
-    dstRect.w = (float)state->texWidth;
-    dstRect.h = (float)state->texHeight;
-    
-    // Render the tilemap texture to the screen surface
-    SDL_RenderTexture(renderer, state->renderTexture, NULL, &dstRect);
+    memset(view, 0, sizeof(*view));
+    if (state->indexed) {
+        view->indices = state->indexCache;
+        view->palette = state->palette.colors;
+    } else {
+        view->pixels = state->pixelCache;
+    }
+    if (!view->indices && !view->pixels) {
+        return FALSE;
+    }
     
-    // Reset render target
-    SDL_SetRenderTarget(renderer, NULL);
+    view->width = state->texWidth;
+    view->height = state->texHeight;
+    view->xOffset = bg->xOffset;
+    view->yOffset = bg->yOffset;
+    view->priority = state->priority;
+    return TRUE;
+}
+
+u8 PAL_Bg_GetPriority(u8 bgLayer) {
+    if (bgLayer >= PAL_BG_LAYER_MAX) {
+        return 0;
+    }
+    return g_palBgLayers[bgLayer].priority;
+}
+
+u32 PAL_Bg_GetBackdropColor(PAL_Screen screen) {
+    // Every layer of a screen shares the standard palette, so layer 0's copy will do
+    int layer = (screen == PAL_SCREEN_SUB) ? PAL_BG_LAYER_SUB_0 : PAL_BG_LAYER_MAIN_0;
+    return g_palBgLayers[layer].palette.colors[0] | 0xFF000000;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+u32 PAL_Bg_GetTilesDecoded(u8 bgLayer) {
+    if (bgLayer >= PAL_BG_LAYER_MAX) {
+        return 0;
+    }
+    return g_palBgLayers[bgLayer].tilesDecoded;
 }
 
 // ============================================================================
@@ -556,118 +607,155 @@ static void GetScreenDimensions(u8 screenSize, int* width, int* height) {
     }
 }
 
-static void RenderTilemap(Background* bg, PAL_BgLayerState* state) {
-    if (!state->renderTexture || !bg->tilemapBuffer || !state->tileData) {
-        // printf("[BG] RenderTilemap failed: texture=%p, tilemap=%p, tiles=%p\n",
-        //        state->renderTexture, bg->tilemapBuffer, state->tileData);
+static void FreeLayerCaches(PAL_BgLayerState* state) {
+    if (state->shadowTilemap) {
+        PAL_Free(state->shadowTilemap);
+        state->shadowTilemap = NULL;
+    }
+    if (state->pixelCache) {
+        PAL_Free(state->pixelCache);
+        state->pixelCache = NULL;
+    }
+    if (state->indexCache) {
+        PAL_Free(state->indexCache);
+        state->indexCache = NULL;
+    }
+}
+
+static void MarkTilemapRowsDirty(PAL_BgLayerState* state, int rowStart, int rowEnd) {
+    if (rowStart > rowEnd) {
         return;
     }
-    
-    // Lock texture for writing
-    void* pixels;
-    int pitch;
-    if (!SDL_LockTexture(state->renderTexture, NULL, &pixels, &pitch)) {
-        printf("[BG] Failed to lock texture: %s\n", SDL_GetError());
+    if (state->dirtyRowMin > state->dirtyRowMax) {
+        state->dirtyRowMin = rowStart;
+        state->dirtyRowMax = rowEnd;
+        return;
+    }
+    if (rowStart < state->dirtyRowMin) state->dirtyRowMin = rowStart;
+    if (rowEnd > state->dirtyRowMax) state->dirtyRowMax = rowEnd;
+}
+
+static void MarkTilesDirty(PAL_BgLayerState* state, u32 tileStart, u32 tileCount) {
+    for (u32 i = tileStart; i < tileStart + tileCount && i < MAX_TILE_INDEX; i++) {
+        state->dirtyTiles[i >> 3] |= (u8)(1 << (i & 7));
+        state->tilesChanged = TRUE;
+    }
+}
+
+static void UpdateLayerCache(Background* bg, PAL_BgLayerState* state) {
+    // Re-decode whatever changed since the last frame
+    state->tilesDecoded = 0;
+    if (state->dirty || state->dirtyRowMin <= state->dirtyRowMax
+        || state->tilesChanged || state->dirtyPalettes) {
+        RenderTilemap(bg, state);
+    }
+}
+
+static void LoadLayerPalette(PAL_BgLayerState* state, const u16* src, u32 numColors, u32 offset) {
+    u16 changed = PAL_PaletteLUT_Load(&state->palette, src, offset, numColors);
+    if (!changed || state->indexed) {
+        // Indexed layers pick up the new colors on the next compose, no re-decode
         return;
     }
     
-    // Clear texture
-    memset(pixels, 0, pitch * state->texHeight);
+    if (state->colorMode == PAL_BG_COLOR_MODE_4BPP) {
+        // Only tiles using the changed 16-color sub-palettes need re-decoding
+        state->dirtyPalettes |= changed;
+    } else {
+        // 8bpp tiles can reference any color
+        state->dirty = TRUE;
+    }
+}
+
+/**
+ * Re-decodes the tiles whose tilemap entry, graphics or sub-palette changed
+ * since the last call into the layer's pixel (or index) cache, which the
+ * compositor samples directly. A full re-decode only happens when
+ * state->dirty is set (new layer, mode change, 8bpp palette change).
+ */
+static void RenderTilemap(Background* bg, PAL_BgLayerState* state) {
+    if (!bg->tilemapBuffer || !state->tileData
+        || !state->shadowTilemap || (!state->pixelCache && !state->indexCache)) {
+        return;
+    }
     
-    // Get tilemap dimensions
     int tilesX = state->texWidth / TILE_SIZE;
     int tilesY = state->texHeight / TILE_SIZE;
+    int pitch = state->texWidth * (state->indexed ? sizeof(u8) : sizeof(u32));
+    u32 bytesPerTile = (bg->colorMode == PAL_BG_COLOR_MODE_4BPP) ? 32 : 64;
     
-    u16* tilemap = (u16*)bg->tilemapBuffer;
-    u32 tileBuffer[TILE_SIZE * TILE_SIZE];  // RGBA buffer for one tile
+    const u16* tilemap = (const u16*)bg->tilemapBuffer;
+    u32 numEntries = bg->bufferSize / sizeof(u16);
     
-    // Render each tile
-    for (int ty = 0; ty < tilesY; ty++) {
-        for (int tx = 0; tx < tilesX; tx++) {
-            u16 tileEntry = tilemap[ty * tilesX + tx];
-            
-            u16 tileIdx = tileEntry & TILEMAP_TILE_MASK;
-            BOOL hflip = (tileEntry & TILEMAP_HFLIP_MASK) != 0;
-            BOOL vflip = (tileEntry & TILEMAP_VFLIP_MASK) != 0;
-            u8 paletteIdx = (tileEntry & TILEMAP_PALETTE_MASK) >> TILEMAP_PALETTE_SHIFT;
-            
-            // Decode tile
-            if (bg->colorMode == PAL_BG_COLOR_MODE_4BPP) {
-                const u8* tileData = (const u8*)state->tileData + (tileIdx * 32);
-                DecodeTile4bpp(tileData, paletteIdx, &state->palette, tileBuffer, hflip, vflip);
-            } else {
-                const u8* tileData = (const u8*)state->tileData + (tileIdx * 64);
-                DecodeTile8bpp(tileData, &state->palette, tileBuffer, hflip, vflip);
-            }
-            
-            // Copy tile to texture
-            int destX = tx * TILE_SIZE;
-            int destY = ty * TILE_SIZE;
-            
-            for (int py = 0; py < TILE_SIZE; py++) {
-                u32* destRow = (u32*)((u8*)pixels + (destY + py) * pitch);
-                memcpy(&destRow[destX], &tileBuffer[py * TILE_SIZE], TILE_SIZE * sizeof(u32));
-            }
-        }
+    BOOL full = state->dirty;
+    if (full) {
+        memset(state->indexed ? (void*)state->indexCache : (void*)state->pixelCache, 0,
+               pitch * state->texHeight);
     }
     
-    SDL_UnlockTexture(state->renderTexture);
-}
-
-static void DecodeTile4bpp(const u8* tileData, u8 paletteIdx, const PAL_Palette* palette, 
-                           u32* output, BOOL hflip, BOOL vflip) {
-    // 4bpp: 4 bits per pixel, 2 pixels per byte
-    // Tile size: 8x8 pixels = 32 bytes
-    
-    int paletteOffset = paletteIdx * 16;  // 16 colors per sub-palette
-    
-    for (int y = 0; y < TILE_SIZE; y++) {
-        for (int x = 0; x < TILE_SIZE; x++) {
-            int srcX = hflip ? (TILE_SIZE - 1 - x) : x;
-            int srcY = vflip ? (TILE_SIZE - 1 - y) : y;
-            
-            int byteIdx = srcY * 4 + srcX / 2;  // 4 bytes per row
-            int nibble = srcX & 1;
-            
-            u8 colorIdx = (tileData[byteIdx] >> (nibble * 4)) & 0x0F;
-            
-            // Color index 0 is transparent
-            if (colorIdx == 0) {
-                output[y * TILE_SIZE + x] = 0x00000000;
-            } else {
-                int palIdx = paletteOffset + colorIdx;
-                if (palIdx < 256) {
-                    PAL_Color color = palette->colors[palIdx];
-                    output[y * TILE_SIZE + x] = (color.a << 24) | (color.b << 16) | 
-                                               (color.g << 8) | color.r;
+    const u32* lut = state->palette.colors;
+    
+    for (int ty = 0; ty < tilesY; ty++) {
+        BOOL rowInSpan = (ty >= state->dirtyRowMin && ty <= state->dirtyRowMax);
+        if (full || rowInSpan || state->tilesChanged || state->dirtyPalettes) {
+            for (int tx = 0; tx < tilesX; tx++) {
+                u32 cell = ty * tilesX + tx;
+                u16 tileEntry = (cell < numEntries) ? tilemap[cell] : 0;
+                u16 tileIdx = tileEntry & TILEMAP_TILE_MASK;
+                u8 paletteIdx = (tileEntry & TILEMAP_PALETTE_MASK) >> TILEMAP_PALETTE_SHIFT;
+                
+                BOOL redraw = full
+                    || (rowInSpan && tileEntry != state->shadowTilemap[cell])
+                    || (state->dirtyTiles[tileIdx >> 3] & (1 << (tileIdx & 7)))
+                    || (bg->colorMode == PAL_BG_COLOR_MODE_4BPP
+                        && (state->dirtyPalettes & (1 << paletteIdx)));
+                if (!redraw) {
+                    continue;
+                }
+                
+                // Tilemap flip bits map straight onto the decoder's flip flags
+                u32 flip = (tileEntry & (TILEMAP_HFLIP_MASK | TILEMAP_VFLIP_MASK)) >> TILEMAP_FLIP_SHIFT;
+                u32 tileOffset = tileIdx * bytesPerTile;
+                const u8* tileData = (const u8*)state->tileData + tileOffset;
+                
+                // Decode tile straight into the pixel (or index) cache
+                u32 destOffset = (ty * TILE_SIZE) * state->texWidth + tx * TILE_SIZE;
+                
+                if (tileOffset + bytesPerTile > state->tileDataSize) {
+                    for (int py = 0; py < TILE_SIZE; py++) {
+                        u32 rowOffset = destOffset + py * state->texWidth;
+                        if (state->indexed) {
+                            memset(state->indexCache + rowOffset, 0, TILE_SIZE);
+                        } else {
+                            memset(state->pixelCache + rowOffset, 0, TILE_SIZE * sizeof(u32));
+                        }
+                    }
+                } else if (state->indexed) {
+                    u8* dest = state->indexCache + destOffset;
+                    if (bg->colorMode == PAL_BG_COLOR_MODE_4BPP) {
+                        PAL_TileDecode_Tile4bppIndex(tileData, paletteIdx, dest, state->texWidth, flip);
+                    } else {
+                        PAL_TileDecode_Tile8bppIndex(tileData, dest, state->texWidth, flip);
+                    }
+                } else if (bg->colorMode == PAL_BG_COLOR_MODE_4BPP) {
+                    PAL_TileDecode_Tile4bpp(tileData, &lut[paletteIdx * 16], state->pixelCache + destOffset,
+                                            state->texWidth, flip);
                 } else {
-                    output[y * TILE_SIZE + x] = 0xFF00FF00;  // Magenta for out-of-bounds
+                    PAL_TileDecode_Tile8bpp(tileData, lut, state->pixelCache + destOffset, state->texWidth, flip);
                 }
+                
+                state->shadowTilemap[cell] = tileEntry;
+                state->tilesDecoded++;
             }
         }
     }
-}
-
-static void DecodeTile8bpp(const u8* tileData, const PAL_Palette* palette, 
-                           u32* output, BOOL hflip, BOOL vflip) {
-    // 8bpp: 8 bits per pixel, 1 pixel per byte
-    // Tile size: 8x8 pixels = 64 bytes
-    
-    for (int y = 0; y < TILE_SIZE; y++) {
-        for (int x = 0; x < TILE_SIZE; x++) {
-            int srcX = hflip ? (TILE_SIZE - 1 - x) : x;
-            int srcY = vflip ? (TILE_SIZE - 1 - y) : y;
-            
-            u8 colorIdx = tileData[srcY * TILE_SIZE + srcX];
-            
-            // Color index 0 is transparent
-            if (colorIdx == 0) {
-                output[y * TILE_SIZE + x] = 0x00000000;
-            } else {
-                PAL_Color color = palette->colors[colorIdx];
-                output[y * TILE_SIZE + x] = (color.a << 24) | (color.b << 16) | 
-                                           (color.g << 8) | color.r;
-            }
-        }
+    
+    state->dirty = FALSE;
+    state->dirtyRowMin = 0;
+    state->dirtyRowMax = -1;
+    if (state->tilesChanged) {
+        memset(state->dirtyTiles, 0, sizeof(state->dirtyTiles));
+        state->tilesChanged = FALSE;
     }
+    state->dirtyPalettes = 0;
 }
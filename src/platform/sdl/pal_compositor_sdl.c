@@ -0,0 +1,595 @@
+/**
+ * @file pal_compositor_sdl.c
+ * @brief SDL3 implementation of the 2D screen compositor
+ *
+ * Each screen is composed on the CPU into one RGBA32 frame and then
+ * uploaded and drawn with a single texture copy, instead of switching the
+ * render target once per BG layer and sprite.
+ */
+
+#include "platform/pal_compositor.h"
+#include "platform/pal_background.h"
+#include "platform/pal_sprite.h"
+#include "platform/pal_memory.h"
+#include <SDL3/SDL.h>
+#include <string.h>
+#include <math.h>
+
+#define FRAME_WIDTH     PAL_SCREEN_WIDTH
+#define FRAME_HEIGHT    PAL_SCREEN_HEIGHT
+#define FRAME_PIXELS    (FRAME_WIDTH * FRAME_HEIGHT)
+
+// OAM holds 128 objects per screen
+#define MAX_OBJS_PER_SCREEN 128
+
+// Number of BG layers per screen
+#define LAYERS_PER_SCREEN 4
+
+// Window control byte: PAL_PLANE_* bits plus the color effect enable
+#define WINDOW_EFFECT 0x40
+#define WINDOW_ALL    (PAL_PLANE_ALL | WINDOW_EFFECT)
+
+// Plane ids for OBJ and the backdrop in the per-pixel plane list (BGs are 0-3)
+#define PLANE_ID_OBJ 4
+#define PLANE_ID_BD  5
+
+// Heap used for the frame buffers
+#define COMPOSITOR_HEAP_ID 0
+
+/**
+ * @brief Window and blend registers plus output of one screen
+ */
+typedef struct {
+    // Windows
+    u32 visibleWindows;
+    int winLeft[PAL_WINDOW_MAX];
+    int winTop[PAL_WINDOW_MAX];
+    int winRight[PAL_WINDOW_MAX];
+    int winBottom[PAL_WINDOW_MAX];
+    u8 winInside[PAL_WINDOW_MAX];
+    u8 winObjInside;
+    u8 winOutside;
+    
+    // Color effect
+    PAL_BlendMode blendMode;
+    u8 target1;
+    u8 target2;
+    int eva, evb, evy;
+    
+    // Output
+    u32* frame;
+    SDL_Texture* texture;
+} CompositorScreen;
+
+/**
+ * @brief BG layer prepared for sampling
+ */
+typedef struct {
+    PAL_BgLayerView view;
+    u8 plane;               // PAL_PLANE_BGn
+    u8 id;                  // 0-3
+} ComposeLayer;
+
+static CompositorScreen g_compScreens[PAL_SCREEN_MAX];
+static BOOL g_compInitialized = FALSE;
+
+// OBJ plane of the screen being composed (objColor 0 = no sprite)
+static u32 g_objColor[FRAME_PIXELS];
+static u8 g_objPriority[FRAME_PIXELS];
+static u8 g_objAlpha[FRAME_PIXELS];
+static u8 g_objBlend[FRAME_PIXELS];
+static u8 g_objWindow[FRAME_PIXELS];
+static PAL_SpriteView g_objViews[MAX_OBJS_PER_SCREEN];
+
+// Sources composed by PAL_Compositor_ComposeFrame
+static struct BgConfig* g_frameBgConfig = NULL;
+static PAL_SpriteManager* g_frameSprites = NULL;
+
+// Helper functions
+static CompositorScreen* GetScreen(PAL_Screen screen);
+static BOOL RasterizeObjs(PAL_SpriteManager* sprites, PAL_Screen screen);
+static void RasterizeObj(const PAL_SpriteView* view);
+static BOOL InWindowRange(int pos, int start, int end);
+static u32 BlendAlpha(u32 top, u32 bottom, int eva, int evb);
+static u32 BlendBrightness(u32 color, int evy);
+static u32 BlendObj(u32 top, u32 bottom, u8 alpha, PAL_SpriteBlendMode mode);
+
+// ============================================================================
+// Window Registers
+// ============================================================================
+
+void PAL_Compositor_SetVisibleWindows(PAL_Screen screen, u32 mask) {
+    CompositorScreen* comp = GetScreen(screen);
+    if (!comp) return;
+    comp->visibleWindows = mask & (PAL_WINDOW_MASK_W0 | PAL_WINDOW_MASK_W1 | PAL_WINDOW_MASK_OBJ);
+}
+
+void PAL_Compositor_SetWindowRect(PAL_Screen screen, PAL_Window window,
+                                  int left, int top, int right, int bottom) {
+    CompositorScreen* comp = GetScreen(screen);
+    if (!comp || window >= PAL_WINDOW_MAX) return;
+    
+    comp->winLeft[window] = left;
+    comp->winTop[window] = top;
+    comp->winRight[window] = right;
+    comp->winBottom[window] = bottom;
+}
+
+void PAL_Compositor_SetWindowInside(PAL_Screen screen, PAL_Window window, u32 planeMask, BOOL effect) {
+    CompositorScreen* comp = GetScreen(screen);
+    if (!comp || window >= PAL_WINDOW_MAX) return;
+    comp->winInside[window] = (u8)((planeMask & PAL_PLANE_ALL) | (effect ? WINDOW_EFFECT : 0));
+}
+
+void PAL_Compositor_SetObjWindowInside(PAL_Screen screen, u32 planeMask, BOOL effect) {
+    CompositorScreen* comp = GetScreen(screen);
+    if (!comp) return;
+    comp->winObjInside = (u8)((planeMask & PAL_PLANE_ALL) | (effect ? WINDOW_EFFECT : 0));
+}
+
+void PAL_Compositor_SetWindowOutside(PAL_Screen screen, u32 planeMask, BOOL effect) {
+    CompositorScreen* comp = GetScreen(screen);
+    if (!comp) return;
+    comp->winOutside = (u8)((planeMask & PAL_PLANE_ALL) | (effect ? WINDOW_EFFECT : 0));
+}
+
+// ============================================================================
+// Blend Registers
+// ============================================================================
+
+void PAL_Compositor_BlendNone(PAL_Screen screen) {
+    CompositorScreen* comp = GetScreen(screen);
+    if (!comp) return;
+    comp->blendMode = PAL_BLEND_NONE;
+}
+
+void PAL_Compositor_SetBlendAlpha(PAL_Screen screen, u32 plane1, u32 plane2, int eva, int evb) {
+    CompositorScreen* comp = GetScreen(screen);
+    if (!comp) return;
+    
+    comp->blendMode = PAL_BLEND_ALPHA;
+    comp->target1 = (u8)(plane1 & PAL_PLANE_ALL);
+    comp->target2 = (u8)(plane2 & PAL_PLANE_ALL);
+    PAL_Compositor_ChangeBlendAlpha(screen, eva, evb);
+}
+
+void PAL_Compositor_ChangeBlendAlpha(PAL_Screen screen, int eva, int evb) {
+    CompositorScreen* comp = GetScreen(screen);
+    if (!comp) return;
+    comp->eva = (eva < 0) ? 0 : (eva > 16 ? 16 : eva);
+    comp->evb = (evb < 0) ? 0 : (evb > 16 ? 16 : evb);
+}
+
+void PAL_Compositor_SetBlendBrightness(PAL_Screen screen, u32 plane, int brightness) {
+    CompositorScreen* comp = GetScreen(screen);
+    if (!comp) return;
+    
+    if (brightness == 0) {
+        comp->blendMode = PAL_BLEND_NONE;
+        return;
+    }
+    
+    comp->blendMode = (brightness > 0) ? PAL_BLEND_BRIGHTEN : PAL_BLEND_DARKEN;
+    comp->target1 = (u8)(plane & PAL_PLANE_ALL);
+    comp->evy = (brightness > 0) ? brightness : -brightness;
+    if (comp->evy > 16) {
+        comp->evy = 16;
+    }
+}
+
+// ============================================================================
+// Composition
+// ============================================================================
+
+void PAL_Compositor_ComposeScreen(struct BgConfig* bgConfig, struct PAL_SpriteManager* sprites,
+                                  PAL_Screen screen) {
+    CompositorScreen* comp = GetScreen(screen);
+    if (!comp) return;
+    
+    if (!comp->frame) {
+        comp->frame = (u32*)PAL_Malloc(FRAME_PIXELS * sizeof(u32), COMPOSITOR_HEAP_ID);
+        if (!comp->frame) return;
+    }
+    
+    // Collect the enabled BG layers, front-most first. The sort is stable, so
+    // equal priorities keep BG0 in front of BG3 like on hardware.
+    ComposeLayer layers[LAYERS_PER_SCREEN];
+    int numLayers = 0;
+    u8 firstLayer = (screen == PAL_SCREEN_SUB) ? PAL_BG_LAYER_SUB_0 : PAL_BG_LAYER_MAIN_0;
+    
+    for (int i = 0; bgConfig && i < LAYERS_PER_SCREEN; i++) {
+        ComposeLayer layer;
+        if (!PAL_Bg_GetLayerView(bgConfig, (u8)(firstLayer + i), &layer.view)) {
+            continue;
+        }
+        layer.plane = (u8)(PAL_PLANE_BG0 << i);
+        layer.id = (u8)i;
+        
+        int pos = numLayers;
+        while (pos > 0 && layers[pos - 1].view.priority > layer.view.priority) {
+            layers[pos] = layers[pos - 1];
+            pos--;
+        }
+        layers[pos] = layer;
+        numLayers++;
+    }
+    
+    BOOL hasObjs = RasterizeObjs(sprites, screen);
+    u32 backdrop = PAL_Bg_GetBackdropColor(screen);
+    
+    for (int y = 0; y < FRAME_HEIGHT; y++) {
+        u32* dst = &comp->frame[y * FRAME_WIDTH];
+        
+        // Vertical window tests only change per line
+        BOOL winRow[PAL_WINDOW_MAX];
+        for (int w = 0; w < PAL_WINDOW_MAX; w++) {
+            winRow[w] = (comp->visibleWindows & (PAL_WINDOW_MASK_W0 << w))
+                && InWindowRange(y, comp->winTop[w], comp->winBottom[w]);
+        }
+        
+        for (int x = 0; x < FRAME_WIDTH; x++) {
+            int idx = y * FRAME_WIDTH + x;
+            
+            // WIN0 takes precedence over WIN1, then the OBJ window, then the outside area
+            u8 control = WINDOW_ALL;
+            if (comp->visibleWindows) {
+                if (winRow[PAL_WINDOW_0] && InWindowRange(x, comp->winLeft[0], comp->winRight[0])) {
+                    control = comp->winInside[PAL_WINDOW_0];
+                } else if (winRow[PAL_WINDOW_1] && InWindowRange(x, comp->winLeft[1], comp->winRight[1])) {
+                    control = comp->winInside[PAL_WINDOW_1];
+                } else if (hasObjs && (comp->visibleWindows & PAL_WINDOW_MASK_OBJ) && g_objWindow[idx]) {
+                    control = comp->winObjInside;
+                } else {
+                    control = comp->winOutside;
+                }
+            }
+            
+            // Find the two front-most opaque planes. OBJ sits in front of BGs
+            // with the same priority value.
+            u32 colors[2] = { backdrop, backdrop };
+            u8 planes[2] = { PAL_PLANE_BD, PAL_PLANE_BD };
+            u8 ids[2] = { PLANE_ID_BD, PLANE_ID_BD };
+            int found = 0;
+            BOOL objHere = hasObjs && g_objColor[idx] && (control & PAL_PLANE_OBJ);
+            int layerPos = 0;
+            
+            for (int prio = 0; prio < 4 && found < 2; prio++) {
+                if (objHere && g_objPriority[idx] == prio) {
+                    colors[found] = g_objColor[idx];
+                    planes[found] = PAL_PLANE_OBJ;
+                    ids[found] = PLANE_ID_OBJ;
+                    found++;
+                }
+                
+                for (; layerPos < numLayers && layers[layerPos].view.priority == prio && found < 2; layerPos++) {
+                    const ComposeLayer* layer = &layers[layerPos];
+                    if (!(control & layer->plane)) {
+                        continue;
+                    }
+                    
+                    const PAL_BgLayerView* view = &layer->view;
+                    int bx = (x + view->xOffset) & (view->width - 1);
+                    int by = (y + view->yOffset) & (view->height - 1);
+                    u32 color;
+                    
+                    if (view->indices) {
+                        u8 index = view->indices[by * view->width + bx];
+                        color = index ? view->palette[index] : 0;
+                    } else {
+                        color = view->pixels[by * view->width + bx];
+                    }
+                    
+                    if (color >> 24) {
+                        colors[found] = color;
+                        planes[found] = layer->plane;
+                        ids[found] = layer->id;
+                        found++;
+                    }
+                }
+            }
+            
+            // Color effect
+            u32 out = colors[0];
+            if (ids[0] == PLANE_ID_OBJ && g_objBlend[idx] != PAL_SPRITE_BLEND_NONE) {
+                // Semi-transparent sprites blend with whatever is below them
+                out = BlendObj(colors[0], colors[1], g_objAlpha[idx], (PAL_SpriteBlendMode)g_objBlend[idx]);
+            } else if ((control & WINDOW_EFFECT) && (comp->target1 & planes[0])) {
+                switch (comp->blendMode) {
+                    case PAL_BLEND_ALPHA:
+                        if (comp->target2 & planes[1]) {
+                            out = BlendAlpha(colors[0], colors[1], comp->eva, comp->evb);
+                        }
+                        break;
+                    case PAL_BLEND_BRIGHTEN:
+                        out = BlendBrightness(colors[0], comp->evy);
+                        break;
+                    case PAL_BLEND_DARKEN:
+                        out = BlendBrightness(colors[0], -comp->evy);
+                        break;
+                    default:
+                        break;
+                }
+            }
+            
+            dst[x] = out | 0xFF000000;
+        }
+    }
+    
+    // One upload and one copy into the screen texture
+    SDL_Renderer* renderer = PAL_Graphics_GetRenderer();
+    SDL_Texture* screenTexture = PAL_Graphics_GetScreenTexture(screen);
+    if (!renderer || !screenTexture) return;
+    
+    if (!comp->texture) {
+        comp->texture = SDL_CreateTexture(renderer,
+                                          SDL_PIXELFORMAT_RGBA32,
+                                          SDL_TEXTUREACCESS_STREAMING,
+                                          FRAME_WIDTH, FRAME_HEIGHT);
+        if (!comp->texture) return;
+        SDL_SetTextureBlendMode(comp->texture, SDL_BLENDMODE_NONE);
+    }
+    
+    SDL_UpdateTexture(comp->texture, NULL, comp->frame, FRAME_WIDTH * sizeof(u32));
+    SDL_SetRenderTarget(renderer, screenTexture);
+    SDL_RenderTexture(renderer, comp->texture, NULL, NULL);
+    SDL_SetRenderTarget(renderer, NULL);
+}
+
+void PAL_Compositor_ComposeAll(struct BgConfig* bgConfig, struct PAL_SpriteManager* sprites) {
+    for (int screen = 0; screen < PAL_SCREEN_MAX; screen++) {
+        PAL_Compositor_ComposeScreen(bgConfig, sprites, (PAL_Screen)screen);
+    }
+}
+
+void PAL_Compositor_AttachBgConfig(struct BgConfig* bgConfig) {
+    g_frameBgConfig = bgConfig;
+}
+
+void PAL_Compositor_DetachBgConfig(struct BgConfig* bgConfig) {
+    if (g_frameBgConfig == bgConfig) {
+        g_frameBgConfig = NULL;
+    }
+}
+
+void PAL_Compositor_AttachSprites(struct PAL_SpriteManager* sprites) {
+    g_frameSprites = sprites;
+}
+
+void PAL_Compositor_DetachSprites(struct PAL_SpriteManager* sprites) {
+    if (g_frameSprites == sprites) {
+        g_frameSprites = NULL;
+    }
+}
+
+BOOL PAL_Compositor_ComposeFrame(void) {
+    if (!g_frameBgConfig && !g_frameSprites) {
+        return FALSE;
+    }
+    
+    PAL_Compositor_ComposeAll(g_frameBgConfig, g_frameSprites);
+    return TRUE;
+}
+
+const u32* PAL_Compositor_GetFrame(PAL_Screen screen) {
+    CompositorScreen* comp = GetScreen(screen);
+    return comp ? comp->frame : NULL;
+}
+
+void PAL_Compositor_Shutdown(void) {
+    if (!g_compInitialized) return;
+    
+    for (int i = 0; i < PAL_SCREEN_MAX; i++) {
+        if (g_compScreens[i].texture) {
+            SDL_DestroyTexture(g_compScreens[i].texture);
+        }
+        if (g_compScreens[i].frame) {
+            PAL_Free(g_compScreens[i].frame);
+        }
+    }
+    
+    g_compInitialized = FALSE;
+}
+
+// ============================================================================
+// DS Register Entry Points (declared in platform_types.h)
+// ============================================================================
+
+void GX_SetVisibleWnd(u32 mask) { PAL_Compositor_SetVisibleWindows(PAL_SCREEN_MAIN, mask); }
+void GXS_SetVisibleWnd(u32 mask) { PAL_Compositor_SetVisibleWindows(PAL_SCREEN_SUB, mask); }
+
+void G2_SetWnd0InsidePlane(u32 mask, int enable) { PAL_Compositor_SetWindowInside(PAL_SCREEN_MAIN, PAL_WINDOW_0, mask, enable); }
+void G2_SetWnd1InsidePlane(u32 plane, int visible) { PAL_Compositor_SetWindowInside(PAL_SCREEN_MAIN, PAL_WINDOW_1, plane, visible); }
+void G2_SetWndOutsidePlane(u32 mask, int enable) { PAL_Compositor_SetWindowOutside(PAL_SCREEN_MAIN, mask, enable); }
+void G2S_SetWnd0InsidePlane(u32 plane, int visible) { PAL_Compositor_SetWindowInside(PAL_SCREEN_SUB, PAL_WINDOW_0, plane, visible); }
+void G2S_SetWnd1InsidePlane(u32 plane, int visible) { PAL_Compositor_SetWindowInside(PAL_SCREEN_SUB, PAL_WINDOW_1, plane, visible); }
+void G2S_SetWndOutsidePlane(u32 plane, int visible) { PAL_Compositor_SetWindowOutside(PAL_SCREEN_SUB, plane, visible); }
+void G2_SetWndOBJInsidePlane(u32 plane, int visible) { PAL_Compositor_SetObjWindowInside(PAL_SCREEN_MAIN, plane, visible); }
+void G2S_SetWndOBJInsidePlane(u32 plane, int visible) { PAL_Compositor_SetObjWindowInside(PAL_SCREEN_SUB, plane, visible); }
+
+void G2_SetWnd0Position(int x1, int y1, int x2, int y2) { PAL_Compositor_SetWindowRect(PAL_SCREEN_MAIN, PAL_WINDOW_0, x1, y1, x2, y2); }
+void G2_SetWnd1Position(int x1, int y1, int x2, int y2) { PAL_Compositor_SetWindowRect(PAL_SCREEN_MAIN, PAL_WINDOW_1, x1, y1, x2, y2); }
+void G2S_SetWnd0Position(int x1, int y1, int x2, int y2) { PAL_Compositor_SetWindowRect(PAL_SCREEN_SUB, PAL_WINDOW_0, x1, y1, x2, y2); }
+void G2S_SetWnd1Position(int x1, int y1, int x2, int y2) { PAL_Compositor_SetWindowRect(PAL_SCREEN_SUB, PAL_WINDOW_1, x1, y1, x2, y2); }
+
+void G2_BlendNone(void) { PAL_Compositor_BlendNone(PAL_SCREEN_MAIN); }
+void G2S_BlendNone(void) { PAL_Compositor_BlendNone(PAL_SCREEN_SUB); }
+
+void G2_SetBlendAlpha(u32 plane1, u32 plane2, int ev1, int ev2) { PAL_Compositor_SetBlendAlpha(PAL_SCREEN_MAIN, plane1, plane2, ev1, ev2); }
+void G2S_SetBlendAlpha(u32 plane1, u32 plane2, int ev1, int ev2) { PAL_Compositor_SetBlendAlpha(PAL_SCREEN_SUB, plane1, plane2, ev1, ev2); }
+void G2_ChangeBlendAlpha(int ev1, int ev2) { PAL_Compositor_ChangeBlendAlpha(PAL_SCREEN_MAIN, ev1, ev2); }
+void G2S_ChangeBlendAlpha(int ev1, int ev2) { PAL_Compositor_ChangeBlendAlpha(PAL_SCREEN_SUB, ev1, ev2); }
+
+void G2_SetBlendBrightness(int plane, int brightness) { PAL_Compositor_SetBlendBrightness(PAL_SCREEN_MAIN, plane, brightness); }
+void G2S_SetBlendBrightness(int plane, int brightness) { PAL_Compositor_SetBlendBrightness(PAL_SCREEN_SUB, plane, brightness); }
+
+// ============================================================================
+// Helper Functions
+// ============================================================================
+
+static CompositorScreen* GetScreen(PAL_Screen screen) {
+    if (screen >= PAL_SCREEN_MAX) {
+        return NULL;
+    }
+    
+    // Power-on state: no windows, every plane visible, no effect
+    if (!g_compInitialized) {
+        memset(g_compScreens, 0, sizeof(g_compScreens));
+        for (int i = 0; i < PAL_SCREEN_MAX; i++) {
+            g_compScreens[i].winOutside = WINDOW_ALL;
+            g_compScreens[i].winInside[PAL_WINDOW_0] = WINDOW_ALL;
+            g_compScreens[i].winInside[PAL_WINDOW_1] = WINDOW_ALL;
+            g_compScreens[i].winObjInside = WINDOW_ALL;
+        }
+        g_compInitialized = TRUE;
+    }
+    
+    return &g_compScreens[screen];
+}
+
+static BOOL RasterizeObjs(PAL_SpriteManager* sprites, PAL_Screen screen) {
+    int count = sprites ? PAL_Sprite_GetViews(sprites, screen, g_objViews, MAX_OBJS_PER_SCREEN) : 0;
+    if (count == 0) {
+        return FALSE;
+    }
+    
+    memset(g_objColor, 0, sizeof(g_objColor));
+    memset(g_objWindow, 0, sizeof(g_objWindow));
+    for (int i = 0; i < count; i++) {
+        RasterizeObj(&g_objViews[i]);
+    }
+    return TRUE;
+}
+
+static void RasterizeObj(const PAL_SpriteView* view) {
+    // Destination size matches the texture path: scaled, rotated about its center
+    float dstW = view->width * view->scaleX;
+    float dstH = view->height * view->scaleY;
+    if (dstW <= 0.0f || dstH <= 0.0f) {
+        return;
+    }
+    
+    u8 priority = view->priority & 3;
+    float cx = view->x + dstW * 0.5f;
+    float cy = view->y + dstH * 0.5f;
+    float angle = view->affine ? view->rotation * (float)M_PI / 180.0f : 0.0f;
+    float cosA = cosf(angle);
+    float sinA = sinf(angle);
+    
+    // Screen-space bounds of the (possibly rotated) sprite
+    float extentX = (fabsf(dstW * cosA) + fabsf(dstH * sinA)) * 0.5f;
+    float extentY = (fabsf(dstW * sinA) + fabsf(dstH * cosA)) * 0.5f;
+    int x0 = (int)floorf(cx - extentX);
+    int x1 = (int)ceilf(cx + extentX);
+    int y0 = (int)floorf(cy - extentY);
+    int y1 = (int)ceilf(cy + extentY);
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > FRAME_WIDTH) x1 = FRAME_WIDTH;
+    if (y1 > FRAME_HEIGHT) y1 = FRAME_HEIGHT;
+    
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+            // Inverse-map the pixel center into sprite texels
+            float dx = x + 0.5f - cx;
+            float dy = y + 0.5f - cy;
+            float u = (dx * cosA + dy * sinA + dstW * 0.5f) / view->scaleX;
+            float v = (-dx * sinA + dy * cosA + dstH * 0.5f) / view->scaleY;
+            if (u < 0.0f || v < 0.0f) {
+                continue;
+            }
+            
+            int tx = (int)u;
+            int ty = (int)v;
+            if (tx >= view->width || ty >= view->height) {
+                continue;
+            }
+            if (view->flip & PAL_SPRITE_FLIP_H) tx = view->width - 1 - tx;
+            if (view->flip & PAL_SPRITE_FLIP_V) ty = view->height - 1 - ty;
+            
+            int texel = ty * view->width + tx;
+            u8 index;
+            if (view->is8bpp) {
+                index = view->graphics[texel];
+            } else {
+                u8 pair = view->graphics[texel >> 1];
+                index = (texel & 1) ? (pair >> 4) : (pair & 0x0F);
+            }
+            if (index == 0) {
+                continue;
+            }
+            
+            // OBJ window sprites only shape the window, they are never drawn
+            int idx = y * FRAME_WIDTH + x;
+            if (view->objWindow) {
+                g_objWindow[idx] = 1;
+                continue;
+            }
+            
+            // Lower priority value wins; on a tie the earlier OAM slot stays
+            if (g_objColor[idx] && g_objPriority[idx] <= priority) {
+                continue;
+            }
+            
+            g_objColor[idx] = view->palette[index] | 0xFF000000;
+            g_objPriority[idx] = priority;
+            g_objAlpha[idx] = view->alpha;
+            g_objBlend[idx] = (u8)view->blendMode;
+        }
+    }
+}
+
+static BOOL InWindowRange(int pos, int start, int end) {
+    // start > end wraps around the screen edge
+    if (start <= end) {
+        return pos >= start && pos < end;
+    }
+    return pos >= start || pos < end;
+}
+
+static u32 BlendAlpha(u32 top, u32 bottom, int eva, int evb) {
+    u32 out = 0;
+    for (int shift = 0; shift < 24; shift += 8) {
+        int c = (((top >> shift) & 0xFF) * eva + ((bottom >> shift) & 0xFF) * evb) >> 4;
+        out |= (u32)(c > 255 ? 255 : c) << shift;
+    }
+    return out;
+}
+
+static u32 BlendBrightness(u32 color, int evy) {
+    u32 out = 0;
+    for (int shift = 0; shift < 24; shift += 8) {
+        int c = (color >> shift) & 0xFF;
+        // DS formulas: brighten I + (31 - I) * EVY / 16, darken I - I * EVY / 16
+        if (evy > 0) {
+            c += ((255 - c) * evy) >> 4;
+        } else {
+            c -= (c * -evy) >> 4;
+        }
+        out |= (u32)c << shift;
+    }
+    return out;
+}
+
+static u32 BlendObj(u32 top, u32 bottom, u8 alpha, PAL_SpriteBlendMode mode) {
+    u32 out = 0;
+    for (int shift = 0; shift < 24; shift += 8) {
+        int src = (top >> shift) & 0xFF;
+        int dst = (bottom >> shift) & 0xFF;
+        int c;
+        
+        // Same equations as the SDL blend modes used by PAL_Sprite_Render
+        switch (mode) {
+            case PAL_SPRITE_BLEND_ADD:
+                c = dst + ((src * alpha) / 255);
+                break;
+            case PAL_SPRITE_BLEND_SUB:
+                c = ((src * dst) + dst * (255 - alpha)) / 255;
+                break;
+            default:
+                c = (src * alpha + dst * (255 - alpha)) / 255;
+                break;
+        }
+        out |= (u32)(c > 255 ? 255 : c) << shift;
+    }
+    return out;
+}
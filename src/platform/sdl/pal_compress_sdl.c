@@ -0,0 +1,362 @@
+/**
+ * @file pal_compress_sdl.c
+ * @brief LZ10/LZ11 decompression for the SDL3 port
+ *
+ * Stream layout: a flag byte, then eight tokens, each a literal byte (flag
+ * bit 0) or a back-reference (flag bit 1), most significant bit first.
+ *
+ *   LZ10 match  LLLL DDDD DDDD DDDD          length L+3, distance D+1
+ *   LZ11 match  first nibble picks the size:
+ *     0         0000 LLLL LLLL DDDD DDDD DDDD             length L+0x11
+ *     1         0001 LLLL LLLL LLLL LLLL DDDD DDDD DDDD   length L+0x111
+ *     2..15     LLLL DDDD DDDD DDDD                        length L+1
+ *
+ * One-shot and streaming decodes share DecodeTokens, which decodes whole
+ * tokens only. The streaming path keeps the few bytes of a token that
+ * straddles two feeds and completes it before going back to the fast loop.
+ */
+
+#include "platform/pal_compress.h"
+
+#ifdef PLATFORM_SDL
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+#define LZ_HEADER_SIZE 4
+#define LZ_EXTENDED_HEADER_SIZE 8
+
+// A flag byte plus eight of the longest tokens, plus slack for the 8-byte
+// literal copy
+#define FAST_BLOCK_INPUT (1 + 8 * 4 + 8)
+
+static u32 ReadU24LE(const u8* p) {
+    return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16);
+}
+
+static u32 ReadU32LE(const u8* p) {
+    return ReadU24LE(p) | ((u32)p[3] << 24);
+}
+
+// Returns the header length, 0 if more bytes are needed, -1 if invalid
+static int ParseHeader(const u8* src, u32 srcSize, u8* type, u32* size) {
+    if (srcSize < 1) {
+        return 0;
+    }
+    
+    if (src[0] != PAL_LZ_TYPE_LZ10 && src[0] != PAL_LZ_TYPE_LZ11) {
+        return -1;
+    }
+    
+    if (srcSize < LZ_HEADER_SIZE) {
+        return 0;
+    }
+    
+    *type = src[0];
+    *size = ReadU24LE(src + 1);
+    if (*size != 0) {
+        return LZ_HEADER_SIZE;
+    }
+    
+    // A zero size means the real one follows (sizes of 16 MiB and up)
+    if (srcSize < LZ_EXTENDED_HEADER_SIZE) {
+        return 0;
+    }
+    
+    *size = ReadU32LE(src + LZ_HEADER_SIZE);
+    return *size != 0 ? LZ_EXTENDED_HEADER_SIZE : -1;
+}
+
+// ============================================================================
+// Token Decoding
+// ============================================================================
+
+static inline void CopyMatch(u8* out, u32 distance, u32 length, const u8* outEnd) {
+    const u8* from = out - distance;
+    
+    if (distance >= 8 && (u32)(outEnd - out) >= length + 7) {
+        // Whole 8-byte chunks; each one reads bytes that are already final
+        // because the distance is at least a chunk. The last chunk may write
+        // up to 7 bytes past the match, which later tokens overwrite.
+        u8* end = out + length;
+        do {
+            memcpy(out, from, 8);
+            out += 8;
+            from += 8;
+        } while (out < end);
+    } else if (distance == 1) {
+        memset(out, *from, length);
+    } else {
+        // Short repeating pattern, or too close to the end of the output
+        for (u32 i = 0; i < length; i++) {
+            out[i] = from[i];
+        }
+    }
+}
+
+static inline u32 MatchTokenSize(u8 first, BOOL lz11) {
+    if (lz11 && (first >> 4) == 0) {
+        return 3;
+    }
+    if (lz11 && (first >> 4) == 1) {
+        return 4;
+    }
+    return 2;
+}
+
+// Returns the match length; the distance is always in the last two bytes
+static inline u32 DecodeMatch(const u8* token, u32 tokenSize, BOOL lz11, u32* distance) {
+    *distance = (((u32)(token[tokenSize - 2] & 0xF) << 8) | token[tokenSize - 1]) + 1;
+    
+    switch (lz11 ? tokenSize : 0) {
+    case 0:
+        return (token[0] >> 4) + 3;
+    case 3:
+        return (((u32)(token[0] & 0xF) << 4) | (token[1] >> 4)) + 0x11;
+    case 4:
+        return (((u32)(token[0] & 0xF) << 12) | ((u32)token[1] << 4) | (token[2] >> 4)) + 0x111;
+    default:
+        return (token[0] >> 4) + 1;
+    }
+}
+
+/**
+ * Decode one flag byte and its eight tokens without checking the input,
+ * which the caller guarantees holds FAST_BLOCK_INPUT bytes. Literal runs
+ * are copied 8 bytes at a time while the output has room for the overshoot.
+ * Returns FALSE on a bad back-reference.
+ */
+static BOOL DecodeBlockFast(u8** outPtr, const u8** srcPtr, u8* outStart, u8* outEnd, BOOL lz11) {
+    u8* out = *outPtr;
+    const u8* src = *srcPtr;
+    u32 flags = (u32)*src++ << 24;  // Unused tokens read as literals
+    u32 tokens = 8;
+    BOOL ok = TRUE;
+    
+    while (tokens > 0 && out < outEnd) {
+        u32 room = (u32)(outEnd - out);
+        u32 literals = flags != 0 ? 31 - (u32)SDL_MostSignificantBitIndex32(flags) : tokens;
+        
+        if (literals > tokens) {
+            literals = tokens;
+        }
+        if (literals > room) {
+            literals = room;
+        }
+        
+        if (literals > 0) {
+            if (room >= 8) {
+                memcpy(out, src, 8);
+            } else {
+                memcpy(out, src, literals);
+            }
+            out += literals;
+            src += literals;
+            tokens -= literals;
+            flags <<= literals;
+            continue;
+        }
+        
+        u32 distance;
+        u32 tokenSize = MatchTokenSize(src[0], lz11);
+        u32 length = DecodeMatch(src, tokenSize, lz11, &distance);
+        
+        if (distance > (u32)(out - outStart)) {
+            ok = FALSE;
+            break;
+        }
+        
+        if (length > room) {
+            length = room;
+        }
+        
+        CopyMatch(out, distance, length, outEnd);
+        out += length;
+        src += tokenSize;
+        tokens--;
+        flags <<= 1;
+    }
+    
+    *outPtr = out;
+    *srcPtr = src;
+    return ok;
+}
+
+/**
+ * Decode whole tokens from [src, srcEnd) until the output is complete or
+ * the next token is cut off. Returns the first byte not consumed; on a bad
+ * back-reference the stream status is set to PAL_LZ_STREAM_ERROR.
+ */
+static const u8* DecodeTokens(PAL_LZStream* stream, const u8* src, const u8* srcEnd) {
+    u8* const outStart = stream->dest;
+    u8* const outEnd = stream->dest + stream->dest_size;
+    u8* out = stream->dest + stream->dest_pos;
+    u32 flags = stream->flags;
+    u32 flagBits = stream->flag_bits;
+    BOOL lz11 = stream->type == PAL_LZ_TYPE_LZ11;
+    
+    while (out < outEnd) {
+        if (flagBits == 0) {
+            if (srcEnd - src >= FAST_BLOCK_INPUT) {
+                if (!DecodeBlockFast(&out, &src, outStart, outEnd, lz11)) {
+                    stream->status = PAL_LZ_STREAM_ERROR;
+                    break;
+                }
+                continue;
+            }
+            
+            if (src == srcEnd) {
+                break;
+            }
+            
+            flags = *src++;
+            flagBits = 8;
+        }
+        
+        // Near the end of the input: one token at a time, checking each
+        if ((flags & 0x80) == 0) {
+            if (src == srcEnd) {
+                break;
+            }
+            *out++ = *src++;
+        } else {
+            u32 distance;
+            
+            if (src == srcEnd || (u32)(srcEnd - src) < MatchTokenSize(src[0], lz11)) {
+                break;
+            }
+            
+            u32 tokenSize = MatchTokenSize(src[0], lz11);
+            u32 length = DecodeMatch(src, tokenSize, lz11, &distance);
+            
+            if (distance > (u32)(out - outStart)) {
+                stream->status = PAL_LZ_STREAM_ERROR;
+                break;
+            }
+            
+            // Some encoders let the final match run past the declared size;
+            // the BIOS would write the extra bytes, we drop them
+            if (length > (u32)(outEnd - out)) {
+                length = (u32)(outEnd - out);
+            }
+            
+            CopyMatch(out, distance, length, outEnd);
+            out += length;
+            src += tokenSize;
+        }
+        
+        flags <<= 1;
+        flagBits--;
+    }
+    
+    stream->dest_pos = (u32)(out - outStart);
+    stream->flags = (u8)flags;
+    stream->flag_bits = (u8)flagBits;
+    
+    if (stream->status != PAL_LZ_STREAM_ERROR && out == outEnd) {
+        stream->status = PAL_LZ_STREAM_DONE;
+    }
+    
+    return src;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+BOOL PAL_LZ_IsCompressed(const void* src, u32 srcSize) {
+    u8 type;
+    u32 size;
+    
+    return src && ParseHeader(src, srcSize, &type, &size) > 0;
+}
+
+u32 PAL_LZ_GetUncompressedSize(const void* src, u32 srcSize) {
+    u8 type;
+    u32 size;
+    
+    if (!src || ParseHeader(src, srcSize, &type, &size) <= 0) {
+        return 0;
+    }
+    return size;
+}
+
+u32 PAL_LZ_Decompress(const void* src, u32 srcSize, void* dest, u32 destSize) {
+    PAL_LZStream stream;
+    const u8* in = src;
+    
+    if (!src || !dest) {
+        return 0;
+    }
+    
+    PAL_LZ_StreamInit(&stream, dest, destSize);
+    
+    int headerSize = ParseHeader(in, srcSize, &stream.type, &stream.dest_size);
+    if (headerSize <= 0 || stream.dest_size > destSize) {
+        return 0;
+    }
+    
+    DecodeTokens(&stream, in + headerSize, in + srcSize);
+    return stream.status == PAL_LZ_STREAM_DONE ? stream.dest_size : 0;
+}
+
+void PAL_LZ_StreamInit(PAL_LZStream* stream, void* dest, u32 destCapacity) {
+    memset(stream, 0, sizeof(*stream));
+    stream->dest = dest;
+    stream->dest_capacity = dest ? destCapacity : 0;
+    stream->status = PAL_LZ_STREAM_NEED_INPUT;
+}
+
+PAL_LZStreamStatus PAL_LZ_StreamFeed(PAL_LZStream* stream, const void* src, u32 srcSize) {
+    const u8* in = src;
+    const u8* inEnd = in + srcSize;
+    
+    if (stream->status != PAL_LZ_STREAM_NEED_INPUT || !src) {
+        return stream->status;
+    }
+    
+    // Header, possibly split across feeds
+    while (stream->dest_size == 0 && in < inEnd) {
+        stream->pending[stream->pending_count++] = *in++;
+        
+        int headerSize = ParseHeader(stream->pending, stream->pending_count, &stream->type, &stream->dest_size);
+        if (headerSize < 0 || (headerSize > 0 && stream->dest_size > stream->dest_capacity)) {
+            stream->dest_size = 0;
+            stream->status = PAL_LZ_STREAM_ERROR;
+            return stream->status;
+        }
+        if (headerSize > 0) {
+            stream->pending_count = 0;
+        }
+    }
+    
+    // Finish a token left over from the last feed, one byte at a time; a
+    // token is at most 4 bytes so this ends within a few iterations
+    while (stream->pending_count > 0 && in < inEnd && stream->status == PAL_LZ_STREAM_NEED_INPUT) {
+        stream->pending[stream->pending_count++] = *in++;
+        
+        const u8* used = DecodeTokens(stream, stream->pending, stream->pending + stream->pending_count);
+        u32 consumed = (u32)(used - stream->pending);
+        
+        stream->pending_count -= consumed;
+        memmove(stream->pending, used, stream->pending_count);
+    }
+    
+    if (stream->pending_count == 0 && in < inEnd && stream->status == PAL_LZ_STREAM_NEED_INPUT) {
+        in = DecodeTokens(stream, in, inEnd);
+        
+        // Only a cut-off token can be left over
+        if (stream->status == PAL_LZ_STREAM_NEED_INPUT) {
+            stream->pending_count = (u8)(inEnd - in);
+            memcpy(stream->pending, in, stream->pending_count);
+        }
+    }
+    
+    return stream->status;
+}
+
+u32 PAL_LZ_StreamGetOutputSize(const PAL_LZStream* stream) {
+    return stream->dest_pos;
+}
+
+#endif // PLATFORM_SDL
@@ -0,0 +1,334 @@
+/**
+ * @file pal_crypt_sdl.c
+ * @brief SDL3 implementation of the LCRNG stream cipher kernels
+ *
+ * Lane j of a k-lane kernel starts at x[j + 1] = A_(j+1) * seed + C_(j+1) and
+ * advances by x[n + k] = A_k * x[n] + C_k, so one vector step yields the next
+ * k keys in order. The jump constants are A_k = A^k and
+ * C_k = C * (A^(k-1) + ... + A + 1), all modulo 2^32.
+ */
+
+#include "platform/pal_crypt.h"
+
+#ifdef PLATFORM_SDL
+
+#include <SDL3/SDL.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define HAVE_X86_SIMD 1
+    #include <emmintrin.h>
+    #include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define HAVE_NEON_SIMD 1
+    #include <arm_neon.h>
+#endif
+
+// GCC/Clang need per-function target attributes to emit AVX2 (and SSE2 on
+// 32-bit x86) without raising the baseline of the whole executable
+#if defined(__GNUC__) || defined(__clang__)
+    #define PAL_TARGET_SSE2 __attribute__((target("sse2")))
+    #define PAL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define PAL_TARGET_SSE2
+    #define PAL_TARGET_AVX2
+#endif
+
+#define LCRNG_MUL 1103515245u
+#define LCRNG_ADD 24691u
+
+#define MAX_LANES 16
+
+// Jump constants for k = 1..16 steps (index k - 1)
+static const u32 sJumpMul[MAX_LANES] = {
+    0x41C64E6D, 0xC2A29A69, 0x807DBCB5, 0xEE067F11,
+    0xEBA1483D, 0xD3DC57F9, 0x9B355305, 0xCFDDDF21,
+    0x0FFA0F0D, 0xEF1C5E89, 0x5AD7FE55, 0xC8333031,
+    0x8D6072DD, 0x88FE3E19, 0x2B820EA5, 0x5F748241,
+};
+
+static const u32 sJumpAdd[MAX_LANES] = {
+    0x00006073, 0xE97E7B6A, 0x52713895, 0x31B0DDE4,
+    0x8E425287, 0xE2CCA5EE, 0xAFC58AC9, 0x67DBB608,
+    0xFC3351DB, 0xEF2CF4B2, 0xFC5ECC3D, 0xCAC5EC6C,
+    0xEBD6F26F, 0x993D6BB6, 0x7ABCB0F1, 0xCBA72510,
+};
+
+// XORs count halfwords with the keystream; returns the sum of the
+// transformed halfwords when checksum is set, 0 otherwise
+typedef u16 (*XorStreamFunc)(u16* data, u32 count, u32 seed, BOOL checksum);
+
+static XorStreamFunc g_activeFunc = NULL;
+static PAL_CryptPath g_activePath = PAL_CRYPT_SCALAR;
+
+// Fills states[0..lanes) with x[1..lanes] for the given seed
+static inline void SeedLanes(u32* states, int lanes, u32 seed) {
+    for (int j = 0; j < lanes; j++) {
+        states[j] = sJumpMul[j] * seed + sJumpAdd[j];
+    }
+}
+
+// Finishes the last count < lanes halfwords from the keys of the next step
+static inline u16 XorTail(u16* data, u32 count, const u16* keys, BOOL checksum) {
+    u16 sum = 0;
+
+    for (u32 i = 0; i < count; i++) {
+        data[i] ^= keys[i];
+        sum += checksum ? data[i] : 0;
+    }
+    return sum;
+}
+
+// ============================================================================
+// Scalar
+// ============================================================================
+
+static u16 XorStream_Scalar(u16* data, u32 count, u32 seed, BOOL checksum) {
+    u16 sum = 0;
+
+    // Separate loops so the plain one carries nothing but the LCRNG chain
+    if (checksum) {
+        for (u32 i = 0; i < count; i++) {
+            seed = seed * LCRNG_MUL + LCRNG_ADD;
+            data[i] ^= (u16)(seed >> 16);
+            sum += data[i];
+        }
+    } else {
+        for (u32 i = 0; i < count; i++) {
+            seed = seed * LCRNG_MUL + LCRNG_ADD;
+            data[i] ^= (u16)(seed >> 16);
+        }
+    }
+    return sum;
+}
+
+// ============================================================================
+// SSE2 (x86)
+// ============================================================================
+
+#ifdef HAVE_X86_SIMD
+
+// SSE2 has no 32-bit low multiply; multiply the even and odd lanes as 64-bit
+// products and interleave their low halves back
+PAL_TARGET_SSE2 static inline __m128i MulLo32_SSE2(__m128i a, __m128i b) {
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// High halfwords of eight states, in lane order. The arithmetic shift keeps
+// each value in int16 range, so the saturating pack is exact.
+PAL_TARGET_SSE2 static inline __m128i Keys_SSE2(__m128i lo, __m128i hi) {
+    return _mm_packs_epi32(_mm_srai_epi32(lo, 16), _mm_srai_epi32(hi, 16));
+}
+
+PAL_TARGET_SSE2 static inline u16 SumHalfwords_SSE2(__m128i v) {
+    v = _mm_add_epi16(v, _mm_srli_si128(v, 8));
+    v = _mm_add_epi16(v, _mm_srli_si128(v, 4));
+    v = _mm_add_epi16(v, _mm_srli_si128(v, 2));
+    return (u16)_mm_cvtsi128_si32(v);
+}
+
+PAL_TARGET_SSE2 static u16 XorStream_SSE2(u16* data, u32 count, u32 seed, BOOL checksum) {
+    u32 states[8];
+    SeedLanes(states, 8, seed);
+
+    __m128i lo = _mm_loadu_si128((const __m128i*)&states[0]);
+    __m128i hi = _mm_loadu_si128((const __m128i*)&states[4]);
+    __m128i mul = _mm_set1_epi32((int)sJumpMul[7]);
+    __m128i add = _mm_set1_epi32((int)sJumpAdd[7]);
+    __m128i sum = _mm_setzero_si128();
+
+    for (; count >= 8; count -= 8, data += 8) {
+        __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i*)data), Keys_SSE2(lo, hi));
+        _mm_storeu_si128((__m128i*)data, v);
+        sum = _mm_add_epi16(sum, v);
+
+        lo = _mm_add_epi32(MulLo32_SSE2(lo, mul), add);
+        hi = _mm_add_epi32(MulLo32_SSE2(hi, mul), add);
+    }
+
+    u16 total = checksum ? SumHalfwords_SSE2(sum) : 0;
+
+    if (count > 0) {
+        u16 keys[8];
+        _mm_storeu_si128((__m128i*)keys, Keys_SSE2(lo, hi));
+        total += XorTail(data, count, keys, checksum);
+    }
+    return total;
+}
+
+// ============================================================================
+// AVX2 (x86)
+// ============================================================================
+
+// packs works within 128-bit halves, giving 64-bit groups in the order
+// lo[0..3], hi[0..3], lo[4..7], hi[4..7]; the permute restores lane order
+PAL_TARGET_AVX2 static inline __m256i Keys_AVX2(__m256i lo, __m256i hi) {
+    __m256i packed = _mm256_packs_epi32(_mm256_srai_epi32(lo, 16), _mm256_srai_epi32(hi, 16));
+
+    return _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+PAL_TARGET_AVX2 static u16 XorStream_AVX2(u16* data, u32 count, u32 seed, BOOL checksum) {
+    u32 states[16];
+    SeedLanes(states, 16, seed);
+
+    __m256i lo = _mm256_loadu_si256((const __m256i*)&states[0]);
+    __m256i hi = _mm256_loadu_si256((const __m256i*)&states[8]);
+    __m256i mul = _mm256_set1_epi32((int)sJumpMul[15]);
+    __m256i add = _mm256_set1_epi32((int)sJumpAdd[15]);
+    __m256i sum = _mm256_setzero_si256();
+
+    for (; count >= 16; count -= 16, data += 16) {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)data), Keys_AVX2(lo, hi));
+        _mm256_storeu_si256((__m256i*)data, v);
+        sum = _mm256_add_epi16(sum, v);
+
+        lo = _mm256_add_epi32(_mm256_mullo_epi32(lo, mul), add);
+        hi = _mm256_add_epi32(_mm256_mullo_epi32(hi, mul), add);
+    }
+
+    u16 total = 0;
+
+    if (checksum) {
+        __m128i half = _mm_add_epi16(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        half = _mm_add_epi16(half, _mm_srli_si128(half, 8));
+        half = _mm_add_epi16(half, _mm_srli_si128(half, 4));
+        half = _mm_add_epi16(half, _mm_srli_si128(half, 2));
+        total = (u16)_mm_cvtsi128_si32(half);
+    }
+
+    if (count > 0) {
+        u16 keys[16];
+        _mm256_storeu_si256((__m256i*)keys, Keys_AVX2(lo, hi));
+        total += XorTail(data, count, keys, checksum);
+    }
+    return total;
+}
+
+#endif // HAVE_X86_SIMD
+
+// ============================================================================
+// NEON (ARM64)
+// ============================================================================
+
+#ifdef HAVE_NEON_SIMD
+
+static inline uint16x8_t Keys_NEON(uint32x4_t lo, uint32x4_t hi) {
+    return vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16));
+}
+
+static u16 XorStream_NEON(u16* data, u32 count, u32 seed, BOOL checksum) {
+    u32 states[8];
+    SeedLanes(states, 8, seed);
+
+    uint32x4_t lo = vld1q_u32(&states[0]);
+    uint32x4_t hi = vld1q_u32(&states[4]);
+    uint32x4_t mul = vdupq_n_u32(sJumpMul[7]);
+    uint32x4_t add = vdupq_n_u32(sJumpAdd[7]);
+    uint16x8_t sum = vdupq_n_u16(0);
+
+    for (; count >= 8; count -= 8, data += 8) {
+        uint16x8_t v = veorq_u16(vld1q_u16(data), Keys_NEON(lo, hi));
+        vst1q_u16(data, v);
+        sum = vaddq_u16(sum, v);
+
+        lo = vmlaq_u32(add, lo, mul);
+        hi = vmlaq_u32(add, hi, mul);
+    }
+
+    u16 total = checksum ? vaddvq_u16(sum) : 0;
+
+    if (count > 0) {
+        u16 keys[8];
+        vst1q_u16(keys, Keys_NEON(lo, hi));
+        total += XorTail(data, count, keys, checksum);
+    }
+    return total;
+}
+
+#endif // HAVE_NEON_SIMD
+
+// ============================================================================
+// Path selection
+// ============================================================================
+
+static XorStreamFunc GetPathFunc(PAL_CryptPath path) {
+    switch (path) {
+        case PAL_CRYPT_SCALAR:
+            return XorStream_Scalar;
+#ifdef HAVE_X86_SIMD
+        case PAL_CRYPT_SSE2:
+            return SDL_HasSSE2() ? XorStream_SSE2 : NULL;
+        case PAL_CRYPT_AVX2:
+            return SDL_HasAVX2() ? XorStream_AVX2 : NULL;
+#endif
+#ifdef HAVE_NEON_SIMD
+        case PAL_CRYPT_NEON:
+            return SDL_HasNEON() ? XorStream_NEON : NULL;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+static inline XorStreamFunc GetActiveFunc(void) {
+    if (!g_activeFunc) {
+        // Prefer the widest supported path
+        static const PAL_CryptPath preference[] = {
+            PAL_CRYPT_AVX2,
+            PAL_CRYPT_NEON,
+            PAL_CRYPT_SSE2,
+            PAL_CRYPT_SCALAR,
+        };
+
+        for (size_t i = 0; i < sizeof(preference) / sizeof(preference[0]); i++) {
+            if (PAL_Crypt_SetPath(preference[i])) {
+                break;
+            }
+        }
+    }
+    return g_activeFunc;
+}
+
+PAL_CryptPath PAL_Crypt_GetPath(void) {
+    GetActiveFunc();
+    return g_activePath;
+}
+
+BOOL PAL_Crypt_SetPath(PAL_CryptPath path) {
+    XorStreamFunc func = GetPathFunc(path);
+    if (!func) {
+        return FALSE;
+    }
+    g_activeFunc = func;
+    g_activePath = path;
+    return TRUE;
+}
+
+BOOL PAL_Crypt_IsPathSupported(PAL_CryptPath path) {
+    return GetPathFunc(path) != NULL;
+}
+
+const char* PAL_Crypt_GetPathName(PAL_CryptPath path) {
+    static const char* names[PAL_CRYPT_PATH_MAX] = {
+        "scalar", "sse2", "avx2", "neon"
+    };
+    return (path < PAL_CRYPT_PATH_MAX) ? names[path] : "unknown";
+}
+
+// ============================================================================
+// Keystream
+// ============================================================================
+
+void PAL_Crypt_LCRNGXor(void* data, u32 size, u32 seed) {
+    GetActiveFunc()((u16*)data, size / 2, seed, FALSE);
+}
+
+u16 PAL_Crypt_LCRNGXorChecksum(void* data, u32 size, u32 seed) {
+    return GetActiveFunc()((u16*)data, size / 2, seed, TRUE);
+}
+
+#endif // PLATFORM_SDL
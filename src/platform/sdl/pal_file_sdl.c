@@ -19,6 +19,8 @@
     #define PATH_SEPARATOR '\\'
 #else
     #include <dirent.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
     #include <unistd.h>
     #define PATH_SEPARATOR '/'
 #endif
@@ -62,6 +64,71 @@ long PAL_File_Tell(PAL_File file) {
     return ftell((FILE*)file);
 }
 
+const void* PAL_File_Map(const char* path, size_t* size) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+    
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return NULL;
+    }
+    
+    // The view keeps the mapping alive, so neither handle is needed afterwards
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) {
+        return NULL;
+    }
+    
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data) {
+        return NULL;
+    }
+    
+    *size = (size_t)fileSize.QuadPart;
+    return data;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+    
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return NULL;
+    }
+    
+    *size = (size_t)st.st_size;
+    return data;
+#endif
+}
+
+void PAL_File_Unmap(const void* data, size_t size) {
+    if (!data) {
+        return;
+    }
+    
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(data);
+#else
+    munmap((void*)data, size);
+#endif
+}
+
 #ifdef _WIN32
 // Windows directory implementation
 struct PAL_Dir_Internal {
@@ -204,4 +271,133 @@ BOOL PAL_Path_IsDirectory(const char* path) {
 #endif
 }
 
+// ============================================================================
+// Asset Pack
+// ============================================================================
+
+// Container layout, see tools/pack_assets.py
+#define ASSET_PACK_VERSION 1
+#define ASSET_PACK_EMPTY_KEY 0xFFFFFFFF
+
+typedef struct {
+    char magic[4];
+    u32 version;
+    u32 num_entries;
+    u32 num_buckets;
+    u32 dir_offset;
+    u32 data_offset;
+    u32 page_size;
+    u32 reserved;
+} AssetPackHeader;
+
+typedef struct {
+    u32 key;
+    u32 offset;
+    u32 size;
+    u32 reserved;
+} AssetPackEntry;
+
+static struct {
+    const u8* data;
+    size_t size;
+    const AssetPackEntry* buckets;
+    u32 bucket_mask;
+    u32 bucket_shift;
+} g_assetPack;
+
+static u32 AssetPackKey(u32 narcID, u32 member, PAL_AssetKind kind) {
+    return ((narcID & 0xFFF) << 20) | ((member & 0xFFFF) << 4) | ((u32)kind & 0xF);
+}
+
+static u32 AssetPackHash(u32 key) {
+    return (key * 0x9E3779B1u) >> g_assetPack.bucket_shift;
+}
+
+BOOL PAL_AssetPack_Open(const char* path) {
+    size_t size;
+    const u8* data = PAL_File_Map(path, &size);
+    
+    PAL_AssetPack_Close();
+    
+    if (!data) {
+        return FALSE;
+    }
+    
+    const AssetPackHeader* header = (const AssetPackHeader*)data;
+    BOOL valid = size >= sizeof(AssetPackHeader)
+        && memcmp(header->magic, "PPAK", 4) == 0
+        && header->version == ASSET_PACK_VERSION
+        && header->num_buckets >= 2
+        && (header->num_buckets & (header->num_buckets - 1)) == 0
+        && header->num_entries < header->num_buckets
+        && header->dir_offset % sizeof(u32) == 0
+        && header->dir_offset <= size
+        && (size - header->dir_offset) / sizeof(AssetPackEntry) >= header->num_buckets;
+    
+    if (!valid) {
+        printf("[AssetPack] %s is not a valid version %d asset pack\n", path, ASSET_PACK_VERSION);
+        PAL_File_Unmap(data, size);
+        return FALSE;
+    }
+    
+    // Check every entry once here so lookups can trust them
+    const AssetPackEntry* buckets = (const AssetPackEntry*)(data + header->dir_offset);
+    for (u32 i = 0; i < header->num_buckets; i++) {
+        if (buckets[i].key != ASSET_PACK_EMPTY_KEY
+            && (buckets[i].offset > size || buckets[i].size > size - buckets[i].offset)) {
+            printf("[AssetPack] %s: entry %u lies outside the file\n", path, i);
+            PAL_File_Unmap(data, size);
+            return FALSE;
+        }
+    }
+    
+    g_assetPack.data = data;
+    g_assetPack.size = size;
+    g_assetPack.buckets = buckets;
+    g_assetPack.bucket_mask = header->num_buckets - 1;
+    g_assetPack.bucket_shift = 32 - (u32)SDL_MostSignificantBitIndex32(header->num_buckets);
+    
+    printf("[AssetPack] Mapped %s (%u assets, %.1f MB)\n", path, header->num_entries, size / (1024.0 * 1024.0));
+    return TRUE;
+}
+
+void PAL_AssetPack_Close(void) {
+    PAL_File_Unmap(g_assetPack.data, g_assetPack.size);
+    memset(&g_assetPack, 0, sizeof(g_assetPack));
+}
+
+BOOL PAL_AssetPack_IsOpen(void) {
+    return g_assetPack.data != NULL;
+}
+
+const void* PAL_AssetPack_Find(u32 narcID, u32 member, PAL_AssetKind kind, u32* size) {
+    if (!g_assetPack.data) {
+        return NULL;
+    }
+    
+    u32 key = AssetPackKey(narcID, member, kind);
+    u32 slot = AssetPackHash(key);
+    
+    // The packer keeps at least half the buckets empty, so probes are short;
+    // the bound only guards against a malformed directory
+    for (u32 probes = 0; probes <= g_assetPack.bucket_mask; probes++) {
+        const AssetPackEntry* entry = &g_assetPack.buckets[slot];
+        
+        if (entry->key == key) {
+            if (size) {
+                *size = entry->size;
+            }
+            return g_assetPack.data + entry->offset;
+        }
+        
+        if (entry->key == ASSET_PACK_EMPTY_KEY) {
+            break;
+        }
+        
+        slot = (slot + 1) & g_assetPack.bucket_mask;
+    }
+    
+    return NULL;
+}
+
 #endif // PLATFORM_SDL
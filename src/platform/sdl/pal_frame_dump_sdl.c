@@ -0,0 +1,300 @@
+/**
+ * @file pal_frame_dump_sdl.c
+ * @brief SDL3 implementation of the frame dump sink
+ *
+ * PNG output uses stored (uncompressed) deflate blocks. Files are larger
+ * than a real encoder would produce, but writing one costs little more
+ * than a memcpy, which keeps batch runs from becoming I/O bound on zlib.
+ */
+
+#include "platform/pal_frame_dump.h"
+#include "platform/pal_file.h"
+#include "platform/pal_memory.h"
+
+#ifdef PLATFORM_SDL
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+#define FRAME_DUMP_PATH_MAX 512
+
+// Largest payload of one stored deflate block
+#define DEFLATE_STORED_BLOCK_MAX 65535
+
+static struct {
+    char directory[FRAME_DUMP_PATH_MAX];
+    PAL_FrameDumpFormat format;
+    u32 interval;
+    u32 submitted;      // Frames offered since Start
+    u32 written;        // Files written since Start
+    u8* scratch;        // PNG scanline/IDAT buffer, grown on demand
+    size_t scratch_size;
+    BOOL active;
+} g_frameDump;
+
+// ============================================================================
+// PNG Encoder
+// ============================================================================
+
+static u32 g_crcTable[256];
+static BOOL g_crcTableReady = FALSE;
+
+static void BuildCRCTable(void) {
+    for (u32 n = 0; n < 256; n++) {
+        u32 c = n;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        }
+        g_crcTable[n] = c;
+    }
+    g_crcTableReady = TRUE;
+}
+
+static u32 UpdateCRC(u32 crc, const u8* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        crc = g_crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+static void PutBE32(u8* dst, u32 value) {
+    dst[0] = (u8)(value >> 24);
+    dst[1] = (u8)(value >> 16);
+    dst[2] = (u8)(value >> 8);
+    dst[3] = (u8)value;
+}
+
+static BOOL WriteChunk(PAL_File file, const char* type, const u8* data, u32 size) {
+    u8 header[8];
+    u8 trailer[4];
+    
+    PutBE32(header, size);
+    memcpy(header + 4, type, 4);
+    
+    u32 crc = UpdateCRC(0xFFFFFFFFu, header + 4, 4);
+    crc = UpdateCRC(crc, data, size);
+    PutBE32(trailer, crc ^ 0xFFFFFFFFu);
+    
+    return PAL_File_Write(header, 1, sizeof(header), file) == sizeof(header)
+        && (size == 0 || PAL_File_Write(data, 1, size, file) == size)
+        && PAL_File_Write(trailer, 1, sizeof(trailer), file) == sizeof(trailer);
+}
+
+static u8* GetScratch(size_t size) {
+    if (g_frameDump.scratch_size < size) {
+        PAL_Free(g_frameDump.scratch);
+        g_frameDump.scratch = PAL_Malloc(size, 0);
+        g_frameDump.scratch_size = g_frameDump.scratch ? size : 0;
+    }
+    return g_frameDump.scratch;
+}
+
+BOOL PAL_FrameDump_WritePNG(const char* path, const void* pixels, int width, int height, int pitch) {
+    static const u8 signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    
+    if (!path || !pixels || width <= 0 || height <= 0) {
+        return FALSE;
+    }
+    
+    if (!g_crcTableReady) {
+        BuildCRCTable();
+    }
+    
+    // zlib stream: 2 byte header, stored blocks (5 byte header each), adler32
+    size_t rowSize = 1 + (size_t)width * 4;
+    size_t rawSize = rowSize * (size_t)height;
+    size_t numBlocks = (rawSize + DEFLATE_STORED_BLOCK_MAX - 1) / DEFLATE_STORED_BLOCK_MAX;
+    size_t idatSize = 2 + numBlocks * 5 + rawSize + 4;
+    
+    if (idatSize > 0x7FFFFFFFu) {
+        return FALSE;
+    }
+    
+    u8* idat = GetScratch(idatSize);
+    if (!idat) {
+        return FALSE;
+    }
+    
+    u8* out = idat;
+    *out++ = 0x78;      // CM = deflate, 32K window
+    *out++ = 0x01;      // No dictionary, fastest; (0x7801 % 31 == 0)
+    
+    // Scanlines are emitted straight into the block payloads; a row may
+    // straddle two blocks, so track the remaining room of the open block
+    u32 adlerA = 1;
+    u32 adlerB = 0;
+    size_t blockLeft = 0;
+    size_t rawLeft = rawSize;
+    
+    for (int y = 0; y < height; y++) {
+        const u8* src = (const u8*)pixels + (size_t)y * pitch;
+        size_t rowLeft = rowSize;
+        BOOL filterByte = TRUE;
+        
+        while (rowLeft > 0) {
+            if (blockLeft == 0) {
+                blockLeft = rawLeft < DEFLATE_STORED_BLOCK_MAX ? rawLeft : DEFLATE_STORED_BLOCK_MAX;
+                rawLeft -= blockLeft;
+                *out++ = rawLeft == 0 ? 1 : 0;  // BFINAL, BTYPE = stored
+                *out++ = (u8)blockLeft;
+                *out++ = (u8)(blockLeft >> 8);
+                *out++ = (u8)~blockLeft;
+                *out++ = (u8)(~blockLeft >> 8);
+            }
+            
+            size_t n = rowLeft < blockLeft ? rowLeft : blockLeft;
+            u8* dst = out;
+            
+            if (filterByte) {
+                *out++ = 0;     // Filter type None
+                n--;
+                filterByte = FALSE;
+                rowLeft--;
+                blockLeft--;
+            }
+            
+            memcpy(out, src, n);
+            out += n;
+            src += n;
+            rowLeft -= n;
+            blockLeft -= n;
+            
+            for (u8* p = dst; p < out; p++) {
+                adlerA += *p;
+                if (adlerA >= 65521) {
+                    adlerA -= 65521;
+                }
+                adlerB += adlerA;
+                if (adlerB >= 65521) {
+                    adlerB -= 65521;
+                }
+            }
+        }
+    }
+    
+    PutBE32(out, (adlerB << 16) | adlerA);
+    out += 4;
+    
+    u8 ihdr[13];
+    PutBE32(ihdr, (u32)width);
+    PutBE32(ihdr + 4, (u32)height);
+    ihdr[8] = 8;        // Bit depth
+    ihdr[9] = 6;        // Color type RGBA
+    ihdr[10] = 0;       // Compression
+    ihdr[11] = 0;       // Filter method
+    ihdr[12] = 0;       // No interlace
+    
+    PAL_File file = PAL_File_Open(path, "wb");
+    if (!file) {
+        return FALSE;
+    }
+    
+    BOOL ok = PAL_File_Write(signature, 1, sizeof(signature), file) == sizeof(signature)
+        && WriteChunk(file, "IHDR", ihdr, sizeof(ihdr))
+        && WriteChunk(file, "IDAT", idat, (u32)(out - idat))
+        && WriteChunk(file, "IEND", NULL, 0);
+    
+    PAL_File_Close(file);
+    return ok;
+}
+
+// ============================================================================
+// Raw Output
+// ============================================================================
+
+static BOOL WriteRaw(const char* path, const void* pixels, int width, int height, int pitch) {
+    PAL_File file = PAL_File_Open(path, "wb");
+    if (!file) {
+        return FALSE;
+    }
+    
+    size_t rowSize = (size_t)width * 4;
+    BOOL ok = TRUE;
+    
+    if ((size_t)pitch == rowSize) {
+        ok = PAL_File_Write(pixels, rowSize, height, file) == (size_t)height;
+    } else {
+        for (int y = 0; y < height && ok; y++) {
+            ok = PAL_File_Write((const u8*)pixels + (size_t)y * pitch, 1, rowSize, file) == rowSize;
+        }
+    }
+    
+    PAL_File_Close(file);
+    return ok;
+}
+
+// ============================================================================
+// Sink
+// ============================================================================
+
+BOOL PAL_FrameDump_Start(const char* directory, PAL_FrameDumpFormat format, u32 interval) {
+    if (!directory || strlen(directory) + 32 >= FRAME_DUMP_PATH_MAX) {
+        return FALSE;
+    }
+    
+    if (!PAL_Path_IsDirectory(directory) && !SDL_CreateDirectory(directory)) {
+        printf("[FrameDump] Can't create %s: %s\n", directory, SDL_GetError());
+        return FALSE;
+    }
+    
+    strcpy(g_frameDump.directory, directory);
+    g_frameDump.format = format;
+    g_frameDump.interval = interval > 1 ? interval : 1;
+    g_frameDump.submitted = 0;
+    g_frameDump.written = 0;
+    g_frameDump.active = TRUE;
+    return TRUE;
+}
+
+void PAL_FrameDump_Stop(void) {
+    PAL_Free(g_frameDump.scratch);
+    g_frameDump.scratch = NULL;
+    g_frameDump.scratch_size = 0;
+    g_frameDump.active = FALSE;
+}
+
+BOOL PAL_FrameDump_IsActive(void) {
+    return g_frameDump.active;
+}
+
+BOOL PAL_FrameDump_WantsNextFrame(void) {
+    return g_frameDump.active && (g_frameDump.submitted % g_frameDump.interval) == 0;
+}
+
+void PAL_FrameDump_Submit(const void* pixels, int width, int height, int pitch) {
+    if (!g_frameDump.active) {
+        return;
+    }
+    
+    u32 frame = g_frameDump.submitted++;
+    if (frame % g_frameDump.interval != 0 || !pixels) {
+        return;
+    }
+    
+    char path[FRAME_DUMP_PATH_MAX];
+    BOOL ok;
+    
+    if (g_frameDump.format == PAL_FRAME_DUMP_PNG) {
+        snprintf(path, sizeof(path), "%s/frame_%06u.png", g_frameDump.directory, frame);
+        ok = PAL_FrameDump_WritePNG(path, pixels, width, height, pitch);
+    } else {
+        snprintf(path, sizeof(path), "%s/frame_%06u.rgba", g_frameDump.directory, frame);
+        ok = WriteRaw(path, pixels, width, height, pitch);
+    }
+    
+    if (!ok) {
+        // A full disk would otherwise print once per frame
+        printf("[FrameDump] Failed to write %s, stopping\n", path);
+        PAL_FrameDump_Stop();
+        return;
+    }
+    
+    g_frameDump.written++;
+}
+
+u32 PAL_FrameDump_GetWrittenCount(void) {
+    return g_frameDump.written;
+}
+
+#endif // PLATFORM_SDL
@@ -0,0 +1,311 @@
+/**
+ * @file pal_frame_pacer_sdl.c
+ * @brief SDL3 implementation of frame pacing and frame-time telemetry
+ */
+
+#include "platform/pal_frame_pacer.h"
+#include "platform/pal_timer.h"
+
+#ifdef PLATFORM_SDL
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Falling further behind than this drops the backlog instead of running
+// the missed frames back to back
+#define PACER_MAX_LAG_FRAMES 4
+
+// Bounds of the spin-finish window. The OS sleep is asked to wake up this
+// much early and the rest is busy-waited on the performance counter.
+#define PACER_SPIN_MIN_NS 200000
+#define PACER_SPIN_MAX_NS 4000000
+
+static const char* const s_phaseNames[PAL_FRAME_PHASE_MAX] = {
+    "input", "tasks", "render", "present", "wait"
+};
+
+static struct {
+    PAL_PaceMode mode;
+    BOOL fast_forward;
+    
+    u64 freq;
+    
+    // Next deadline in counter ticks; the frame period is split into whole
+    // ticks plus a 32-bit fraction so fractional rates don't drift
+    u64 deadline;
+    u32 deadline_frac;
+    u64 period;
+    u32 period_frac;
+    
+    u64 spin_ns;            // Current spin-finish window
+    
+    u64 frame_start;
+    u64 phase_start[PAL_FRAME_PHASE_MAX];
+    u64 phase_ticks[PAL_FRAME_PHASE_MAX];
+    
+    PAL_FrameTiming history[PAL_FRAME_PACER_HISTORY];
+    u32 history_head;       // Next slot to write
+    u32 history_count;
+    
+    u64 total_frames;
+    u64 late_frames;
+    u64 resyncs;
+} g_pacer;
+
+static u32 TicksToMicroseconds(u64 ticks) {
+    u64 us = ticks * 1000000 / g_pacer.freq;
+    return us > 0xFFFFFFFFu ? 0xFFFFFFFFu : (u32)us;
+}
+
+static u64 TicksToNanoseconds(u64 ticks) {
+    return ticks * 1000000000 / g_pacer.freq;
+}
+
+static void AdvanceDeadline(void) {
+    u32 frac = g_pacer.deadline_frac + g_pacer.period_frac;
+    g_pacer.deadline += g_pacer.period + (frac < g_pacer.deadline_frac ? 1 : 0);
+    g_pacer.deadline_frac = frac;
+}
+
+static void Resync(u64 now) {
+    g_pacer.deadline = now;
+    g_pacer.deadline_frac = 0;
+    AdvanceDeadline();
+}
+
+void PAL_FramePacer_Init(double refreshHz) {
+    if (refreshHz <= 0.0) {
+        refreshHz = PAL_FRAME_PACER_DS_REFRESH_HZ;
+    }
+    
+    memset(&g_pacer, 0, sizeof(g_pacer));
+    g_pacer.mode = PAL_PACE_TIMED;
+    g_pacer.freq = PAL_Timer_GetPerformanceFrequency();
+    
+    double period = (double)g_pacer.freq / refreshHz;
+    g_pacer.period = (u64)period;
+    g_pacer.period_frac = (u32)((period - (double)g_pacer.period) * 4294967296.0);
+    g_pacer.spin_ns = 1000000;
+    
+    g_pacer.frame_start = PAL_Timer_GetPerformanceCounter();
+    Resync(g_pacer.frame_start);
+}
+
+void PAL_FramePacer_SetMode(PAL_PaceMode mode) {
+    if (mode != g_pacer.mode) {
+        g_pacer.mode = mode;
+        Resync(PAL_Timer_GetPerformanceCounter());
+    }
+}
+
+PAL_PaceMode PAL_FramePacer_GetMode(void) {
+    return g_pacer.mode;
+}
+
+void PAL_FramePacer_SetFastForward(BOOL enabled) {
+    if (g_pacer.fast_forward && !enabled) {
+        Resync(PAL_Timer_GetPerformanceCounter());
+    }
+    g_pacer.fast_forward = enabled;
+}
+
+BOOL PAL_FramePacer_IsFastForward(void) {
+    return g_pacer.fast_forward;
+}
+
+void PAL_FramePacer_BeginPhase(PAL_FramePhase phase) {
+    if (phase < PAL_FRAME_PHASE_MAX) {
+        g_pacer.phase_start[phase] = PAL_Timer_GetPerformanceCounter();
+    }
+}
+
+void PAL_FramePacer_EndPhase(PAL_FramePhase phase) {
+    if (phase < PAL_FRAME_PHASE_MAX) {
+        g_pacer.phase_ticks[phase] += PAL_Timer_GetPerformanceCounter() - g_pacer.phase_start[phase];
+    }
+}
+
+// Sleep most of the remaining time, then spin. The spin window follows
+// how late the OS actually wakes us, so a precise timer spins very little.
+static void WaitUntil(u64 deadline) {
+    u64 now = PAL_Timer_GetPerformanceCounter();
+    
+    if (now < deadline) {
+        u64 remaining_ns = TicksToNanoseconds(deadline - now);
+        
+        if (remaining_ns > g_pacer.spin_ns) {
+            u64 request_ns = remaining_ns - g_pacer.spin_ns;
+            u64 before = now;
+            
+            PAL_Timer_DelayNS(request_ns);
+            now = PAL_Timer_GetPerformanceCounter();
+            
+            u64 slept_ns = TicksToNanoseconds(now - before);
+            u64 oversleep_ns = slept_ns > request_ns ? slept_ns - request_ns : 0;
+            
+            // Jump up to a bad wakeup at once, drift back down slowly
+            u64 target = oversleep_ns * 2;
+            if (target > g_pacer.spin_ns) {
+                g_pacer.spin_ns = target;
+            } else {
+                g_pacer.spin_ns -= (g_pacer.spin_ns - target) / 16;
+            }
+            
+            if (g_pacer.spin_ns < PACER_SPIN_MIN_NS) {
+                g_pacer.spin_ns = PACER_SPIN_MIN_NS;
+            } else if (g_pacer.spin_ns > PACER_SPIN_MAX_NS) {
+                g_pacer.spin_ns = PACER_SPIN_MAX_NS;
+            }
+        }
+    }
+    
+    while (now < deadline) {
+        now = PAL_Timer_GetPerformanceCounter();
+    }
+}
+
+void PAL_FramePacer_WaitForNextFrame(void) {
+    u64 now = PAL_Timer_GetPerformanceCounter();
+    BOOL late = now > g_pacer.deadline;
+    
+    g_pacer.phase_start[PAL_FRAME_PHASE_WAIT] = now;
+    
+    if (g_pacer.fast_forward || g_pacer.mode != PAL_PACE_TIMED) {
+        // Nothing to wait for here; keep the deadline next to the clock so
+        // switching back to timed pacing doesn't start with a backlog
+        Resync(now);
+        late = FALSE;
+    } else if (late && now - g_pacer.deadline > g_pacer.period * PACER_MAX_LAG_FRAMES) {
+        Resync(now);
+        g_pacer.resyncs++;
+    } else {
+        WaitUntil(g_pacer.deadline);
+        AdvanceDeadline();
+    }
+    
+    u64 end = PAL_Timer_GetPerformanceCounter();
+    g_pacer.phase_ticks[PAL_FRAME_PHASE_WAIT] = end - g_pacer.phase_start[PAL_FRAME_PHASE_WAIT];
+    
+    PAL_FrameTiming* timing = &g_pacer.history[g_pacer.history_head];
+    for (int i = 0; i < PAL_FRAME_PHASE_MAX; i++) {
+        timing->phase_us[i] = TicksToMicroseconds(g_pacer.phase_ticks[i]);
+        g_pacer.phase_ticks[i] = 0;
+    }
+    timing->frame_us = TicksToMicroseconds(end - g_pacer.frame_start);
+    timing->late = late;
+    
+    g_pacer.history_head = (g_pacer.history_head + 1) % PAL_FRAME_PACER_HISTORY;
+    if (g_pacer.history_count < PAL_FRAME_PACER_HISTORY) {
+        g_pacer.history_count++;
+    }
+    
+    g_pacer.total_frames++;
+    if (late) {
+        g_pacer.late_frames++;
+    }
+    
+    g_pacer.frame_start = end;
+}
+
+const PAL_FrameTiming* PAL_FramePacer_GetLastFrame(void) {
+    if (g_pacer.history_count == 0) {
+        return NULL;
+    }
+    return &g_pacer.history[(g_pacer.history_head + PAL_FRAME_PACER_HISTORY - 1) % PAL_FRAME_PACER_HISTORY];
+}
+
+u32 PAL_FramePacer_GetHistory(PAL_FrameTiming* out, u32 maxFrames) {
+    if (!out) {
+        return 0;
+    }
+    
+    u32 count = g_pacer.history_count < maxFrames ? g_pacer.history_count : maxFrames;
+    u32 index = (g_pacer.history_head + PAL_FRAME_PACER_HISTORY - count) % PAL_FRAME_PACER_HISTORY;
+    
+    for (u32 i = 0; i < count; i++) {
+        out[i] = g_pacer.history[index];
+        index = (index + 1) % PAL_FRAME_PACER_HISTORY;
+    }
+    return count;
+}
+
+// ============================================================================
+// Summary
+// ============================================================================
+
+static int CompareU32(const void* a, const void* b) {
+    u32 x = *(const u32*)a;
+    u32 y = *(const u32*)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of a sorted array
+static u32 Percentile(const u32* sorted, u32 count, u32 percent) {
+    u32 rank = (percent * count + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static void ComputePercentiles(u32* values, u32 count, PAL_FramePercentiles* out) {
+    qsort(values, count, sizeof(u32), CompareU32);
+    out->p50 = Percentile(values, count, 50);
+    out->p95 = Percentile(values, count, 95);
+    out->p99 = Percentile(values, count, 99);
+    out->max = values[count - 1];
+}
+
+void PAL_FramePacer_GetSummary(PAL_FramePacerSummary* out) {
+    static u32 values[PAL_FRAME_PACER_HISTORY];
+    
+    if (!out) {
+        return;
+    }
+    
+    memset(out, 0, sizeof(*out));
+    out->num_frames = g_pacer.history_count;
+    out->total_frames = g_pacer.total_frames;
+    out->late_frames = g_pacer.late_frames;
+    out->resyncs = g_pacer.resyncs;
+    
+    if (g_pacer.history_count == 0) {
+        return;
+    }
+    
+    for (int phase = 0; phase < PAL_FRAME_PHASE_MAX; phase++) {
+        for (u32 i = 0; i < g_pacer.history_count; i++) {
+            values[i] = g_pacer.history[i].phase_us[phase];
+        }
+        ComputePercentiles(values, g_pacer.history_count, &out->phases[phase]);
+    }
+    
+    for (u32 i = 0; i < g_pacer.history_count; i++) {
+        values[i] = g_pacer.history[i].frame_us;
+    }
+    ComputePercentiles(values, g_pacer.history_count, &out->frame);
+}
+
+static void PrintPercentileRow(const char* name, const PAL_FramePercentiles* p) {
+    printf("  %-8s %8.2f %8.2f %8.2f %8.2f\n", name,
+           p->p50 / 1000.0, p->p95 / 1000.0, p->p99 / 1000.0, p->max / 1000.0);
+}
+
+void PAL_FramePacer_PrintSummary(void) {
+    PAL_FramePacerSummary summary;
+    PAL_FramePacer_GetSummary(&summary);
+    
+    if (summary.num_frames == 0) {
+        return;
+    }
+    
+    printf("Frame times over the last %u frames (ms):\n", summary.num_frames);
+    printf("  %-8s %8s %8s %8s %8s\n", "phase", "p50", "p95", "p99", "max");
+    for (int i = 0; i < PAL_FRAME_PHASE_MAX; i++) {
+        PrintPercentileRow(s_phaseNames[i], &summary.phases[i]);
+    }
+    PrintPercentileRow("frame", &summary.frame);
+    printf("Late frames: %llu of %llu, resyncs: %llu\n",
+           (unsigned long long)summary.late_frames, (unsigned long long)summary.total_frames,
+           (unsigned long long)summary.resyncs);
+}
+
+#endif // PLATFORM_SDL
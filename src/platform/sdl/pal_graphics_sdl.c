@@ -4,6 +4,8 @@
  */
 
 #include "platform/pal_graphics.h"
+#include "platform/pal_compositor.h"
+#include "platform/pal_frame_dump.h"
 
 #ifdef PLATFORM_SDL
 
@@ -21,40 +23,85 @@ struct PAL_Surface {
 
 // Global state
 static struct {
+    PAL_GraphicsBackend backend;
     SDL_Window* window;
+    SDL_Surface* framebuffer;       // Headless: software renderer target
     SDL_Renderer* renderer;
     PAL_Surface screens[PAL_SCREEN_MAX];
-    PAL_Palette default_palette;
+    PAL_PaletteLUT default_palette;
+    PAL_GraphicsColorMode color_mode;
     BOOL initialized;
+    
+    // Frame rate, measured over roughly one second of presented frames
+    u64 frame_count;
+    u64 fps_window_start;
+    u32 fps_window_frames;
+    float fps;
 } g_graphics;
 
-BOOL PAL_Graphics_Init(int window_width, int window_height) {
+void PAL_Graphics_SetBackend(PAL_GraphicsBackend backend) {
     if (g_graphics.initialized) {
-        return TRUE;
+        return;
     }
-    
-    // Create window
-    g_graphics.window = SDL_CreateWindow(
-        "Pokemon Platinum",
-        window_width, window_height,
-        SDL_WINDOW_RESIZABLE
-    );
-    
-    if (!g_graphics.window) {
+    g_graphics.backend = backend;
+}
+
+PAL_GraphicsBackend PAL_Graphics_GetBackend(void) {
+    return g_graphics.backend;
+}
+
+static BOOL CreateHeadlessRenderer(int width, int height) {
+    // The software renderer draws straight into a CPU surface, so neither a
+    // display nor a GPU is needed and there is nothing to wait on for vsync
+    g_graphics.framebuffer = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_RGBA32);
+    if (!g_graphics.framebuffer) {
         return FALSE;
     }
     
-    // Create renderer
-    g_graphics.renderer = SDL_CreateRenderer(
-        g_graphics.window,
-        NULL
-    );
-    
+    g_graphics.renderer = SDL_CreateSoftwareRenderer(g_graphics.framebuffer);
     if (!g_graphics.renderer) {
-        SDL_DestroyWindow(g_graphics.window);
+        SDL_DestroySurface(g_graphics.framebuffer);
+        g_graphics.framebuffer = NULL;
         return FALSE;
     }
     
+    return TRUE;
+}
+
+BOOL PAL_Graphics_Init(int window_width, int window_height) {
+    if (g_graphics.initialized) {
+        return TRUE;
+    }
+    
+    if (g_graphics.backend == PAL_GRAPHICS_BACKEND_HEADLESS) {
+        if (!CreateHeadlessRenderer(window_width, window_height)) {
+            return FALSE;
+        }
+    } else {
+        // Create window
+        g_graphics.window = SDL_CreateWindow(
+            "Pokemon Platinum",
+            window_width, window_height,
+            SDL_WINDOW_RESIZABLE
+        );
+        
+        if (!g_graphics.window) {
+            return FALSE;
+        }
+        
+        // Create renderer
+        g_graphics.renderer = SDL_CreateRenderer(
+            g_graphics.window,
+            NULL
+        );
+        
+        if (!g_graphics.renderer) {
+            SDL_DestroyWindow(g_graphics.window);
+            g_graphics.window = NULL;
+            return FALSE;
+        }
+    }
+    
     // Initialize screen surfaces
     // Side-by-side layout by default
     for (int i = 0; i < PAL_SCREEN_MAX; i++) {
@@ -78,6 +125,13 @@ BOOL PAL_Graphics_Init(int window_width, int window_height) {
         g_graphics.screens[i].screen = (PAL_Screen)i;
     }
     
+    PAL_PaletteLUT_Init(&g_graphics.default_palette);
+    
+    g_graphics.frame_count = 0;
+    g_graphics.fps_window_start = SDL_GetPerformanceCounter();
+    g_graphics.fps_window_frames = 0;
+    g_graphics.fps = 0.0f;
+    
     g_graphics.initialized = TRUE;
     return TRUE;
 }
@@ -87,6 +141,8 @@ void PAL_Graphics_Shutdown(void) {
         return;
     }
     
+    PAL_Compositor_Shutdown();
+    
     for (int i = 0; i < PAL_SCREEN_MAX; i++) {
         if (g_graphics.screens[i].texture) {
             SDL_DestroyTexture(g_graphics.screens[i].texture);
@@ -99,6 +155,11 @@ void PAL_Graphics_Shutdown(void) {
         g_graphics.renderer = NULL;
     }
     
+    if (g_graphics.framebuffer) {
+        SDL_DestroySurface(g_graphics.framebuffer);
+        g_graphics.framebuffer = NULL;
+    }
+    
     if (g_graphics.window) {
         SDL_DestroyWindow(g_graphics.window);
         g_graphics.window = NULL;
@@ -137,6 +198,46 @@ void PAL_Graphics_BeginFrame(void) {
     SDL_SetRenderTarget(g_graphics.renderer, NULL);
 }
 
+static void UpdateFrameRate(void) {
+    g_graphics.frame_count++;
+    g_graphics.fps_window_frames++;
+    
+    u64 now = SDL_GetPerformanceCounter();
+    u64 elapsed = now - g_graphics.fps_window_start;
+    u64 freq = SDL_GetPerformanceFrequency();
+    
+    if (elapsed >= freq) {
+        g_graphics.fps = (float)((double)g_graphics.fps_window_frames * (double)freq / (double)elapsed);
+        g_graphics.fps_window_start = now;
+        g_graphics.fps_window_frames = 0;
+    }
+}
+
+// Window backend: read the back buffer before it is presented. Readback
+// stalls the GPU, so frames the dump interval would drop are skipped here.
+static void SubmitWindowFrame(void) {
+    if (!PAL_FrameDump_WantsNextFrame()) {
+        PAL_FrameDump_Submit(NULL, 0, 0, 0);
+        return;
+    }
+    
+    SDL_Surface* readback = SDL_RenderReadPixels(g_graphics.renderer, NULL);
+    if (!readback) {
+        PAL_FrameDump_Submit(NULL, 0, 0, 0);
+        return;
+    }
+    
+    SDL_Surface* rgba = SDL_ConvertSurface(readback, SDL_PIXELFORMAT_RGBA32);
+    SDL_DestroySurface(readback);
+    
+    if (rgba) {
+        PAL_FrameDump_Submit(rgba->pixels, rgba->w, rgba->h, rgba->pitch);
+        SDL_DestroySurface(rgba);
+    } else {
+        PAL_FrameDump_Submit(NULL, 0, 0, 0);
+    }
+}
+
 void PAL_Graphics_EndFrame(void) {
     SDL_SetRenderTarget(g_graphics.renderer, NULL);
     
@@ -151,7 +252,51 @@ void PAL_Graphics_EndFrame(void) {
         SDL_RenderTexture(g_graphics.renderer, g_graphics.screens[i].texture, NULL, &dest);
     }
     
-    SDL_RenderPresent(g_graphics.renderer);
+    if (g_graphics.framebuffer) {
+        // Headless: execute the queued draws so the surface holds this frame
+        SDL_FlushRenderer(g_graphics.renderer);
+        PAL_FrameDump_Submit(g_graphics.framebuffer->pixels, g_graphics.framebuffer->w,
+                             g_graphics.framebuffer->h, g_graphics.framebuffer->pitch);
+    } else {
+        if (PAL_FrameDump_IsActive()) {
+            SubmitWindowFrame();
+        }
+        SDL_RenderPresent(g_graphics.renderer);
+    }
+    
+    UpdateFrameRate();
+}
+
+BOOL PAL_Graphics_SetVSync(BOOL enabled) {
+    if (!g_graphics.renderer || g_graphics.framebuffer) {
+        return FALSE;
+    }
+    return SDL_SetRenderVSync(g_graphics.renderer, enabled ? 1 : 0);
+}
+
+float PAL_Graphics_GetFrameRate(void) {
+    return g_graphics.fps;
+}
+
+u64 PAL_Graphics_GetFrameCount(void) {
+    return g_graphics.frame_count;
+}
+
+const void* PAL_Graphics_GetFramebuffer(int* width, int* height, int* pitch) {
+    if (!g_graphics.framebuffer) {
+        return NULL;
+    }
+    
+    if (width) {
+        *width = g_graphics.framebuffer->w;
+    }
+    if (height) {
+        *height = g_graphics.framebuffer->h;
+    }
+    if (pitch) {
+        *pitch = g_graphics.framebuffer->pitch;
+    }
+    return g_graphics.framebuffer->pixels;
 }
 
 void PAL_Graphics_DrawSprite(PAL_Surface* surf, const void* sprite_data, 
@@ -339,10 +484,179 @@ void PAL_Graphics_SetPalette(const u16* palette_rgb555, int num_colors) {
         return;
     }
     
-    g_graphics.default_palette.num_colors = num_colors;
-    for (int i = 0; i < num_colors; i++) {
-        g_graphics.default_palette.colors[i] = PAL_ColorFromRGB555(palette_rgb555[i]);
+    PAL_PaletteLUT_Load(&g_graphics.default_palette, palette_rgb555, 0, num_colors);
+}
+
+/**
+ * Get the palette set by PAL_Graphics_SetPalette
+ */
+const PAL_PaletteLUT* PAL_Graphics_GetPaletteLUT(void) {
+    return &g_graphics.default_palette;
+}
+
+// ============================================================================
+// Palette LUTs
+// ============================================================================
+
+// Shared by every LUT so generations are unique across palettes; 0 is
+// never handed out and can be used as "not decoded yet"
+static u32 sPaletteGeneration = 0;
+
+// Marks an rgb555 slot that has never been loaded (real colors never have bit 15 set)
+#define PALETTE_SLOT_UNLOADED 0xFFFF
+
+void PAL_PaletteLUT_Init(PAL_PaletteLUT* lut) {
+    if (!lut) {
+        return;
+    }
+    
+    memset(lut->colors, 0, sizeof(lut->colors));
+    for (int i = 0; i < 256; i++) {
+        lut->rgb555[i] = PALETTE_SLOT_UNLOADED;
     }
+    lut->generation = ++sPaletteGeneration;
+    for (int i = 0; i < PAL_PALETTE_NUM_SUBPALETTES; i++) {
+        lut->subGenerations[i] = lut->generation;
+    }
+    lut->num_colors = 0;
+}
+
+u16 PAL_PaletteLUT_Load(PAL_PaletteLUT* lut, const u16* src, u32 offset, u32 count) {
+    if (!lut || !src || offset >= 256) {
+        return 0;
+    }
+    if (count > 256 - offset) {
+        count = 256 - offset;
+    }
+    
+    u16 changed = 0;
+    for (u32 i = 0; i < count; i++) {
+        u32 idx = offset + i;
+        u16 color = src[i] & 0x7FFF;  // Bit 15 is ignored by the hardware
+        if (lut->rgb555[idx] == color) {
+            continue;
+        }
+        
+        lut->rgb555[idx] = color;
+        lut->colors[idx] = PAL_ColorToRGBA32(PAL_ColorFromRGB555(color));
+        changed |= (u16)(1 << (idx / 16));
+    }
+    
+    if ((int)(offset + count) > lut->num_colors) {
+        lut->num_colors = offset + count;
+    }
+    
+    if (changed) {
+        lut->generation = ++sPaletteGeneration;
+        for (int i = 0; i < PAL_PALETTE_NUM_SUBPALETTES; i++) {
+            if (changed & (1 << i)) {
+                lut->subGenerations[i] = lut->generation;
+            }
+        }
+    }
+    
+    return changed;
+}
+
+// ============================================================================
+// Indexed Color Mode
+// ============================================================================
+
+BOOL PAL_Graphics_SetColorMode(PAL_GraphicsColorMode mode) {
+    if (mode == PAL_GRAPHICS_COLOR_INDEXED) {
+        // Probe the renderer: not every SDL build/backend can draw INDEX8
+        SDL_Palette* palette = NULL;
+        SDL_Texture* probe = PAL_Graphics_CreateIndexedTexture(8, 8, &palette);
+        if (!probe) {
+            return FALSE;
+        }
+        SDL_DestroyTexture(probe);
+        SDL_DestroyPalette(palette);
+    }
+    
+    g_graphics.color_mode = mode;
+    return TRUE;
+}
+
+PAL_GraphicsColorMode PAL_Graphics_GetColorMode(void) {
+    return g_graphics.color_mode;
+}
+
+SDL_Texture* PAL_Graphics_CreateIndexedTexture(int width, int height, SDL_Palette** outPalette) {
+    if (!g_graphics.renderer || !outPalette) {
+        return NULL;
+    }
+    
+#if SDL_VERSION_ATLEAST(3, 4, 0)
+    SDL_Texture* texture = SDL_CreateTexture(g_graphics.renderer,
+                                             SDL_PIXELFORMAT_INDEX8,
+                                             SDL_TEXTUREACCESS_STREAMING,
+                                             width, height);
+    if (!texture) {
+        return NULL;
+    }
+    
+    SDL_Palette* palette = SDL_CreatePalette(256);
+    if (!palette || !SDL_SetTexturePalette(texture, palette)) {
+        if (palette) {
+            SDL_DestroyPalette(palette);
+        }
+        SDL_DestroyTexture(texture);
+        return NULL;
+    }
+    
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    *outPalette = palette;
+    return texture;
+#else
+    // Indexed textures need SDL 3.4
+    (void)width;
+    (void)height;
+    return NULL;
+#endif
+}
+
+u32 PAL_Graphics_SyncIndexedPalette(SDL_Palette* palette, const PAL_PaletteLUT* lut, u32 syncedGeneration) {
+    if (!palette || !lut) {
+        return syncedGeneration;
+    }
+    if (lut->generation == syncedGeneration) {
+        return syncedGeneration;
+    }
+    
+    // Upload each run of consecutive changed sub-palettes with one call
+    int runStart = -1;
+    for (int sub = 0; sub <= PAL_PALETTE_NUM_SUBPALETTES; sub++) {
+        BOOL changed = sub < PAL_PALETTE_NUM_SUBPALETTES
+            && lut->subGenerations[sub] > syncedGeneration;
+        if (changed) {
+            if (runStart < 0) {
+                runStart = sub;
+            }
+            continue;
+        }
+        if (runStart < 0) {
+            continue;
+        }
+        
+        SDL_Color colors[256];
+        int first = runStart * 16;
+        int count = (sub - runStart) * 16;
+        for (int i = 0; i < count; i++) {
+            u32 packed = lut->colors[first + i];
+            colors[i].r = (u8)packed;
+            colors[i].g = (u8)(packed >> 8);
+            colors[i].b = (u8)(packed >> 16);
+            colors[i].a = (u8)(packed >> 24);
+        }
+        if (first == 0) {
+            colors[0].a = 0;
+        }
+        SDL_SetPaletteColors(palette, colors, first, count);
+        runStart = -1;
+    }
+    
+    return lut->generation;
 }
 
 /**
@@ -0,0 +1,735 @@
+/**
+ * @file pal_heap_profiler_sdl.c
+ * @brief SDL3 implementation of the heap allocation profiler
+ *
+ * Callsite names come from dladdr() on POSIX systems, like the task
+ * profiler's callback names, so static functions are shown as
+ * "nearest_symbol+0xOFFSET".
+ *
+ * The profiler's own tables use malloc/free directly: PAL_Malloc is one of
+ * the functions being recorded.
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#define HEAP_PROFILER_HAVE_DLADDR
+#endif
+
+#include "platform/pal_heap_profiler.h"
+#include "platform/pal_file.h"
+
+#if defined(PLATFORM_SDL) && defined(PAL_HEAP_PROFILER)
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HEAP_PROFILER_MAX_SITES 4096        // Power of two, open addressing
+#define HEAP_PROFILER_FRAME_HISTORY 1024
+#define HEAP_PROFILER_NAME_MAX 128
+#define HEAP_PROFILER_MIN_LIVE_CAPACITY 4096
+#define HEAP_PROFILER_NUM_HEAPS 256
+
+// A site counts as churn when it allocates at least this many blocks per
+// frame that are freed in the same frame, and they are most of its blocks
+#define HEAP_PROFILER_CHURN_PER_FRAME 1.0
+
+enum {
+    ALLOC_EVENT_ALLOC = 0,
+    ALLOC_EVENT_FREE,
+    ALLOC_EVENT_RESIZE,
+    ALLOC_EVENT_DESTROY,
+};
+
+// One (caller, heap) combination
+typedef struct {
+    void* caller;
+    u32 heap;
+    BOOL used;
+    
+    u64 allocs;
+    u64 frees;
+    u64 bytes;
+    u64 short_lived;        // Freed in the frame they were allocated in
+    u64 destroyed;          // Still allocated when their heap was destroyed
+    u64 live_blocks;
+    u64 live_bytes;
+    u64 peak_live_bytes;
+} AllocSite;
+
+// Open addressing by pointer; ptr NULL marks an empty slot
+typedef struct {
+    void* ptr;
+    u32 size;
+    u32 frame;
+    u32 id;
+    u16 site;
+} LiveBlock;
+
+typedef struct {
+    u32 frame;
+    u32 size;
+    u32 block;              // LiveBlock id, so traces can be replayed; 0 for destroy
+    u16 site;
+    u8 heap;
+    u8 kind;
+} AllocEvent;
+
+typedef struct {
+    u32 allocs;
+    u32 frees;
+    u64 bytes;
+} FrameCounts;
+
+static struct {
+    BOOL enabled;
+    SDL_Mutex* mutex;           // PAL_Malloc is called from loader threads
+    
+    AllocSite sites[HEAP_PROFILER_MAX_SITES];
+    u32 num_sites;
+    u64 dropped;                // Allocations that found the site table full
+    
+    LiveBlock* live;
+    u32 live_capacity;
+    u32 live_count;
+    
+    u32 frame;
+    FrameCounts current;
+    FrameCounts history[HEAP_PROFILER_FRAME_HISTORY];
+    u32 max_frame_allocs;
+    u64 total_allocs;
+    u64 total_frees;
+    u64 total_bytes;
+    u32 next_block_id;
+    
+    AllocEvent* events;
+    u32 event_capacity;
+    u32 event_head;             // Next slot to write
+    u32 event_count;
+} g_heapProfiler;
+
+// ============================================================================
+// Tables
+// ============================================================================
+
+static u32 HashPointer(const void* ptr) {
+    u64 key = (u64)(uintptr_t)ptr;
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDull;
+    key ^= key >> 33;
+    return (u32)key;
+}
+
+static int FindSite(void* caller, u32 heap) {
+    u32 index = (HashPointer(caller) ^ (heap * 0x9E3779B9u)) & (HEAP_PROFILER_MAX_SITES - 1);
+    
+    for (u32 probe = 0; probe < HEAP_PROFILER_MAX_SITES; probe++) {
+        AllocSite* site = &g_heapProfiler.sites[index];
+        
+        if (!site->used) {
+            // Keep the table at most 3/4 full so probes stay short
+            if (g_heapProfiler.num_sites >= HEAP_PROFILER_MAX_SITES * 3 / 4) {
+                return -1;
+            }
+            site->used = TRUE;
+            site->caller = caller;
+            site->heap = heap;
+            g_heapProfiler.num_sites++;
+            return (int)index;
+        }
+        
+        if (site->caller == caller && site->heap == heap) {
+            return (int)index;
+        }
+        
+        index = (index + 1) & (HEAP_PROFILER_MAX_SITES - 1);
+    }
+    
+    return -1;
+}
+
+static LiveBlock* FindLive(const void* ptr) {
+    u32 mask = g_heapProfiler.live_capacity - 1;
+    u32 index = HashPointer(ptr) & mask;
+    
+    while (g_heapProfiler.live[index].ptr != NULL) {
+        if (g_heapProfiler.live[index].ptr == ptr) {
+            return &g_heapProfiler.live[index];
+        }
+        index = (index + 1) & mask;
+    }
+    
+    return NULL;
+}
+
+static void InsertLive(const LiveBlock* block) {
+    u32 mask = g_heapProfiler.live_capacity - 1;
+    u32 index = HashPointer(block->ptr) & mask;
+    
+    while (g_heapProfiler.live[index].ptr != NULL) {
+        index = (index + 1) & mask;
+    }
+    
+    g_heapProfiler.live[index] = *block;
+    g_heapProfiler.live_count++;
+}
+
+// Backward-shift deletion, so lookups never need tombstones
+static void RemoveLive(LiveBlock* block) {
+    u32 mask = g_heapProfiler.live_capacity - 1;
+    u32 hole = (u32)(block - g_heapProfiler.live);
+    u32 index = (hole + 1) & mask;
+    
+    while (g_heapProfiler.live[index].ptr != NULL) {
+        u32 home = HashPointer(g_heapProfiler.live[index].ptr) & mask;
+        
+        // Move the entry into the hole unless its home lies cyclically in (hole, index]
+        if (((index - home) & mask) >= ((index - hole) & mask)) {
+            g_heapProfiler.live[hole] = g_heapProfiler.live[index];
+            hole = index;
+        }
+        index = (index + 1) & mask;
+    }
+    
+    g_heapProfiler.live[hole].ptr = NULL;
+    g_heapProfiler.live_count--;
+}
+
+// Rebuilds the live table, dropping the blocks of one heap (pass a value
+// above 0xFF to keep all of them)
+static BOOL RehashLive(u32 capacity, u32 dropHeap) {
+    LiveBlock* old = g_heapProfiler.live;
+    u32 oldCapacity = g_heapProfiler.live_capacity;
+    LiveBlock* table = calloc(capacity, sizeof(LiveBlock));
+    
+    if (!table) {
+        return FALSE;
+    }
+    
+    g_heapProfiler.live = table;
+    g_heapProfiler.live_capacity = capacity;
+    g_heapProfiler.live_count = 0;
+    
+    for (u32 i = 0; i < oldCapacity; i++) {
+        if (old[i].ptr != NULL && g_heapProfiler.sites[old[i].site].heap != dropHeap) {
+            InsertLive(&old[i]);
+        }
+    }
+    
+    free(old);
+    return TRUE;
+}
+
+static void RecordEvent(u8 kind, u32 heap, u32 size, u32 blockID, u16 site) {
+    if (g_heapProfiler.event_capacity == 0) {
+        return;
+    }
+    
+    AllocEvent* event = &g_heapProfiler.events[g_heapProfiler.event_head];
+    event->frame = g_heapProfiler.frame;
+    event->size = size;
+    event->block = blockID;
+    event->site = site;
+    event->heap = (u8)heap;
+    event->kind = kind;
+    
+    g_heapProfiler.event_head = (g_heapProfiler.event_head + 1) % g_heapProfiler.event_capacity;
+    if (g_heapProfiler.event_count < g_heapProfiler.event_capacity) {
+        g_heapProfiler.event_count++;
+    }
+}
+
+static const char* GetCallsiteName(void* caller, char* buffer, size_t size) {
+#ifdef HEAP_PROFILER_HAVE_DLADDR
+    Dl_info info;
+    if (dladdr(caller, &info) && info.dli_sname) {
+        snprintf(buffer, size, "%s+0x%lx", info.dli_sname,
+                 (unsigned long)((uintptr_t)caller - (uintptr_t)info.dli_saddr));
+        return buffer;
+    }
+#endif
+    snprintf(buffer, size, "%p", caller);
+    return buffer;
+}
+
+static const char* GetHeapName(u32 heap, char* buffer, size_t size) {
+    if (heap == PAL_HEAP_PROFILER_PAL_HEAP) {
+        return "pal";
+    }
+    snprintf(buffer, size, "%u", heap);
+    return buffer;
+}
+
+static u32 GetFrameCount(void) {
+    // Profiles shorter than a frame still count as one
+    return g_heapProfiler.frame > 0 ? g_heapProfiler.frame : 1;
+}
+
+static BOOL IsChurn(const AllocSite* site) {
+    return (double)site->short_lived / (double)GetFrameCount() >= HEAP_PROFILER_CHURN_PER_FRAME
+        && site->short_lived * 2 >= site->allocs;
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+BOOL PAL_HeapProfiler_Init(u32 maxEvents) {
+    PAL_HeapProfiler_Shutdown();
+    memset(&g_heapProfiler, 0, sizeof(g_heapProfiler));
+    
+    g_heapProfiler.mutex = SDL_CreateMutex();
+    g_heapProfiler.live = calloc(HEAP_PROFILER_MIN_LIVE_CAPACITY, sizeof(LiveBlock));
+    g_heapProfiler.live_capacity = HEAP_PROFILER_MIN_LIVE_CAPACITY;
+    
+    if (maxEvents > 0) {
+        g_heapProfiler.events = malloc(sizeof(AllocEvent) * maxEvents);
+        g_heapProfiler.event_capacity = maxEvents;
+    }
+    
+    if (!g_heapProfiler.mutex || !g_heapProfiler.live || (maxEvents > 0 && !g_heapProfiler.events)) {
+        PAL_HeapProfiler_Shutdown();
+        return FALSE;
+    }
+    
+    g_heapProfiler.enabled = TRUE;
+    return TRUE;
+}
+
+void PAL_HeapProfiler_Shutdown(void) {
+    g_heapProfiler.enabled = FALSE;
+    
+    if (g_heapProfiler.mutex) {
+        SDL_DestroyMutex(g_heapProfiler.mutex);
+        g_heapProfiler.mutex = NULL;
+    }
+    
+    free(g_heapProfiler.live);
+    g_heapProfiler.live = NULL;
+    g_heapProfiler.live_capacity = 0;
+    g_heapProfiler.live_count = 0;
+    
+    free(g_heapProfiler.events);
+    g_heapProfiler.events = NULL;
+    g_heapProfiler.event_capacity = 0;
+    g_heapProfiler.event_count = 0;
+}
+
+BOOL PAL_HeapProfiler_IsEnabled(void) {
+    return g_heapProfiler.enabled;
+}
+
+void PAL_HeapProfiler_RecordAlloc(void* ptr, u32 size, u32 heapID, void* caller) {
+    if (!g_heapProfiler.enabled || ptr == NULL) {
+        return;
+    }
+    
+    SDL_LockMutex(g_heapProfiler.mutex);
+    
+    g_heapProfiler.current.allocs++;
+    g_heapProfiler.current.bytes += size;
+    g_heapProfiler.total_allocs++;
+    g_heapProfiler.total_bytes += size;
+    
+    int siteIndex = FindSite(caller, heapID);
+    if (siteIndex < 0) {
+        g_heapProfiler.dropped++;
+        SDL_UnlockMutex(g_heapProfiler.mutex);
+        return;
+    }
+    
+    // Grow at half full
+    if (g_heapProfiler.live_count * 2 >= g_heapProfiler.live_capacity
+        && !RehashLive(g_heapProfiler.live_capacity * 2, 0xFFFFFFFF)) {
+        g_heapProfiler.dropped++;
+        SDL_UnlockMutex(g_heapProfiler.mutex);
+        return;
+    }
+    
+    AllocSite* site = &g_heapProfiler.sites[siteIndex];
+    site->allocs++;
+    site->bytes += size;
+    site->live_blocks++;
+    site->live_bytes += size;
+    if (site->live_bytes > site->peak_live_bytes) {
+        site->peak_live_bytes = site->live_bytes;
+    }
+    
+    LiveBlock block = { ptr, size, g_heapProfiler.frame, ++g_heapProfiler.next_block_id, (u16)siteIndex };
+    InsertLive(&block);
+    RecordEvent(ALLOC_EVENT_ALLOC, heapID, size, block.id, (u16)siteIndex);
+    
+    SDL_UnlockMutex(g_heapProfiler.mutex);
+}
+
+void PAL_HeapProfiler_RecordFree(void* ptr) {
+    if (!g_heapProfiler.enabled || ptr == NULL) {
+        return;
+    }
+    
+    SDL_LockMutex(g_heapProfiler.mutex);
+    
+    LiveBlock* block = FindLive(ptr);
+    if (block) {
+        AllocSite* site = &g_heapProfiler.sites[block->site];
+        
+        site->frees++;
+        site->live_blocks--;
+        site->live_bytes -= block->size;
+        if (block->frame == g_heapProfiler.frame) {
+            site->short_lived++;
+        }
+        
+        g_heapProfiler.current.frees++;
+        g_heapProfiler.total_frees++;
+        RecordEvent(ALLOC_EVENT_FREE, site->heap, block->size, block->id, block->site);
+        RemoveLive(block);
+    }
+    
+    SDL_UnlockMutex(g_heapProfiler.mutex);
+}
+
+void PAL_HeapProfiler_RecordResize(void* ptr, u32 newSize) {
+    if (!g_heapProfiler.enabled || ptr == NULL) {
+        return;
+    }
+    
+    SDL_LockMutex(g_heapProfiler.mutex);
+    
+    LiveBlock* block = FindLive(ptr);
+    if (block) {
+        AllocSite* site = &g_heapProfiler.sites[block->site];
+        
+        site->live_bytes = site->live_bytes - block->size + newSize;
+        if (site->live_bytes > site->peak_live_bytes) {
+            site->peak_live_bytes = site->live_bytes;
+        }
+        block->size = newSize;
+        RecordEvent(ALLOC_EVENT_RESIZE, site->heap, newSize, block->id, block->site);
+    }
+    
+    SDL_UnlockMutex(g_heapProfiler.mutex);
+}
+
+void PAL_HeapProfiler_EndFrame(void) {
+    if (!g_heapProfiler.enabled) {
+        return;
+    }
+    
+    SDL_LockMutex(g_heapProfiler.mutex);
+    
+    g_heapProfiler.history[g_heapProfiler.frame % HEAP_PROFILER_FRAME_HISTORY] = g_heapProfiler.current;
+    if (g_heapProfiler.current.allocs > g_heapProfiler.max_frame_allocs) {
+        g_heapProfiler.max_frame_allocs = g_heapProfiler.current.allocs;
+    }
+    memset(&g_heapProfiler.current, 0, sizeof(g_heapProfiler.current));
+    g_heapProfiler.frame++;
+    
+    SDL_UnlockMutex(g_heapProfiler.mutex);
+}
+
+// ============================================================================
+// Reports
+// ============================================================================
+
+// Indices of the n sites with the most allocations (or live blocks), most
+// first; heap restricts to one heap unless it is above 0xFF
+static u32 SelectTopSites(u32* out, u32 n, BOOL byLive, u32 heap) {
+    u32 count = 0;
+    
+    for (u32 i = 0; i < HEAP_PROFILER_MAX_SITES; i++) {
+        const AllocSite* site = &g_heapProfiler.sites[i];
+        u64 key = byLive ? site->live_blocks : site->allocs;
+        
+        if (!site->used || key == 0 || (heap <= 0xFF && site->heap != heap)) {
+            continue;
+        }
+        
+        // Insertion into the short sorted list
+        u32 pos = count < n ? count : n;
+        while (pos > 0) {
+            const AllocSite* other = &g_heapProfiler.sites[out[pos - 1]];
+            if ((byLive ? other->live_blocks : other->allocs) >= key) {
+                break;
+            }
+            if (pos < n) {
+                out[pos] = out[pos - 1];
+            }
+            pos--;
+        }
+        if (pos < n) {
+            out[pos] = i;
+            if (count < n) {
+                count++;
+            }
+        }
+    }
+    
+    return count;
+}
+
+void PAL_HeapProfiler_HeapDestroyed(u32 heapID) {
+    if (!g_heapProfiler.enabled) {
+        return;
+    }
+    
+    SDL_LockMutex(g_heapProfiler.mutex);
+    
+    u64 blocks = 0;
+    u64 bytes = 0;
+    for (u32 i = 0; i < HEAP_PROFILER_MAX_SITES; i++) {
+        if (g_heapProfiler.sites[i].used && g_heapProfiler.sites[i].heap == heapID) {
+            blocks += g_heapProfiler.sites[i].live_blocks;
+            bytes += g_heapProfiler.sites[i].live_bytes;
+        }
+    }
+    
+    if (blocks > 0) {
+        u32 top[5];
+        u32 count = SelectTopSites(top, 5, TRUE, heapID);
+        char nameBuffer[HEAP_PROFILER_NAME_MAX];
+        
+        printf("[HeapProfiler] Frame %u: heap %u destroyed with %llu blocks (%llu bytes) outstanding\n",
+               g_heapProfiler.frame, heapID, (unsigned long long)blocks, (unsigned long long)bytes);
+        for (u32 i = 0; i < count; i++) {
+            const AllocSite* site = &g_heapProfiler.sites[top[i]];
+            printf("  %6llu blocks %9llu bytes  %s\n", (unsigned long long)site->live_blocks,
+                   (unsigned long long)site->live_bytes, GetCallsiteName(site->caller, nameBuffer, sizeof(nameBuffer)));
+        }
+        
+        for (u32 i = 0; i < HEAP_PROFILER_MAX_SITES; i++) {
+            AllocSite* site = &g_heapProfiler.sites[i];
+            if (site->used && site->heap == heapID && site->live_blocks > 0) {
+                RecordEvent(ALLOC_EVENT_DESTROY, heapID, (u32)site->live_bytes, 0, (u16)i);
+                site->destroyed += site->live_blocks;
+                site->live_blocks = 0;
+                site->live_bytes = 0;
+            }
+        }
+        
+        RehashLive(g_heapProfiler.live_capacity, heapID);
+    }
+    
+    SDL_UnlockMutex(g_heapProfiler.mutex);
+}
+
+void PAL_HeapProfiler_ReportOutstanding(const char* when) {
+    if (!g_heapProfiler.enabled) {
+        return;
+    }
+    
+    SDL_LockMutex(g_heapProfiler.mutex);
+    
+    static u64 blocks[HEAP_PROFILER_NUM_HEAPS];
+    static u64 bytes[HEAP_PROFILER_NUM_HEAPS];
+    memset(blocks, 0, sizeof(blocks));
+    memset(bytes, 0, sizeof(bytes));
+    
+    for (u32 i = 0; i < HEAP_PROFILER_MAX_SITES; i++) {
+        const AllocSite* site = &g_heapProfiler.sites[i];
+        if (site->used) {
+            blocks[site->heap & 0xFF] += site->live_blocks;
+            bytes[site->heap & 0xFF] += site->live_bytes;
+        }
+    }
+    
+    printf("[HeapProfiler] Frame %u, %s: outstanding blocks per heap:\n", g_heapProfiler.frame, when);
+    BOOL any = FALSE;
+    for (u32 heap = 0; heap < HEAP_PROFILER_NUM_HEAPS; heap++) {
+        char heapBuffer[8];
+        if (blocks[heap] > 0) {
+            printf("  heap %-4s %8llu blocks %10llu bytes\n", GetHeapName(heap, heapBuffer, sizeof(heapBuffer)),
+                   (unsigned long long)blocks[heap], (unsigned long long)bytes[heap]);
+            any = TRUE;
+        }
+    }
+    if (!any) {
+        printf("  (none)\n");
+    }
+    
+    SDL_UnlockMutex(g_heapProfiler.mutex);
+}
+
+void PAL_HeapProfiler_PrintSummary(void) {
+    if (!g_heapProfiler.enabled) {
+        return;
+    }
+    
+    SDL_LockMutex(g_heapProfiler.mutex);
+    
+    u32 frames = GetFrameCount();
+    printf("Heap allocations over %u frames: %.1f allocs/frame (max %u), %.1f frees/frame, %.1f KB/frame\n",
+           g_heapProfiler.frame, (double)g_heapProfiler.total_allocs / frames, g_heapProfiler.max_frame_allocs,
+           (double)g_heapProfiler.total_frees / frames, (double)g_heapProfiler.total_bytes / 1024.0 / frames);
+    
+    u32 top[20];
+    u32 count = SelectTopSites(top, 20, FALSE, 0xFFFFFFFF);
+    
+    printf("Top allocating callsites:\n");
+    printf("  %10s %9s %6s %10s %8s %9s  %-4s  %s\n",
+           "allocs", "per frame", "short", "total KB", "live", "peak KB", "heap", "callsite");
+    for (u32 i = 0; i < count; i++) {
+        const AllocSite* site = &g_heapProfiler.sites[top[i]];
+        char nameBuffer[HEAP_PROFILER_NAME_MAX];
+        char heapBuffer[8];
+        
+        printf("  %10llu %9.2f %5.0f%% %10.1f %8llu %9.1f  %-4s  %s%s\n",
+               (unsigned long long)site->allocs, (double)site->allocs / frames,
+               (double)site->short_lived * 100.0 / (double)site->allocs, (double)site->bytes / 1024.0,
+               (unsigned long long)site->live_blocks, (double)site->peak_live_bytes / 1024.0,
+               GetHeapName(site->heap, heapBuffer, sizeof(heapBuffer)),
+               GetCallsiteName(site->caller, nameBuffer, sizeof(nameBuffer)),
+               IsChurn(site) ? "  [churn]" : "");
+    }
+    
+    if (g_heapProfiler.dropped > 0) {
+        printf("  (%llu allocations not attributed: site table full)\n", (unsigned long long)g_heapProfiler.dropped);
+    }
+    
+    SDL_UnlockMutex(g_heapProfiler.mutex);
+    
+    PAL_HeapProfiler_ReportOutstanding("exit");
+}
+
+// Callsite names are C symbols, but escape anyway so a stray quote can't
+// break the file
+static void WriteJSONString(PAL_File file, const char* str) {
+    char buffer[HEAP_PROFILER_NAME_MAX * 2 + 2];
+    size_t len = 0;
+    
+    buffer[len++] = '"';
+    for (; *str && len < sizeof(buffer) - 3; str++) {
+        if (*str == '"' || *str == '\\') {
+            buffer[len++] = '\\';
+        }
+        buffer[len++] = (u8)*str < 0x20 ? '?' : *str;
+    }
+    buffer[len++] = '"';
+    PAL_File_Write(buffer, 1, len, file);
+}
+
+typedef struct {
+    char name[HEAP_PROFILER_NAME_MAX];
+    u32 heap;
+    u16 site;
+} SiteName;
+
+static int CompareSiteNames(const void* a, const void* b) {
+    const SiteName* left = a;
+    const SiteName* right = b;
+    int order = strcmp(left->name, right->name);
+    
+    if (order != 0) {
+        return order;
+    }
+    return left->heap < right->heap ? -1 : left->heap > right->heap;
+}
+
+BOOL PAL_HeapProfiler_WriteJSON(const char* path) {
+    if (!path || !g_heapProfiler.enabled) {
+        return FALSE;
+    }
+    
+    PAL_File file = PAL_File_Open(path, "w");
+    if (!file) {
+        return FALSE;
+    }
+    
+    SDL_LockMutex(g_heapProfiler.mutex);
+    
+    SiteName* names = malloc(sizeof(SiteName) * (g_heapProfiler.num_sites + 1));
+    u16* order = malloc(sizeof(u16) * HEAP_PROFILER_MAX_SITES);
+    if (!names || !order) {
+        free(names);
+        free(order);
+        SDL_UnlockMutex(g_heapProfiler.mutex);
+        PAL_File_Close(file);
+        return FALSE;
+    }
+    
+    u32 numNames = 0;
+    for (u32 i = 0; i < HEAP_PROFILER_MAX_SITES; i++) {
+        if (g_heapProfiler.sites[i].used) {
+            SiteName* name = &names[numNames++];
+            GetCallsiteName(g_heapProfiler.sites[i].caller, name->name, sizeof(name->name));
+            name->heap = g_heapProfiler.sites[i].heap;
+            name->site = (u16)i;
+        }
+    }
+    qsort(names, numNames, sizeof(SiteName), CompareSiteNames);
+    for (u32 i = 0; i < numNames; i++) {
+        order[names[i].site] = (u16)i;
+    }
+    
+    u32 frames = GetFrameCount();
+    char line[512];
+    int len = snprintf(line, sizeof(line),
+                       "{\n\"frames\": %u,\n\"allocs\": %llu,\n\"frees\": %llu,\n\"bytes\": %llu,\n"
+                       "\"allocs_per_frame\": %.3f,\n\"max_frame_allocs\": %u,\n\"sites\": [\n",
+                       g_heapProfiler.frame, (unsigned long long)g_heapProfiler.total_allocs,
+                       (unsigned long long)g_heapProfiler.total_frees, (unsigned long long)g_heapProfiler.total_bytes,
+                       (double)g_heapProfiler.total_allocs / frames, g_heapProfiler.max_frame_allocs);
+    PAL_File_Write(line, 1, len, file);
+    
+    // One site per line, in name order, so the files diff well
+    for (u32 i = 0; i < numNames; i++) {
+        const AllocSite* site = &g_heapProfiler.sites[names[i].site];
+        char heapBuffer[8];
+        
+        PAL_File_Write("{\"site\":", 1, 8, file);
+        WriteJSONString(file, names[i].name);
+        PAL_File_Write(",\"heap\":", 1, 8, file);
+        WriteJSONString(file, GetHeapName(site->heap, heapBuffer, sizeof(heapBuffer)));
+        len = snprintf(line, sizeof(line),
+                       ",\"allocs\":%llu,\"frees\":%llu,\"bytes\":%llu,\"short_lived\":%llu,\"destroyed\":%llu,"
+                       "\"live_blocks\":%llu,\"live_bytes\":%llu,\"peak_live_bytes\":%llu,"
+                       "\"allocs_per_frame\":%.3f,\"churn\":%s}%s\n",
+                       (unsigned long long)site->allocs, (unsigned long long)site->frees,
+                       (unsigned long long)site->bytes, (unsigned long long)site->short_lived,
+                       (unsigned long long)site->destroyed, (unsigned long long)site->live_blocks,
+                       (unsigned long long)site->live_bytes, (unsigned long long)site->peak_live_bytes,
+                       (double)site->allocs / frames, IsChurn(site) ? "true" : "false",
+                       i + 1 < numNames ? "," : "");
+        PAL_File_Write(line, 1, len, file);
+    }
+    
+    // [allocs, frees, bytes] for the most recent frames, oldest first
+    static const char frameHeader[] = "],\n\"frame_counts\": [\n";
+    PAL_File_Write(frameHeader, 1, sizeof(frameHeader) - 1, file);
+    u32 numFrames = g_heapProfiler.frame < HEAP_PROFILER_FRAME_HISTORY ? g_heapProfiler.frame : HEAP_PROFILER_FRAME_HISTORY;
+    for (u32 i = 0; i < numFrames; i++) {
+        const FrameCounts* counts = &g_heapProfiler.history[(g_heapProfiler.frame - numFrames + i) % HEAP_PROFILER_FRAME_HISTORY];
+        len = snprintf(line, sizeof(line), "[%u,%u,%llu]%s\n", counts->allocs, counts->frees,
+                       (unsigned long long)counts->bytes, i + 1 < numFrames ? "," : "");
+        PAL_File_Write(line, 1, len, file);
+    }
+    
+    // [frame, kind, heap, size, site, block] with site indexing the sites
+    // array and block identifying the allocation the event belongs to; kind
+    // is 0 alloc, 1 free, 2 resize, 3 outstanding at Heap_Destroy
+    static const char eventHeader[] = "],\n\"events\": [\n";
+    PAL_File_Write(eventHeader, 1, sizeof(eventHeader) - 1, file);
+    u32 index = g_heapProfiler.event_capacity > 0
+        ? (g_heapProfiler.event_head + g_heapProfiler.event_capacity - g_heapProfiler.event_count) % g_heapProfiler.event_capacity
+        : 0;
+    for (u32 i = 0; i < g_heapProfiler.event_count; i++) {
+        const AllocEvent* event = &g_heapProfiler.events[index];
+        len = snprintf(line, sizeof(line), "[%u,%u,%u,%u,%u,%u]%s\n", event->frame, event->kind, event->heap,
+                       event->size, order[event->site], event->block, i + 1 < g_heapProfiler.event_count ? "," : "");
+        PAL_File_Write(line, 1, len, file);
+        index = (index + 1) % g_heapProfiler.event_capacity;
+    }
+    
+    PAL_File_Write("]\n}\n", 1, 4, file);
+    
+    SDL_UnlockMutex(g_heapProfiler.mutex);
+    
+    free(names);
+    free(order);
+    PAL_File_Close(file);
+    return TRUE;
+}
+
+#endif // PLATFORM_SDL && PAL_HEAP_PROFILER
@@ -5,24 +5,40 @@
 
 #include "platform/pal_memory.h"
 
+#ifdef PAL_HEAP_PROFILER
+#include "platform/pal_heap_profiler.h"
+#endif
+
 #ifdef PLATFORM_SDL
 
+#include <SDL3/SDL.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 // Optional custom allocator
 static PAL_Allocator* g_custom_allocator = NULL;
 
-void* PAL_Malloc(size_t size, int heap_id) {
-    // On SDL, ignore heap_id and use standard malloc
-    // (could be extended to track allocations per heap for debugging)
+static void* MallocInternal(size_t size) {
     if (g_custom_allocator && g_custom_allocator->malloc_func) {
         return g_custom_allocator->malloc_func(size);
     }
     return malloc(size);
 }
 
+void* PAL_Malloc(size_t size, int heap_id) {
+    // On SDL, ignore heap_id and use standard malloc
+    void* ptr = MallocInternal(size);
+#ifdef PAL_HEAP_PROFILER
+    PAL_HeapProfiler_RecordAlloc(ptr, (u32)size, PAL_HEAP_PROFILER_PAL_HEAP, PAL_HEAP_PROFILER_CALLER());
+#endif
+    return ptr;
+}
+
 void PAL_Free(void* ptr) {
+#ifdef PAL_HEAP_PROFILER
+    PAL_HeapProfiler_RecordFree(ptr);
+#endif
     if (g_custom_allocator && g_custom_allocator->free_func) {
         g_custom_allocator->free_func(ptr);
         return;
@@ -31,14 +47,31 @@ void PAL_Free(void* ptr) {
 }
 
 void* PAL_Realloc(void* ptr, size_t new_size) {
+    void* result;
+    
+#ifdef PAL_HEAP_PROFILER
+    // Recorded as a free and an allocation. The free goes first, before
+    // another thread can be handed the old address; if realloc fails the
+    // old block is simply no longer tracked.
+    PAL_HeapProfiler_RecordFree(ptr);
+#endif
     if (g_custom_allocator && g_custom_allocator->realloc_func) {
-        return g_custom_allocator->realloc_func(ptr, new_size);
+        result = g_custom_allocator->realloc_func(ptr, new_size);
+    } else {
+        result = realloc(ptr, new_size);
     }
-    return realloc(ptr, new_size);
+#ifdef PAL_HEAP_PROFILER
+    PAL_HeapProfiler_RecordAlloc(result, (u32)new_size, PAL_HEAP_PROFILER_PAL_HEAP, PAL_HEAP_PROFILER_CALLER());
+#endif
+    return result;
 }
 
 void* PAL_Calloc(size_t size, int heap_id) {
-    void* ptr = PAL_Malloc(size, heap_id);
+    (void)heap_id;
+    void* ptr = MallocInternal(size);
+#ifdef PAL_HEAP_PROFILER
+    PAL_HeapProfiler_RecordAlloc(ptr, (u32)size, PAL_HEAP_PROFILER_PAL_HEAP, PAL_HEAP_PROFILER_CALLER());
+#endif
     if (ptr) {
         memset(ptr, 0, size);
     }
@@ -65,4 +98,220 @@ void PAL_Memory_SetAllocator(PAL_Allocator* allocator) {
     g_custom_allocator = allocator;
 }
 
+// ============================================================================
+// Small-object slab allocator
+// ============================================================================
+
+#define SLAB_PAGE_MAGIC 0x534C4142   // "SLAB"
+#define SLAB_PAGE_HEADER_SIZE 64     // Keeps objects 16-byte aligned
+
+// Start of every page; objects are found by rounding down to the page size
+typedef struct SlabPage {
+    u32 magic;
+    u16 size_class;
+    u16 object_size;
+    PAL_SlabCache* cache;
+    struct SlabPage* next;
+} SlabPage;
+
+typedef struct {
+    void* free_list;        // Linked through each object's first word
+    u8* bump;               // Unused tail of the newest page
+    u8* bump_end;
+    PAL_SlabClassStats stats;
+} SlabClass;
+
+struct PAL_SlabCache {
+    SlabClass classes[PAL_SLAB_NUM_CLASSES];
+    SlabPage* pages;
+    SDL_ThreadID owner;
+    void* remote_frees;     // Objects freed by other threads, pushed with CAS
+};
+
+static const u16 g_slabClassSizes[PAL_SLAB_NUM_CLASSES] = {
+    16, 32, 48, 64, 80, 96, 112, 128,
+    160, 192, 224, 256,
+    320, 384, 448, 512,
+};
+
+// Class of each request size in 16-byte steps, indexed by (size + 15) / 16
+static const u8 g_slabSizeClassLookup[PAL_SLAB_MAX_SIZE / 16 + 1] = {
+    0, 0, 1, 2, 3, 4, 5, 6, 7,
+    8, 8, 9, 9, 10, 10, 11, 11,
+    12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15,
+};
+
+static SDL_TLSID g_slabThreadCache;
+
+static SlabPage* GetSlabPage(const void* ptr) {
+    return (SlabPage*)((uintptr_t)ptr & ~(uintptr_t)(PAL_SLAB_PAGE_SIZE - 1));
+}
+
+static BOOL AddSlabPage(PAL_SlabCache* cache, u32 sizeClass) {
+    SlabPage* page = SDL_aligned_alloc(PAL_SLAB_PAGE_SIZE, PAL_SLAB_PAGE_SIZE);
+    if (!page) {
+        return FALSE;
+    }
+    
+    SlabClass* slabClass = &cache->classes[sizeClass];
+    u32 objectSize = g_slabClassSizes[sizeClass];
+    u32 capacity = (PAL_SLAB_PAGE_SIZE - SLAB_PAGE_HEADER_SIZE) / objectSize;
+    
+    page->magic = SLAB_PAGE_MAGIC;
+    page->size_class = (u16)sizeClass;
+    page->object_size = (u16)objectSize;
+    page->cache = cache;
+    page->next = cache->pages;
+    cache->pages = page;
+    
+    slabClass->bump = (u8*)page + SLAB_PAGE_HEADER_SIZE;
+    slabClass->bump_end = slabClass->bump + capacity * objectSize;
+    slabClass->stats.pages++;
+    return TRUE;
+}
+
+static void FreeSlabObject(PAL_SlabCache* cache, u32 sizeClass, void* ptr) {
+    SlabClass* slabClass = &cache->classes[sizeClass];
+    
+    *(void**)ptr = slabClass->free_list;
+    slabClass->free_list = ptr;
+    slabClass->stats.frees++;
+    slabClass->stats.live--;
+}
+
+static void DrainRemoteFrees(PAL_SlabCache* cache) {
+    void* object = SDL_SetAtomicPointer(&cache->remote_frees, NULL);
+    
+    while (object) {
+        void* next = *(void**)object;
+        FreeSlabObject(cache, GetSlabPage(object)->size_class, object);
+        object = next;
+    }
+}
+
+u32 PAL_Slab_GetSizeClass(size_t size) {
+    if (size > PAL_SLAB_MAX_SIZE) {
+        return PAL_SLAB_NUM_CLASSES;
+    }
+    return g_slabSizeClassLookup[(size + 15) / 16];
+}
+
+PAL_SlabCache* PAL_Slab_CreateCache(void) {
+    PAL_SlabCache* cache = calloc(1, sizeof(PAL_SlabCache));
+    if (!cache) {
+        return NULL;
+    }
+    
+    for (u32 i = 0; i < PAL_SLAB_NUM_CLASSES; i++) {
+        cache->classes[i].stats.object_size = g_slabClassSizes[i];
+    }
+    cache->owner = SDL_GetCurrentThreadID();
+    return cache;
+}
+
+void PAL_Slab_DestroyCache(PAL_SlabCache* cache) {
+    if (!cache) {
+        return;
+    }
+    
+    SlabPage* page = cache->pages;
+    while (page) {
+        SlabPage* next = page->next;
+        SDL_aligned_free(page);
+        page = next;
+    }
+    free(cache);
+}
+
+PAL_SlabCache* PAL_Slab_GetThreadCache(void) {
+    PAL_SlabCache* cache = SDL_GetTLS(&g_slabThreadCache);
+    
+    if (!cache) {
+        cache = PAL_Slab_CreateCache();
+        if (cache && !SDL_SetTLS(&g_slabThreadCache, cache, NULL)) {
+            PAL_Slab_DestroyCache(cache);
+            cache = NULL;
+        }
+    }
+    return cache;
+}
+
+void* PAL_Slab_Alloc(PAL_SlabCache* cache, size_t size) {
+    u32 sizeClass = PAL_Slab_GetSizeClass(size);
+    if (sizeClass >= PAL_SLAB_NUM_CLASSES) {
+        return NULL;
+    }
+    return PAL_Slab_AllocFromClass(cache, sizeClass);
+}
+
+void* PAL_Slab_AllocFromClass(PAL_SlabCache* cache, u32 sizeClass) {
+    SlabClass* slabClass = &cache->classes[sizeClass];
+    void* object = slabClass->free_list;
+    
+    if (!object && SDL_GetAtomicPointer(&cache->remote_frees)) {
+        DrainRemoteFrees(cache);
+        object = slabClass->free_list;
+    }
+    
+    if (object) {
+        slabClass->free_list = *(void**)object;
+    } else {
+        if (slabClass->bump == slabClass->bump_end && !AddSlabPage(cache, sizeClass)) {
+            return NULL;
+        }
+        object = slabClass->bump;
+        slabClass->bump += g_slabClassSizes[sizeClass];
+    }
+    
+    slabClass->stats.allocs++;
+    if (++slabClass->stats.live > slabClass->stats.peak_live) {
+        slabClass->stats.peak_live = slabClass->stats.live;
+    }
+    return object;
+}
+
+void PAL_Slab_Free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    
+    SlabPage* page = GetSlabPage(ptr);
+    if (page->magic != SLAB_PAGE_MAGIC) {
+        printf("[Slab] Freeing %p, which is not a slab object\n", ptr);
+        return;
+    }
+    
+    PAL_SlabCache* cache = page->cache;
+    
+    if (cache->owner == SDL_GetCurrentThreadID()) {
+        FreeSlabObject(cache, page->size_class, ptr);
+        return;
+    }
+    
+    void* head;
+    do {
+        head = SDL_GetAtomicPointer(&cache->remote_frees);
+        *(void**)ptr = head;
+    } while (!SDL_CompareAndSwapAtomicPointer(&cache->remote_frees, head, ptr));
+}
+
+void PAL_Slab_FreeToClass(PAL_SlabCache* cache, u32 sizeClass, void* ptr) {
+    FreeSlabObject(cache, sizeClass, ptr);
+}
+
+size_t PAL_Slab_GetObjectSize(const void* ptr) {
+    return GetSlabPage(ptr)->object_size;
+}
+
+void PAL_Slab_GetStats(const PAL_SlabCache* cache, u32 sizeClass, PAL_SlabClassStats* stats) {
+    if (!cache || sizeClass >= PAL_SLAB_NUM_CLASSES) {
+        memset(stats, 0, sizeof(*stats));
+        if (sizeClass < PAL_SLAB_NUM_CLASSES) {
+            stats->object_size = g_slabClassSizes[sizeClass];
+        }
+        return;
+    }
+    *stats = cache->classes[sizeClass].stats;
+}
+
 #endif // PLATFORM_SDL
@@ -6,6 +6,8 @@
 #include "platform/pal_sprite.h"
 #include "platform/pal_memory.h"
 #include "platform/pal_graphics.h"
+#include "platform/pal_tile_decode.h"
+#include "platform/pal_compositor.h"
 #include <SDL3/SDL.h>
 #include <string.h>
 #include <stdlib.h>
@@ -14,6 +16,42 @@
 // Maximum sprites per manager (DS has 128 per screen)
 #define MAX_SPRITES_DEFAULT 256
 
+// OBJ priority levels (0 = front)
+#define SPRITE_NUM_PRIORITIES 4
+
+// Sprite slots per word of a priority mask
+#define SLOTS_PER_MASK_WORD 32
+
+// Sprite atlas: one RGBA32 texture split into 64x64 pages. Every page holds
+// slots of a single sprite size, so all OBJ shapes pack without fragmentation.
+#define ATLAS_SIZE              1024
+#define ATLAS_PAGE_SIZE         64
+#define ATLAS_PAGES_PER_ROW     (ATLAS_SIZE / ATLAS_PAGE_SIZE)
+#define ATLAS_NUM_PAGES         (ATLAS_PAGES_PER_ROW * ATLAS_PAGES_PER_ROW)
+#define ATLAS_MAX_PAGE_SLOTS    64
+
+/**
+ * @brief One 64x64 atlas page
+ */
+typedef struct {
+    u8 slot_width;            // 0 = page unassigned
+    u8 slot_height;
+    u8 slots_per_row;
+    u8 num_slots;
+    u64 used_mask;            // Bit per slot
+    u32 generation;           // Bumped on eviction, invalidates old slots
+    u32 last_used_frame;
+} SpriteAtlasPage;
+
+/**
+ * @brief Shared sprite texture with its page allocator
+ */
+typedef struct {
+    SDL_Texture* texture;
+    SpriteAtlasPage pages[ATLAS_NUM_PAGES];
+    u32 frame;                // Render pass counter, for LRU eviction
+} SpriteAtlas;
+
 /**
  * @brief Single sprite structure
  */
@@ -21,7 +59,8 @@ struct PAL_Sprite {
     // Graphics data
     void* graphics_data;
     u32 graphics_size;
-    PAL_Palette palette;
+    PAL_PaletteLUT palette;
+    BOOL has_palette;         // FALSE = use the screen's OBJ palette
     
     // Sprite properties
     PAL_SpriteSize size;
@@ -40,6 +79,7 @@ struct PAL_Sprite {
     u8 alpha;                 // 0-255
     PAL_SpriteFlip flip;
     PAL_SpriteBlendMode blend_mode;
+    BOOL obj_window;          // Shapes the OBJ window, never drawn
     PAL_Screen screen;
     
     // State
@@ -48,12 +88,19 @@ struct PAL_Sprite {
     int frame;                // Current animation frame
     
     // Rendering cache
-    SDL_Texture* texture;
+    SDL_Texture* texture;     // Own texture (indexed mode, or atlas full), else NULL
+    int atlas_page;           // Atlas page holding the pixels, -1 = none
+    int atlas_slot;
+    u32 atlas_generation;     // Page generation the slot was allocated in
     BOOL texture_dirty;
+    u32 decoded_palette_generation;  // Palette generation the texture was decoded with
+    SDL_Palette* sdl_palette;        // Indexed mode: palette attached to texture, else NULL
+    u32 synced_palette_generation;   // Indexed mode: generation last copied to sdl_palette
     
     // Manager link
     PAL_SpriteManager* manager;
     int index;                // Index in manager's array
+    PAL_Sprite* next_free;    // Free list link while the slot is unused
 };
 
 /**
@@ -68,20 +115,45 @@ struct PAL_SpriteManager {
     // Rendering
     SDL_Renderer* renderer;
     
-    // Sorted list for priority rendering
-    PAL_Sprite** render_order;
-    BOOL render_order_dirty;
+    // Unused slots, lowest index first when the manager is created
+    PAL_Sprite* free_list;
+    
+    // Visible sprites, one bit per slot for each priority level. Walking
+    // the bits gives OAM index order without ever sorting.
+    u32* priority_masks[SPRITE_NUM_PRIORITIES];
+    int mask_words;
+    
+    // Batched atlas rendering
+    SpriteAtlas* atlas;
+    SDL_Vertex* batch_vertices;
+    int* batch_indices;
+    int batch_count;          // Quads queued
+    SDL_BlendMode batch_blend;
 };
 
 // Helper functions
 static void GetSpriteDimensions(PAL_SpriteSize size, int* width, int* height);
 static u32 GetSpriteDataSize(PAL_SpriteSize size, PAL_SpriteColorMode color_mode);
+static void DecodeSpritePixels(PAL_Sprite* sprite, u32* dst, int stride);
 static void RenderSpriteTexture(PAL_Sprite* sprite);
-static void DecodeSpriteGraphics4bpp(const u8* src, u8 palette_num, const PAL_Palette* palette,
-                                     int width, int height, PAL_SpriteFlip flip, u32* output);
-static void DecodeSpriteGraphics8bpp(const u8* src, const PAL_Palette* palette,
-                                     int width, int height, PAL_SpriteFlip flip, u32* output);
-static int CompareSpritesByPriority(const void* a, const void* b);
+static void RenderSpriteIndices(PAL_Sprite* sprite);
+static void DrawSpriteTexture(PAL_Sprite* sprite);
+static SDL_BlendMode GetSDLBlendMode(PAL_SpriteBlendMode blend_mode);
+static BOOL SyncAtlasSprite(PAL_SpriteManager* manager, PAL_Sprite* sprite);
+static BOOL AllocAtlasSlot(SpriteAtlas* atlas, int width, int height, int* page, int* slot);
+static void FreeAtlasSlot(SpriteAtlas* atlas, PAL_Sprite* sprite);
+static void GetAtlasSlotRect(const SpriteAtlas* atlas, int page, int slot, SDL_Rect* rect);
+static void AppendSpriteQuad(PAL_SpriteManager* manager, const PAL_Sprite* sprite);
+static void FlushSpriteBatch(PAL_SpriteManager* manager);
+static const PAL_PaletteLUT* GetSpritePaletteLUT(const PAL_Sprite* sprite);
+static u32 GetSpritePaletteGeneration(const PAL_Sprite* sprite);
+static void EnsureObjPalettes(void);
+static void LinkSprite(PAL_Sprite* sprite);
+static void UnlinkSprite(PAL_Sprite* sprite);
+
+// Shared OBJ palettes (one per screen), initialized on first use
+static PAL_PaletteLUT g_objPalettes[PAL_SCREEN_MAX];
+static BOOL g_objPalettesInitialized = FALSE;
 
 // ============================================================================
 // Sprite Manager
@@ -105,34 +177,69 @@ PAL_SpriteManager* PAL_Sprite_CreateManager(int max_sprites, u32 heapID) {
         return NULL;
     }
     
-    manager->render_order = (PAL_Sprite**)PAL_Malloc(
-        sizeof(PAL_Sprite*) * max_sprites, heapID);
-    if (!manager->render_order) {
+    manager->mask_words = (max_sprites + SLOTS_PER_MASK_WORD - 1) / SLOTS_PER_MASK_WORD;
+    u32* masks = (u32*)PAL_Calloc(
+        sizeof(u32) * manager->mask_words * SPRITE_NUM_PRIORITIES, heapID);
+    if (!masks) {
+        PAL_Free(manager->sprites);
+        PAL_Free(manager);
+        return NULL;
+    }
+    for (int i = 0; i < SPRITE_NUM_PRIORITIES; i++) {
+        manager->priority_masks[i] = &masks[i * manager->mask_words];
+    }
+    
+    // Room for every sprite in one batch; the index pattern never changes
+    manager->batch_vertices = (SDL_Vertex*)PAL_Malloc(
+        sizeof(SDL_Vertex) * 4 * max_sprites, heapID);
+    manager->batch_indices = (int*)PAL_Malloc(
+        sizeof(int) * 6 * max_sprites, heapID);
+    if (!manager->batch_vertices || !manager->batch_indices) {
+        PAL_Free(manager->batch_vertices);
+        PAL_Free(manager->batch_indices);
+        PAL_Free(manager->priority_masks[0]);
         PAL_Free(manager->sprites);
         PAL_Free(manager);
         return NULL;
     }
+    for (int i = 0; i < max_sprites; i++) {
+        int* quad = &manager->batch_indices[i * 6];
+        quad[0] = i * 4 + 0;
+        quad[1] = i * 4 + 1;
+        quad[2] = i * 4 + 2;
+        quad[3] = i * 4 + 2;
+        quad[4] = i * 4 + 1;
+        quad[5] = i * 4 + 3;
+    }
     
-    // Initialize all sprites as inactive
+    // Initialize all sprites as inactive and chain them into the free list
     memset(manager->sprites, 0, sizeof(PAL_Sprite) * max_sprites);
-    for (int i = 0; i < max_sprites; i++) {
+    manager->free_list = NULL;
+    for (int i = max_sprites - 1; i >= 0; i--) {
         manager->sprites[i].active = FALSE;
         manager->sprites[i].manager = manager;
         manager->sprites[i].index = i;
+        manager->sprites[i].next_free = manager->free_list;
+        manager->free_list = &manager->sprites[i];
     }
     
     manager->max_sprites = max_sprites;
     manager->active_count = 0;
     manager->heapID = heapID;
     manager->renderer = PAL_Graphics_GetRenderer();
-    manager->render_order_dirty = TRUE;
+    manager->atlas = NULL;
+    manager->batch_count = 0;
+    manager->batch_blend = SDL_BLENDMODE_BLEND;
     
+    PAL_Compositor_AttachSprites(manager);
     return manager;
 }
 
 void PAL_Sprite_DestroyManager(PAL_SpriteManager* manager) {
     if (!manager) return;
     
+    PAL_Compositor_DetachSprites(manager);
+    
     // Destroy all sprites first
     for (int i = 0; i < manager->max_sprites; i++) {
         PAL_Sprite* sprite = &manager->sprites[i];
@@ -143,10 +250,22 @@ void PAL_Sprite_DestroyManager(PAL_SpriteManager* manager) {
             if (sprite->texture) {
                 SDL_DestroyTexture(sprite->texture);
             }
+            if (sprite->sdl_palette) {
+                SDL_DestroyPalette(sprite->sdl_palette);
+            }
         }
     }
     
-    PAL_Free(manager->render_order);
+    if (manager->atlas) {
+        if (manager->atlas->texture) {
+            SDL_DestroyTexture(manager->atlas->texture);
+        }
+        PAL_Free(manager->atlas);
+    }
+    
+    PAL_Free(manager->batch_vertices);
+    PAL_Free(manager->batch_indices);
+    PAL_Free(manager->priority_masks[0]);
     PAL_Free(manager->sprites);
     PAL_Free(manager);
 }
@@ -169,18 +288,12 @@ PAL_Sprite* PAL_Sprite_Create(PAL_SpriteManager* manager,
         return NULL;
     }
     
-    // Find free sprite slot
-    PAL_Sprite* sprite = NULL;
-    for (int i = 0; i < manager->max_sprites; i++) {
-        if (!manager->sprites[i].active) {
-            sprite = &manager->sprites[i];
-            break;
-        }
-    }
-    
+    // Take a free sprite slot
+    PAL_Sprite* sprite = manager->free_list;
     if (!sprite) {
         return NULL; // No free slots
     }
+    manager->free_list = sprite->next_free;
     
     // Initialize sprite
     memset(sprite, 0, sizeof(PAL_Sprite));
@@ -197,16 +310,12 @@ PAL_Sprite* PAL_Sprite_Create(PAL_SpriteManager* manager,
         }
     }
     
-    // Convert palette
+    // Pack palette once
+    PAL_PaletteLUT_Init(&sprite->palette);
     if (template->palette_data && template->palette_size > 0) {
-        const u16* rgb555_palette = (const u16*)template->palette_data;
-        u32 num_colors = template->palette_size / sizeof(u16);
-        if (num_colors > 256) num_colors = 256;
-        
-        for (u32 i = 0; i < num_colors; i++) {
-            sprite->palette.colors[i] = PAL_ColorFromRGB555(rgb555_palette[i]);
-        }
-        sprite->palette.num_colors = num_colors;
+        PAL_PaletteLUT_Load(&sprite->palette, (const u16*)template->palette_data,
+                            0, template->palette_size / sizeof(u16));
+        sprite->has_palette = TRUE;
     }
     
     // Set properties
@@ -216,7 +325,7 @@ PAL_Sprite* PAL_Sprite_Create(PAL_SpriteManager* manager,
     
     sprite->x = template->x;
     sprite->y = template->y;
-    sprite->priority = template->priority;
+    sprite->priority = (template->priority > 3) ? 3 : template->priority;
     sprite->palette_num = template->palette_num;
     sprite->screen = template->screen;
     
@@ -228,15 +337,16 @@ PAL_Sprite* PAL_Sprite_Create(PAL_SpriteManager* manager,
     sprite->alpha = 255;
     sprite->flip = PAL_SPRITE_FLIP_NONE;
     sprite->blend_mode = PAL_SPRITE_BLEND_NONE;
+    sprite->obj_window = FALSE;
     sprite->visible = TRUE;
     sprite->frame = 0;
     
-    // Create SDL texture
-    if (manager->renderer) {
-        sprite->texture = SDL_CreateTexture(manager->renderer,
-                                           SDL_PIXELFORMAT_RGBA32,
-                                           SDL_TEXTUREACCESS_STREAMING,
-                                           sprite->width, sprite->height);
+    // Direct color sprites live in the manager's atlas; indexed sprites
+    // need their own texture to carry their own palette
+    sprite->atlas_page = -1;
+    if (manager->renderer && PAL_Graphics_GetColorMode() == PAL_GRAPHICS_COLOR_INDEXED) {
+        sprite->texture = PAL_Graphics_CreateIndexedTexture(sprite->width, sprite->height,
+                                                           &sprite->sdl_palette);
         if (sprite->texture) {
             SDL_SetTextureBlendMode(sprite->texture, SDL_BLENDMODE_BLEND);
         }
@@ -244,7 +354,7 @@ PAL_Sprite* PAL_Sprite_Create(PAL_SpriteManager* manager,
     
     sprite->texture_dirty = TRUE;
     manager->active_count++;
-    manager->render_order_dirty = TRUE;
+    LinkSprite(sprite);
     
     return sprite;
 }
@@ -261,10 +371,19 @@ void PAL_Sprite_Destroy(PAL_SpriteManager* manager, PAL_Sprite* sprite) {
     if (sprite->texture) {
         SDL_DestroyTexture(sprite->texture);
     }
+    if (sprite->sdl_palette) {
+        SDL_DestroyPalette(sprite->sdl_palette);
+        sprite->sdl_palette = NULL;
+    }
+    FreeAtlasSlot(manager->atlas, sprite);
     
+    if (sprite->visible) {
+        UnlinkSprite(sprite);
+    }
     sprite->active = FALSE;
+    sprite->next_free = manager->free_list;
+    manager->free_list = sprite;
     manager->active_count--;
-    manager->render_order_dirty = TRUE;
 }
 
 void PAL_Sprite_DestroyAll(PAL_SpriteManager* manager) {
@@ -295,6 +414,11 @@ void PAL_Sprite_GetPosition(const PAL_Sprite* sprite, int* x, int* y) {
 
 void PAL_Sprite_SetVisible(PAL_Sprite* sprite, BOOL visible) {
     if (!sprite || !sprite->active) return;
+    if (visible && !sprite->visible) {
+        LinkSprite(sprite);
+    } else if (!visible && sprite->visible) {
+        UnlinkSprite(sprite);
+    }
     sprite->visible = visible;
 }
 
@@ -305,9 +429,12 @@ BOOL PAL_Sprite_GetVisible(const PAL_Sprite* sprite) {
 void PAL_Sprite_SetPriority(PAL_Sprite* sprite, u8 priority) {
     if (!sprite || !sprite->active) return;
     if (priority > 3) priority = 3;
-    sprite->priority = priority;
-    if (sprite->manager) {
-        sprite->manager->render_order_dirty = TRUE;
+    if (sprite->visible) {
+        UnlinkSprite(sprite);
+        sprite->priority = priority;
+        LinkSprite(sprite);
+    } else {
+        sprite->priority = priority;
     }
 }
 
@@ -336,27 +463,18 @@ void PAL_Sprite_SetAlpha(PAL_Sprite* sprite, u8 alpha) {
 }
 
 void PAL_Sprite_SetBlendMode(PAL_Sprite* sprite, PAL_SpriteBlendMode blend_mode) {
-    if (!sprite || !sprite->active || !sprite->texture) return;
+    if (!sprite || !sprite->active) return;
     
     sprite->blend_mode = blend_mode;
     
-    SDL_BlendMode sdl_blend;
-    switch (blend_mode) {
-        case PAL_SPRITE_BLEND_ALPHA:
-            sdl_blend = SDL_BLENDMODE_BLEND;
-            break;
-        case PAL_SPRITE_BLEND_ADD:
-            sdl_blend = SDL_BLENDMODE_ADD;
-            break;
-        case PAL_SPRITE_BLEND_SUB:
-            sdl_blend = SDL_BLENDMODE_MUL;  // SDL doesn't have subtract, use multiply
-            break;
-        default:
-            sdl_blend = SDL_BLENDMODE_NONE;
-            break;
+    if (sprite->texture) {
+        SDL_SetTextureBlendMode(sprite->texture, GetSDLBlendMode(blend_mode));
     }
-    
-    SDL_SetTextureBlendMode(sprite->texture, sdl_blend);
+}
+
+void PAL_Sprite_SetObjWindow(PAL_Sprite* sprite, BOOL enable) {
+    if (!sprite || !sprite->active) return;
+    sprite->obj_window = enable;
 }
 
 // ============================================================================
@@ -407,76 +525,124 @@ int PAL_Sprite_GetFrame(const PAL_Sprite* sprite) {
 // ============================================================================
 
 void PAL_Sprite_UpdateAll(PAL_SpriteManager* manager) {
-    if (!manager) return;
-    
-    // Update render order if dirty
-    if (manager->render_order_dirty) {
-        int count = 0;
-        for (int i = 0; i < manager->max_sprites; i++) {
-            if (manager->sprites[i].active && manager->sprites[i].visible) {
-                manager->render_order[count++] = &manager->sprites[i];
-            }
-        }
-        
-        // Sort by priority (lower priority = rendered first/behind)
-        qsort(manager->render_order, count, sizeof(PAL_Sprite*), 
-              CompareSpritesByPriority);
-        
-        manager->render_order_dirty = FALSE;
-    }
+    // Draw order is maintained as sprites are created, shown and
+    // re-prioritised, so there is nothing to rebuild here
+    (void)manager;
 }
 
 void PAL_Sprite_RenderAll(PAL_SpriteManager* manager) {
     if (!manager || !manager->renderer) return;
     
-    // Ensure render order is up to date
-    PAL_Sprite_UpdateAll(manager);
+    if (manager->atlas) {
+        manager->atlas->frame++;
+    }
     
-    // Render all visible sprites in priority order
-    for (int i = 0; i < manager->max_sprites; i++) {
-        PAL_Sprite* sprite = manager->render_order[i];
-        if (!sprite || !sprite->active || !sprite->visible) {
-            break; // End of active sprites
+    // Screens never overlap, so each one is a run of batches in priority
+    // order; a batch only breaks on a blend mode change or a sprite that
+    // has its own texture
+    for (int screen = 0; screen < PAL_SCREEN_MAX; screen++) {
+        // Back to front: priority 3 first, and within a priority the highest
+        // OAM index first so lower indices end up on top, as on the DS
+        for (int prio = SPRITE_NUM_PRIORITIES - 1; prio >= 0; prio--) {
+            const u32* mask = manager->priority_masks[prio];
+            
+            for (int word = manager->mask_words - 1; word >= 0; word--) {
+                u32 bits = mask[word];
+                
+                while (bits) {
+                    int bit = SDL_MostSignificantBitIndex32(bits);
+                    bits &= ~(1u << bit);
+                    
+                    PAL_Sprite* sprite = &manager->sprites[word * SLOTS_PER_MASK_WORD + bit];
+                    if (sprite->screen != screen || sprite->obj_window) {
+                        continue;
+                    }
+                    
+                    if (SyncAtlasSprite(manager, sprite)) {
+                        SDL_BlendMode blend = GetSDLBlendMode(sprite->blend_mode);
+                        if (manager->batch_count > 0 && blend != manager->batch_blend) {
+                            FlushSpriteBatch(manager);
+                        }
+                        manager->batch_blend = blend;
+                        AppendSpriteQuad(manager, sprite);
+                    } else {
+                        FlushSpriteBatch(manager);
+                        DrawSpriteTexture(sprite);
+                    }
+                }
+            }
         }
-        
-        PAL_Sprite_Render(sprite);
+        FlushSpriteBatch(manager);
     }
 }
 
 void PAL_Sprite_Render(const PAL_Sprite* sprite) {
-    if (!sprite || !sprite->active || !sprite->visible || !sprite->texture) {
+    if (!sprite || !sprite->active || !sprite->visible || sprite->obj_window) {
         return;
     }
     
-    // Update texture if dirty
-    if (sprite->texture_dirty) {
-        RenderSpriteTexture((PAL_Sprite*)sprite);
-        ((PAL_Sprite*)sprite)->texture_dirty = FALSE;
+    PAL_SpriteManager* manager = sprite->manager;
+    if (SyncAtlasSprite(manager, (PAL_Sprite*)sprite)) {
+        manager->batch_blend = GetSDLBlendMode(sprite->blend_mode);
+        AppendSpriteQuad(manager, sprite);
+        FlushSpriteBatch(manager);
+    } else {
+        DrawSpriteTexture((PAL_Sprite*)sprite);
     }
+}
+
+int PAL_Sprite_GetViews(PAL_SpriteManager* manager, PAL_Screen screen,
+                        PAL_SpriteView* views, int maxViews) {
+    if (!manager || !views) return 0;
     
-    SDL_Renderer* renderer = sprite->manager->renderer;
+    int count = 0;
+    for (int i = 0; i < manager->max_sprites && count < maxViews; i++) {
+        const PAL_Sprite* sprite = &manager->sprites[i];
+        if (!sprite->active || !sprite->visible || sprite->screen != screen || !sprite->graphics_data) {
+            continue;
+        }
+        // Same rule as the texture path: never read past the sprite's graphics
+        if (sprite->graphics_size < GetSpriteDataSize(sprite->size, sprite->color_mode)) {
+            continue;
+        }
+        
+        PAL_SpriteView* view = &views[count++];
+        const u32* lut = GetSpritePaletteLUT(sprite)->colors;
+        
+        view->graphics = (const u8*)sprite->graphics_data;
+        view->is8bpp = (sprite->color_mode == PAL_SPRITE_COLOR_8BPP);
+        view->palette = view->is8bpp ? lut : &lut[(sprite->palette_num & 0x0F) * 16];
+        view->width = sprite->width;
+        view->height = sprite->height;
+        view->x = sprite->x;
+        view->y = sprite->y;
+        view->priority = sprite->priority;
+        view->flip = sprite->flip;
+        view->affine = sprite->affine_enabled;
+        view->rotation = sprite->rotation;
+        view->scaleX = sprite->scale_x;
+        view->scaleY = sprite->scale_y;
+        view->alpha = sprite->alpha;
+        view->blendMode = sprite->blend_mode;
+        view->objWindow = sprite->obj_window;
+    }
     
-    // Calculate screen offset
-    int screen_x_offset = (sprite->screen == PAL_SCREEN_SUB) ? 256 : 0;
+    return count;
+}
+
+// ============================================================================
+// OBJ Palette
+// ============================================================================
+
+void PAL_Sprite_LoadScreenPalette(PAL_Screen screen, const void* src, u16 size, u16 offset) {
+    if (screen >= PAL_SCREEN_MAX || !src) {
+        return;
+    }
     
-    // Create destination rectangle
-    SDL_FRect dst;
-    dst.x = (float)(sprite->x + screen_x_offset);
-    dst.y = (float)sprite->y;
-    dst.w = (float)(sprite->width * sprite->scale_x);
-    dst.h = (float)(sprite->height * sprite->scale_y);
+    EnsureObjPalettes();
     
-    // Center point for rotation
-    SDL_FPoint center = { dst.w / 2.0f, dst.h / 2.0f };
-    
-    // Render with or without affine transformation
-    if (sprite->affine_enabled && 
-        (sprite->rotation != 0.0f || sprite->scale_x != 1.0f || sprite->scale_y != 1.0f)) {
-        SDL_RenderTextureRotated(renderer, sprite->texture, NULL, &dst, 
-                                sprite->rotation, &center, SDL_FLIP_NONE);
-    } else {
-        SDL_RenderTexture(renderer, sprite->texture, NULL, &dst);
-    }
+    // Sprites notice the new generation on their next render
+    PAL_PaletteLUT_Load(&g_objPalettes[screen], (const u16*)src, offset, size / sizeof(u16));
 }
 
 // ============================================================================
@@ -532,8 +698,32 @@ static u32 GetSpriteDataSize(PAL_SpriteSize size, PAL_SpriteColorMode color_mode
     }
 }
 
+static void DecodeSpritePixels(PAL_Sprite* sprite, u32* dst, int stride) {
+    sprite->decoded_palette_generation = GetSpritePaletteGeneration(sprite);
+    
+    // Never read past the end of the sprite's graphics
+    if (!sprite->graphics_data
+        || sprite->graphics_size < GetSpriteDataSize(sprite->size, sprite->color_mode)) {
+        for (int y = 0; y < sprite->height; y++) {
+            memset(&dst[y * stride], 0, sprite->width * sizeof(u32));
+        }
+        return;
+    }
+    
+    const u32* lut = GetSpritePaletteLUT(sprite)->colors;
+    
+    if (sprite->color_mode == PAL_SPRITE_COLOR_4BPP) {
+        PAL_TileDecode_Linear4bpp((const u8*)sprite->graphics_data,
+                                  &lut[(sprite->palette_num & 0x0F) * 16], dst,
+                                  sprite->width, sprite->height, stride, sprite->flip);
+    } else {
+        PAL_TileDecode_Linear8bpp((const u8*)sprite->graphics_data, lut, dst,
+                                  sprite->width, sprite->height, stride, sprite->flip);
+    }
+}
+
 static void RenderSpriteTexture(PAL_Sprite* sprite) {
-    if (!sprite->texture || !sprite->graphics_data) {
+    if (!sprite->texture) {
         return;
     }
     
@@ -544,83 +734,325 @@ static void RenderSpriteTexture(PAL_Sprite* sprite) {
         return;
     }
     
-    // Decode sprite graphics to RGBA
-    u32* rgba_buffer = (u32*)pixels;
+    DecodeSpritePixels(sprite, (u32*)pixels, pitch / (int)sizeof(u32));
     
-    if (sprite->color_mode == PAL_SPRITE_COLOR_4BPP) {
-        DecodeSpriteGraphics4bpp((const u8*)sprite->graphics_data, 
-                                sprite->palette_num, &sprite->palette,
-                                sprite->width, sprite->height, sprite->flip,
-                                rgba_buffer);
+    SDL_UnlockTexture(sprite->texture);
+}
+
+static void RenderSpriteIndices(PAL_Sprite* sprite) {
+    if (!sprite->texture || !sprite->graphics_data) {
+        return;
+    }
+    
+    void* pixels;
+    int pitch;
+    if (!SDL_LockTexture(sprite->texture, NULL, &pixels, &pitch)) {
+        return;
+    }
+    
+    if (sprite->graphics_size < GetSpriteDataSize(sprite->size, sprite->color_mode)) {
+        memset(pixels, 0, pitch * sprite->height);
+    } else if (sprite->color_mode == PAL_SPRITE_COLOR_4BPP) {
+        PAL_TileDecode_Linear4bppIndex((const u8*)sprite->graphics_data, sprite->palette_num,
+                                       (u8*)pixels, sprite->width, sprite->height, pitch, sprite->flip);
     } else {
-        DecodeSpriteGraphics8bpp((const u8*)sprite->graphics_data,
-                                &sprite->palette,
-                                sprite->width, sprite->height, sprite->flip,
-                                rgba_buffer);
+        PAL_TileDecode_Linear8bppIndex((const u8*)sprite->graphics_data, (u8*)pixels,
+                                       sprite->width, sprite->height, pitch, sprite->flip);
     }
     
     SDL_UnlockTexture(sprite->texture);
 }
 
-static void DecodeSpriteGraphics4bpp(const u8* src, u8 palette_num, const PAL_Palette* palette,
-                                     int width, int height, PAL_SpriteFlip flip, u32* output) {
-    int palette_offset = palette_num * 16;
-    BOOL hflip = (flip & PAL_SPRITE_FLIP_H) != 0;
-    BOOL vflip = (flip & PAL_SPRITE_FLIP_V) != 0;
+static void DrawSpriteTexture(PAL_Sprite* sprite) {
+    SDL_Renderer* renderer = sprite->manager->renderer;
+    if (!renderer) {
+        return;
+    }
     
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            int src_x = hflip ? (width - 1 - x) : x;
-            int src_y = vflip ? (height - 1 - y) : y;
-            
-            int byte_idx = (src_y * width + src_x) / 2;
-            int nibble = (src_x & 1);
-            
-            u8 color_idx = (src[byte_idx] >> (nibble * 4)) & 0x0F;
-            
-            if (color_idx == 0) {
-                output[y * width + x] = 0x00000000;  // Transparent
-            } else {
-                int pal_idx = palette_offset + color_idx;
-                if (pal_idx < 256) {
-                    PAL_Color color = palette->colors[pal_idx];
-                    output[y * width + x] = (color.a << 24) | (color.b << 16) | 
-                                           (color.g << 8) | color.r;
-                } else {
-                    output[y * width + x] = 0xFF00FF00;  // Magenta (out of bounds)
-                }
-            }
+    // Sprites that did not get an atlas slot fall back to their own texture
+    if (!sprite->texture) {
+        sprite->texture = SDL_CreateTexture(renderer,
+                                           SDL_PIXELFORMAT_RGBA32,
+                                           SDL_TEXTUREACCESS_STREAMING,
+                                           sprite->width, sprite->height);
+        if (!sprite->texture) {
+            return;
+        }
+        SDL_SetTextureBlendMode(sprite->texture, GetSDLBlendMode(sprite->blend_mode));
+        SDL_SetTextureAlphaMod(sprite->texture, sprite->alpha);
+        sprite->texture_dirty = TRUE;
+    }
+    
+    // Update texture if dirty or its palette changed; indexed textures
+    // only need their palette entries refreshed on a palette change
+    if (sprite->sdl_palette) {
+        if (sprite->texture_dirty) {
+            RenderSpriteIndices(sprite);
+            sprite->texture_dirty = FALSE;
         }
+        sprite->synced_palette_generation = PAL_Graphics_SyncIndexedPalette(
+            sprite->sdl_palette, GetSpritePaletteLUT(sprite), sprite->synced_palette_generation);
+    } else if (sprite->texture_dirty
+        || sprite->decoded_palette_generation != GetSpritePaletteGeneration(sprite)) {
+        RenderSpriteTexture(sprite);
+        sprite->texture_dirty = FALSE;
+    }
+    
+    // Calculate screen offset
+    int screen_x_offset = (sprite->screen == PAL_SCREEN_SUB) ? 256 : 0;
+    
+    // Create destination rectangle
+    SDL_FRect dst;
+    dst.x = (float)(sprite->x + screen_x_offset);
+    dst.y = (float)sprite->y;
+    dst.w = (float)(sprite->width * sprite->scale_x);
+    dst.h = (float)(sprite->height * sprite->scale_y);
+    
+    // Center point for rotation
+    SDL_FPoint center = { dst.w / 2.0f, dst.h / 2.0f };
+    
+    // Render with or without affine transformation
+    if (sprite->affine_enabled && 
+        (sprite->rotation != 0.0f || sprite->scale_x != 1.0f || sprite->scale_y != 1.0f)) {
+        SDL_RenderTextureRotated(renderer, sprite->texture, NULL, &dst, 
+                                sprite->rotation, &center, SDL_FLIP_NONE);
+    } else {
+        SDL_RenderTexture(renderer, sprite->texture, NULL, &dst);
     }
 }
 
-static void DecodeSpriteGraphics8bpp(const u8* src, const PAL_Palette* palette,
-                                     int width, int height, PAL_SpriteFlip flip, u32* output) {
-    BOOL hflip = (flip & PAL_SPRITE_FLIP_H) != 0;
-    BOOL vflip = (flip & PAL_SPRITE_FLIP_V) != 0;
+static SDL_BlendMode GetSDLBlendMode(PAL_SpriteBlendMode blend_mode) {
+    switch (blend_mode) {
+        case PAL_SPRITE_BLEND_ADD:
+            return SDL_BLENDMODE_ADD;
+        case PAL_SPRITE_BLEND_SUB:
+            return SDL_BLENDMODE_MUL;  // SDL doesn't have subtract, use multiply
+        default:
+            // Color 0 has to stay see-through even without a blend effect
+            return SDL_BLENDMODE_BLEND;
+    }
+}
+
+static void EnsureObjPalettes(void) {
+    if (!g_objPalettesInitialized) {
+        for (int i = 0; i < PAL_SCREEN_MAX; i++) {
+            PAL_PaletteLUT_Init(&g_objPalettes[i]);
+        }
+        g_objPalettesInitialized = TRUE;
+    }
+}
+
+static const PAL_PaletteLUT* GetSpritePaletteLUT(const PAL_Sprite* sprite) {
+    if (sprite->has_palette) {
+        return &sprite->palette;
+    }
     
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            int src_x = hflip ? (width - 1 - x) : x;
-            int src_y = vflip ? (height - 1 - y) : y;
-            
-            u8 color_idx = src[src_y * width + src_x];
-            
-            if (color_idx == 0) {
-                output[y * width + x] = 0x00000000;  // Transparent
-            } else {
-                PAL_Color color = palette->colors[color_idx];
-                output[y * width + x] = (color.a << 24) | (color.b << 16) | 
-                                       (color.g << 8) | color.r;
+    EnsureObjPalettes();
+    return &g_objPalettes[sprite->screen == PAL_SCREEN_SUB ? PAL_SCREEN_SUB : PAL_SCREEN_MAIN];
+}
+
+static u32 GetSpritePaletteGeneration(const PAL_Sprite* sprite) {
+    const PAL_PaletteLUT* lut = GetSpritePaletteLUT(sprite);
+    
+    // A 4bpp sprite only sees its own 16-color sub-palette
+    if (sprite->color_mode == PAL_SPRITE_COLOR_4BPP) {
+        return lut->subGenerations[sprite->palette_num & 0x0F];
+    }
+    return lut->generation;
+}
+
+static void LinkSprite(PAL_Sprite* sprite) {
+    int index = sprite->index;
+    sprite->manager->priority_masks[sprite->priority][index / SLOTS_PER_MASK_WORD]
+        |= 1u << (index % SLOTS_PER_MASK_WORD);
+}
+
+static void UnlinkSprite(PAL_Sprite* sprite) {
+    int index = sprite->index;
+    sprite->manager->priority_masks[sprite->priority][index / SLOTS_PER_MASK_WORD]
+        &= ~(1u << (index % SLOTS_PER_MASK_WORD));
+}
+
+// ============================================================================
+// Sprite Atlas
+// ============================================================================
+
+static BOOL SyncAtlasSprite(PAL_SpriteManager* manager, PAL_Sprite* sprite) {
+    // Indexed sprites, and sprites already moved to their own texture, stay there
+    if (!manager || !manager->renderer || sprite->texture) {
+        return FALSE;
+    }
+    
+    if (!manager->atlas) {
+        manager->atlas = (SpriteAtlas*)PAL_Calloc(sizeof(SpriteAtlas), manager->heapID);
+        if (!manager->atlas) {
+            return FALSE;
+        }
+        manager->atlas->texture = SDL_CreateTexture(manager->renderer,
+                                                    SDL_PIXELFORMAT_RGBA32,
+                                                    SDL_TEXTUREACCESS_STATIC,
+                                                    ATLAS_SIZE, ATLAS_SIZE);
+        if (manager->atlas->texture) {
+            // Nearest sampling keeps neighbouring slots from bleeding in when scaled
+            SDL_SetTextureScaleMode(manager->atlas->texture, SDL_SCALEMODE_NEAREST);
+        }
+    }
+    
+    SpriteAtlas* atlas = manager->atlas;
+    if (!atlas->texture) {
+        return FALSE;
+    }
+    
+    // A slot is lost when its page was evicted for another sprite size
+    BOOL upload = sprite->texture_dirty
+        || sprite->decoded_palette_generation != GetSpritePaletteGeneration(sprite);
+    if (sprite->atlas_page < 0
+        || atlas->pages[sprite->atlas_page].generation != sprite->atlas_generation) {
+        if (!AllocAtlasSlot(atlas, sprite->width, sprite->height,
+                            &sprite->atlas_page, &sprite->atlas_slot)) {
+            sprite->atlas_page = -1;
+            return FALSE;
+        }
+        sprite->atlas_generation = atlas->pages[sprite->atlas_page].generation;
+        upload = TRUE;
+    }
+    
+    atlas->pages[sprite->atlas_page].last_used_frame = atlas->frame;
+    
+    if (upload) {
+        u32 pixels[ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE];
+        SDL_Rect rect;
+        
+        DecodeSpritePixels(sprite, pixels, sprite->width);
+        GetAtlasSlotRect(atlas, sprite->atlas_page, sprite->atlas_slot, &rect);
+        SDL_UpdateTexture(atlas->texture, &rect, pixels, sprite->width * (int)sizeof(u32));
+        sprite->texture_dirty = FALSE;
+    }
+    
+    return TRUE;
+}
+
+static BOOL AllocAtlasSlot(SpriteAtlas* atlas, int width, int height, int* page, int* slot) {
+    int target = -1;
+    
+    // 1. A page of the same slot size with room left
+    for (int i = 0; i < ATLAS_NUM_PAGES && target < 0; i++) {
+        SpriteAtlasPage* p = &atlas->pages[i];
+        u64 full = (p->num_slots == 64) ? ~0ULL : ((1ULL << p->num_slots) - 1);
+        if (p->slot_width == width && p->slot_height == height && p->used_mask != full) {
+            target = i;
+        }
+    }
+    
+    // 2. An empty page, or else the least recently drawn page not used this frame
+    if (target < 0) {
+        int lru = -1;
+        for (int i = 0; i < ATLAS_NUM_PAGES; i++) {
+            SpriteAtlasPage* p = &atlas->pages[i];
+            if (p->used_mask == 0) {
+                lru = i;
+                break;
             }
+            if (p->last_used_frame != atlas->frame
+                && (lru < 0 || p->last_used_frame < atlas->pages[lru].last_used_frame)) {
+                lru = i;
+            }
+        }
+        if (lru < 0) {
+            return FALSE; // Everything is on screen this frame
         }
+        
+        SpriteAtlasPage* p = &atlas->pages[lru];
+        p->slot_width = (u8)width;
+        p->slot_height = (u8)height;
+        p->slots_per_row = (u8)(ATLAS_PAGE_SIZE / width);
+        p->num_slots = (u8)(p->slots_per_row * (ATLAS_PAGE_SIZE / height));
+        p->used_mask = 0;
+        p->generation++;
+        target = lru;
     }
+    
+    SpriteAtlasPage* p = &atlas->pages[target];
+    int free_slot = 0;
+    while (p->used_mask & (1ULL << free_slot)) {
+        free_slot++;
+    }
+    
+    p->used_mask |= 1ULL << free_slot;
+    *page = target;
+    *slot = free_slot;
+    return TRUE;
+}
+
+static void FreeAtlasSlot(SpriteAtlas* atlas, PAL_Sprite* sprite) {
+    if (atlas && sprite->atlas_page >= 0
+        && atlas->pages[sprite->atlas_page].generation == sprite->atlas_generation) {
+        atlas->pages[sprite->atlas_page].used_mask &= ~(1ULL << sprite->atlas_slot);
+    }
+    sprite->atlas_page = -1;
+}
+
+static void GetAtlasSlotRect(const SpriteAtlas* atlas, int page, int slot, SDL_Rect* rect) {
+    const SpriteAtlasPage* p = &atlas->pages[page];
+    rect->x = (page % ATLAS_PAGES_PER_ROW) * ATLAS_PAGE_SIZE + (slot % p->slots_per_row) * p->slot_width;
+    rect->y = (page / ATLAS_PAGES_PER_ROW) * ATLAS_PAGE_SIZE + (slot / p->slots_per_row) * p->slot_height;
+    rect->w = p->slot_width;
+    rect->h = p->slot_height;
 }
 
-static int CompareSpritesByPriority(const void* a, const void* b) {
-    const PAL_Sprite* sprite_a = *(const PAL_Sprite**)a;
-    const PAL_Sprite* sprite_b = *(const PAL_Sprite**)b;
+static void AppendSpriteQuad(PAL_SpriteManager* manager, const PAL_Sprite* sprite) {
+    if (manager->batch_count >= manager->max_sprites) {
+        FlushSpriteBatch(manager);
+    }
+    
+    SDL_Rect rect;
+    GetAtlasSlotRect(manager->atlas, sprite->atlas_page, sprite->atlas_slot, &rect);
+    
+    float u0 = (float)rect.x / ATLAS_SIZE;
+    float v0 = (float)rect.y / ATLAS_SIZE;
+    float u1 = (float)(rect.x + rect.w) / ATLAS_SIZE;
+    float v1 = (float)(rect.y + rect.h) / ATLAS_SIZE;
+    
+    // Same placement as the texture path: scaled box at (x, y), rotated
+    // clockwise about its center when affine is on
+    int screen_x_offset = (sprite->screen == PAL_SCREEN_SUB) ? 256 : 0;
+    float half_w = sprite->width * sprite->scale_x * 0.5f;
+    float half_h = sprite->height * sprite->scale_y * 0.5f;
+    float cx = sprite->x + screen_x_offset + half_w;
+    float cy = sprite->y + half_h;
+    float cos_a = 1.0f;
+    float sin_a = 0.0f;
+    if (sprite->affine_enabled && sprite->rotation != 0.0f) {
+        float angle = sprite->rotation * (float)M_PI / 180.0f;
+        cos_a = cosf(angle);
+        sin_a = sinf(angle);
+    }
+    
+    static const float corners[4][2] = { { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 } };
+    SDL_FColor color = { 1.0f, 1.0f, 1.0f, sprite->alpha / 255.0f };
+    SDL_Vertex* v = &manager->batch_vertices[manager->batch_count * 4];
+    
+    for (int i = 0; i < 4; i++) {
+        float lx = corners[i][0] * half_w;
+        float ly = corners[i][1] * half_h;
+        v[i].position.x = cx + lx * cos_a - ly * sin_a;
+        v[i].position.y = cy + lx * sin_a + ly * cos_a;
+        v[i].color = color;
+        v[i].tex_coord.x = (corners[i][0] < 0) ? u0 : u1;
+        v[i].tex_coord.y = (corners[i][1] < 0) ? v0 : v1;
+    }
+    
+    manager->batch_count++;
+}
+
+static void FlushSpriteBatch(PAL_SpriteManager* manager) {
+    if (manager->batch_count == 0) {
+        return;
+    }
     
-    // Higher priority value = rendered later (on top)
-    return (int)sprite_b->priority - (int)sprite_a->priority;
+    SDL_SetTextureBlendMode(manager->atlas->texture, manager->batch_blend);
+    SDL_RenderGeometry(manager->renderer, manager->atlas->texture,
+                       manager->batch_vertices, manager->batch_count * 4,
+                       manager->batch_indices, manager->batch_count * 6);
+    manager->batch_count = 0;
 }
@@ -0,0 +1,444 @@
+/**
+ * @file pal_task_profiler_sdl.c
+ * @brief SDL3 implementation of the SysTask profiler
+ *
+ * Callback names come from dladdr() on POSIX systems, which only sees
+ * exported symbols: link with -rdynamic (the CMake option does) and note
+ * that static functions are shown as "nearest_symbol+0xOFFSET".
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#define TASK_PROFILER_HAVE_DLADDR
+#endif
+
+#include "platform/pal_task_profiler.h"
+#include "platform/pal_timer.h"
+#include "platform/pal_memory.h"
+#include "platform/pal_file.h"
+
+#if defined(PLATFORM_SDL) && defined(PAL_TASK_PROFILER)
+
+#include <stdio.h>
+#include <string.h>
+
+#define TASK_PROFILER_MAX_SITES 1024   // Power of two, open addressing
+#define TASK_PROFILER_MAX_MANAGERS 8
+#define TASK_PROFILER_NAME_MAX 128
+
+// One (manager, callback, priority) combination
+typedef struct {
+    void* callback;
+    u32 priority;
+    u16 manager;
+    BOOL used;
+    
+    u64 calls;
+    u64 ticks;
+    u64 max_ticks;
+    
+    // Reset by the per-second table
+    u64 window_calls;
+    u64 window_ticks;
+} TaskSite;
+
+typedef struct {
+    const void* manager;
+    const char* name;
+    char fallback_name[24];
+    u64 calls;
+    u64 ticks;
+} TaskManagerStats;
+
+typedef struct {
+    u64 start;
+    u32 ticks;
+    u16 site;
+} TraceEvent;
+
+static struct {
+    BOOL enabled;
+    u64 freq;
+    u32 top_n;
+    
+    TaskSite sites[TASK_PROFILER_MAX_SITES];
+    u32 num_sites;
+    u64 dropped_calls;      // Calls that found the site table full
+    
+    TaskManagerStats managers[TASK_PROFILER_MAX_MANAGERS];
+    u32 num_managers;
+    
+    u64 frames;
+    u64 window_start;
+    u64 window_frames;
+    
+    TraceEvent* trace;
+    u32 trace_capacity;
+    u32 trace_head;         // Next slot to write
+    u32 trace_count;
+} g_taskProfiler;
+
+static u32 HashSite(void* callback, u32 priority, u16 manager) {
+    u64 key = (u64)(uintptr_t)callback ^ ((u64)priority << 32) ^ ((u64)manager << 56);
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDull;
+    key ^= key >> 33;
+    return (u32)key & (TASK_PROFILER_MAX_SITES - 1);
+}
+
+static int FindSite(void* callback, u32 priority, u16 manager) {
+    u32 index = HashSite(callback, priority, manager);
+    
+    for (u32 probe = 0; probe < TASK_PROFILER_MAX_SITES; probe++) {
+        TaskSite* site = &g_taskProfiler.sites[index];
+        
+        if (!site->used) {
+            // Keep the table at most 3/4 full so probes stay short
+            if (g_taskProfiler.num_sites >= TASK_PROFILER_MAX_SITES * 3 / 4) {
+                return -1;
+            }
+            site->used = TRUE;
+            site->callback = callback;
+            site->priority = priority;
+            site->manager = manager;
+            g_taskProfiler.num_sites++;
+            return (int)index;
+        }
+        
+        if (site->callback == callback && site->priority == priority && site->manager == manager) {
+            return (int)index;
+        }
+        
+        index = (index + 1) & (TASK_PROFILER_MAX_SITES - 1);
+    }
+    
+    return -1;
+}
+
+static int FindManager(const void* manager) {
+    for (u32 i = 0; i < g_taskProfiler.num_managers; i++) {
+        if (g_taskProfiler.managers[i].manager == manager) {
+            return (int)i;
+        }
+    }
+    
+    if (g_taskProfiler.num_managers == TASK_PROFILER_MAX_MANAGERS) {
+        return -1;
+    }
+    
+    TaskManagerStats* stats = &g_taskProfiler.managers[g_taskProfiler.num_managers];
+    memset(stats, 0, sizeof(*stats));
+    stats->manager = manager;
+    snprintf(stats->fallback_name, sizeof(stats->fallback_name), "%p", manager);
+    stats->name = stats->fallback_name;
+    return (int)g_taskProfiler.num_managers++;
+}
+
+static const char* GetCallbackName(void* callback, char* buffer, size_t size) {
+#ifdef TASK_PROFILER_HAVE_DLADDR
+    Dl_info info;
+    if (dladdr(callback, &info) && info.dli_sname) {
+        if (info.dli_saddr == callback) {
+            return info.dli_sname;
+        }
+        snprintf(buffer, size, "%s+0x%lx", info.dli_sname,
+                 (unsigned long)((uintptr_t)callback - (uintptr_t)info.dli_saddr));
+        return buffer;
+    }
+#endif
+    snprintf(buffer, size, "%p", callback);
+    return buffer;
+}
+
+static double TicksToMs(u64 ticks) {
+    return (double)ticks * 1000.0 / (double)g_taskProfiler.freq;
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+BOOL PAL_TaskProfiler_Init(u32 topN, u32 maxTraceEvents) {
+    PAL_TaskProfiler_Shutdown();
+    memset(&g_taskProfiler, 0, sizeof(g_taskProfiler));
+    
+    if (maxTraceEvents > 0) {
+        g_taskProfiler.trace = PAL_Malloc(sizeof(TraceEvent) * maxTraceEvents, 0);
+        if (!g_taskProfiler.trace) {
+            return FALSE;
+        }
+        g_taskProfiler.trace_capacity = maxTraceEvents;
+    }
+    
+    g_taskProfiler.freq = PAL_Timer_GetPerformanceFrequency();
+    g_taskProfiler.top_n = topN;
+    g_taskProfiler.window_start = PAL_Timer_GetPerformanceCounter();
+    g_taskProfiler.enabled = TRUE;
+    return TRUE;
+}
+
+void PAL_TaskProfiler_Shutdown(void) {
+    PAL_Free(g_taskProfiler.trace);
+    g_taskProfiler.trace = NULL;
+    g_taskProfiler.trace_capacity = 0;
+    g_taskProfiler.enabled = FALSE;
+}
+
+BOOL PAL_TaskProfiler_IsEnabled(void) {
+    return g_taskProfiler.enabled;
+}
+
+void PAL_TaskProfiler_RegisterManager(const void* manager, const char* name) {
+    int index = FindManager(manager);
+    if (index >= 0 && name) {
+        g_taskProfiler.managers[index].name = name;
+    }
+}
+
+u64 PAL_TaskProfiler_BeginTask(void) {
+    return PAL_Timer_GetPerformanceCounter();
+}
+
+void PAL_TaskProfiler_EndTask(const void* manager, void* callback, u32 priority, u64 start) {
+    if (!g_taskProfiler.enabled) {
+        return;
+    }
+    
+    u64 ticks = PAL_Timer_GetPerformanceCounter() - start;
+    
+    int managerIndex = FindManager(manager);
+    if (managerIndex < 0) {
+        g_taskProfiler.dropped_calls++;
+        return;
+    }
+    
+    TaskManagerStats* stats = &g_taskProfiler.managers[managerIndex];
+    stats->calls++;
+    stats->ticks += ticks;
+    
+    int siteIndex = FindSite(callback, priority, (u16)managerIndex);
+    if (siteIndex < 0) {
+        g_taskProfiler.dropped_calls++;
+        return;
+    }
+    
+    TaskSite* site = &g_taskProfiler.sites[siteIndex];
+    site->calls++;
+    site->ticks += ticks;
+    site->window_calls++;
+    site->window_ticks += ticks;
+    if (ticks > site->max_ticks) {
+        site->max_ticks = ticks;
+    }
+    
+    if (g_taskProfiler.trace_capacity > 0) {
+        TraceEvent* event = &g_taskProfiler.trace[g_taskProfiler.trace_head];
+        event->start = start;
+        event->ticks = ticks > 0xFFFFFFFFu ? 0xFFFFFFFFu : (u32)ticks;
+        event->site = (u16)siteIndex;
+        
+        g_taskProfiler.trace_head = (g_taskProfiler.trace_head + 1) % g_taskProfiler.trace_capacity;
+        if (g_taskProfiler.trace_count < g_taskProfiler.trace_capacity) {
+            g_taskProfiler.trace_count++;
+        }
+    }
+}
+
+// ============================================================================
+// Reports
+// ============================================================================
+
+// Indices of the n sites with the largest key, largest first
+static u32 SelectTopSites(u32* out, u32 n, BOOL window) {
+    u32 count = 0;
+    
+    for (u32 i = 0; i < TASK_PROFILER_MAX_SITES; i++) {
+        const TaskSite* site = &g_taskProfiler.sites[i];
+        u64 key = window ? site->window_ticks : site->ticks;
+        
+        if (!site->used || (window ? site->window_calls : site->calls) == 0) {
+            continue;
+        }
+        
+        // Insertion into the short sorted list
+        u32 pos = count < n ? count : n;
+        while (pos > 0) {
+            const TaskSite* other = &g_taskProfiler.sites[out[pos - 1]];
+            if ((window ? other->window_ticks : other->ticks) >= key) {
+                break;
+            }
+            if (pos < n) {
+                out[pos] = out[pos - 1];
+            }
+            pos--;
+        }
+        if (pos < n) {
+            out[pos] = i;
+            if (count < n) {
+                count++;
+            }
+        }
+    }
+    
+    return count;
+}
+
+static void PrintSiteRow(const TaskSite* site, u64 calls, u64 ticks, double totalMs) {
+    char nameBuffer[TASK_PROFILER_NAME_MAX];
+    double ms = TicksToMs(ticks);
+    
+    printf("  %9.3f %6.1f%% %8llu %9.1f %9.3f  %-10s %5u  %s\n",
+           ms, totalMs > 0.0 ? ms * 100.0 / totalMs : 0.0, (unsigned long long)calls,
+           calls > 0 ? ms * 1000.0 / (double)calls : 0.0, TicksToMs(site->max_ticks),
+           g_taskProfiler.managers[site->manager].name, site->priority,
+           GetCallbackName(site->callback, nameBuffer, sizeof(nameBuffer)));
+}
+
+static void PrintTableHeader(void) {
+    printf("  %9s %7s %8s %9s %9s  %-10s %5s  %s\n",
+           "ms", "share", "calls", "avg us", "max ms", "manager", "prio", "callback");
+}
+
+void PAL_TaskProfiler_EndFrame(void) {
+    if (!g_taskProfiler.enabled) {
+        return;
+    }
+    
+    g_taskProfiler.frames++;
+    g_taskProfiler.window_frames++;
+    
+    u64 now = PAL_Timer_GetPerformanceCounter();
+    u64 elapsed = now - g_taskProfiler.window_start;
+    if (elapsed < g_taskProfiler.freq) {
+        return;
+    }
+    
+    if (g_taskProfiler.top_n > 0) {
+        u32 top[32];
+        u32 n = g_taskProfiler.top_n < 32 ? g_taskProfiler.top_n : 32;
+        u32 count = SelectTopSites(top, n, TRUE);
+        double windowMs = TicksToMs(elapsed);
+        
+        printf("[TaskProfiler] Top tasks over %.2f s (%llu frames):\n",
+               windowMs / 1000.0, (unsigned long long)g_taskProfiler.window_frames);
+        PrintTableHeader();
+        for (u32 i = 0; i < count; i++) {
+            const TaskSite* site = &g_taskProfiler.sites[top[i]];
+            PrintSiteRow(site, site->window_calls, site->window_ticks, windowMs);
+        }
+    }
+    
+    for (u32 i = 0; i < TASK_PROFILER_MAX_SITES; i++) {
+        g_taskProfiler.sites[i].window_calls = 0;
+        g_taskProfiler.sites[i].window_ticks = 0;
+    }
+    g_taskProfiler.window_start = now;
+    g_taskProfiler.window_frames = 0;
+}
+
+void PAL_TaskProfiler_PrintSummary(void) {
+    if (g_taskProfiler.frames == 0) {
+        return;
+    }
+    
+    printf("Task time per manager over %llu frames:\n", (unsigned long long)g_taskProfiler.frames);
+    printf("  %-10s %10s %10s %12s\n", "manager", "calls", "total ms", "ms/frame");
+    for (u32 i = 0; i < g_taskProfiler.num_managers; i++) {
+        const TaskManagerStats* stats = &g_taskProfiler.managers[i];
+        double ms = TicksToMs(stats->ticks);
+        printf("  %-10s %10llu %10.1f %12.3f\n", stats->name, (unsigned long long)stats->calls,
+               ms, ms / (double)g_taskProfiler.frames);
+    }
+    
+    u32 top[32];
+    u32 n = g_taskProfiler.top_n > 0 && g_taskProfiler.top_n < 32 ? g_taskProfiler.top_n : 32;
+    u32 count = SelectTopSites(top, n, FALSE);
+    
+    double totalMs = 0.0;
+    for (u32 i = 0; i < g_taskProfiler.num_managers; i++) {
+        totalMs += TicksToMs(g_taskProfiler.managers[i].ticks);
+    }
+    
+    printf("Most expensive tasks (share of all task time):\n");
+    PrintTableHeader();
+    for (u32 i = 0; i < count; i++) {
+        const TaskSite* site = &g_taskProfiler.sites[top[i]];
+        PrintSiteRow(site, site->calls, site->ticks, totalMs);
+    }
+    
+    if (g_taskProfiler.dropped_calls > 0) {
+        printf("  (%llu calls not attributed: site table full)\n", (unsigned long long)g_taskProfiler.dropped_calls);
+    }
+}
+
+// Manager names are ours and callback names are C symbols, but escape
+// anyway so a stray quote can't break the file
+static void WriteJSONString(PAL_File file, const char* str) {
+    char buffer[TASK_PROFILER_NAME_MAX * 2 + 2];
+    size_t len = 0;
+    
+    buffer[len++] = '"';
+    for (; *str && len < sizeof(buffer) - 3; str++) {
+        if (*str == '"' || *str == '\\') {
+            buffer[len++] = '\\';
+        }
+        buffer[len++] = (u8)*str < 0x20 ? '?' : *str;
+    }
+    buffer[len++] = '"';
+    PAL_File_Write(buffer, 1, len, file);
+}
+
+BOOL PAL_TaskProfiler_WriteChromeTrace(const char* path) {
+    if (!path || g_taskProfiler.trace_count == 0) {
+        return FALSE;
+    }
+    
+    PAL_File file = PAL_File_Open(path, "w");
+    if (!file) {
+        return FALSE;
+    }
+    
+    static const char header[] = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    static const char eventPrefix[] = "{\"ph\":\"X\",\"name\":";
+    PAL_File_Write(header, 1, sizeof(header) - 1, file);
+    
+    char line[256];
+    char nameBuffer[TASK_PROFILER_NAME_MAX];
+    int len;
+    
+    // One thread row per task manager
+    for (u32 i = 0; i < g_taskProfiler.num_managers; i++) {
+        len = snprintf(line, sizeof(line),
+                       "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":", i + 1);
+        PAL_File_Write(line, 1, len, file);
+        WriteJSONString(file, g_taskProfiler.managers[i].name);
+        PAL_File_Write("}},\n", 1, 4, file);
+    }
+    
+    u32 index = (g_taskProfiler.trace_head + g_taskProfiler.trace_capacity - g_taskProfiler.trace_count)
+        % g_taskProfiler.trace_capacity;
+    u64 origin = g_taskProfiler.trace[index].start;
+    
+    for (u32 i = 0; i < g_taskProfiler.trace_count; i++) {
+        const TraceEvent* event = &g_taskProfiler.trace[index];
+        const TaskSite* site = &g_taskProfiler.sites[event->site];
+        
+        PAL_File_Write(eventPrefix, 1, sizeof(eventPrefix) - 1, file);
+        WriteJSONString(file, GetCallbackName(site->callback, nameBuffer, sizeof(nameBuffer)));
+        len = snprintf(line, sizeof(line),
+                       ",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"priority\":%u}}%s\n",
+                       site->manager + 1, TicksToMs(event->start - origin) * 1000.0,
+                       TicksToMs(event->ticks) * 1000.0, site->priority,
+                       i + 1 < g_taskProfiler.trace_count ? "," : "");
+        PAL_File_Write(line, 1, len, file);
+        
+        index = (index + 1) % g_taskProfiler.trace_capacity;
+    }
+    
+    PAL_File_Write("]}\n", 1, 3, file);
+    PAL_File_Close(file);
+    return TRUE;
+}
+
+#endif // PLATFORM_SDL && PAL_TASK_PROFILER
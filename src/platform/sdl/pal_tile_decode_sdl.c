@@ -0,0 +1,497 @@
+/**
+ * @file pal_tile_decode_sdl.c
+ * @brief SDL3 implementation of the 4bpp/8bpp indexed pixel decode kernels
+ *
+ * Every kernel works on 8-pixel chunks: unpack the color indices, look them
+ * up in the packed palette, zero the pixels whose index is 0 and store the
+ * chunk forwards or reversed. Flips are resolved once per row (source row
+ * for V, chunk order and permutation for H), never per pixel.
+ */
+
+#include "platform/pal_tile_decode.h"
+
+#ifdef PLATFORM_SDL
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define HAVE_X86_SIMD 1
+    #include <emmintrin.h>
+    #include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define HAVE_NEON_SIMD 1
+    #include <arm_neon.h>
+#endif
+
+// GCC/Clang need per-function target attributes to emit AVX2 (and SSE2 on
+// 32-bit x86) without raising the baseline of the whole executable
+#if defined(__GNUC__) || defined(__clang__)
+    #define PAL_TARGET_SSE2 __attribute__((target("sse2")))
+    #define PAL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define PAL_TARGET_SSE2
+    #define PAL_TARGET_AVX2
+#endif
+
+#define TILE_SIZE 8
+
+typedef void (*DecodeTileFunc)(const u8* src, const u32* lut, u32* dst, int dstStride, u32 flip);
+typedef void (*DecodeLinearFunc)(const u8* src, const u32* lut, u32* dst,
+                                 int width, int height, int dstStride, u32 flip);
+
+typedef struct {
+    DecodeTileFunc tile4bpp;
+    DecodeTileFunc tile8bpp;
+    DecodeLinearFunc linear4bpp;
+    DecodeLinearFunc linear8bpp;
+} DecodeFuncs;
+
+static const DecodeFuncs* g_activeFuncs = NULL;
+static PAL_TileDecodePath g_activePath = PAL_TILE_DECODE_SCALAR;
+
+// Emits the tile and linear entry points for one path from its row kernels:
+//   DecodeRow4_<name>(src, lut, dst, chunks, hflip)  (4 bytes per chunk)
+//   DecodeRow8_<name>(src, lut, dst, chunks, hflip)  (8 bytes per chunk)
+#define DEFINE_DECODE_FUNCS(name, attr)                                                        \
+    attr static void DecodeTile4bpp_##name(const u8* src, const u32* lut, u32* dst,             \
+                                           int dstStride, u32 flip) {                           \
+        BOOL hflip = (flip & PAL_TILE_DECODE_FLIP_H) != 0;                                      \
+        int rowStep = (flip & PAL_TILE_DECODE_FLIP_V) ? -4 : 4;                                 \
+        const u8* row = (flip & PAL_TILE_DECODE_FLIP_V) ? src + 7 * 4 : src;                    \
+        for (int y = 0; y < TILE_SIZE; y++, row += rowStep, dst += dstStride) {                 \
+            DecodeRow4_##name(row, lut, dst, 1, hflip);                                         \
+        }                                                                                       \
+    }                                                                                           \
+    attr static void DecodeTile8bpp_##name(const u8* src, const u32* lut, u32* dst,             \
+                                           int dstStride, u32 flip) {                           \
+        BOOL hflip = (flip & PAL_TILE_DECODE_FLIP_H) != 0;                                      \
+        int rowStep = (flip & PAL_TILE_DECODE_FLIP_V) ? -8 : 8;                                 \
+        const u8* row = (flip & PAL_TILE_DECODE_FLIP_V) ? src + 7 * 8 : src;                    \
+        for (int y = 0; y < TILE_SIZE; y++, row += rowStep, dst += dstStride) {                 \
+            DecodeRow8_##name(row, lut, dst, 1, hflip);                                         \
+        }                                                                                       \
+    }                                                                                           \
+    attr static void DecodeLinear4bpp_##name(const u8* src, const u32* lut, u32* dst,           \
+                                             int width, int height, int dstStride, u32 flip) {  \
+        BOOL hflip = (flip & PAL_TILE_DECODE_FLIP_H) != 0;                                      \
+        int srcPitch = width / 2;                                                               \
+        int rowStep = (flip & PAL_TILE_DECODE_FLIP_V) ? -srcPitch : srcPitch;                   \
+        const u8* row = (flip & PAL_TILE_DECODE_FLIP_V) ? src + (height - 1) * srcPitch : src;  \
+        for (int y = 0; y < height; y++, row += rowStep, dst += dstStride) {                    \
+            DecodeRow4_##name(row, lut, dst, width / 8, hflip);                                 \
+        }                                                                                       \
+    }                                                                                           \
+    attr static void DecodeLinear8bpp_##name(const u8* src, const u32* lut, u32* dst,           \
+                                             int width, int height, int dstStride, u32 flip) {  \
+        BOOL hflip = (flip & PAL_TILE_DECODE_FLIP_H) != 0;                                      \
+        int rowStep = (flip & PAL_TILE_DECODE_FLIP_V) ? -width : width;                         \
+        const u8* row = (flip & PAL_TILE_DECODE_FLIP_V) ? src + (height - 1) * width : src;     \
+        for (int y = 0; y < height; y++, row += rowStep, dst += dstStride) {                    \
+            DecodeRow8_##name(row, lut, dst, width / 8, hflip);                                 \
+        }                                                                                       \
+    }                                                                                           \
+    static const DecodeFuncs sDecodeFuncs_##name = {                                            \
+        DecodeTile4bpp_##name, DecodeTile8bpp_##name,                                           \
+        DecodeLinear4bpp_##name, DecodeLinear8bpp_##name                                        \
+    };
+
+// ============================================================================
+// Scalar
+// ============================================================================
+
+// Store order for a decoded chunk: forwards, or reversed for H-flip
+static const u8 sChunkOrder[2][8] = {
+    { 0, 1, 2, 3, 4, 5, 6, 7 },
+    { 7, 6, 5, 4, 3, 2, 1, 0 },
+};
+
+static inline u32 LookupColor(const u32* lut, u32 idx) {
+    // All-ones mask when idx != 0, zero otherwise
+    return lut[idx] & (0u - (u32)(idx != 0));
+}
+
+static inline void DecodeRow4_Scalar(const u8* src, const u32* lut, u32* dst, int chunks, BOOL hflip) {
+    const u8* order = sChunkOrder[hflip != 0];
+    int dstChunk = hflip ? chunks - 1 : 0;
+    int dstChunkStep = hflip ? -1 : 1;
+
+    for (int c = 0; c < chunks; c++, src += 4, dstChunk += dstChunkStep) {
+        u32* out = dst + dstChunk * 8;
+        for (int i = 0; i < 4; i++) {
+            out[order[i * 2]] = LookupColor(lut, src[i] & 0x0F);
+            out[order[i * 2 + 1]] = LookupColor(lut, src[i] >> 4);
+        }
+    }
+}
+
+static inline void DecodeRow8_Scalar(const u8* src, const u32* lut, u32* dst, int chunks, BOOL hflip) {
+    const u8* order = sChunkOrder[hflip != 0];
+    int dstChunk = hflip ? chunks - 1 : 0;
+    int dstChunkStep = hflip ? -1 : 1;
+
+    for (int c = 0; c < chunks; c++, src += 8, dstChunk += dstChunkStep) {
+        u32* out = dst + dstChunk * 8;
+        for (int i = 0; i < 8; i++) {
+            out[order[i]] = LookupColor(lut, src[i]);
+        }
+    }
+}
+
+DEFINE_DECODE_FUNCS(Scalar, )
+
+// ============================================================================
+// SSE2 (x86)
+// ============================================================================
+
+#ifdef HAVE_X86_SIMD
+
+// SSE2 has no gather, so the 8 lookups stay scalar loads; unpack, masking
+// and the H-flip reversal are done on vectors
+PAL_TARGET_SSE2 static inline void StoreChunk_SSE2(const u8* idx, const u32* lut, u32* out, BOOL hflip) {
+    __m128i lo = _mm_set_epi32((int)lut[idx[3]], (int)lut[idx[2]], (int)lut[idx[1]], (int)lut[idx[0]]);
+    __m128i hi = _mm_set_epi32((int)lut[idx[7]], (int)lut[idx[6]], (int)lut[idx[5]], (int)lut[idx[4]]);
+
+    __m128i idxBytes = _mm_loadl_epi64((const __m128i*)idx);
+    __m128i idxWords = _mm_unpacklo_epi8(idxBytes, _mm_setzero_si128());
+    __m128i zero = _mm_setzero_si128();
+    __m128i loZero = _mm_cmpeq_epi32(_mm_unpacklo_epi16(idxWords, zero), zero);
+    __m128i hiZero = _mm_cmpeq_epi32(_mm_unpackhi_epi16(idxWords, zero), zero);
+    lo = _mm_andnot_si128(loZero, lo);
+    hi = _mm_andnot_si128(hiZero, hi);
+
+    if (hflip) {
+        __m128i revLo = _mm_shuffle_epi32(hi, _MM_SHUFFLE(0, 1, 2, 3));
+        __m128i revHi = _mm_shuffle_epi32(lo, _MM_SHUFFLE(0, 1, 2, 3));
+        lo = revLo;
+        hi = revHi;
+    }
+
+    _mm_storeu_si128((__m128i*)out, lo);
+    _mm_storeu_si128((__m128i*)(out + 4), hi);
+}
+
+PAL_TARGET_SSE2 static inline void DecodeRow4_SSE2(const u8* src, const u32* lut, u32* dst, int chunks, BOOL hflip) {
+    int dstChunk = hflip ? chunks - 1 : 0;
+    int dstChunkStep = hflip ? -1 : 1;
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+    for (int c = 0; c < chunks; c++, src += 4, dstChunk += dstChunkStep) {
+        u32 packed;
+        memcpy(&packed, src, sizeof(packed));
+
+        // Interleave low and high nibbles: pixel 2n is the low nibble of byte n
+        __m128i bytes = _mm_cvtsi32_si128((int)packed);
+        __m128i lo = _mm_and_si128(bytes, nibbleMask);
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask);
+
+        SDL_ALIGNED(16) u8 idx[16];
+        _mm_store_si128((__m128i*)idx, _mm_unpacklo_epi8(lo, hi));
+        StoreChunk_SSE2(idx, lut, dst + dstChunk * 8, hflip);
+    }
+}
+
+PAL_TARGET_SSE2 static inline void DecodeRow8_SSE2(const u8* src, const u32* lut, u32* dst, int chunks, BOOL hflip) {
+    int dstChunk = hflip ? chunks - 1 : 0;
+    int dstChunkStep = hflip ? -1 : 1;
+
+    for (int c = 0; c < chunks; c++, src += 8, dstChunk += dstChunkStep) {
+        StoreChunk_SSE2(src, lut, dst + dstChunk * 8, hflip);
+    }
+}
+
+DEFINE_DECODE_FUNCS(SSE2, PAL_TARGET_SSE2)
+
+// ============================================================================
+// AVX2 (x86)
+// ============================================================================
+
+PAL_TARGET_AVX2 static inline void StoreChunk_AVX2(__m256i idx, const u32* lut, u32* out, __m256i perm) {
+    __m256i colors = _mm256_i32gather_epi32((const int*)lut, idx, 4);
+    __m256i isZero = _mm256_cmpeq_epi32(idx, _mm256_setzero_si256());
+    colors = _mm256_andnot_si256(isZero, colors);
+    _mm256_storeu_si256((__m256i*)out, _mm256_permutevar8x32_epi32(colors, perm));
+}
+
+PAL_TARGET_AVX2 static inline __m256i ChunkPermutation_AVX2(BOOL hflip) {
+    return hflip ? _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)
+                 : _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+}
+
+PAL_TARGET_AVX2 static inline void DecodeRow4_AVX2(const u8* src, const u32* lut, u32* dst, int chunks, BOOL hflip) {
+    int dstChunk = hflip ? chunks - 1 : 0;
+    int dstChunkStep = hflip ? -1 : 1;
+    __m256i perm = ChunkPermutation_AVX2(hflip);
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+    for (int c = 0; c < chunks; c++, src += 4, dstChunk += dstChunkStep) {
+        u32 packed;
+        memcpy(&packed, src, sizeof(packed));
+
+        __m128i bytes = _mm_cvtsi32_si128((int)packed);
+        __m128i lo = _mm_and_si128(bytes, nibbleMask);
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask);
+        __m256i idx = _mm256_cvtepu8_epi32(_mm_unpacklo_epi8(lo, hi));
+
+        StoreChunk_AVX2(idx, lut, dst + dstChunk * 8, perm);
+    }
+}
+
+PAL_TARGET_AVX2 static inline void DecodeRow8_AVX2(const u8* src, const u32* lut, u32* dst, int chunks, BOOL hflip) {
+    int dstChunk = hflip ? chunks - 1 : 0;
+    int dstChunkStep = hflip ? -1 : 1;
+    __m256i perm = ChunkPermutation_AVX2(hflip);
+
+    for (int c = 0; c < chunks; c++, src += 8, dstChunk += dstChunkStep) {
+        __m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)src));
+        StoreChunk_AVX2(idx, lut, dst + dstChunk * 8, perm);
+    }
+}
+
+DEFINE_DECODE_FUNCS(AVX2, PAL_TARGET_AVX2)
+
+#endif // HAVE_X86_SIMD
+
+// ============================================================================
+// NEON (AArch64)
+// ============================================================================
+
+#ifdef HAVE_NEON_SIMD
+
+// 4bpp: the 16-entry sub-palette is split into four byte planes so a single
+// TBL per plane resolves 8 pixels; VST4 re-interleaves them into RGBA words.
+// Plane entry 0 is cleared, which makes index 0 transparent for free.
+static inline void DecodeRow4_NEON(const u8* src, const u32* lut, u32* dst, int chunks, BOOL hflip) {
+    uint8x16x4_t planes = vld4q_u8((const u8*)lut);
+    planes.val[0] = vsetq_lane_u8(0, planes.val[0], 0);
+    planes.val[1] = vsetq_lane_u8(0, planes.val[1], 0);
+    planes.val[2] = vsetq_lane_u8(0, planes.val[2], 0);
+    planes.val[3] = vsetq_lane_u8(0, planes.val[3], 0);
+
+    int dstChunk = hflip ? chunks - 1 : 0;
+    int dstChunkStep = hflip ? -1 : 1;
+
+    for (int c = 0; c < chunks; c++, src += 4, dstChunk += dstChunkStep) {
+        u32 packed;
+        memcpy(&packed, src, sizeof(packed));
+
+        uint8x8_t bytes = vreinterpret_u8_u32(vdup_n_u32(packed));
+        uint8x8_t idx = vzip1_u8(vand_u8(bytes, vdup_n_u8(0x0F)), vshr_n_u8(bytes, 4));
+        if (hflip) {
+            idx = vrev64_u8(idx);
+        }
+
+        uint8x8x4_t out;
+        out.val[0] = vqtbl1_u8(planes.val[0], idx);
+        out.val[1] = vqtbl1_u8(planes.val[1], idx);
+        out.val[2] = vqtbl1_u8(planes.val[2], idx);
+        out.val[3] = vqtbl1_u8(planes.val[3], idx);
+        vst4_u8((u8*)(dst + dstChunk * 8), out);
+    }
+}
+
+// 8bpp: 256 entries do not fit TBL, so the lookups are scalar loads and
+// only masking and reversal are vectorized
+static inline void DecodeRow8_NEON(const u8* src, const u32* lut, u32* dst, int chunks, BOOL hflip) {
+    int dstChunk = hflip ? chunks - 1 : 0;
+    int dstChunkStep = hflip ? -1 : 1;
+
+    for (int c = 0; c < chunks; c++, src += 8, dstChunk += dstChunkStep) {
+        u32 colors[8];
+        for (int i = 0; i < 8; i++) {
+            colors[i] = lut[src[i]];
+        }
+
+        uint8x8_t idx = vld1_u8(src);
+        uint16x8_t idx16 = vmovl_u8(idx);
+        uint32x4_t lo = vandq_u32(vld1q_u32(colors), vtstq_u32(vmovl_u16(vget_low_u16(idx16)), vdupq_n_u32(0xFF)));
+        uint32x4_t hi = vandq_u32(vld1q_u32(colors + 4), vtstq_u32(vmovl_u16(vget_high_u16(idx16)), vdupq_n_u32(0xFF)));
+
+        u32* out = dst + dstChunk * 8;
+        if (hflip) {
+            uint32x4_t revLo = vrev64q_u32(hi);
+            uint32x4_t revHi = vrev64q_u32(lo);
+            lo = vcombine_u32(vget_high_u32(revLo), vget_low_u32(revLo));
+            hi = vcombine_u32(vget_high_u32(revHi), vget_low_u32(revHi));
+        }
+        vst1q_u32(out, lo);
+        vst1q_u32(out + 4, hi);
+    }
+}
+
+DEFINE_DECODE_FUNCS(NEON, )
+
+#endif // HAVE_NEON_SIMD
+
+// ============================================================================
+// Path selection
+// ============================================================================
+
+static const DecodeFuncs* GetPathFuncs(PAL_TileDecodePath path) {
+    switch (path) {
+        case PAL_TILE_DECODE_SCALAR:
+            return &sDecodeFuncs_Scalar;
+#ifdef HAVE_X86_SIMD
+        case PAL_TILE_DECODE_SSE2:
+            return SDL_HasSSE2() ? &sDecodeFuncs_SSE2 : NULL;
+        case PAL_TILE_DECODE_AVX2:
+            return SDL_HasAVX2() ? &sDecodeFuncs_AVX2 : NULL;
+#endif
+#ifdef HAVE_NEON_SIMD
+        case PAL_TILE_DECODE_NEON:
+            return SDL_HasNEON() ? &sDecodeFuncs_NEON : NULL;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+static inline const DecodeFuncs* GetActiveFuncs(void) {
+    if (!g_activeFuncs) {
+        // Prefer the widest supported path
+        static const PAL_TileDecodePath preference[] = {
+            PAL_TILE_DECODE_AVX2,
+            PAL_TILE_DECODE_NEON,
+            PAL_TILE_DECODE_SSE2,
+            PAL_TILE_DECODE_SCALAR,
+        };
+
+        for (size_t i = 0; i < sizeof(preference) / sizeof(preference[0]); i++) {
+            if (PAL_TileDecode_SetPath(preference[i])) {
+                break;
+            }
+        }
+    }
+    return g_activeFuncs;
+}
+
+PAL_TileDecodePath PAL_TileDecode_GetPath(void) {
+    GetActiveFuncs();
+    return g_activePath;
+}
+
+BOOL PAL_TileDecode_SetPath(PAL_TileDecodePath path) {
+    const DecodeFuncs* funcs = GetPathFuncs(path);
+    if (!funcs) {
+        return FALSE;
+    }
+    g_activeFuncs = funcs;
+    g_activePath = path;
+    return TRUE;
+}
+
+BOOL PAL_TileDecode_IsPathSupported(PAL_TileDecodePath path) {
+    return GetPathFuncs(path) != NULL;
+}
+
+const char* PAL_TileDecode_GetPathName(PAL_TileDecodePath path) {
+    static const char* names[PAL_TILE_DECODE_PATH_MAX] = {
+        "scalar", "sse2", "avx2", "neon"
+    };
+    return (path < PAL_TILE_DECODE_PATH_MAX) ? names[path] : "unknown";
+}
+
+// ============================================================================
+// Decoding
+// ============================================================================
+
+void PAL_TileDecode_Tile4bpp(const u8* src, const u32* lut16, u32* dst, int dstStride, u32 flip) {
+    GetActiveFuncs()->tile4bpp(src, lut16, dst, dstStride, flip);
+}
+
+void PAL_TileDecode_Tile8bpp(const u8* src, const u32* lut256, u32* dst, int dstStride, u32 flip) {
+    GetActiveFuncs()->tile8bpp(src, lut256, dst, dstStride, flip);
+}
+
+void PAL_TileDecode_Linear4bpp(const u8* src, const u32* lut16, u32* dst,
+                               int width, int height, int dstStride, u32 flip) {
+    GetActiveFuncs()->linear4bpp(src, lut16, dst, width, height, dstStride, flip);
+}
+
+void PAL_TileDecode_Linear8bpp(const u8* src, const u32* lut256, u32* dst,
+                               int width, int height, int dstStride, u32 flip) {
+    GetActiveFuncs()->linear8bpp(src, lut256, dst, width, height, dstStride, flip);
+}
+
+
+// ============================================================================
+// Index Output
+// ============================================================================
+
+// Index decoding is a byte shuffle with no palette lookup, so the scalar
+// version already runs at memory speed and has no SIMD variants
+
+static inline void IndexRow4(const u8* src, u8 paletteBase, u8* dst, int chunks, BOOL hflip) {
+    const u8* order = sChunkOrder[hflip != 0];
+    int dstChunk = hflip ? chunks - 1 : 0;
+    int dstChunkStep = hflip ? -1 : 1;
+
+    for (int c = 0; c < chunks; c++, src += 4, dstChunk += dstChunkStep) {
+        u8* out = dst + dstChunk * 8;
+        for (int i = 0; i < 4; i++) {
+            u8 lo = src[i] & 0x0F;
+            u8 hi = src[i] >> 4;
+            out[order[i * 2]] = lo ? (paletteBase | lo) : 0;
+            out[order[i * 2 + 1]] = hi ? (paletteBase | hi) : 0;
+        }
+    }
+}
+
+static inline void IndexRow8(const u8* src, u8* dst, int chunks, BOOL hflip) {
+    if (!hflip) {
+        memcpy(dst, src, chunks * 8);
+        return;
+    }
+
+    int width = chunks * 8;
+    for (int i = 0; i < width; i++) {
+        dst[width - 1 - i] = src[i];
+    }
+}
+
+void PAL_TileDecode_Tile4bppIndex(const u8* src, u8 paletteNum, u8* dst, int dstStride, u32 flip) {
+    BOOL hflip = (flip & PAL_TILE_DECODE_FLIP_H) != 0;
+    int rowStep = (flip & PAL_TILE_DECODE_FLIP_V) ? -4 : 4;
+    const u8* row = (flip & PAL_TILE_DECODE_FLIP_V) ? src + 7 * 4 : src;
+    u8 paletteBase = (u8)((paletteNum & 0x0F) << 4);
+
+    for (int y = 0; y < TILE_SIZE; y++, row += rowStep, dst += dstStride) {
+        IndexRow4(row, paletteBase, dst, 1, hflip);
+    }
+}
+
+void PAL_TileDecode_Tile8bppIndex(const u8* src, u8* dst, int dstStride, u32 flip) {
+    BOOL hflip = (flip & PAL_TILE_DECODE_FLIP_H) != 0;
+    int rowStep = (flip & PAL_TILE_DECODE_FLIP_V) ? -8 : 8;
+    const u8* row = (flip & PAL_TILE_DECODE_FLIP_V) ? src + 7 * 8 : src;
+
+    for (int y = 0; y < TILE_SIZE; y++, row += rowStep, dst += dstStride) {
+        IndexRow8(row, dst, 1, hflip);
+    }
+}
+
+void PAL_TileDecode_Linear4bppIndex(const u8* src, u8 paletteNum, u8* dst,
+                                    int width, int height, int dstStride, u32 flip) {
+    BOOL hflip = (flip & PAL_TILE_DECODE_FLIP_H) != 0;
+    int srcPitch = width / 2;
+    int rowStep = (flip & PAL_TILE_DECODE_FLIP_V) ? -srcPitch : srcPitch;
+    const u8* row = (flip & PAL_TILE_DECODE_FLIP_V) ? src + (height - 1) * srcPitch : src;
+    u8 paletteBase = (u8)((paletteNum & 0x0F) << 4);
+
+    for (int y = 0; y < height; y++, row += rowStep, dst += dstStride) {
+        IndexRow4(row, paletteBase, dst, width / 8, hflip);
+    }
+}
+
+void PAL_TileDecode_Linear8bppIndex(const u8* src, u8* dst,
+                                    int width, int height, int dstStride, u32 flip) {
+    BOOL hflip = (flip & PAL_TILE_DECODE_FLIP_H) != 0;
+    int rowStep = (flip & PAL_TILE_DECODE_FLIP_V) ? -width : width;
+    const u8* row = (flip & PAL_TILE_DECODE_FLIP_V) ? src + (height - 1) * width : src;
+
+    for (int y = 0; y < height; y++, row += rowStep, dst += dstStride) {
+        IndexRow8(row, dst, width / 8, hflip);
+    }
+}
+
+#endif // PLATFORM_SDL
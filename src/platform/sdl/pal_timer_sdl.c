@@ -40,4 +40,8 @@ void PAL_Timer_Delay(u32 ms) {
     SDL_Delay(ms);
 }
 
+void PAL_Timer_DelayNS(u64 ns) {
+    SDL_DelayNS(ns);
+}
+
 #endif // PLATFORM_SDL
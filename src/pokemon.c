@@ -53,6 +53,10 @@
 #include "rtc.h"
 #include "sound_chatot.h"
 #include "sound_playback.h"
+#ifndef PLATFORM_DS
+#include "platform/pal_crypt.h"
+#include "species_table.h"
+#endif
 #include "sprite.h"
 #include "sprite_system.h"
 #include "strbuf.h"
@@ -283,6 +287,9 @@ static void LoadSpeciesEvolutions(int monSpecies, SpeciesEvolution speciesEvolut
 static void Pokemon_EncryptData(void *data, u32 bytes, u32 seed);
 static void Pokemon_DecryptData(void *data, u32 bytes, u32 seed);
 static u16 Pokemon_GetDataChecksum(void *data, u32 bytes);
+#ifndef PLATFORM_DS
+static u16 Pokemon_DecryptDataWithChecksum(void *data, u32 bytes, u32 seed);
+#endif
 static void *BoxPokemon_GetDataBlock(BoxPokemon *boxMon, u32 personality, enum PokemonDataBlockID dataBlockID);
 static int Pokemon_GetFormNarcIndex(int monSpecies, int monForm);
 static inline int Pokemon_Face(int num);
@@ -650,9 +657,12 @@ u32 Pokemon_GetValue(Pokemon *mon, enum PokemonDataParam param, void *dest)
 {
     if (mon->box.partyDecrypted == FALSE) {
         Pokemon_DecryptData(&mon->party, sizeof(PartyPokemon), mon->box.personality);
+#ifndef PLATFORM_DS
+        u16 checksum = Pokemon_DecryptDataWithChecksum(&mon->box.dataBlocks, sizeof(PokemonDataBlock) * 4, mon->box.checksum);
+#else
         Pokemon_DecryptData(&mon->box.dataBlocks, sizeof(PokemonDataBlock) * 4, mon->box.checksum);
-
         u16 checksum = Pokemon_GetDataChecksum(&mon->box.dataBlocks, sizeof(PokemonDataBlock) * 4);
+#endif
 
         if (checksum != mon->box.checksum) {
             GF_ASSERT(checksum == mon->box.checksum);
@@ -670,6 +680,30 @@ u32 Pokemon_GetValue(Pokemon *mon, enum PokemonDataParam param, void *dest)
     return result;
 }
 
+#ifndef PLATFORM_DS
+void Pokemon_GetValues(Pokemon *mon, const enum PokemonDataParam *params, u32 *out, u32 count)
+{
+    if (mon->box.partyDecrypted == FALSE) {
+        Pokemon_DecryptData(&mon->party, sizeof(PartyPokemon), mon->box.personality);
+        u16 checksum = Pokemon_DecryptDataWithChecksum(&mon->box.dataBlocks, sizeof(PokemonDataBlock) * 4, mon->box.checksum);
+
+        if (checksum != mon->box.checksum) {
+            GF_ASSERT(checksum == mon->box.checksum);
+            mon->box.checksumFailed = TRUE;
+        }
+    }
+
+    for (u32 i = 0; i < count; i++) {
+        out[i] = Pokemon_GetDataInternal(mon, params[i], NULL);
+    }
+
+    if (mon->box.partyDecrypted == FALSE) {
+        Pokemon_EncryptData(&mon->party, sizeof(PartyPokemon), mon->box.personality);
+        Pokemon_EncryptData(&mon->box.dataBlocks, sizeof(PokemonDataBlock) * 4, mon->box.checksum);
+    }
+}
+#endif
+
 static u32 Pokemon_GetDataInternal(Pokemon *mon, enum PokemonDataParam param, void *dest)
 {
     u32 result = 0;
@@ -736,8 +770,12 @@ static u32 Pokemon_GetDataInternal(Pokemon *mon, enum PokemonDataParam param, vo
 u32 BoxPokemon_GetValue(BoxPokemon *boxMon, enum PokemonDataParam param, void *dest)
 {
     if (boxMon->boxDecrypted == FALSE) {
+#ifndef PLATFORM_DS
+        u16 checksum = Pokemon_DecryptDataWithChecksum(boxMon->dataBlocks, sizeof(PokemonDataBlock) * 4, boxMon->checksum);
+#else
         Pokemon_DecryptData(boxMon->dataBlocks, sizeof(PokemonDataBlock) * 4, boxMon->checksum);
         u16 checksum = Pokemon_GetDataChecksum(boxMon->dataBlocks, sizeof(PokemonDataBlock) * 4);
+#endif
 
         if (checksum != boxMon->checksum) {
             GF_ASSERT(checksum == boxMon->checksum);
@@ -754,6 +792,28 @@ u32 BoxPokemon_GetValue(BoxPokemon *boxMon, enum PokemonDataParam param, void *d
     return result;
 }
 
+#ifndef PLATFORM_DS
+void BoxPokemon_GetValues(BoxPokemon *boxMon, const enum PokemonDataParam *params, u32 *out, u32 count)
+{
+    if (boxMon->boxDecrypted == FALSE) {
+        u16 checksum = Pokemon_DecryptDataWithChecksum(boxMon->dataBlocks, sizeof(PokemonDataBlock) * 4, boxMon->checksum);
+
+        if (checksum != boxMon->checksum) {
+            GF_ASSERT(checksum == boxMon->checksum);
+            boxMon->checksumFailed = TRUE;
+        }
+    }
+
+    for (u32 i = 0; i < count; i++) {
+        out[i] = BoxPokemon_GetDataInternal(boxMon, params[i], NULL);
+    }
+
+    if (boxMon->boxDecrypted == FALSE) {
+        Pokemon_EncryptData(boxMon->dataBlocks, sizeof(PokemonDataBlock) * 4, boxMon->checksum);
+    }
+}
+#endif
+
 static inline u32 GetRibbon(u64 mask, enum PokemonDataParam param, enum PokemonDataParam ribbonStart)
 {
     u64 bit = 1; // need to force a u64 to match
@@ -1236,8 +1296,12 @@ void Pokemon_SetValue(Pokemon *mon, enum PokemonDataParam param, const void *val
 {
     if (mon->box.partyDecrypted == FALSE) {
         Pokemon_DecryptData(&mon->party, sizeof(PartyPokemon), mon->box.personality);
+#ifndef PLATFORM_DS
+        u16 checksum = Pokemon_DecryptDataWithChecksum(&mon->box.dataBlocks, sizeof(PokemonDataBlock) * 4, mon->box.checksum);
+#else
         Pokemon_DecryptData(&mon->box.dataBlocks, sizeof(PokemonDataBlock) * 4, mon->box.checksum);
         u16 checksum = Pokemon_GetDataChecksum(&mon->box.dataBlocks, sizeof(PokemonDataBlock) * 4);
+#endif
 
         if (checksum != mon->box.checksum) {
             GF_ASSERT(checksum == mon->box.checksum);
@@ -1320,8 +1384,12 @@ static void Pokemon_SetDataInternal(Pokemon *mon, enum PokemonDataParam param, c
 void BoxPokemon_SetValue(BoxPokemon *boxMon, enum PokemonDataParam param, const void *value)
 {
     if (boxMon->boxDecrypted == FALSE) {
+#ifndef PLATFORM_DS
+        u16 checksum = Pokemon_DecryptDataWithChecksum(boxMon->dataBlocks, sizeof(PokemonDataBlock) * 4, boxMon->checksum);
+#else
         Pokemon_DecryptData(boxMon->dataBlocks, sizeof(PokemonDataBlock) * 4, boxMon->checksum);
         u16 checksum = Pokemon_GetDataChecksum(boxMon->dataBlocks, sizeof(PokemonDataBlock) * 4);
+#endif
 
         if (checksum != boxMon->checksum) {
             GF_ASSERT(checksum == boxMon->checksum);
@@ -1792,9 +1860,12 @@ void Pokemon_IncreaseValue(Pokemon *mon, enum PokemonDataParam param, int value)
 {
     if (mon->box.partyDecrypted == FALSE) {
         Pokemon_DecryptData(&mon->party, sizeof(PartyPokemon), mon->box.personality);
+#ifndef PLATFORM_DS
+        u16 checksum = Pokemon_DecryptDataWithChecksum(&mon->box.dataBlocks, sizeof(PokemonDataBlock) * 4, mon->box.checksum);
+#else
         Pokemon_DecryptData(&mon->box.dataBlocks, sizeof(PokemonDataBlock) * 4, mon->box.checksum);
-
         u16 checksum = Pokemon_GetDataChecksum(&mon->box.dataBlocks, sizeof(PokemonDataBlock) * 4);
+#endif
 
         if (checksum != mon->box.checksum) {
             GF_ASSERT(checksum == mon->box.checksum);
@@ -2271,6 +2342,12 @@ u32 SpeciesData_GetFormValue(int monSpecies, int monForm, enum SpeciesDataParam
 {
     monSpecies = Pokemon_GetFormNarcIndex(monSpecies, monForm);
 
+#ifndef PLATFORM_DS
+    if (SpeciesTable_Load()) {
+        return SpeciesTable_GetValue(monSpecies, param);
+    }
+#endif
+
     SpeciesData *speciesData = SpeciesData_FromMonSpecies(monSpecies, HEAP_ID_SYSTEM);
     u32 result = SpeciesData_GetValue(speciesData, param);
 
@@ -2281,6 +2358,12 @@ u32 SpeciesData_GetFormValue(int monSpecies, int monForm, enum SpeciesDataParam
 
 u32 SpeciesData_GetSpeciesValue(int monSpecies, enum SpeciesDataParam param)
 {
+#ifndef PLATFORM_DS
+    if (SpeciesTable_Load()) {
+        return SpeciesTable_GetValue(monSpecies, param);
+    }
+#endif
+
     SpeciesData *speciesData = SpeciesData_FromMonSpecies(monSpecies, HEAP_ID_SYSTEM);
     u32 result = SpeciesData_GetValue(speciesData, param);
 
@@ -2339,6 +2422,12 @@ static u32 Pokemon_GetExpRateBaseExpAt(enum ExpRate monExpRate, int monLevel)
     GF_ASSERT(monExpRate < EXP_RATE_COUNT);
     GF_ASSERT(monLevel <= MAX_POKEMON_LEVEL + 1);
 
+#ifndef PLATFORM_DS
+    if (SpeciesTable_Load()) {
+        return SpeciesTable_GetBaseExpAt(monExpRate, monLevel);
+    }
+#endif
+
     u32 *expTable = Heap_Alloc(HEAP_ID_SYSTEM, (MAX_POKEMON_LEVEL + 1) * 4);
     Pokemon_LoadExperienceTableOf(monExpRate, expTable);
 
@@ -2366,6 +2455,12 @@ u32 BoxPokemon_GetLevel(BoxPokemon *boxMon)
 
 u32 Pokemon_GetSpeciesLevelAt(u16 monSpecies, u32 monExp)
 {
+#ifndef PLATFORM_DS
+    if (SpeciesTable_Load()) {
+        return SpeciesTable_GetLevelAt(SpeciesTable_GetValue(monSpecies, SPECIES_DATA_EXP_RATE), monExp);
+    }
+#endif
+
     SpeciesData *speciesData = SpeciesData_FromMonSpecies(monSpecies, HEAP_ID_SYSTEM);
 
     u32 monLevel = SpeciesData_GetLevelAt(speciesData, monSpecies, monExp);
@@ -2379,6 +2474,13 @@ u32 SpeciesData_GetLevelAt(SpeciesData *speciesData, u16 unused_monSpecies, u32
     static u32 monExpTable[MAX_POKEMON_LEVEL + 1];
 
     enum ExpRate monExpRate = SpeciesData_GetValue(speciesData, SPECIES_DATA_EXP_RATE);
+
+#ifndef PLATFORM_DS
+    if (SpeciesTable_Load()) {
+        return SpeciesTable_GetLevelAt(monExpRate, monExp);
+    }
+#endif
+
     Pokemon_LoadExperienceTableOf(monExpRate, monExpTable);
 
     int i;
@@ -4098,11 +4200,23 @@ u8 Party_GetMaxLevel(Party *party)
 
     u8 result = 1;
 
+#ifndef PLATFORM_DS
+    static const enum PokemonDataParam params[] = { MON_DATA_SPECIES, MON_DATA_IS_EGG, MON_DATA_LEVEL };
+    u32 values[NELEMS(params)];
+#endif
+
     for (int i = 0; i < currentPartyCount; i++) {
         Pokemon *mon = Party_GetPokemonBySlotIndex(party, i);
 
+#ifndef PLATFORM_DS
+        Pokemon_GetValues(mon, params, values, NELEMS(params));
+
+        if (values[0] && values[1] == FALSE) {
+            u8 monLevel = values[2];
+#else
         if (Pokemon_GetValue(mon, MON_DATA_SPECIES, NULL) && Pokemon_GetValue(mon, MON_DATA_IS_EGG, NULL) == FALSE) {
             u8 monLevel = Pokemon_GetValue(mon, MON_DATA_LEVEL, NULL);
+#endif
 
             if (monLevel > result) {
                 result = monLevel;
@@ -4169,6 +4283,20 @@ s8 Pokemon_GetFlavorAffinityOf(u32 monPersonality, enum Flavor flavor)
 
 int Pokemon_LoadLevelUpMoveIdsOf(int monSpecies, int monForm, u16 *monLevelUpMoveIDs)
 {
+#ifndef PLATFORM_DS
+    if (SpeciesTable_Load()) {
+        const u16 *levelUpMoves = SpeciesTable_GetLevelUpMoves(Pokemon_GetFormNarcIndex(monSpecies, monForm));
+        int count = 0;
+
+        while (levelUpMoves[count] != LEARNSET_ALL_SLOTS_FILLED) {
+            monLevelUpMoveIDs[count] = levelUpMoves[count] & 0x1FF;
+            count++;
+        }
+
+        return count;
+    }
+#endif
+
     u16 *monLevelUpMoves = Heap_Alloc(HEAP_ID_SYSTEM, sizeof(SpeciesLearnset));
 
     Pokemon_LoadLevelUpMovesOf(monSpecies, monForm, monLevelUpMoves);
@@ -4626,6 +4754,20 @@ BOOL Pokemon_SetRotomForm(Pokemon *mon, int form, int moveSlot)
 void Pokemon_LoadLevelUpMovesOf(int monSpecies, int monForm, u16 *monLevelUpMoves)
 {
     monSpecies = Pokemon_GetFormNarcIndex(monSpecies, monForm);
+
+#ifndef PLATFORM_DS
+    if (SpeciesTable_Load()) {
+        const u16 *levelUpMoves = SpeciesTable_GetLevelUpMoves(monSpecies);
+        int i = 0;
+
+        do {
+            monLevelUpMoves[i] = levelUpMoves[i];
+        } while (levelUpMoves[i++] != LEARNSET_SENTINEL_ENTRY);
+
+        return;
+    }
+#endif
+
     NARC_ReadWholeMemberByIndexPair(monLevelUpMoves, NARC_INDEX_POKETOOL__PERSONAL__WOTBL, monSpecies);
 }
 
@@ -4852,6 +4994,13 @@ static void SpeciesData_LoadForm(int monSpecies, int monForm, SpeciesData *speci
 
 static void LoadSpeciesEvolutions(int monSpecies, SpeciesEvolution speciesEvolutions[MAX_EVOLUTIONS])
 {
+#ifndef PLATFORM_DS
+    if (SpeciesTable_Load()) {
+        memcpy(speciesEvolutions, SpeciesTable_GetEvolutions(monSpecies), sizeof(SpeciesEvolution) * MAX_EVOLUTIONS);
+        return;
+    }
+#endif
+
     NARC_ReadWholeMemberByIndexPair(speciesEvolutions, NARC_INDEX_POKETOOL__PERSONAL__EVO, monSpecies);
 }
 
@@ -4879,6 +5028,14 @@ static u16 Pokemon_GetDataChecksum(void *data, u32 bytes)
     return checksum;
 }
 
+#ifndef PLATFORM_DS
+static u16 Pokemon_DecryptDataWithChecksum(void *data, u32 bytes, u32 seed)
+{
+    // Decrypts and sums in a single pass over the data
+    return PAL_Crypt_LCRNGXorChecksum(data, bytes, seed);
+}
+#endif
+
 #define DATA_BLOCK_SHUFFLE_CASE(v1, v2, v3, v4)            \
     {                                                      \
         PokemonDataBlock *dataBlocks = boxMon->dataBlocks; \
@@ -14,6 +14,7 @@
 #include "heap.h"
 #include "inlines.h"
 #include "math_util.h"
+#include "pc_boxes.h"
 #include "savedata_misc.h"
 #include "system.h"
 #include "unk_0209A74C.h"
@@ -600,6 +601,10 @@ static BOOL SaveDataState_Load(SaveData *saveData)
         saveData->pageInfo[i].checksum = CalcCRC16Checksum(SaveData_SaveTable(saveData, i), saveData->pageInfo[i].size);
     }
 
+#ifndef PLATFORM_DS
+    PCBoxes_RebuildIndex(SaveData_GetPCBoxes(saveData));
+#endif
+
     return TRUE;
 }
 
@@ -0,0 +1,363 @@
+#include "species_table.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "platform/pal_memory.h"
+#include "platform/platform_types.h"
+
+#include "narc.h"
+
+#define NUM_SMALL_COLUMNS SPECIES_DATA_TM_LEARNSET_MASK_1
+#define NUM_TM_MASKS      (SPECIES_DATA_TM_LEARNSET_MASK_4 - SPECIES_DATA_TM_LEARNSET_MASK_1 + 1)
+#define EXP_TABLE_SIZE    (MAX_POKEMON_LEVEL + 2)
+#define COLUMN_ALIGN      64
+
+typedef struct SpeciesTable {
+    u16 personalCount;
+    u16 learnsetCount;
+    u16 evolutionCount;
+
+    // Every field but the TM masks fits in 16 bits; each column starts on
+    // its own cache line
+    u16 *columns[NUM_SMALL_COLUMNS];
+    u32 *tmLearnsetMasks[NUM_TM_MASKS];
+
+    u32 expTables[EXP_RATE_COUNT][EXP_TABLE_SIZE];
+
+    // Learnset i is learnsetMoves[learnsetStarts[i]] up to its sentinel
+    u32 *learnsetStarts;
+    u16 *learnsetMoves;
+
+    SpeciesEvolution *evolutions;
+
+    void *memory;
+} SpeciesTable;
+
+static SpeciesTable sTable;
+static BOOL sLoaded;
+static BOOL sLoadFailed;
+
+static u32 AlignColumn(u32 size)
+{
+    return (size + COLUMN_ALIGN - 1) & ~(COLUMN_ALIGN - 1);
+}
+
+static u32 GetSpeciesDataField(const SpeciesData *speciesData, enum SpeciesDataParam param)
+{
+    switch (param) {
+    case SPECIES_DATA_BASE_HP:
+        return speciesData->baseStats.hp;
+    case SPECIES_DATA_BASE_ATK:
+        return speciesData->baseStats.attack;
+    case SPECIES_DATA_BASE_DEF:
+        return speciesData->baseStats.defense;
+    case SPECIES_DATA_BASE_SPEED:
+        return speciesData->baseStats.speed;
+    case SPECIES_DATA_BASE_SP_ATK:
+        return speciesData->baseStats.spAttack;
+    case SPECIES_DATA_BASE_SP_DEF:
+        return speciesData->baseStats.spDefense;
+    case SPECIES_DATA_TYPE_1:
+        return speciesData->types[0];
+    case SPECIES_DATA_TYPE_2:
+        return speciesData->types[1];
+    case SPECIES_DATA_CATCH_RATE:
+        return speciesData->catchRate;
+    case SPECIES_DATA_BASE_EXP_REWARD:
+        return speciesData->baseExpReward;
+    case SPECIES_DATA_EV_HP_YIELD:
+        return speciesData->evYields.hp;
+    case SPECIES_DATA_EV_ATK_YIELD:
+        return speciesData->evYields.attack;
+    case SPECIES_DATA_EV_DEF_YIELD:
+        return speciesData->evYields.defense;
+    case SPECIES_DATA_EV_SPEED_YIELD:
+        return speciesData->evYields.speed;
+    case SPECIES_DATA_EV_SP_ATK_YIELD:
+        return speciesData->evYields.spAttack;
+    case SPECIES_DATA_EV_SP_DEF_YIELD:
+        return speciesData->evYields.spDefense;
+    case SPECIES_DATA_HELD_ITEM_COMMON:
+        return speciesData->wildHeldItems.common;
+    case SPECIES_DATA_HELD_ITEM_RARE:
+        return speciesData->wildHeldItems.rare;
+    case SPECIES_DATA_GENDER_RATIO:
+        return speciesData->genderRatio;
+    case SPECIES_DATA_HATCH_CYCLES:
+        return speciesData->hatchCycles;
+    case SPECIES_DATA_BASE_FRIENDSHIP:
+        return speciesData->baseFriendship;
+    case SPECIES_DATA_EXP_RATE:
+        return speciesData->expRate;
+    case SPECIES_DATA_EGG_GROUP_1:
+        return speciesData->eggGroups[0];
+    case SPECIES_DATA_EGG_GROUP_2:
+        return speciesData->eggGroups[1];
+    case SPECIES_DATA_ABILITY_1:
+        return speciesData->abilities[0];
+    case SPECIES_DATA_ABILITY_2:
+        return speciesData->abilities[1];
+    case SPECIES_DATA_SAFARI_FLEE_RATE:
+        return speciesData->safariFleeRate;
+    case SPECIES_DATA_BODY_COLOR:
+        return speciesData->bodyColor;
+    case SPECIES_DATA_FLIP_SPRITE:
+        return speciesData->flipSprite;
+    case SPECIES_DATA_TM_LEARNSET_MASK_1:
+    case SPECIES_DATA_TM_LEARNSET_MASK_2:
+    case SPECIES_DATA_TM_LEARNSET_MASK_3:
+    case SPECIES_DATA_TM_LEARNSET_MASK_4:
+        return speciesData->tmLearnsetMasks[param - SPECIES_DATA_TM_LEARNSET_MASK_1];
+    }
+
+    return 0;
+}
+
+// Number of entries in a learnset member, including its sentinel
+static u32 CountLearnsetEntries(const u16 *moves, u32 memberSize)
+{
+    u32 count = 0;
+    u32 maxCount = memberSize / sizeof(u16);
+
+    if (maxCount > MAX_LEARNSET_ENTRIES) {
+        maxCount = MAX_LEARNSET_ENTRIES;
+    }
+
+    while (count < maxCount && moves[count] != LEARNSET_SENTINEL_ENTRY) {
+        count++;
+    }
+
+    return count + 1;
+}
+
+static void LoadPersonalColumns(void)
+{
+    for (u32 i = 0; i < sTable.personalCount; i++) {
+        u32 size = 0;
+        const SpeciesData *view = NARC_GetMemberView(NARC_INDEX_POKETOOL__PERSONAL__PL_PERSONAL, i, &size);
+        SpeciesData speciesData;
+
+        memset(&speciesData, 0, sizeof(SpeciesData));
+
+        if (view) {
+            memcpy(&speciesData, view, size < sizeof(SpeciesData) ? size : sizeof(SpeciesData));
+        }
+
+        for (u32 param = 0; param < NUM_SMALL_COLUMNS; param++) {
+            sTable.columns[param][i] = GetSpeciesDataField(&speciesData, param);
+        }
+
+        for (u32 mask = 0; mask < NUM_TM_MASKS; mask++) {
+            sTable.tmLearnsetMasks[mask][i] = speciesData.tmLearnsetMasks[mask];
+        }
+    }
+}
+
+static void LoadExpTables(void)
+{
+    u16 count = NARC_GetMemberCountByIndexPair(NARC_INDEX_POKETOOL__PERSONAL__PL_GROWTBL);
+
+    for (u32 rate = 0; rate < EXP_RATE_COUNT; rate++) {
+        u32 size = 0;
+        const u32 *view = rate < count ? NARC_GetMemberView(NARC_INDEX_POKETOOL__PERSONAL__PL_GROWTBL, rate, &size) : NULL;
+        u32 entries = view ? size / sizeof(u32) : 0;
+
+        if (entries > EXP_TABLE_SIZE) {
+            entries = EXP_TABLE_SIZE;
+        }
+
+        if (entries > 0) {
+            memcpy(sTable.expTables[rate], view, entries * sizeof(u32));
+        }
+
+        // The level after the last one is never reached
+        for (u32 level = entries; level < EXP_TABLE_SIZE; level++) {
+            sTable.expTables[rate][level] = level > MAX_POKEMON_LEVEL ? 0xFFFFFFFF : 0;
+        }
+    }
+}
+
+static void LoadLearnsets(void)
+{
+    u32 start = 0;
+
+    for (u32 i = 0; i < sTable.learnsetCount; i++) {
+        u32 size = 0;
+        const u16 *view = NARC_GetMemberView(NARC_INDEX_POKETOOL__PERSONAL__WOTBL, i, &size);
+        u32 count = view ? CountLearnsetEntries(view, size) : 1;
+
+        if (count > 1) {
+            memcpy(&sTable.learnsetMoves[start], view, (count - 1) * sizeof(u16));
+        }
+
+        sTable.learnsetMoves[start + count - 1] = LEARNSET_SENTINEL_ENTRY;
+        sTable.learnsetStarts[i] = start;
+        start += count;
+    }
+}
+
+static void LoadEvolutions(void)
+{
+    for (u32 i = 0; i < sTable.evolutionCount; i++) {
+        u32 size = 0;
+        const void *view = NARC_GetMemberView(NARC_INDEX_POKETOOL__PERSONAL__EVO, i, &size);
+        SpeciesEvolution *evolutions = &sTable.evolutions[i * MAX_EVOLUTIONS];
+
+        if (view) {
+            memcpy(evolutions, view, size < sizeof(SpeciesEvolution) * MAX_EVOLUTIONS ? size : sizeof(SpeciesEvolution) * MAX_EVOLUTIONS);
+        }
+    }
+}
+
+BOOL SpeciesTable_Load(void)
+{
+    if (sLoaded || sLoadFailed) {
+        return sLoaded;
+    }
+
+    sTable.personalCount = NARC_GetMemberCountByIndexPair(NARC_INDEX_POKETOOL__PERSONAL__PL_PERSONAL);
+    sTable.learnsetCount = NARC_GetMemberCountByIndexPair(NARC_INDEX_POKETOOL__PERSONAL__WOTBL);
+    sTable.evolutionCount = NARC_GetMemberCountByIndexPair(NARC_INDEX_POKETOOL__PERSONAL__EVO);
+
+    if (sTable.personalCount == 0 || sTable.learnsetCount == 0 || sTable.evolutionCount == 0
+        || NARC_GetMemberCountByIndexPair(NARC_INDEX_POKETOOL__PERSONAL__PL_GROWTBL) == 0) {
+        printf("[SpeciesTable] Species archives are not available, reading them per lookup\n");
+        sLoadFailed = TRUE;
+        return FALSE;
+    }
+
+    // Learnsets are variable length; size the move pool first
+    u32 learnsetMoveCount = 0;
+
+    for (u32 i = 0; i < sTable.learnsetCount; i++) {
+        u32 size = 0;
+        const u16 *view = NARC_GetMemberView(NARC_INDEX_POKETOOL__PERSONAL__WOTBL, i, &size);
+
+        learnsetMoveCount += view ? CountLearnsetEntries(view, size) : 1;
+    }
+
+    u32 smallColumnSize = AlignColumn(sTable.personalCount * sizeof(u16));
+    u32 maskColumnSize = AlignColumn(sTable.personalCount * sizeof(u32));
+    u32 startsSize = AlignColumn(sTable.learnsetCount * sizeof(u32));
+    u32 movesSize = AlignColumn(learnsetMoveCount * sizeof(u16));
+    u32 evolutionsSize = AlignColumn(sTable.evolutionCount * sizeof(SpeciesEvolution) * MAX_EVOLUTIONS);
+    u32 totalSize = smallColumnSize * NUM_SMALL_COLUMNS + maskColumnSize * NUM_TM_MASKS + startsSize + movesSize + evolutionsSize;
+
+    sTable.memory = PAL_Calloc(totalSize + COLUMN_ALIGN, 0);
+
+    if (sTable.memory == NULL) {
+        printf("[SpeciesTable] Failed to allocate %u bytes\n", totalSize);
+        sLoadFailed = TRUE;
+        return FALSE;
+    }
+
+    u8 *cursor = (u8 *)(((uintptr_t)sTable.memory + COLUMN_ALIGN - 1) & ~(uintptr_t)(COLUMN_ALIGN - 1));
+
+    for (u32 param = 0; param < NUM_SMALL_COLUMNS; param++) {
+        sTable.columns[param] = (u16 *)cursor;
+        cursor += smallColumnSize;
+    }
+
+    for (u32 mask = 0; mask < NUM_TM_MASKS; mask++) {
+        sTable.tmLearnsetMasks[mask] = (u32 *)cursor;
+        cursor += maskColumnSize;
+    }
+
+    sTable.learnsetStarts = (u32 *)cursor;
+    cursor += startsSize;
+    sTable.learnsetMoves = (u16 *)cursor;
+    cursor += movesSize;
+    sTable.evolutions = (SpeciesEvolution *)cursor;
+
+    LoadPersonalColumns();
+    LoadExpTables();
+    LoadLearnsets();
+    LoadEvolutions();
+
+    sLoaded = TRUE;
+    return TRUE;
+}
+
+void SpeciesTable_Unload(void)
+{
+    PAL_Free(sTable.memory);
+    memset(&sTable, 0, sizeof(SpeciesTable));
+
+    sLoaded = FALSE;
+    sLoadFailed = FALSE;
+}
+
+u32 SpeciesTable_GetValue(int personalIndex, enum SpeciesDataParam param)
+{
+    GF_ASSERT(sLoaded);
+
+    if ((u32)personalIndex >= sTable.personalCount) {
+        GF_ASSERT(FALSE);
+        return 0;
+    }
+
+    if (param < NUM_SMALL_COLUMNS) {
+        return sTable.columns[param][personalIndex];
+    }
+
+    return sTable.tmLearnsetMasks[param - SPECIES_DATA_TM_LEARNSET_MASK_1][personalIndex];
+}
+
+u32 SpeciesTable_GetBaseExpAt(enum ExpRate expRate, int monLevel)
+{
+    GF_ASSERT(sLoaded);
+    GF_ASSERT(expRate < EXP_RATE_COUNT);
+    GF_ASSERT(monLevel <= MAX_POKEMON_LEVEL + 1);
+
+    return sTable.expTables[expRate][monLevel];
+}
+
+u32 SpeciesTable_GetLevelAt(enum ExpRate expRate, u32 monExp)
+{
+    GF_ASSERT(sLoaded);
+    GF_ASSERT(expRate < EXP_RATE_COUNT);
+
+    const u32 *expTable = sTable.expTables[expRate];
+
+    // First level in [1, MAX_POKEMON_LEVEL] that needs more than monExp; the
+    // tables are non-decreasing
+    u32 low = 1;
+    u32 high = MAX_POKEMON_LEVEL + 1;
+
+    while (low < high) {
+        u32 mid = (low + high) / 2;
+
+        if (expTable[mid] > monExp) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    return low - 1;
+}
+
+const u16 *SpeciesTable_GetLevelUpMoves(int learnsetIndex)
+{
+    GF_ASSERT(sLoaded);
+
+    if ((u32)learnsetIndex >= sTable.learnsetCount) {
+        GF_ASSERT(FALSE);
+        learnsetIndex = 0;
+    }
+
+    return &sTable.learnsetMoves[sTable.learnsetStarts[learnsetIndex]];
+}
+
+const SpeciesEvolution *SpeciesTable_GetEvolutions(int monSpecies)
+{
+    GF_ASSERT(sLoaded);
+
+    if ((u32)monSpecies >= sTable.evolutionCount) {
+        GF_ASSERT(FALSE);
+        monSpecies = 0;
+    }
+
+    return &sTable.evolutions[monSpecies * MAX_EVOLUTIONS];
+}
@@ -8,6 +8,10 @@
 #endif
 #include <string.h>
 
+#ifdef PAL_TASK_PROFILER
+#include "platform/pal_task_profiler.h"
+#endif
+
 static void SysTaskManager_InitTask(SysTaskManager *sysTaskMgr, SysTask *task);
 static void SysTaskManager_InitTasks(SysTaskManager *sysTaskMgr);
 static SysTask *SysTaskManager_AllocTask(SysTaskManager *sysTaskMgr);
@@ -109,7 +113,16 @@ void SysTaskManager_ExecuteTasks(SysTaskManager *sysTaskMgr)
 
         if (sysTaskMgr->currentTask->state == TASK_STATE_ACTIVE) {
             if (sysTaskMgr->currentTask->callback != NULL) {
+#ifdef PAL_TASK_PROFILER
+                // The callback may delete its own task, so capture what identifies it first
+                SysTaskFunc callback = sysTaskMgr->currentTask->callback;
+                u32 priority = sysTaskMgr->currentTask->priority;
+                u64 profileStart = PAL_TaskProfiler_BeginTask();
+#endif
                 sysTaskMgr->currentTask->callback(sysTaskMgr->currentTask, sysTaskMgr->currentTask->param);
+#ifdef PAL_TASK_PROFILER
+                PAL_TaskProfiler_EndTask(sysTaskMgr, (void *)callback, priority, profileStart);
+#endif
             }
         } else {
             sysTaskMgr->currentTask->state = TASK_STATE_ACTIVE;
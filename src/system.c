@@ -16,6 +16,7 @@
 #include "platform/pal_graphics.h"
 #include "platform/pal_background.h"
 #include "platform/pal_sprite.h"
+#include "platform/pal_task_profiler.h"
 #include <stdio.h>
 #include <stdlib.h>
 #endif
@@ -217,22 +218,22 @@ static const HeapParam sHeapInitParams[] = {
     #ifdef PLATFORM_DS
     { HEAP_SIZE_SYSTEM, OS_ARENA_MAIN },
     #else
-    // TODO: Port OS_ARENA_MAIN to PAL
+    { HEAP_SIZE_SYSTEM, 0 },
     #endif
     #ifdef PLATFORM_DS
     { HEAP_SIZE_SAVE, OS_ARENA_MAIN },
     #else
-    // TODO: Port OS_ARENA_MAIN to PAL
+    { HEAP_SIZE_SAVE, 0 },
     #endif
     #ifdef PLATFORM_DS
     { HEAP_SIZE_DEBUG, OS_ARENA_MAIN },
     #else
-    // TODO: Port OS_ARENA_MAIN to PAL
+    { HEAP_SIZE_DEBUG, 0 },
     #endif
     #ifdef PLATFORM_DS
     { HEAP_SIZE_APPLICATION, OS_ARENA_MAIN }
     #else
-    // TODO: Port OS_ARENA_MAIN to PAL
+    { HEAP_SIZE_APPLICATION, 0 }
     #endif
 };
 
@@ -293,6 +294,13 @@ void InitSystem(void)
     gSystem.vBlankTaskMgr = SysTaskManager_Init(VBLANK_TASK_MAX, malloc(SysTaskManager_GetRequiredSize(VBLANK_TASK_MAX)));
     gSystem.postVBlankTaskMgr = SysTaskManager_Init(POST_VBLANK_TASK_MAX, malloc(SysTaskManager_GetRequiredSize(POST_VBLANK_TASK_MAX)));
     gSystem.printTaskMgr = SysTaskManager_Init(PRINT_TASK_MAX, malloc(SysTaskManager_GetRequiredSize(PRINT_TASK_MAX)));
+
+#ifdef PAL_TASK_PROFILER
+    PAL_TaskProfiler_RegisterManager(gSystem.mainTaskMgr, "main");
+    PAL_TaskProfiler_RegisterManager(gSystem.vBlankTaskMgr, "vblank");
+    PAL_TaskProfiler_RegisterManager(gSystem.postVBlankTaskMgr, "postVBlank");
+    PAL_TaskProfiler_RegisterManager(gSystem.printTaskMgr, "print");
+#endif
 #endif
     #ifdef PLATFORM_DS
     #ifdef PLATFORM_DS
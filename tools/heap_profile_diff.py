@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""
+Heap Profile Diff for Pokemon Platinum SDL3 Port
+
+Compares two heap profiles written by `pokeplatinum_sdl --heap-profile FILE`
+(a build configured with -DPAL_ENABLE_HEAP_PROFILER=ON) and flags allocation
+churn regressions: callsites that allocate noticeably more blocks per frame
+than in the baseline, or that turned into churn (most blocks freed in the
+frame that allocated them, every frame).
+
+Callsites are matched by function name and heap, without the offset into
+the function, since offsets move between builds. Allocations per frame are
+compared rather than totals, so the two runs don't need the same length,
+but they should cover the same part of the game.
+
+Usage:
+    python3 heap_profile_diff.py baseline.json current.json [--threshold PCT] [--min-delta N]
+
+Exits with status 1 when a regression is found, so it can gate CI.
+"""
+
+import argparse
+import json
+import sys
+from collections import defaultdict
+
+
+def load_sites(path):
+    with open(path) as f:
+        profile = json.load(f)
+
+    sites = defaultdict(lambda: {'allocs_per_frame': 0.0, 'bytes_per_frame': 0.0, 'churn': False})
+    frames = max(profile['frames'], 1)
+
+    for site in profile['sites']:
+        function = site['site'].split('+0x')[0]
+        entry = sites[(function, site['heap'])]
+        entry['allocs_per_frame'] += site['allocs_per_frame']
+        entry['bytes_per_frame'] += site['bytes'] / frames
+        entry['churn'] = entry['churn'] or site['churn']
+
+    return profile, sites
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Flag heap allocation churn regressions between two profiles')
+    parser.add_argument('baseline')
+    parser.add_argument('current')
+    parser.add_argument('--threshold', type=float, default=20.0,
+                        help='percent increase in allocations per frame to flag (default 20)')
+    parser.add_argument('--min-delta', type=float, default=0.5,
+                        help='ignore increases below this many allocations per frame (default 0.5)')
+    args = parser.parse_args()
+
+    base_profile, base = load_sites(args.baseline)
+    cur_profile, cur = load_sites(args.current)
+
+    print(f"Allocations per frame: {base_profile['allocs_per_frame']:.2f} -> {cur_profile['allocs_per_frame']:.2f}")
+    print(f"Max allocations in a frame: {base_profile['max_frame_allocs']} -> {cur_profile['max_frame_allocs']}")
+
+    regressions = []
+    for key, site in cur.items():
+        old = base.get(key, {'allocs_per_frame': 0.0, 'bytes_per_frame': 0.0, 'churn': False})
+        delta = site['allocs_per_frame'] - old['allocs_per_frame']
+        grew = delta >= args.min_delta and (
+            old['allocs_per_frame'] == 0.0 or delta * 100.0 / old['allocs_per_frame'] >= args.threshold)
+        new_churn = site['churn'] and not old['churn']
+
+        if grew or new_churn:
+            regressions.append((delta, key, old, site, new_churn))
+
+    if not regressions:
+        print("No allocation churn regressions")
+        return
+
+    regressions.sort(reverse=True, key=lambda r: r[0])
+    print(f"\n{len(regressions)} callsite(s) regressed:")
+    print(f"  {'allocs/frame':>22} {'KB/frame':>20}  {'heap':<4}  function")
+    for delta, (function, heap), old, site, new_churn in regressions:
+        allocs = f"{old['allocs_per_frame']:.2f} -> {site['allocs_per_frame']:.2f}"
+        kb = f"{old['bytes_per_frame'] / 1024:.1f} -> {site['bytes_per_frame'] / 1024:.1f}"
+        print(f"  {allocs:>22} {kb:>20}  {heap:<4}  {function}{'  [new churn]' if new_churn else ''}")
+
+    sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
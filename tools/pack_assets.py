@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+"""
+Asset Packer for Pokemon Platinum SDL3 Port
+
+Packs the loose converted assets under resources/graphics into a single
+indexed container that the SDL3 build maps into memory at startup
+(see PAL_AssetPack_Open in src/platform/sdl/pal_file_sdl.c).
+
+Assets are keyed by (NARC ID, member index, kind), the same triple the
+Graphics_Load* functions ask for, so the paths below mirror GetAssetPath in
+src/graphics.c. Keep the two in sync when adding mappings.
+
+Container layout (all values little-endian):
+
+    header      32 bytes
+                  char magic[4]   "PPAK"
+                  u32  version    1
+                  u32  numEntries
+                  u32  numBuckets power of two
+                  u32  dirOffset  start of the directory
+                  u32  dataOffset start of the data, page aligned
+                  u32  pageSize   4096
+                  u32  reserved
+    directory   numBuckets x 16 bytes, open addressing with linear probing
+                  u32  key        (narcID << 20) | (member << 4) | kind,
+                                  0xFFFFFFFF for an empty bucket
+                  u32  offset     from the start of the file
+                  u32  size       in bytes
+                  u32  reserved
+    data        assets of a page or more start on a page boundary, smaller
+                ones are packed at 32-byte alignment
+
+Usage:
+    python3 pack_assets.py [resources_dir] [output_file]
+
+Example:
+    python3 pack_assets.py resources resources/assets.pak
+"""
+
+import os
+import re
+import struct
+import sys
+
+MAGIC = b'PPAK'
+VERSION = 1
+HEADER_SIZE = 32
+ENTRY_SIZE = 16
+PAGE_SIZE = 4096
+SMALL_ALIGN = 32
+EMPTY_KEY = 0xFFFFFFFF
+
+# Must match PAL_AssetKind in include/platform/pal_file.h
+ASSET_KINDS = {
+    'tiles.bin': 0,
+    'tilemap.bin': 1,
+    'palette.pal': 2,
+}
+
+# Title screen members with named files, from GetAssetPath
+TITLE_SCREEN_NAMES = {
+    4: 'gf_presents', 6: 'bottom_screen_border', 7: 'top_screen_border',
+    8: 'logo_jp', 11: 'logo', 14: 'copyright',
+    5: 'gf_presents', 9: 'logo_jp', 12: 'logo', 15: 'copyright',
+    23: 'top_screen_border', 26: 'bottom_screen_border',
+}
+
+GENERIC_PATTERN = re.compile(r'^(\d{4})_(.+)$')
+NARC_DIR_PATTERN = re.compile(r'^narc_(\d{3,})$')
+
+
+def make_key(narc_id, member, kind):
+    return ((narc_id & 0xFFF) << 20) | ((member & 0xFFFF) << 4) | (kind & 0xF)
+
+
+def hash_key(key, num_buckets):
+    # Same multiplicative hash as AssetPackHash in pal_file_sdl.c
+    bucket_bits = num_buckets.bit_length() - 1
+    return ((key * 0x9E3779B1) & 0xFFFFFFFF) >> (32 - bucket_bits)
+
+
+def find_narc_index(project_root, name):
+    """Position of an enumerator in enum NarcID (the enum is sequential)"""
+    header = os.path.join(project_root, 'include', 'constants', 'narc.h')
+    index = 0
+    with open(header) as f:
+        for line in f:
+            match = re.match(r'\s*(NARC_INDEX_\w+)', line)
+            if not match:
+                continue
+            if match.group(1) == name:
+                return index
+            index += 1
+    raise ValueError(f'{name} not found in {header}')
+
+
+def title_screen_path(resources_dir, member, asset_type):
+    graphics = os.path.join(resources_dir, 'graphics')
+    raw = os.path.join(graphics, 'title_screen_raw', f'{member:04d}.bin')
+
+    if asset_type == 'tilemap.bin' or member not in TITLE_SCREEN_NAMES:
+        return raw
+
+    name = TITLE_SCREEN_NAMES[member]
+    if asset_type == 'palette.pal':
+        return os.path.join(graphics, 'title_screen', f'{name}.pal')
+    if asset_type == 'tiles.bin':
+        return os.path.join(graphics, 'title_screen', f'{name}_tiles.bin')
+    return os.path.join(graphics, 'title_screen', f'{name}_{asset_type}')
+
+
+def collect_assets(resources_dir, title_narc_id):
+    """Returns {key: path} for every asset GetAssetPath could resolve"""
+    assets = {}
+    graphics = os.path.join(resources_dir, 'graphics')
+
+    # Generic layout: graphics/narc_NNN/MMMM_<kind>
+    if os.path.isdir(graphics):
+        for dir_name in sorted(os.listdir(graphics)):
+            dir_match = NARC_DIR_PATTERN.match(dir_name)
+            if not dir_match:
+                continue
+            narc_id = int(dir_match.group(1))
+            for file_name in sorted(os.listdir(os.path.join(graphics, dir_name))):
+                file_match = GENERIC_PATTERN.match(file_name)
+                if not file_match or file_match.group(2) not in ASSET_KINDS:
+                    continue
+                member = int(file_match.group(1))
+                kind = ASSET_KINDS[file_match.group(2)]
+                assets[make_key(narc_id, member, kind)] = os.path.join(graphics, dir_name, file_name)
+
+    # Title screen: every member present in the raw dump, in every kind
+    raw_dir = os.path.join(graphics, 'title_screen_raw')
+    if os.path.isdir(raw_dir):
+        members = [int(name[:4]) for name in os.listdir(raw_dir) if re.match(r'^\d{4}\.bin$', name)]
+        for member in sorted(members):
+            for asset_type, kind in ASSET_KINDS.items():
+                path = title_screen_path(resources_dir, member, asset_type)
+                if os.path.isfile(path):
+                    assets[make_key(title_narc_id, member, kind)] = path
+
+    return assets
+
+
+def align(value, alignment):
+    return (value + alignment - 1) & ~(alignment - 1)
+
+
+def write_pack(assets, output_path):
+    num_buckets = 16
+    while num_buckets < len(assets) * 2:
+        num_buckets *= 2
+
+    dir_offset = HEADER_SIZE
+    data_offset = align(dir_offset + num_buckets * ENTRY_SIZE, PAGE_SIZE)
+
+    # Lay out each file once (several keys can resolve to the same file), big
+    # files first so the small ones pack together at the end
+    files = {}
+    for path in sorted(set(assets.values())):
+        with open(path, 'rb') as f:
+            files[path] = f.read()
+    layout = sorted(files, key=lambda path: (len(files[path]) < PAGE_SIZE, path))
+
+    offsets = {}
+    cursor = data_offset
+    for path in layout:
+        size = len(files[path])
+        cursor = align(cursor, PAGE_SIZE if size >= PAGE_SIZE else SMALL_ALIGN)
+        offsets[path] = cursor
+        cursor += size
+
+    buckets = [(EMPTY_KEY, 0, 0)] * num_buckets
+    for key, path in sorted(assets.items()):
+        slot = hash_key(key, num_buckets)
+        while buckets[slot][0] != EMPTY_KEY:
+            slot = (slot + 1) & (num_buckets - 1)
+        buckets[slot] = (key, offsets[path], len(files[path]))
+
+    if cursor > 0xFFFFFFFF:
+        raise ValueError('asset pack would exceed 4 GiB')
+
+    out = bytearray(cursor)
+    struct.pack_into('<4s7I', out, 0, MAGIC, VERSION, len(assets), num_buckets,
+                     dir_offset, data_offset, PAGE_SIZE, 0)
+    for i, (key, offset, size) in enumerate(buckets):
+        struct.pack_into('<4I', out, dir_offset + i * ENTRY_SIZE, key, offset, size, 0)
+    for path, data in files.items():
+        out[offsets[path]:offsets[path] + len(data)] = data
+
+    os.makedirs(os.path.dirname(os.path.abspath(output_path)), exist_ok=True)
+    with open(output_path, 'wb') as f:
+        f.write(out)
+
+    return len(assets), cursor
+
+
+def main():
+    project_root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    resources_dir = sys.argv[1] if len(sys.argv) > 1 else os.path.join(project_root, 'resources')
+    output_path = sys.argv[2] if len(sys.argv) > 2 else os.path.join(resources_dir, 'assets.pak')
+
+    if not os.path.isdir(resources_dir):
+        print(f"Error: resources directory not found: {resources_dir}")
+        sys.exit(1)
+
+    title_narc_id = find_narc_index(project_root, 'NARC_INDEX_DEMO__TITLE__TITLEDEMO')
+    assets = collect_assets(resources_dir, title_narc_id)
+
+    if not assets:
+        print(f"Error: no assets found under {resources_dir}")
+        sys.exit(1)
+
+    count, size = write_pack(assets, output_path)
+    print(f"✓ Packed {count} assets into {output_path} ({size / 1024:.1f} KB)")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,211 @@
+/**
+ * @file crypt_bench.c
+ * @brief Micro-benchmark for the PAL LCRNG stream cipher kernels
+ *
+ * Replays what BoxPokemon_GetValue does for every mon in 18 full PC boxes
+ * (540 mons): decrypt the 128 bytes of data blocks, checksum them and
+ * encrypt them again. The reference is the previous EncodeData loop, one
+ * LCRNG step per halfword, followed by a separate checksum loop; every
+ * keystream path the CPU supports is then timed with the fused
+ * decrypt+checksum kernel.
+ *
+ * Before timing, each path is checked against the reference for every size
+ * from 0 to 300 bytes (odd sizes included) and a set of seeds, in both the
+ * plain and checksum variants.
+ *
+ * Usage: pal_bench_crypt [iterations]
+ */
+
+#include "platform/pal_crypt.h"
+#include "platform/pal_timer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_BOXES 18
+#define MONS_PER_BOX 30
+#define NUM_MONS (NUM_BOXES * MONS_PER_BOX)
+#define DATA_BLOCKS_SIZE 128
+#define MAX_CHECK_SIZE 300
+
+typedef struct {
+    u32 checksum;
+    u16 dataBlocks[DATA_BLOCKS_SIZE / 2];
+} BoxMon;
+
+typedef struct {
+    const char* name;
+    double seconds;
+    BOOL exact;
+} BenchResult;
+
+// Keeps the timed passes from being optimized out
+static volatile u32 sSink;
+
+static u32 sRngState = 0x12345678;
+
+static u32 NextRandom(void) {
+    sRngState = sRngState * 1103515245 + 12345;
+    return sRngState;
+}
+
+// ============================================================================
+// Reference: EncodeData and Pokemon_GetDataChecksum before the kernels
+// ============================================================================
+
+static void RefXor(void* data, u32 size, u32 seed) {
+    u16* halfWords = data;
+
+    for (u32 i = 0; i < size / 2; i++) {
+        seed = seed * 1103515245 + 24691;
+        halfWords[i] ^= (u16)(seed >> 16);
+    }
+}
+
+static u16 RefChecksum(const void* data, u32 size) {
+    const u16* halfWords = data;
+    u16 checksum = 0;
+
+    for (u32 i = 0; i < size / 2; i++) {
+        checksum += halfWords[i];
+    }
+    return checksum;
+}
+
+// ============================================================================
+// Bit-exactness
+// ============================================================================
+
+static BOOL CheckPath(void) {
+    static const u32 seeds[] = { 0, 1, 0xFFFF, 0x10000, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF, 0xDEADBEEF };
+    u8 src[MAX_CHECK_SIZE + 4];
+    u8 expected[MAX_CHECK_SIZE + 4];
+    u8 actual[MAX_CHECK_SIZE + 4];
+
+    for (u32 i = 0; i < sizeof(src); i++) {
+        src[i] = (u8)(NextRandom() >> 16);
+    }
+
+    for (u32 s = 0; s < sizeof(seeds) / sizeof(seeds[0]); s++) {
+        for (u32 size = 0; size <= MAX_CHECK_SIZE; size++) {
+            // Offset by one halfword, with guard bytes on both sides
+            memcpy(expected, src, sizeof(src));
+            RefXor(expected + 2, size, seeds[s]);
+            u16 expectedChecksum = RefChecksum(expected + 2, size);
+
+            memcpy(actual, src, sizeof(src));
+            PAL_Crypt_LCRNGXor(actual + 2, size, seeds[s]);
+            if (memcmp(actual, expected, sizeof(src)) != 0) {
+                return FALSE;
+            }
+
+            memcpy(actual, src, sizeof(src));
+            u16 checksum = PAL_Crypt_LCRNGXorChecksum(actual + 2, size, seeds[s]);
+            if (memcmp(actual, expected, sizeof(src)) != 0 || checksum != expectedChecksum) {
+                return FALSE;
+            }
+        }
+    }
+    return TRUE;
+}
+
+// ============================================================================
+// Box pass
+// ============================================================================
+
+static u32 ReadBoxesRef(BoxMon* mons) {
+    u32 failed = 0;
+
+    for (u32 i = 0; i < NUM_MONS; i++) {
+        RefXor(mons[i].dataBlocks, DATA_BLOCKS_SIZE, mons[i].checksum);
+        failed += RefChecksum(mons[i].dataBlocks, DATA_BLOCKS_SIZE) != mons[i].checksum;
+        RefXor(mons[i].dataBlocks, DATA_BLOCKS_SIZE, mons[i].checksum);
+    }
+    return failed;
+}
+
+static u32 ReadBoxesPAL(BoxMon* mons) {
+    u32 failed = 0;
+
+    for (u32 i = 0; i < NUM_MONS; i++) {
+        failed += PAL_Crypt_LCRNGXorChecksum(mons[i].dataBlocks, DATA_BLOCKS_SIZE, mons[i].checksum) != mons[i].checksum;
+        PAL_Crypt_LCRNGXor(mons[i].dataBlocks, DATA_BLOCKS_SIZE, mons[i].checksum);
+    }
+    return failed;
+}
+
+// Random plaintext, checksummed and encrypted the way Pokemon_EncryptData does
+static void FillBoxes(BoxMon* mons) {
+    for (u32 i = 0; i < NUM_MONS; i++) {
+        for (u32 j = 0; j < DATA_BLOCKS_SIZE / 2; j++) {
+            mons[i].dataBlocks[j] = (u16)(NextRandom() >> 16);
+        }
+        mons[i].checksum = RefChecksum(mons[i].dataBlocks, DATA_BLOCKS_SIZE);
+        RefXor(mons[i].dataBlocks, DATA_BLOCKS_SIZE, mons[i].checksum);
+    }
+}
+
+static double TimeBoxes(u32 (*read)(BoxMon*), BoxMon* mons, int iterations, u64 freq) {
+    u64 best = ~0ull;
+
+    for (int i = 0; i < iterations; i++) {
+        u64 start = PAL_Timer_GetPerformanceCounter();
+        sSink = read(mons);
+        u64 elapsed = PAL_Timer_GetPerformanceCounter() - start;
+
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return (double)best / (double)freq;
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 200;
+    if (iterations <= 0) {
+        iterations = 1;
+    }
+
+    PAL_Timer_Init();
+
+    static BoxMon mons[NUM_MONS];
+    static BoxMon original[NUM_MONS];
+    FillBoxes(mons);
+    memcpy(original, mons, sizeof(mons));
+
+    u64 freq = PAL_Timer_GetPerformanceFrequency();
+    double refSeconds = TimeBoxes(ReadBoxesRef, mons, iterations, freq);
+    BOOL refOk = ReadBoxesRef(mons) == 0 && memcmp(mons, original, sizeof(mons)) == 0;
+
+    BenchResult results[PAL_CRYPT_PATH_MAX];
+    int numResults = 0;
+    BOOL allExact = refOk;
+
+    for (int path = 0; path < PAL_CRYPT_PATH_MAX; path++) {
+        if (!PAL_Crypt_SetPath((PAL_CryptPath)path)) {
+            continue;
+        }
+
+        BenchResult* result = &results[numResults++];
+        result->name = PAL_Crypt_GetPathName((PAL_CryptPath)path);
+        result->exact = CheckPath() && ReadBoxesPAL(mons) == 0 && memcmp(mons, original, sizeof(mons)) == 0;
+        result->seconds = TimeBoxes(ReadBoxesPAL, mons, iterations, freq);
+        allExact = allExact && result->exact;
+    }
+
+    printf("Box read (decrypt, checksum, encrypt), %d boxes x %d mons, best of %d:\n",
+           NUM_BOXES, MONS_PER_BOX, iterations);
+    printf("  %-10s %10s %10s %10s %s\n", "path", "us/pass", "ns/mon", "speedup", "bit-exact");
+    printf("  %-10s %10.1f %10.1f %9.2fx %s\n", "reference", refSeconds * 1e6, refSeconds * 1e9 / NUM_MONS,
+           1.0, refOk ? "yes" : "NO");
+    for (int i = 0; i < numResults; i++) {
+        printf("  %-10s %10.1f %10.1f %9.2fx %s\n", results[i].name, results[i].seconds * 1e6,
+               results[i].seconds * 1e9 / NUM_MONS, refSeconds / results[i].seconds,
+               results[i].exact ? "yes" : "NO");
+    }
+
+    PAL_Timer_Shutdown();
+
+    return allExact ? 0 : 1;
+}
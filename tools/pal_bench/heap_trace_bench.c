@@ -0,0 +1,510 @@
+/**
+ * @file heap_trace_bench.c
+ * @brief Benchmark for game heap allocations, replaying allocation traces
+ *
+ * Replays a sequence of Heap_Alloc/Heap_Free/Heap_Destroy events three ways:
+ *   malloc - malloc/free, with a destroyed heap freeing its blocks one by one
+ *   arena  - the game heaps with small blocks taken from the arenas
+ *   slab   - the game heaps with small blocks taken from the slab caches
+ *
+ * The trace is either the "events" array of a profile written by
+ * `pokeplatinum_sdl --heap-profile FILE` (PAL_ENABLE_HEAP_PROFILER build),
+ * or, without a file, two generated traces. Neither is a recording; they
+ * are hand-written guesses at the allocation pattern, for comparing the
+ * allocators against each other rather than predicting the game's numbers:
+ *   battle    - a battle heap filled with long-lived structures, a steady
+ *               stream of message and animation buffers freed within a few
+ *               frames, then destroyed at the end of each battle. The
+ *               battle code is not in the SDL build, so there is no
+ *               profile to check this one against.
+ *   overworld - a field heap that is never destroyed, with per-frame map
+ *               object scratch and map blocks loaded and dropped while
+ *               walking. Replay a --heap-profile dump of the overworld for
+ *               real numbers.
+ *
+ * Usage: pal_bench_heap_trace [profile.json] [iterations]
+ */
+
+#include "heap.h"
+#include "platform/pal_memory.h"
+#include "platform/pal_timer.h"
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEMPLATE_HEAP_SIZE 0x100000
+#define CREATED_HEAP_SIZE  0x80000
+#define NUM_TEMPLATES      (HEAP_ID_APPLICATION + 1)
+
+// Event kinds, as written by the heap profiler
+enum {
+    OP_ALLOC = 0,
+    OP_FREE,
+    OP_RESIZE,
+    OP_DESTROY,
+    OP_RELEASE,     // Block still allocated when its heap is destroyed
+};
+
+typedef struct {
+    u8 kind;
+    u8 heap;
+    u32 size;
+    u32 block;      // Dense index into the replay's block table
+} TraceOp;
+
+typedef struct {
+    const char* name;
+    TraceOp* ops;
+    u32 numOps;
+    u32 capacity;
+    u32 numBlocks;
+    u32 numAllocs;
+} Trace;
+
+typedef enum {
+    REPLAY_MALLOC = 0,
+    REPLAY_ARENA,
+    REPLAY_SLAB,
+} ReplayMode;
+
+static const char* const sModeNames[] = { "malloc", "arena", "slab" };
+
+static u32 sRandState;
+
+static u32 Random(void) {
+    sRandState = sRandState * 1103515245 + 12345;
+    return sRandState >> 16;
+}
+
+static u32 RandomRange(u32 min, u32 max) {
+    return min + Random() % (max - min + 1);
+}
+
+// ============================================================================
+// Traces
+// ============================================================================
+
+static void AddOp(Trace* trace, u8 kind, u8 heap, u32 size, u32 block) {
+    if (trace->numOps == trace->capacity) {
+        trace->capacity = trace->capacity ? trace->capacity * 2 : 4096;
+        trace->ops = realloc(trace->ops, sizeof(TraceOp) * trace->capacity);
+    }
+    
+    TraceOp* op = &trace->ops[trace->numOps++];
+    op->kind = kind;
+    op->heap = heap;
+    op->size = size;
+    op->block = block;
+    
+    if (kind == OP_ALLOC) {
+        trace->numAllocs++;
+    }
+}
+
+static u32 AddAlloc(Trace* trace, u8 heap, u32 size) {
+    u32 block = trace->numBlocks++;
+    AddOp(trace, OP_ALLOC, heap, size, block);
+    return block;
+}
+
+// Small sizes dominate: most game allocations are structs and string buffers
+static u32 RandomSmallSize(void) {
+    static const u32 sizes[] = { 16, 24, 32, 40, 48, 64, 72, 96, 128, 160, 200, 256, 320, 400, 480 };
+    return sizes[Random() % (sizeof(sizes) / sizeof(sizes[0]))] - RandomRange(0, 7);
+}
+
+static void BuildBattleTrace(Trace* trace, u32 battles) {
+    enum { PENDING_MAX = 256 };
+    u32 pending[PENDING_MAX];
+    u32 pendingFrame[PENDING_MAX];
+    
+    trace->name = "battle";
+    sRandState = 1;
+    
+    for (u32 battle = 0; battle < battles; battle++) {
+        u32 numPending = 0;
+        
+        // Setup: battle context, parties, sprite managers and their tables
+        for (u32 i = 0; i < 600; i++) {
+            u32 size = Random() % 8 == 0 ? RandomRange(1024, 16384) : RandomSmallSize();
+            AddAlloc(trace, HEAP_ID_BATTLE, size);
+        }
+        
+        for (u32 frame = 0; frame < 1800; frame++) {
+            // Message and animation buffers, freed a few frames later
+            u32 count = RandomRange(2, 12);
+            
+            for (u32 i = 0; i < count && numPending < PENDING_MAX; i++) {
+                u32 size = Random() % 16 == 0 ? RandomRange(2048, 8192) : RandomSmallSize();
+                pending[numPending] = AddAlloc(trace, HEAP_ID_BATTLE, size);
+                pendingFrame[numPending] = frame + RandomRange(0, 4);
+                numPending++;
+            }
+            
+            for (u32 i = 0; i < numPending;) {
+                if (pendingFrame[i] <= frame) {
+                    AddOp(trace, OP_FREE, HEAP_ID_BATTLE, 0, pending[i]);
+                    pending[i] = pending[numPending - 1];
+                    pendingFrame[i] = pendingFrame[numPending - 1];
+                    numPending--;
+                } else {
+                    i++;
+                }
+            }
+        }
+        
+        // Whatever is left goes with the heap
+        AddOp(trace, OP_DESTROY, HEAP_ID_BATTLE, 0, 0);
+    }
+}
+
+static void BuildOverworldTrace(Trace* trace, u32 frames) {
+    enum { MAP_BLOCKS = 4, SCRATCH_MAX = 512 };
+    u32 mapBlocks[MAP_BLOCKS][6];
+    u32 scratch[SCRATCH_MAX];
+    u32 scratchFrame[SCRATCH_MAX];
+    u32 numScratch = 0;
+    
+    trace->name = "overworld";
+    sRandState = 2;
+    
+    // Field system, map objects and the loaded map blocks
+    for (u32 i = 0; i < 400; i++) {
+        AddAlloc(trace, HEAP_ID_FIELD1, Random() % 10 == 0 ? RandomRange(512, 8192) : RandomSmallSize());
+    }
+    
+    for (u32 i = 0; i < MAP_BLOCKS; i++) {
+        for (u32 j = 0; j < 6; j++) {
+            mapBlocks[i][j] = AddAlloc(trace, HEAP_ID_FIELD1, j == 0 ? 0x4000 : RandomSmallSize());
+        }
+    }
+    
+    for (u32 frame = 0; frame < frames; frame++) {
+        // Map object movement and script scratch, mostly freed next frame
+        u32 count = RandomRange(0, 6);
+        
+        for (u32 i = 0; i < count && numScratch < SCRATCH_MAX; i++) {
+            scratch[numScratch] = AddAlloc(trace, HEAP_ID_FIELD1, RandomSmallSize());
+            scratchFrame[numScratch] = frame + (Random() % 8 == 0 ? RandomRange(30, 300) : 1);
+            numScratch++;
+        }
+        
+        for (u32 i = 0; i < numScratch;) {
+            if (scratchFrame[i] <= frame) {
+                AddOp(trace, OP_FREE, HEAP_ID_FIELD1, 0, scratch[i]);
+                scratch[i] = scratch[numScratch - 1];
+                scratchFrame[i] = scratchFrame[numScratch - 1];
+                numScratch--;
+            } else {
+                i++;
+            }
+        }
+        
+        // Crossing into a new map block every few seconds
+        if (frame % 240 == 239) {
+            u32 slot = Random() % MAP_BLOCKS;
+            
+            for (u32 j = 0; j < 6; j++) {
+                AddOp(trace, OP_FREE, HEAP_ID_FIELD1, 0, mapBlocks[slot][j]);
+                mapBlocks[slot][j] = AddAlloc(trace, HEAP_ID_FIELD1, j == 0 ? 0x4000 : RandomSmallSize());
+            }
+        }
+    }
+}
+
+// Reads the "events" of a heap profile. Block ids are made dense, events for
+// PAL_Malloc and for blocks allocated before the recorded window are dropped,
+// and resizes are ignored (the heaps only resize in place).
+static BOOL LoadTrace(Trace* trace, const char* path) {
+    FILE* file = fopen(path, "rb");
+    
+    if (!file) {
+        printf("Cannot open %s\n", path);
+        return FALSE;
+    }
+    
+    char line[256];
+    BOOL inEvents = FALSE;
+    u32* blockMap = NULL;
+    u32 blockMapSize = 0;
+    
+    trace->name = path;
+    
+    while (fgets(line, sizeof(line), file)) {
+        if (!inEvents) {
+            inEvents = strstr(line, "\"events\"") != NULL;
+            continue;
+        }
+        
+        unsigned frame, kind, heap, size, site, block;
+        int fields = sscanf(line, "[%u,%u,%u,%u,%u,%u]", &frame, &kind, &heap, &size, &site, &block);
+        
+        if (fields < 5) {
+            continue;
+        }
+        
+        if (fields < 6) {
+            printf("%s has no block ids; record it again with this build\n", path);
+            fclose(file);
+            free(blockMap);
+            return FALSE;
+        }
+        
+        if (heap >= HEAP_ID_MAX || kind == OP_RESIZE) {
+            continue;
+        }
+        
+        if (kind == OP_DESTROY) {
+            AddOp(trace, OP_DESTROY, (u8)heap, 0, 0);
+            continue;
+        }
+        
+        if (block >= blockMapSize) {
+            u32 newSize = blockMapSize ? blockMapSize : 4096;
+            
+            while (newSize <= block) {
+                newSize *= 2;
+            }
+            
+            blockMap = realloc(blockMap, sizeof(u32) * newSize);
+            memset(blockMap + blockMapSize, 0xFF, sizeof(u32) * (newSize - blockMapSize));
+            blockMapSize = newSize;
+        }
+        
+        if (kind == OP_ALLOC) {
+            blockMap[block] = AddAlloc(trace, (u8)heap, size);
+        } else if (blockMap[block] != 0xFFFFFFFF) {
+            AddOp(trace, OP_FREE, (u8)heap, 0, blockMap[block]);
+        }
+    }
+    
+    fclose(file);
+    free(blockMap);
+    
+    if (trace->numAllocs == 0) {
+        printf("%s has no heap allocation events\n", path);
+        return FALSE;
+    }
+    
+    return TRUE;
+}
+
+// Puts a release of every block still allocated in a heap before each
+// destroy, so replaying doesn't have to search for them
+static void ExpandDestroys(Trace* trace) {
+    TraceOp* ops = trace->ops;
+    u32 numOps = trace->numOps;
+    u32 numBlocks = trace->numBlocks ? trace->numBlocks : 1;
+    u32* livePos = malloc(sizeof(u32) * numBlocks);
+    u32* live = malloc(sizeof(u32) * numBlocks);
+    u8* blockHeap = malloc(numBlocks);
+    u32 numLive = 0;
+    
+    trace->ops = NULL;
+    trace->numOps = 0;
+    trace->capacity = 0;
+    trace->numAllocs = 0;
+    
+    for (u32 i = 0; i < numOps; i++) {
+        const TraceOp* op = &ops[i];
+        
+        if (op->kind == OP_ALLOC) {
+            livePos[op->block] = numLive;
+            live[numLive++] = op->block;
+            blockHeap[op->block] = op->heap;
+        } else if (op->kind == OP_FREE) {
+            u32 pos = livePos[op->block];
+            
+            live[pos] = live[--numLive];
+            livePos[live[pos]] = pos;
+        } else if (op->kind == OP_DESTROY) {
+            for (u32 j = 0; j < numLive;) {
+                if (blockHeap[live[j]] == op->heap) {
+                    AddOp(trace, OP_RELEASE, op->heap, 0, live[j]);
+                    live[j] = live[--numLive];
+                    livePos[live[j]] = j;
+                } else {
+                    j++;
+                }
+            }
+        }
+        
+        AddOp(trace, op->kind, op->heap, op->size, op->block);
+    }
+    
+    free(ops);
+    free(live);
+    free(livePos);
+    free(blockHeap);
+}
+
+// ============================================================================
+// Replay
+// ============================================================================
+
+static void FreeBlock(ReplayMode mode, void* ptr) {
+    if (mode == REPLAY_MALLOC) {
+        free(ptr);
+    } else {
+        Heap_Free(ptr);
+    }
+}
+
+static void CreateHeaps(ReplayMode mode, const BOOL* usedHeaps) {
+    if (mode == REPLAY_MALLOC) {
+        return;
+    }
+    
+    for (u32 heap = NUM_TEMPLATES; heap < HEAP_ID_MAX; heap++) {
+        if (usedHeaps[heap]) {
+            Heap_Create(HEAP_ID_SYSTEM, heap, CREATED_HEAP_SIZE);
+        }
+    }
+}
+
+static u64 Replay(const Trace* trace, ReplayMode mode, void** blocks, const BOOL* usedHeaps) {
+    Heap_SetSlabEnabled(mode == REPLAY_SLAB);
+    memset(blocks, 0, sizeof(void*) * trace->numBlocks);
+    CreateHeaps(mode, usedHeaps);
+    
+    u64 start = PAL_Timer_GetPerformanceCounter();
+    
+    for (u32 i = 0; i < trace->numOps; i++) {
+        const TraceOp* op = &trace->ops[i];
+        void** block = &blocks[op->block];
+        
+        switch (op->kind) {
+        case OP_ALLOC:
+            *block = mode == REPLAY_MALLOC ? malloc(op->size) : Heap_Alloc(op->heap, op->size);
+            // Touch the block, as its owner would
+            *(volatile u8*)*block = 0;
+            break;
+        case OP_FREE:
+            FreeBlock(mode, *block);
+            *block = NULL;
+            break;
+        case OP_RELEASE:
+            // The game heaps drop these all at once in the destroy that follows
+            if (mode == REPLAY_MALLOC || op->heap < NUM_TEMPLATES) {
+                FreeBlock(mode, *block);
+            }
+            *block = NULL;
+            break;
+        case OP_DESTROY:
+            if (mode != REPLAY_MALLOC && op->heap >= NUM_TEMPLATES) {
+                Heap_Destroy(op->heap);
+                Heap_Create(HEAP_ID_SYSTEM, op->heap, CREATED_HEAP_SIZE);
+            }
+            break;
+        }
+    }
+    
+    u64 elapsed = PAL_Timer_GetPerformanceCounter() - start;
+    
+    // Teardown isn't timed
+    for (u32 i = 0; i < trace->numBlocks; i++) {
+        if (blocks[i]) {
+            FreeBlock(mode, blocks[i]);
+        }
+    }
+    
+    if (mode != REPLAY_MALLOC) {
+        for (u32 heap = NUM_TEMPLATES; heap < HEAP_ID_MAX; heap++) {
+            if (usedHeaps[heap]) {
+                Heap_Destroy(heap);
+            }
+        }
+    }
+    
+    return elapsed;
+}
+
+static void RunTrace(Trace* trace, int iterations) {
+    ExpandDestroys(trace);
+    
+    void** blocks = malloc(sizeof(void*) * (trace->numBlocks ? trace->numBlocks : 1));
+    BOOL usedHeaps[HEAP_ID_MAX] = { FALSE };
+    u32 smallAllocs = 0;
+    
+    for (u32 i = 0; i < trace->numOps; i++) {
+        usedHeaps[trace->ops[i].heap] = TRUE;
+        
+        if (trace->ops[i].kind == OP_ALLOC && trace->ops[i].size <= PAL_SLAB_MAX_SIZE - 32) {
+            smallAllocs++;
+        }
+    }
+    
+    printf("\n%s: %u events, %u allocations (%.0f%% small)\n", trace->name, trace->numOps, trace->numAllocs,
+           100.0 * smallAllocs / (trace->numAllocs ? trace->numAllocs : 1));
+    printf("  %-8s %12s %12s\n", "mode", "ns/event", "vs malloc");
+    
+    double frequency = (double)PAL_Timer_GetPerformanceFrequency();
+    double mallocNs = 0.0;
+    
+    for (ReplayMode mode = REPLAY_MALLOC; mode <= REPLAY_SLAB; mode++) {
+        u64 best = ~0ull;
+        
+        // Best of N, after a warm-up pass that sizes the arenas and caches
+        Replay(trace, mode, blocks, usedHeaps);
+        for (int i = 0; i < iterations; i++) {
+            u64 elapsed = Replay(trace, mode, blocks, usedHeaps);
+            if (elapsed < best) {
+                best = elapsed;
+            }
+        }
+        
+        double ns = best * 1e9 / frequency / trace->numOps;
+        if (mode == REPLAY_MALLOC) {
+            mallocNs = ns;
+        }
+        
+        printf("  %-8s %12.1f %11.2fx\n", sModeNames[mode], ns, mallocNs / ns);
+    }
+    
+    free(blocks);
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = argc > 1 && strcmp(argv[1], "-") != 0 ? argv[1] : NULL;
+    int iterations = argc > 2 ? atoi(argv[2]) : 5;
+    HeapParam templates[NUM_TEMPLATES];
+    
+    if (iterations < 1) {
+        iterations = 1;
+    }
+    
+    PAL_Timer_Init();
+    
+    for (u32 i = 0; i < NUM_TEMPLATES; i++) {
+        templates[i].size = TEMPLATE_HEAP_SIZE;
+        templates[i].arena = 0;
+    }
+    Heap_InitSystem(templates, NUM_TEMPLATES, HEAP_ID_MAX, 0);
+    
+    if (path) {
+        Trace trace = { 0 };
+        
+        if (!LoadTrace(&trace, path)) {
+            return 1;
+        }
+        RunTrace(&trace, iterations);
+        free(trace.ops);
+    } else {
+        Trace battle = { 0 };
+        Trace overworld = { 0 };
+        
+        BuildBattleTrace(&battle, 8);
+        BuildOverworldTrace(&overworld, 36000);
+        RunTrace(&battle, iterations);
+        RunTrace(&overworld, iterations);
+        free(battle.ops);
+        free(overworld.ops);
+    }
+    
+    printf("\n");
+    Heap_PrintStats();
+    PAL_Timer_Shutdown();
+    return 0;
+}
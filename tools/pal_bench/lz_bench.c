@@ -0,0 +1,265 @@
+/**
+ * @file lz_bench.c
+ * @brief Benchmark for the PAL LZ10/LZ11 decoder
+ *
+ * Decompresses every LZ-compressed member of an archive (Pokemon sprites
+ * by default) three ways:
+ *   ref    - a byte-at-a-time decoder in the style of tools/nitrogfx/lz.c
+ *   pal    - PAL_LZ_Decompress
+ *   stream - PAL_LZ_StreamFeed, fed 512 bytes at a time
+ *
+ * The PAL outputs must match the reference byte for byte.
+ *
+ * Usage: pal_bench_lz [archive] [iterations]
+ */
+
+#include "platform/pal_archive.h"
+#include "platform/pal_compress.h"
+#include "platform/pal_timer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_ARCHIVE PAL_ARCHIVE_DEFAULT_ROOT "/poketool/pokegra/pl_pokegra.narc"
+#define STREAM_CHUNK 512
+
+typedef struct {
+    const u8* src;
+    u32 src_size;
+    u32 size;
+    u8* expected;
+    u8* output;
+} Member;
+
+typedef struct {
+    Member* members;
+    int count;
+    u64 bytes;
+} MemberList;
+
+// ============================================================================
+// Reference decoder
+// ============================================================================
+
+static u32 RefDecompress(const u8* src, u32 srcSize, u8* dest, u32 destSize) {
+    u32 srcPos = 4, destPos = 0;
+    BOOL lz11 = src[0] == PAL_LZ_TYPE_LZ11;
+    
+    if (PAL_LZ_GetUncompressedSize(src, srcSize) != destSize || destSize >= 0x1000000) {
+        return 0;
+    }
+    
+    while (destPos < destSize) {
+        if (srcPos >= srcSize) {
+            return 0;
+        }
+        
+        u8 flags = src[srcPos++];
+        
+        for (int i = 0; i < 8 && destPos < destSize; i++, flags <<= 1) {
+            if (!(flags & 0x80)) {
+                if (srcPos >= srcSize) {
+                    return 0;
+                }
+                dest[destPos++] = src[srcPos++];
+                continue;
+            }
+            
+            u32 length, distance;
+            if (srcPos + 1 >= srcSize) {
+                return 0;
+            }
+            
+            if (lz11 && (src[srcPos] >> 4) == 0) {
+                if (srcPos + 2 >= srcSize) {
+                    return 0;
+                }
+                length = (((src[srcPos] & 0xF) << 4) | (src[srcPos + 1] >> 4)) + 0x11;
+                srcPos++;
+            } else if (lz11 && (src[srcPos] >> 4) == 1) {
+                if (srcPos + 3 >= srcSize) {
+                    return 0;
+                }
+                length = (((src[srcPos] & 0xF) << 12) | (src[srcPos + 1] << 4) | (src[srcPos + 2] >> 4)) + 0x111;
+                srcPos += 2;
+            } else {
+                length = (src[srcPos] >> 4) + (lz11 ? 1 : 3);
+            }
+            
+            distance = (((src[srcPos] & 0xF) << 8) | src[srcPos + 1]) + 1;
+            srcPos += 2;
+            
+            if (distance > destPos) {
+                return 0;
+            }
+            
+            for (u32 j = 0; j < length && destPos < destSize; j++, destPos++) {
+                dest[destPos] = dest[destPos - distance];
+            }
+        }
+    }
+    
+    return destSize;
+}
+
+// ============================================================================
+// Passes
+// ============================================================================
+
+static void RunRefPass(MemberList* list) {
+    for (int i = 0; i < list->count; i++) {
+        Member* m = &list->members[i];
+        RefDecompress(m->src, m->src_size, m->output, m->size);
+    }
+}
+
+static void RunPalPass(MemberList* list) {
+    for (int i = 0; i < list->count; i++) {
+        Member* m = &list->members[i];
+        PAL_LZ_Decompress(m->src, m->src_size, m->output, m->size);
+    }
+}
+
+static void RunStreamPass(MemberList* list) {
+    for (int i = 0; i < list->count; i++) {
+        Member* m = &list->members[i];
+        PAL_LZStream stream;
+        
+        PAL_LZ_StreamInit(&stream, m->output, m->size);
+        for (u32 pos = 0; pos < m->src_size; pos += STREAM_CHUNK) {
+            u32 chunk = m->src_size - pos < STREAM_CHUNK ? m->src_size - pos : STREAM_CHUNK;
+            if (PAL_LZ_StreamFeed(&stream, m->src + pos, chunk) != PAL_LZ_STREAM_NEED_INPUT) {
+                break;
+            }
+        }
+    }
+}
+
+static BOOL CheckOutputs(const MemberList* list, const char* name) {
+    for (int i = 0; i < list->count; i++) {
+        const Member* m = &list->members[i];
+        if (memcmp(m->output, m->expected, m->size) != 0) {
+            fprintf(stderr, "%s: member %d differs from the reference\n", name, i);
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static void ClearOutputs(MemberList* list) {
+    for (int i = 0; i < list->count; i++) {
+        memset(list->members[i].output, 0, list->members[i].size);
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char* argv[]) {
+    const char* path = (argc > 1) ? argv[1] : DEFAULT_ARCHIVE;
+    int iterations = (argc > 2) ? atoi(argv[2]) : 20;
+    MemberList list = { 0 };
+    
+    if (iterations <= 0) {
+        iterations = 1;
+    }
+    
+    PAL_Timer_Init();
+    
+    // The path is taken as given, not relative to the archive root
+    char dir[512];
+    const char* name = strrchr(path, '/');
+    if (name) {
+        snprintf(dir, sizeof(dir), "%.*s", (int)(name - path), path);
+        name++;
+    } else {
+        snprintf(dir, sizeof(dir), ".");
+        name = path;
+    }
+    PAL_Archive_SetRootDir(dir);
+    PAL_Archive* archive = PAL_Archive_Open(name);
+    if (!archive) {
+        fprintf(stderr, "Could not open %s\n", path);
+        return 1;
+    }
+    
+    u32 count = PAL_Archive_GetMemberCount(archive);
+    list.members = calloc(count > 0 ? count : 1, sizeof(Member));
+    
+    for (u32 i = 0; i < count; i++) {
+        Member* m = &list.members[list.count];
+        u32 size;
+        
+        m->src = PAL_Archive_GetMember(archive, i, &size);
+        m->src_size = size;
+        m->size = PAL_LZ_GetUncompressedSize(m->src, size);
+        
+        if (m->size == 0) {
+            continue;
+        }
+        
+        m->expected = malloc(m->size);
+        m->output = malloc(m->size);
+        
+        // Skip members that merely look compressed
+        if (RefDecompress(m->src, m->src_size, m->expected, m->size) == 0) {
+            free(m->expected);
+            free(m->output);
+            continue;
+        }
+        
+        list.bytes += m->size;
+        list.count++;
+    }
+    
+    if (list.count == 0) {
+        fprintf(stderr, "No LZ-compressed members in %s\n", path);
+        PAL_Archive_Close(archive);
+        return 1;
+    }
+    
+    static const struct {
+        const char* name;
+        void (*run)(MemberList*);
+    } passes[] = {
+        { "ref", RunRefPass },
+        { "pal", RunPalPass },
+        { "stream", RunStreamPass },
+    };
+    
+    double seconds[3];
+    BOOL match = TRUE;
+    u64 freq = PAL_Timer_GetPerformanceFrequency();
+    
+    for (int p = 0; p < 3; p++) {
+        ClearOutputs(&list);
+        
+        u64 start = PAL_Timer_GetPerformanceCounter();
+        for (int it = 0; it < iterations; it++) {
+            passes[p].run(&list);
+        }
+        seconds[p] = (double)(PAL_Timer_GetPerformanceCounter() - start) / freq / iterations;
+        
+        match = CheckOutputs(&list, passes[p].name) && match;
+    }
+    
+    printf("%d compressed members of %u, %.1f MB decompressed, %d iterations\n",
+           list.count, count, list.bytes / (1024.0 * 1024.0), iterations);
+    printf("  %-7s %10s %10s %8s\n", "path", "ms/pass", "MB/s", "speedup");
+    
+    for (int p = 0; p < 3; p++) {
+        printf("  %-7s %10.2f %10.1f %7.1fx\n", passes[p].name, seconds[p] * 1000.0,
+               list.bytes / (1024.0 * 1024.0) / seconds[p], seconds[0] / seconds[p]);
+    }
+    
+    for (int i = 0; i < list.count; i++) {
+        free(list.members[i].expected);
+        free(list.members[i].output);
+    }
+    free(list.members);
+    PAL_Archive_Close(archive);
+    
+    return match ? 0 : 1;
+}
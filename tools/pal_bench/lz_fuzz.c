@@ -0,0 +1,262 @@
+/**
+ * @file lz_fuzz.c
+ * @brief Fuzz harness for the PAL LZ10/LZ11 decoder
+ *
+ * LLVMFuzzerTestOneInput decodes arbitrary bytes with PAL_LZ_Decompress and
+ * with PAL_LZ_StreamFeed split at input-derived points, and aborts if the
+ * two disagree. Run it under AddressSanitizer to catch out-of-bounds
+ * accesses; the CMake target turns the sanitizers on.
+ *
+ * Built with -DPAL_LIBFUZZER (and -fsanitize=fuzzer) it is a plain
+ * libFuzzer target. Otherwise main() drives it with its own inputs:
+ * random data compressed by tools/nitrogfx/lz.c (LZ10) and by a small
+ * greedy LZ11 encoder below, checked for round trips, then mutated.
+ *
+ * Usage: pal_fuzz_lz [iterations] [seed]
+ */
+
+#include "platform/pal_compress.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Larger headers are rejected up front to keep allocations sane
+#define MAX_OUTPUT_SIZE (1 << 20)
+
+int LLVMFuzzerTestOneInput(const u8* data, size_t size) {
+    u32 srcSize = (u32)size;
+    u32 outSize = PAL_LZ_GetUncompressedSize(data, srcSize);
+    
+    if (outSize == 0 || outSize > MAX_OUTPUT_SIZE) {
+        return 0;
+    }
+    
+    u8* oneShot = malloc(outSize);
+    u8* streamed = malloc(outSize);
+    u32 written = PAL_LZ_Decompress(data, srcSize, oneShot, outSize);
+    
+    // Split points come from the data itself so every input explores a
+    // different set of token boundaries
+    PAL_LZStream stream;
+    PAL_LZStreamStatus status = PAL_LZ_STREAM_NEED_INPUT;
+    u32 pos = 0;
+    
+    PAL_LZ_StreamInit(&stream, streamed, outSize);
+    while (pos < srcSize && status == PAL_LZ_STREAM_NEED_INPUT) {
+        u32 chunk = 1 + data[pos] % 7;
+        if (chunk > srcSize - pos) {
+            chunk = srcSize - pos;
+        }
+        status = PAL_LZ_StreamFeed(&stream, data + pos, chunk);
+        pos += chunk;
+    }
+    
+    BOOL done = status == PAL_LZ_STREAM_DONE;
+    if ((written != 0) != done || (done && memcmp(oneShot, streamed, outSize) != 0)) {
+        fprintf(stderr, "One-shot and streaming decodes disagree (%u bytes in, %u out)\n", srcSize, outSize);
+        abort();
+    }
+    
+    free(oneShot);
+    free(streamed);
+    return 0;
+}
+
+#ifndef PAL_LIBFUZZER
+
+#include "lz.h"
+
+static u32 sRngState;
+
+static u32 NextRandom(void) {
+    sRngState = sRngState * 1103515245 + 12345;
+    return sRngState >> 8;
+}
+
+// Random data with enough repetition to produce plenty of matches
+static void FillTestData(u8* buf, u32 size) {
+    u32 i = 0;
+    
+    while (i < size) {
+        u32 run = 1 + NextRandom() % 600;
+        if (run > size - i) {
+            run = size - i;
+        }
+        
+        switch (NextRandom() % 4) {
+        case 0: // Noise
+            for (u32 j = 0; j < run; j++) {
+                buf[i + j] = (u8)NextRandom();
+            }
+            break;
+        case 1: // Single byte
+            memset(buf + i, (u8)NextRandom(), run);
+            break;
+        default: // Copy of something earlier, possibly overlapping
+            if (i == 0) {
+                buf[i] = (u8)NextRandom();
+                run = 1;
+            } else {
+                u32 distance = 1 + NextRandom() % (i < 4096 ? i : 4096);
+                for (u32 j = 0; j < run; j++) {
+                    buf[i + j] = buf[i + j - distance];
+                }
+            }
+            break;
+        }
+        
+        i += run;
+    }
+}
+
+// Greedy LZ11 encoder; slow, but it emits all three match sizes
+static u8* CompressLZ11(const u8* src, u32 size, u32* outSize) {
+    u8* dest = malloc(8 + size + (size + 7) / 8 + 8);
+    u32 pos = 0, out = 0;
+    
+    dest[out++] = PAL_LZ_TYPE_LZ11;
+    dest[out++] = (u8)size;
+    dest[out++] = (u8)(size >> 8);
+    dest[out++] = (u8)(size >> 16);
+    
+    while (pos < size) {
+        u32 flagsPos = out++;
+        dest[flagsPos] = 0;
+        
+        for (int bit = 0; bit < 8 && pos < size; bit++) {
+            u32 bestLength = 0, bestDistance = 0;
+            
+            for (u32 distance = 1; distance <= pos && distance <= 0x1000; distance++) {
+                u32 length = 0;
+                while (pos + length < size && length < 0x10110 && src[pos + length] == src[pos + length - distance]) {
+                    length++;
+                }
+                if (length > bestLength) {
+                    bestLength = length;
+                    bestDistance = distance;
+                }
+                if (bestLength >= 0x111 || pos + bestLength == size) {
+                    break;
+                }
+            }
+            
+            if (bestLength < 3) {
+                dest[out++] = src[pos++];
+                continue;
+            }
+            
+            u32 d = bestDistance - 1;
+            dest[flagsPos] |= 0x80 >> bit;
+            
+            if (bestLength <= 0x10) {
+                dest[out++] = (u8)(((bestLength - 1) << 4) | (d >> 8));
+            } else if (bestLength <= 0x110) {
+                u32 l = bestLength - 0x11;
+                dest[out++] = (u8)(l >> 4);
+                dest[out++] = (u8)((l << 4) | (d >> 8));
+            } else {
+                u32 l = bestLength - 0x111;
+                dest[out++] = (u8)(0x10 | (l >> 12));
+                dest[out++] = (u8)(l >> 4);
+                dest[out++] = (u8)((l << 4) | (d >> 8));
+            }
+            dest[out++] = (u8)d;
+            pos += bestLength;
+        }
+    }
+    
+    *outSize = out;
+    return dest;
+}
+
+static BOOL CheckRoundTrip(const char* name, const u8* compressed, u32 compressedSize, const u8* original, u32 size) {
+    u8* output = malloc(size);
+    u32 written = PAL_LZ_Decompress(compressed, compressedSize, output, size);
+    BOOL ok = written == size && memcmp(output, original, size) == 0;
+    
+    if (!ok) {
+        fprintf(stderr, "%s round trip failed for %u bytes (decoded %u)\n", name, size, written);
+    }
+    
+    free(output);
+    return ok;
+}
+
+static void FuzzMutations(u8* compressed, u32 compressedSize) {
+    u8* mutated = malloc(compressedSize);
+    
+    for (int m = 0; m < 16; m++) {
+        u32 size = compressedSize;
+        memcpy(mutated, compressed, compressedSize);
+        
+        switch (m % 4) {
+        case 0: // Flip bytes after the header
+            for (int i = 0; i < 4 && size > 4; i++) {
+                mutated[4 + NextRandom() % (size - 4)] ^= (u8)(1 + NextRandom() % 255);
+            }
+            break;
+        case 1: // Truncate
+            size = NextRandom() % (compressedSize + 1);
+            break;
+        case 2: // Claim a different output size
+            mutated[1] = (u8)NextRandom();
+            mutated[2] = (u8)NextRandom();
+            mutated[3] = (u8)(NextRandom() % 4);
+            break;
+        default: // Swap the type
+            mutated[0] ^= PAL_LZ_TYPE_LZ10 ^ PAL_LZ_TYPE_LZ11;
+            break;
+        }
+        
+        LLVMFuzzerTestOneInput(mutated, size);
+    }
+    
+    free(mutated);
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 2000;
+    sRngState = (argc > 2) ? (u32)strtoul(argv[2], NULL, 0) : 0x4C5A3737;
+    int failures = 0;
+    
+    for (int it = 0; it < iterations; it++) {
+        u32 size = 1 + NextRandom() % (it % 16 == 0 ? 70000 : 4096);
+        u8* original = malloc(size);
+        FillTestData(original, size);
+        
+        // LZ10 through the reference encoder, alternating its search modes
+        int lz10Size;
+        u8* lz10 = LZCompress(original, (int)size, &lz10Size, 2, it & 1, TRUE);
+        failures += !CheckRoundTrip("LZ10", lz10, (u32)lz10Size, original, size);
+        LLVMFuzzerTestOneInput(lz10, (size_t)lz10Size);
+        FuzzMutations(lz10, (u32)lz10Size);
+        free(lz10);
+        
+        // LZ11 is slow to encode, so use fewer and smaller inputs
+        if (it % 4 == 0) {
+            u32 lz11Size;
+            u8* lz11 = CompressLZ11(original, size < 8192 ? size : 8192, &lz11Size);
+            failures += !CheckRoundTrip("LZ11", lz11, lz11Size, original, size < 8192 ? size : 8192);
+            LLVMFuzzerTestOneInput(lz11, lz11Size);
+            FuzzMutations(lz11, lz11Size);
+            free(lz11);
+        }
+        
+        // Raw noise, mostly rejected by the header check
+        u8 noise[64];
+        for (u32 i = 0; i < sizeof(noise); i++) {
+            noise[i] = (u8)NextRandom();
+        }
+        noise[0] = (it & 1) ? PAL_LZ_TYPE_LZ10 : PAL_LZ_TYPE_LZ11;
+        noise[3] = 0;
+        LLVMFuzzerTestOneInput(noise, sizeof(noise));
+        
+        free(original);
+    }
+    
+    printf("%d iterations, %d round trip failures\n", iterations, failures);
+    return failures == 0 ? 0 : 1;
+}
+
+#endif // PAL_LIBFUZZER
@@ -0,0 +1,293 @@
+/**
+ * @file narc_bench.c
+ * @brief Benchmark for NARC member reads, mapped archives vs open/seek/read
+ *
+ * Reads every member of every archive under the root directory three ways:
+ *   seek - the original path: open the file and walk the chunk headers with
+ *          seeks and small reads for each member, then read it
+ *   copy - PAL_Archive: map once, then copy the member out
+ *   view - PAL_Archive: map once, then only touch the member in place
+ *
+ * All three must produce the same checksum.
+ *
+ * Usage: pal_bench_narc [root] [iterations]
+ */
+
+#include "platform/pal_archive.h"
+#include "platform/pal_file.h"
+#include "platform/pal_timer.h"
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_ARCHIVES 1024
+#define PATH_LEN 512
+
+typedef struct {
+    char* paths[MAX_ARCHIVES];
+    int count;
+    char root[PATH_LEN];
+} ArchiveList;
+
+typedef struct {
+    u64 members;
+    u64 bytes;
+    u32 checksum;
+} PassResult;
+
+static BOOL HasArchiveExtension(const char* name) {
+    size_t len = strlen(name);
+    return (len > 5 && strcmp(name + len - 5, ".narc") == 0) || (len > 4 && strcmp(name + len - 4, ".arc") == 0);
+}
+
+// dirname is the full path of the directory being listed, with a trailing separator
+static SDL_EnumerationResult CollectArchives(void* userdata, const char* dirname, const char* fname) {
+    ArchiveList* list = userdata;
+    char fullPath[PATH_LEN];
+    SDL_PathInfo info;
+    
+    snprintf(fullPath, sizeof(fullPath), "%s%s", dirname, fname);
+    if (!SDL_GetPathInfo(fullPath, &info)) {
+        return SDL_ENUM_CONTINUE;
+    }
+    
+    if (info.type == SDL_PATHTYPE_DIRECTORY) {
+        SDL_EnumerateDirectory(fullPath, CollectArchives, list);
+    } else if (info.type == SDL_PATHTYPE_FILE && HasArchiveExtension(fname) && list->count < MAX_ARCHIVES) {
+        // Store relative to the root, the way the game names archives
+        size_t rootLen = strlen(list->root);
+        const char* relative = fullPath + rootLen;
+        while (*relative == '/' || *relative == '\\') {
+            relative++;
+        }
+        list->paths[list->count++] = SDL_strdup(relative);
+    }
+    
+    return SDL_ENUM_CONTINUE;
+}
+
+// Cheap checksum over a few bytes per member so the optimizer can't drop the reads
+static u32 Mix(u32 sum, const u8* data, u32 size) {
+    sum = sum * 31 + size;
+    if (size > 0) {
+        sum = sum * 31 + data[0];
+        sum = sum * 31 + data[size / 2];
+        sum = sum * 31 + data[size - 1];
+    }
+    return sum;
+}
+
+// ============================================================================
+// Seek path
+// ============================================================================
+
+static BOOL ReadAt(PAL_File file, long offset, void* dest, size_t size) {
+    return PAL_File_Seek(file, offset, SEEK_SET) == 0 && PAL_File_Read(dest, 1, size, file) == size;
+}
+
+// Same sequence of file operations as ReadFromNarcMember in
+// narc.c on the DS: one open, six seeks and seven reads per member
+static BOOL SeekReadMember(const char* path, u32 index, u8** buffer, u32* capacity, u32* size, u16* numFiles) {
+    u32 btafStart = 0, chunkSize = 0, fileStart = 0, fileEnd = 0;
+    u32 btnfStart, gmifStart;
+    BOOL ok;
+    
+    PAL_File file = PAL_File_Open(path, "rb");
+    if (!file) {
+        return FALSE;
+    }
+    
+    ok = ReadAt(file, 12, &btafStart, 2)
+        && ReadAt(file, btafStart + 4, &chunkSize, 4)
+        && PAL_File_Read(numFiles, 2, 1, file) == 1;
+    
+    btnfStart = btafStart + chunkSize;
+    ok = ok && index < *numFiles && ReadAt(file, btnfStart + 4, &chunkSize, 4);
+    gmifStart = btnfStart + chunkSize;
+    
+    ok = ok && ReadAt(file, btafStart + 12 + index * 8, &fileStart, 4)
+        && PAL_File_Read(&fileEnd, 4, 1, file) == 1
+        && fileEnd >= fileStart;
+    
+    if (ok) {
+        *size = fileEnd - fileStart;
+        if (*size > *capacity) {
+            *capacity = *size;
+            *buffer = realloc(*buffer, *capacity);
+        }
+        ok = ReadAt(file, gmifStart + 8 + fileStart, *buffer, *size);
+    }
+    
+    PAL_File_Close(file);
+    return ok;
+}
+
+static PassResult RunSeekPass(const ArchiveList* list) {
+    PassResult result = { 0 };
+    char fullPath[PATH_LEN];
+    u8* buffer = NULL;
+    u32 capacity = 0;
+    
+    for (int a = 0; a < list->count; a++) {
+        u16 numFiles = 1;
+        u32 size;
+        
+        snprintf(fullPath, sizeof(fullPath), "%s/%s", list->root, list->paths[a]);
+        
+        for (u32 i = 0; i < numFiles; i++) {
+            if (!SeekReadMember(fullPath, i, &buffer, &capacity, &size, &numFiles)) {
+                break;
+            }
+            result.checksum = Mix(result.checksum, buffer, size);
+            result.members++;
+            result.bytes += size;
+        }
+    }
+    
+    free(buffer);
+    return result;
+}
+
+// ============================================================================
+// Mapped paths
+// ============================================================================
+
+static PassResult RunMappedPass(const ArchiveList* list, BOOL copy) {
+    PassResult result = { 0 };
+    u8* buffer = NULL;
+    u32 capacity = 0;
+    
+    for (int a = 0; a < list->count; a++) {
+        PAL_Archive* archive = PAL_Archive_Open(list->paths[a]);
+        if (!archive) {
+            continue;
+        }
+        
+        u32 count = PAL_Archive_GetMemberCount(archive);
+        for (u32 i = 0; i < count; i++) {
+            u32 size;
+            const u8* data = PAL_Archive_GetMember(archive, i, &size);
+            
+            if (copy) {
+                if (size > capacity) {
+                    capacity = size;
+                    buffer = realloc(buffer, capacity);
+                }
+                memcpy(buffer, data, size);
+                data = buffer;
+            }
+            
+            result.checksum = Mix(result.checksum, data, size);
+            result.members++;
+            result.bytes += size;
+        }
+        
+        PAL_Archive_Close(archive);
+    }
+    
+    free(buffer);
+    return result;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static double TimePass(PassResult (*pass)(const ArchiveList*), const ArchiveList* list, int iterations, PassResult* result) {
+    u64 freq = PAL_Timer_GetPerformanceFrequency();
+    u64 start = PAL_Timer_GetPerformanceCounter();
+    
+    for (int i = 0; i < iterations; i++) {
+        *result = pass(list);
+    }
+    
+    return (double)(PAL_Timer_GetPerformanceCounter() - start) / freq / iterations;
+}
+
+static PassResult RunCopyPass(const ArchiveList* list) {
+    return RunMappedPass(list, TRUE);
+}
+
+static PassResult RunViewPass(const ArchiveList* list) {
+    return RunMappedPass(list, FALSE);
+}
+
+int main(int argc, char* argv[]) {
+    static ArchiveList list;
+    const char* root = (argc > 1) ? argv[1] : PAL_ARCHIVE_DEFAULT_ROOT;
+    int iterations = (argc > 2) ? atoi(argv[2]) : 5;
+    
+    if (iterations <= 0) {
+        iterations = 1;
+    }
+    
+    PAL_Timer_Init();
+    PAL_Archive_SetRootDir(root);
+    
+    snprintf(list.root, sizeof(list.root), "%s", root);
+    SDL_EnumerateDirectory(root, CollectArchives, &list);
+    
+    // Drop files that aren't valid NARCs so every pass sees the same set
+    int valid = 0;
+    for (int i = 0; i < list.count; i++) {
+        PAL_Archive* archive = PAL_Archive_Open(list.paths[i]);
+        if (archive) {
+            PAL_Archive_Close(archive);
+            list.paths[valid++] = list.paths[i];
+        } else {
+            SDL_free(list.paths[i]);
+        }
+    }
+    list.count = valid;
+    
+    if (list.count == 0) {
+        fprintf(stderr, "No valid .narc/.arc files found under %s\n", root);
+        return 1;
+    }
+    
+    static const struct {
+        const char* name;
+        PassResult (*run)(const ArchiveList*);
+    } passes[] = {
+        { "seek", RunSeekPass },
+        { "copy", RunCopyPass },
+        { "view", RunViewPass },
+    };
+    
+    PassResult results[3];
+    double seconds[3];
+    
+    // Warm the page cache so every pass reads from memory
+    RunViewPass(&list);
+    
+    for (int i = 0; i < 3; i++) {
+        seconds[i] = TimePass(passes[i].run, &list, iterations, &results[i]);
+    }
+    
+    printf("%d archives, %llu members, %.1f MB, %d iterations\n", list.count,
+           (unsigned long long)results[0].members, results[0].bytes / (1024.0 * 1024.0), iterations);
+    printf("  %-6s %10s %12s %10s %8s\n", "path", "ms/pass", "us/member", "MB/s", "speedup");
+    
+    for (int i = 0; i < 3; i++) {
+        double members = results[i].members ? (double)results[i].members : 1.0;
+        printf("  %-6s %10.2f %12.3f %10.1f %7.1fx\n", passes[i].name, seconds[i] * 1000.0,
+               seconds[i] * 1e6 / members, results[i].bytes / (1024.0 * 1024.0) / seconds[i],
+               seconds[0] / seconds[i]);
+    }
+    
+    BOOL match = results[1].checksum == results[0].checksum && results[2].checksum == results[0].checksum
+        && results[1].members == results[0].members;
+    if (!match) {
+        fprintf(stderr, "Mismatch: seek %08X/%llu, copy %08X/%llu, view %08X\n",
+                results[0].checksum, (unsigned long long)results[0].members,
+                results[1].checksum, (unsigned long long)results[1].members, results[2].checksum);
+    }
+    
+    for (int i = 0; i < list.count; i++) {
+        SDL_free(list.paths[i]);
+    }
+    
+    return match ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+/**
+ * @file palette_fade_bench.c
+ * @brief Frame time of a full-screen palette fade, direct vs indexed color
+ *
+ * Sets up eight 256x256 4bpp BG layers (both screens) and a screen full of
+ * 64x64 sprites, then runs a fade to white and back the way
+ * PaletteData_CommitFadedBuffers drives it: every frame the BG and OBJ
+ * palettes of both screens are reloaded and both screens are composed,
+ * BGs and sprites in one pass.
+ *
+ * In PAL_GRAPHICS_COLOR_DIRECT mode every BG tile has to be re-decoded
+ * each frame; in PAL_GRAPHICS_COLOR_INDEXED mode the compositor looks the
+ * new colors up without re-decoding anything.
+ *
+ * Runs headless on SDL's offscreen video driver by default.
+ *
+ * Usage: pal_bench_palette_fade [frames] [video-driver]
+ */
+
+#include "platform/pal_background.h"
+#include "platform/pal_graphics.h"
+#include "platform/pal_sprite.h"
+#include "platform/pal_timer.h"
+#include "bg_window.h"
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_HEAP_ID   0
+#define NUM_TILES       512
+#define TILEMAP_ENTRIES (32 * 32)
+#define NUM_SPRITES     24
+#define SPRITE_BYTES    (64 * 64 / 2)
+#define FADE_STEPS      16
+
+typedef struct {
+    const char* name;
+    double avgMs;
+    double maxMs;
+    double tilesPerFrame;
+} FadeResult;
+
+static u32 sRngState = 0xC0FFEE11;
+
+static u32 NextRandom(void) {
+    sRngState = sRngState * 1103515245 + 12345;
+    return sRngState;
+}
+
+// Blend each RGB555 channel towards white in 1/16 steps, like a palette.c fade
+static void BlendPalette(const u16* src, u16* dst, int count, u8 fraction) {
+    for (int i = 0; i < count; i++) {
+        int r = src[i] & 0x1F;
+        int g = (src[i] >> 5) & 0x1F;
+        int b = (src[i] >> 10) & 0x1F;
+        r += ((31 - r) * fraction) >> 4;
+        g += ((31 - g) * fraction) >> 4;
+        b += ((31 - b) * fraction) >> 4;
+        dst[i] = (u16)(r | (g << 5) | (b << 10));
+    }
+}
+
+static BOOL RunFade(PAL_GraphicsColorMode mode, const char* name, int frames,
+                    const u8* tiles, const u16* tilemap, const u8* spriteGfx,
+                    const u16* basePalette, FadeResult* result) {
+    if (!PAL_Graphics_SetColorMode(mode)) {
+        return FALSE;
+    }
+
+    PAL_BgConfig* bgConfig = PAL_Bg_CreateConfig(BENCH_HEAP_ID);
+    PAL_SpriteManager* sprites = PAL_Sprite_CreateManager(NUM_SPRITES, BENCH_HEAP_ID);
+    if (!bgConfig || !sprites) {
+        fprintf(stderr, "Failed to create BG config or sprite manager\n");
+        exit(1);
+    }
+
+    PAL_BgTemplate bgTemplate;
+    memset(&bgTemplate, 0, sizeof(bgTemplate));
+    bgTemplate.bufferSize = TILEMAP_ENTRIES * sizeof(u16);
+    bgTemplate.screenSize = PAL_BG_SCREEN_SIZE_256x256;
+    bgTemplate.colorMode = PAL_BG_COLOR_MODE_4BPP;
+
+    for (u8 layer = 0; layer < PAL_BG_LAYER_MAX; layer++) {
+        PAL_Bg_InitFromTemplate(bgConfig, layer, &bgTemplate, PAL_BG_TYPE_STATIC);
+        PAL_Bg_LoadTiles(bgConfig, layer, tiles, NUM_TILES * 32, 0);
+        PAL_Bg_LoadTilemapBuffer(bgConfig, layer, tilemap, TILEMAP_ENTRIES * sizeof(u16));
+    }
+
+    for (int i = 0; i < NUM_SPRITES; i++) {
+        PAL_SpriteTemplate spriteTemplate;
+        memset(&spriteTemplate, 0, sizeof(spriteTemplate));
+        spriteTemplate.graphics_data = spriteGfx + (i % 4) * SPRITE_BYTES;
+        spriteTemplate.graphics_size = SPRITE_BYTES;
+        spriteTemplate.size = PAL_SPRITE_SIZE_64x64;
+        spriteTemplate.color_mode = PAL_SPRITE_COLOR_4BPP;
+        spriteTemplate.x = (i % 4) * 64;
+        spriteTemplate.y = ((i / 4) % 3) * 64;
+        spriteTemplate.palette_num = (u8)(i & 0x0F);
+        spriteTemplate.screen = (i < NUM_SPRITES / 2) ? PAL_SCREEN_MAIN : PAL_SCREEN_SUB;
+        PAL_Sprite_Create(sprites, &spriteTemplate);
+    }
+
+    u16 faded[256];
+    u64 freq = PAL_Timer_GetPerformanceFrequency();
+    double totalMs = 0.0;
+    u64 totalTiles = 0;
+    result->name = name;
+    result->maxMs = 0.0;
+
+    // Frame -1 is a warm-up that decodes everything once in both modes
+    for (int frame = -1; frame < frames; frame++) {
+        int step = (frame < 0) ? 0 : frame % (FADE_STEPS * 2);
+        u8 fraction = (u8)(step <= FADE_STEPS ? step : FADE_STEPS * 2 - step);
+        BlendPalette(basePalette, faded, 256, fraction);
+
+        u64 start = PAL_Timer_GetPerformanceCounter();
+
+        PAL_Bg_LoadScreenPalette(PAL_SCREEN_MAIN, faded, sizeof(faded), 0);
+        PAL_Bg_LoadScreenPalette(PAL_SCREEN_SUB, faded, sizeof(faded), 0);
+        PAL_Sprite_LoadScreenPalette(PAL_SCREEN_MAIN, faded, sizeof(faded), 0);
+        PAL_Sprite_LoadScreenPalette(PAL_SCREEN_SUB, faded, sizeof(faded), 0);
+
+        PAL_Graphics_BeginFrame();
+        PAL_Bg_RenderAll(bgConfig, sprites);
+        PAL_Graphics_EndFrame();
+
+        u64 end = PAL_Timer_GetPerformanceCounter();
+        if (frame < 0) {
+            continue;
+        }
+
+        double ms = (double)(end - start) * 1000.0 / (double)freq;
+        totalMs += ms;
+        if (ms > result->maxMs) {
+            result->maxMs = ms;
+        }
+        for (u8 layer = 0; layer < PAL_BG_LAYER_MAX; layer++) {
+            totalTiles += PAL_Bg_GetTilesDecoded(layer);
+        }
+    }
+
+    result->avgMs = totalMs / frames;
+    result->tilesPerFrame = (double)totalTiles / frames;
+
+    PAL_Sprite_DestroyManager(sprites);
+    PAL_Bg_DestroyConfig(bgConfig);
+    return TRUE;
+}
+
+int main(int argc, char* argv[]) {
+    int frames = (argc > 1) ? atoi(argv[1]) : 600;
+    const char* videoDriver = (argc > 2) ? argv[2] : "offscreen";
+    if (frames <= 0) {
+        frames = 1;
+    }
+
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, videoDriver);
+    if (!SDL_Init(SDL_INIT_VIDEO)) {
+        fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+        return 1;
+    }
+    PAL_Timer_Init();
+    if (!PAL_Graphics_Init(PAL_SCREEN_WIDTH * 2, PAL_SCREEN_HEIGHT)) {
+        fprintf(stderr, "PAL_Graphics_Init failed: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    u8* tiles = malloc(NUM_TILES * 32);
+    u16* tilemap = malloc(TILEMAP_ENTRIES * sizeof(u16));
+    u8* spriteGfx = malloc(4 * SPRITE_BYTES);
+    u16 basePalette[256];
+
+    if (!tiles || !tilemap || !spriteGfx) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    for (int i = 0; i < NUM_TILES * 32; i++) {
+        tiles[i] = (u8)(NextRandom() >> 16);
+    }
+    for (int i = 0; i < 4 * SPRITE_BYTES; i++) {
+        spriteGfx[i] = (u8)(NextRandom() >> 16);
+    }
+    // Every entry uses a random tile, flip and sub-palette
+    for (int i = 0; i < TILEMAP_ENTRIES; i++) {
+        tilemap[i] = (u16)(NextRandom() >> 16);
+        tilemap[i] = (u16)((tilemap[i] & 0xFC00) | (i % NUM_TILES));
+    }
+    for (int i = 0; i < 256; i++) {
+        basePalette[i] = (u16)((NextRandom() >> 16) & 0x7FFF);
+    }
+
+    FadeResult results[2];
+    int numResults = 0;
+
+    if (RunFade(PAL_GRAPHICS_COLOR_DIRECT, "direct", frames, tiles, tilemap, spriteGfx,
+                basePalette, &results[numResults])) {
+        numResults++;
+    }
+    if (RunFade(PAL_GRAPHICS_COLOR_INDEXED, "indexed", frames, tiles, tilemap, spriteGfx,
+                basePalette, &results[numResults])) {
+        numResults++;
+    } else {
+        printf("indexed mode not supported by this renderer (needs SDL 3.4)\n");
+    }
+
+    printf("renderer: %s, %d frames\n", SDL_GetRendererName(PAL_Graphics_GetRenderer()), frames);
+    printf("%-8s %12s %12s %14s\n", "mode", "avg ms", "max ms", "tiles/frame");
+    for (int i = 0; i < numResults; i++) {
+        printf("%-8s %12.3f %12.3f %14.1f\n", results[i].name, results[i].avgMs,
+               results[i].maxMs, results[i].tilesPerFrame);
+    }
+
+    free(tiles);
+    free(tilemap);
+    free(spriteGfx);
+    PAL_Graphics_Shutdown();
+    PAL_Timer_Shutdown();
+    SDL_Quit();
+
+    return 0;
+}
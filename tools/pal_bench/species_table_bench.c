@@ -0,0 +1,287 @@
+/**
+ * @file species_table_bench.c
+ * @brief Benchmark for species lookups, per-call archive reads vs resident tables
+ *
+ * Replays the species lookups the PC box app makes when it opens with 18 full
+ * boxes (540 mons): level from experience, gender ratio, both types, and the
+ * experience of the current and next level for the progress bar. Two ways:
+ *   read  - the previous path: allocate a SpeciesData or experience table on
+ *           HEAP_ID_SYSTEM, copy the member out of the mapped archive, read
+ *           one field and free it, for every lookup
+ *   table - SpeciesTable, built once from the same archives
+ *
+ * Both must produce the same checksum.
+ *
+ * Usage: pal_bench_species_table [root] [iterations]
+ */
+
+#include "heap.h"
+#include "narc.h"
+#include "species_table.h"
+#include "platform/pal_archive.h"
+#include "platform/pal_memory.h"
+#include "platform/pal_timer.h"
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_BOXES 18
+#define MONS_PER_BOX 30
+#define NUM_MONS (NUM_BOXES * MONS_PER_BOX)
+#define NUM_SPECIES 493
+
+// Keeps the timed passes from being optimized out
+static volatile u32 sSink;
+
+typedef struct {
+    u16 species;
+    u32 exp;
+} BoxMon;
+
+typedef struct {
+    enum NarcID narcID;
+    const char* path;
+    PAL_Archive* archive;
+} BenchArchive;
+
+static BenchArchive sArchives[] = {
+    { NARC_INDEX_POKETOOL__PERSONAL__PL_PERSONAL, "poketool/personal/pl_personal.narc", NULL },
+    { NARC_INDEX_POKETOOL__PERSONAL__PL_GROWTBL, "poketool/personal/pl_growtbl.narc", NULL },
+    { NARC_INDEX_POKETOOL__PERSONAL__WOTBL, "poketool/personal/wotbl.narc", NULL },
+    { NARC_INDEX_POKETOOL__PERSONAL__EVO, "poketool/personal/evo.narc", NULL },
+};
+
+#define NUM_ARCHIVES (sizeof(sArchives) / sizeof(sArchives[0]))
+
+// ============================================================================
+// The subset of narc.c that SpeciesTable uses, over the bench's archives
+// ============================================================================
+
+static PAL_Archive* GetArchive(enum NarcID narcID) {
+    for (u32 i = 0; i < NUM_ARCHIVES; i++) {
+        if (sArchives[i].narcID == narcID) {
+            return sArchives[i].archive;
+        }
+    }
+    
+    return NULL;
+}
+
+const void* NARC_GetMemberView(enum NarcID narcID, int memberIndex, u32* size) {
+    PAL_Archive* archive = GetArchive(narcID);
+    
+    return archive ? PAL_Archive_GetMember(archive, memberIndex, size) : NULL;
+}
+
+u16 NARC_GetMemberCountByIndexPair(enum NarcID narcID) {
+    PAL_Archive* archive = GetArchive(narcID);
+    
+    return archive ? PAL_Archive_GetMemberCount(archive) : 0;
+}
+
+static void ReadWholeMember(void* dest, enum NarcID narcID, int memberIndex) {
+    u32 size = 0;
+    const void* member = NARC_GetMemberView(narcID, memberIndex, &size);
+    
+    if (member) {
+        memcpy(dest, member, size);
+    }
+}
+
+// ============================================================================
+// Previous lookups, as pokemon.c made them before the resident tables
+// ============================================================================
+
+static u32 ReadSpeciesValue(int species, enum SpeciesDataParam param) {
+    SpeciesData* speciesData = Heap_Alloc(HEAP_ID_SYSTEM, sizeof(SpeciesData));
+    u32 result = 0;
+    
+    ReadWholeMember(speciesData, NARC_INDEX_POKETOOL__PERSONAL__PL_PERSONAL, species);
+    
+    switch (param) {
+    case SPECIES_DATA_TYPE_1:
+        result = speciesData->types[0];
+        break;
+    case SPECIES_DATA_TYPE_2:
+        result = speciesData->types[1];
+        break;
+    case SPECIES_DATA_GENDER_RATIO:
+        result = speciesData->genderRatio;
+        break;
+    case SPECIES_DATA_EXP_RATE:
+        result = speciesData->expRate;
+        break;
+    default:
+        break;
+    }
+    
+    Heap_Free(speciesData);
+    return result;
+}
+
+static u32 ReadBaseExpAt(int species, int level) {
+    u32* expTable = Heap_Alloc(HEAP_ID_SYSTEM, (MAX_POKEMON_LEVEL + 1) * 4);
+    
+    ReadWholeMember(expTable, NARC_INDEX_POKETOOL__PERSONAL__PL_GROWTBL, ReadSpeciesValue(species, SPECIES_DATA_EXP_RATE));
+    
+    u32 result = expTable[level];
+    Heap_Free(expTable);
+    
+    return result;
+}
+
+static u32 ReadLevelAt(int species, u32 exp) {
+    static u32 expTable[MAX_POKEMON_LEVEL + 1];
+    SpeciesData* speciesData = Heap_Alloc(HEAP_ID_SYSTEM, sizeof(SpeciesData));
+    
+    ReadWholeMember(speciesData, NARC_INDEX_POKETOOL__PERSONAL__PL_PERSONAL, species);
+    ReadWholeMember(expTable, NARC_INDEX_POKETOOL__PERSONAL__PL_GROWTBL, speciesData->expRate);
+    Heap_Free(speciesData);
+    
+    int i;
+    for (i = 1; i < MAX_POKEMON_LEVEL + 1; i++) {
+        if (expTable[i] > exp) {
+            break;
+        }
+    }
+    
+    return i - 1;
+}
+
+// ============================================================================
+// Box open
+// ============================================================================
+
+static u32 OpenBoxesRead(const BoxMon* mons) {
+    u32 checksum = 0;
+    
+    for (u32 i = 0; i < NUM_MONS; i++) {
+        u32 level = ReadLevelAt(mons[i].species, mons[i].exp);
+        
+        checksum = checksum * 31 + level;
+        checksum = checksum * 31 + ReadSpeciesValue(mons[i].species, SPECIES_DATA_GENDER_RATIO);
+        checksum = checksum * 31 + ReadSpeciesValue(mons[i].species, SPECIES_DATA_TYPE_1);
+        checksum = checksum * 31 + ReadSpeciesValue(mons[i].species, SPECIES_DATA_TYPE_2);
+        checksum = checksum * 31 + ReadBaseExpAt(mons[i].species, level);
+        checksum = checksum * 31 + ReadBaseExpAt(mons[i].species, level + 1);
+    }
+    
+    return checksum;
+}
+
+static u32 OpenBoxesTable(const BoxMon* mons) {
+    u32 checksum = 0;
+    
+    for (u32 i = 0; i < NUM_MONS; i++) {
+        u32 expRate = SpeciesTable_GetValue(mons[i].species, SPECIES_DATA_EXP_RATE);
+        u32 level = SpeciesTable_GetLevelAt(expRate, mons[i].exp);
+        
+        checksum = checksum * 31 + level;
+        checksum = checksum * 31 + SpeciesTable_GetValue(mons[i].species, SPECIES_DATA_GENDER_RATIO);
+        checksum = checksum * 31 + SpeciesTable_GetValue(mons[i].species, SPECIES_DATA_TYPE_1);
+        checksum = checksum * 31 + SpeciesTable_GetValue(mons[i].species, SPECIES_DATA_TYPE_2);
+        checksum = checksum * 31 + SpeciesTable_GetBaseExpAt(SpeciesTable_GetValue(mons[i].species, SPECIES_DATA_EXP_RATE), level);
+        checksum = checksum * 31 + SpeciesTable_GetBaseExpAt(SpeciesTable_GetValue(mons[i].species, SPECIES_DATA_EXP_RATE), level + 1);
+    }
+    
+    return checksum;
+}
+
+// Random species at random levels below 100, with experience part of the
+// way to the next level
+static void FillBoxes(BoxMon* mons) {
+    u32 seed = 12345;
+    
+    for (u32 i = 0; i < NUM_MONS; i++) {
+        seed = seed * 1103515245 + 24691;
+        mons[i].species = 1 + (seed >> 16) % NUM_SPECIES;
+        
+        seed = seed * 1103515245 + 24691;
+        int level = 1 + (seed >> 16) % (MAX_POKEMON_LEVEL - 1);
+        u32 levelExp = ReadBaseExpAt(mons[i].species, level);
+        u32 nextExp = ReadBaseExpAt(mons[i].species, level + 1);
+        
+        seed = seed * 1103515245 + 24691;
+        mons[i].exp = levelExp + (nextExp > levelExp ? (seed >> 16) % (nextExp - levelExp) : 0);
+    }
+}
+
+static u64 TimeOpen(u32 (*open)(const BoxMon*), const BoxMon* mons, int iterations, u32* checksum) {
+    u64 best = ~0ull;
+    
+    *checksum = open(mons);
+    for (int i = 0; i < iterations; i++) {
+        u64 start = PAL_Timer_GetPerformanceCounter();
+        sSink = open(mons);
+        u64 elapsed = PAL_Timer_GetPerformanceCounter() - start;
+        
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    const char* root = argc > 1 ? argv[1] : "resources/filesys";
+    int iterations = argc > 2 ? atoi(argv[2]) : 20;
+    HeapParam templates[1] = { { .size = 0x40000, .arena = 0 } };
+    
+    if (iterations < 1) {
+        iterations = 1;
+    }
+    
+    PAL_Timer_Init();
+    Heap_InitSystem(templates, 1, HEAP_ID_MAX, 0);
+    
+    PAL_Archive_SetRootDir(root);
+    for (u32 i = 0; i < NUM_ARCHIVES; i++) {
+        sArchives[i].archive = PAL_Archive_Open(sArchives[i].path);
+        
+        if (sArchives[i].archive == NULL) {
+            fprintf(stderr, "Failed to open %s/%s\n", root, sArchives[i].path);
+            return 1;
+        }
+    }
+    
+    u64 start = PAL_Timer_GetPerformanceCounter();
+    if (!SpeciesTable_Load()) {
+        fprintf(stderr, "Failed to build the species tables\n");
+        return 1;
+    }
+    u64 loadTicks = PAL_Timer_GetPerformanceCounter() - start;
+    
+    BoxMon mons[NUM_MONS];
+    FillBoxes(mons);
+    
+    u32 readChecksum;
+    u32 tableChecksum;
+    u64 readTicks = TimeOpen(OpenBoxesRead, mons, iterations, &readChecksum);
+    u64 tableTicks = TimeOpen(OpenBoxesTable, mons, iterations, &tableChecksum);
+    double frequency = (double)PAL_Timer_GetPerformanceFrequency();
+    double readUs = readTicks * 1e6 / frequency;
+    double tableUs = tableTicks * 1e6 / frequency;
+    
+    printf("Species tables built in %.1f us\n", loadTicks * 1e6 / frequency);
+    printf("\nPC box open, %d boxes x %d mons, best of %d:\n", NUM_BOXES, MONS_PER_BOX, iterations);
+    printf("  %-6s %12s %12s %10s\n", "mode", "us/open", "ns/mon", "checksum");
+    printf("  %-6s %12.1f %12.1f %10x\n", "read", readUs, readUs * 1000.0 / NUM_MONS, readChecksum);
+    printf("  %-6s %12.1f %12.1f %10x\n", "table", tableUs, tableUs * 1000.0 / NUM_MONS, tableChecksum);
+    printf("  speedup %.1fx\n", readUs / tableUs);
+    
+    SpeciesTable_Unload();
+    for (u32 i = 0; i < NUM_ARCHIVES; i++) {
+        PAL_Archive_Close(sArchives[i].archive);
+    }
+    PAL_Timer_Shutdown();
+    
+    if (readChecksum != tableChecksum) {
+        fprintf(stderr, "Checksum mismatch between read and table lookups\n");
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file tile_decode_bench.c
+ * @brief Micro-benchmark for the PAL 4bpp/8bpp decode kernels
+ *
+ * Decodes a fixed set of random tiles and sprite bitmaps with every decode
+ * path the CPU supports, reports pixels/sec per path and checks that each
+ * path's output is bit-identical to the scalar reference.
+ *
+ * Usage: pal_bench_tile_decode [iterations]
+ */
+
+#include "platform/pal_tile_decode.h"
+#include "platform/pal_timer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_TILES     1024
+#define TILES_PER_ROW 32
+#define SPRITE_SIZE   64
+#define NUM_SPRITES   64
+
+typedef struct {
+    const char* name;
+    u64 pixels;
+    double seconds;
+    BOOL exact;
+} BenchResult;
+
+static u32 sRngState = 0x12345678;
+
+static u32 NextRandom(void) {
+    sRngState = sRngState * 1103515245 + 12345;
+    return sRngState;
+}
+
+static void FillRandom(u8* buf, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        buf[i] = (u8)(NextRandom() >> 16);
+    }
+}
+
+// Decodes every tile in all four flip variants plus every sprite bitmap
+static void RunDecodePass(const u8* tiles4, const u8* tiles8, const u8* sprites4, const u8* sprites8,
+                          const u32* lut, u32* tileOut, u32* spriteOut) {
+    int tileStride = TILES_PER_ROW * 8;
+
+    for (u32 flip = 0; flip < 4; flip++) {
+        for (int t = 0; t < NUM_TILES; t++) {
+            u32* dst = tileOut + flip * (NUM_TILES * 64 * 2)
+                + (t / TILES_PER_ROW) * 8 * tileStride + (t % TILES_PER_ROW) * 8;
+            PAL_TileDecode_Tile4bpp(tiles4 + t * 32, &lut[(t & 15) * 16], dst, tileStride, flip);
+            PAL_TileDecode_Tile8bpp(tiles8 + t * 64, lut, dst + NUM_TILES * 64, tileStride, flip);
+        }
+
+        for (int s = 0; s < NUM_SPRITES; s++) {
+            u32* dst = spriteOut + (flip * NUM_SPRITES + s) * SPRITE_SIZE * SPRITE_SIZE * 2;
+            PAL_TileDecode_Linear4bpp(sprites4 + s * SPRITE_SIZE * SPRITE_SIZE / 2, &lut[(s & 15) * 16],
+                                      dst, SPRITE_SIZE, SPRITE_SIZE, SPRITE_SIZE, flip);
+            PAL_TileDecode_Linear8bpp(sprites8 + s * SPRITE_SIZE * SPRITE_SIZE, lut,
+                                      dst + SPRITE_SIZE * SPRITE_SIZE, SPRITE_SIZE, SPRITE_SIZE,
+                                      SPRITE_SIZE, flip);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 200;
+    if (iterations <= 0) {
+        iterations = 1;
+    }
+
+    PAL_Timer_Init();
+
+    size_t tileOutCount = 4 * NUM_TILES * 64 * 2;
+    size_t spriteOutCount = 4 * NUM_SPRITES * SPRITE_SIZE * SPRITE_SIZE * 2;
+    u64 pixelsPerPass = (u64)tileOutCount + spriteOutCount;
+
+    u8* tiles4 = malloc(NUM_TILES * 32);
+    u8* tiles8 = malloc(NUM_TILES * 64);
+    u8* sprites4 = malloc(NUM_SPRITES * SPRITE_SIZE * SPRITE_SIZE / 2);
+    u8* sprites8 = malloc(NUM_SPRITES * SPRITE_SIZE * SPRITE_SIZE);
+    u32* refTiles = malloc(tileOutCount * sizeof(u32));
+    u32* refSprites = malloc(spriteOutCount * sizeof(u32));
+    u32* outTiles = malloc(tileOutCount * sizeof(u32));
+    u32* outSprites = malloc(spriteOutCount * sizeof(u32));
+    u32 lut[256];
+
+    if (!tiles4 || !tiles8 || !sprites4 || !sprites8 || !refTiles || !refSprites
+        || !outTiles || !outSprites) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    FillRandom(tiles4, NUM_TILES * 32);
+    FillRandom(tiles8, NUM_TILES * 64);
+    FillRandom(sprites4, NUM_SPRITES * SPRITE_SIZE * SPRITE_SIZE / 2);
+    FillRandom(sprites8, NUM_SPRITES * SPRITE_SIZE * SPRITE_SIZE);
+    for (int i = 0; i < 256; i++) {
+        lut[i] = NextRandom() | 0xFF000000;
+    }
+
+    // Scalar reference output
+    PAL_TileDecode_SetPath(PAL_TILE_DECODE_SCALAR);
+    RunDecodePass(tiles4, tiles8, sprites4, sprites8, lut, refTiles, refSprites);
+
+    BenchResult results[PAL_TILE_DECODE_PATH_MAX];
+    int numResults = 0;
+    BOOL allExact = TRUE;
+    u64 freq = PAL_Timer_GetPerformanceFrequency();
+
+    for (int path = 0; path < PAL_TILE_DECODE_PATH_MAX; path++) {
+        if (!PAL_TileDecode_SetPath((PAL_TileDecodePath)path)) {
+            continue;
+        }
+
+        memset(outTiles, 0xCD, tileOutCount * sizeof(u32));
+        memset(outSprites, 0xCD, spriteOutCount * sizeof(u32));
+        RunDecodePass(tiles4, tiles8, sprites4, sprites8, lut, outTiles, outSprites);
+
+        BenchResult* result = &results[numResults++];
+        result->name = PAL_TileDecode_GetPathName((PAL_TileDecodePath)path);
+        result->exact = memcmp(outTiles, refTiles, tileOutCount * sizeof(u32)) == 0
+            && memcmp(outSprites, refSprites, spriteOutCount * sizeof(u32)) == 0;
+        allExact = allExact && result->exact;
+
+        u64 start = PAL_Timer_GetPerformanceCounter();
+        for (int i = 0; i < iterations; i++) {
+            RunDecodePass(tiles4, tiles8, sprites4, sprites8, lut, outTiles, outSprites);
+        }
+        u64 end = PAL_Timer_GetPerformanceCounter();
+
+        result->pixels = pixelsPerPass * iterations;
+        result->seconds = (double)(end - start) / (double)freq;
+    }
+
+    printf("%-8s %14s %10s %s\n", "path", "Mpixels/sec", "speedup", "bit-exact");
+    double scalarRate = 0.0;
+    for (int i = 0; i < numResults; i++) {
+        double rate = (double)results[i].pixels / results[i].seconds / 1e6;
+        if (i == 0) {
+            scalarRate = rate;
+        }
+        printf("%-8s %14.1f %9.2fx %s\n", results[i].name, rate, rate / scalarRate,
+               results[i].exact ? "yes" : "NO");
+    }
+
+    free(tiles4);
+    free(tiles8);
+    free(sprites4);
+    free(sprites8);
+    free(refTiles);
+    free(refSprites);
+    free(outTiles);
+    free(outSprites);
+    PAL_Timer_Shutdown();
+
+    return allExact ? 0 : 1;
+}